@@ -0,0 +1,85 @@
+# Tools
+CC = g++ -c
+LD = g++
+RM = rm -rf
+MKDIR = mkdir -p
+
+
+# Toolchain arguments
+CFLAGS = -O3 -MMD -MP -std=c++1y -fPIC -pthread
+LFLAGS = -pthread
+
+
+# Output name of executable file
+EXECUTABLE_DIRECTORY = bench
+EXECUTABLE = $(EXECUTABLE_DIRECTORY)/bcore.exe
+
+
+# Environment
+SOURCES_DIRECTORY = src
+BENCH_DIRECTORY = bench
+
+
+# Project sources
+SOURCES_MODULES = . cluster container differential interface nnet parallel tsp utils
+BENCH_MODULES = .
+
+SOURCES_DIRECTORIES = $(addprefix $(SOURCES_DIRECTORY)/, $(SOURCES_MODULES))
+SOURCES_DIRECTORIES += $(addprefix $(BENCH_DIRECTORY)/, $(BENCH_MODULES))
+
+SOURCES = $(foreach SUBDIR, $(SOURCES_DIRECTORIES), $(wildcard $(SUBDIR)/*.cpp))
+
+INCLUDES = -I$(SOURCES_DIRECTORY) -I$(BENCH_DIRECTORY)
+
+
+# Project objects
+OBJECTS_DIRECTORY = obj/bench
+
+OBJECTS_DIRECTORIES = $(addprefix $(OBJECTS_DIRECTORY)/$(SOURCES_DIRECTORY)/, $(SOURCES_MODULES))
+OBJECTS_DIRECTORIES += $(addprefix $(OBJECTS_DIRECTORY)/$(BENCH_DIRECTORY)/, $(BENCH_MODULES))
+
+OBJECTS = $(patsubst %.cpp, $(OBJECTS_DIRECTORY)/%.o, $(SOURCES))
+
+
+# The dependency file names
+DEPENDENCIES = $(OBJECTS:.o=.d)
+
+
+# Targets
+.PHONY: bench
+bench: mkdirs $(EXECUTABLE)
+
+
+.PHONY: mkdirs
+mkdirs: $(OBJECTS_DIRECTORIES)
+
+
+.PHONY: clean
+clean:
+	$(RM) $(EXECUTABLE) $(OBJECTS_DIRECTORY)
+
+
+# Build targets
+$(EXECUTABLE): $(OBJECTS)
+	$(LD) $(LFLAGS) $^ -o $@
+
+
+$(OBJECTS_DIRECTORIES):
+	$(MKDIR) $@
+
+
+vpath %.cpp $(SOURCES_DIRECTORIES)
+
+
+define make-objects
+$1/%.o: %.cpp
+	$(CC) $(CFLAGS) $(INCLUDES) $$< -o $$@
+endef
+
+
+$(foreach OBJDIR, $(OBJECTS_DIRECTORIES), $(eval $(call make-objects, $(OBJDIR))))
+
+
+# Include dependencies
+-include $(DEPENDENCIES)
+
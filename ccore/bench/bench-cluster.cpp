@@ -0,0 +1,114 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#include "benchmark.hpp"
+
+#include <algorithm>
+
+#include "cluster/agglomerative.hpp"
+#include "cluster/cure.hpp"
+#include "cluster/dbscan.hpp"
+#include "cluster/hsyncnet.hpp"
+#include "cluster/kmeans.hpp"
+#include "cluster/kmedians.hpp"
+#include "cluster/kmedoids.hpp"
+#include "cluster/optics.hpp"
+#include "cluster/rock.hpp"
+#include "cluster/syncnet.hpp"
+#include "cluster/xmeans.hpp"
+
+
+using namespace cluster_analysis;
+
+
+static dataset get_initial_centers(const dataset & p_data, const std::size_t p_amount) {
+    /* points of synthetic data belong to clusters in round-robin order */
+    return dataset(p_data.begin(), p_data.begin() + std::min(p_amount, p_data.size()));
+}
+
+
+void register_cluster_benchmarks(benchmark_runner & p_runner) {
+    p_runner.add("kmeans", 100000, [](const dataset & p_data) {
+        kmeans_data result;
+        kmeans(get_initial_centers(p_data, BENCHMARK_AMOUNT_CLUSTERS), 0.001).process(p_data, result);
+    });
+
+    p_runner.add("xmeans", 100000, [](const dataset & p_data) {
+        xmeans_data result;
+        xmeans(get_initial_centers(p_data, 2), 2 * BENCHMARK_AMOUNT_CLUSTERS, 0.001, splitting_type::BAYESIAN_INFORMATION_CRITERION).process(p_data, result);
+    });
+
+    p_runner.add("kmedians", 100000, [](const dataset & p_data) {
+        kmedians_data result;
+        kmedians(get_initial_centers(p_data, BENCHMARK_AMOUNT_CLUSTERS), 0.001).process(p_data, result);
+    });
+
+    p_runner.add("kmedoids", 10000, [](const dataset & p_data) {
+        medoid_sequence medoids;
+        for (std::size_t index = 0; index < std::min(BENCHMARK_AMOUNT_CLUSTERS, p_data.size()); index++) {
+            medoids.push_back(index);
+        }
+
+        kmedoids_data result;
+        kmedoids(medoids, 0.001).process(p_data, result);
+    });
+
+    p_runner.add("dbscan", 10000, [](const dataset & p_data) {
+        dbscan_data result;
+        dbscan(get_benchmark_radius(p_data[0].size()), 5).process(p_data, result);
+    });
+
+    p_runner.add("optics", 10000, [](const dataset & p_data) {
+        optics_data result;
+        optics(get_benchmark_radius(p_data[0].size()), 5).process(p_data, result);
+    });
+
+    p_runner.add("cure", 1000, [](const dataset & p_data) {
+        cure_data result;
+        cure(BENCHMARK_AMOUNT_CLUSTERS, 5, 0.5).process(p_data, result);
+    });
+
+    p_runner.add("rock", 1000, [](const dataset & p_data) {
+        cluster_data result;
+        rock(get_benchmark_radius(p_data[0].size()), BENCHMARK_AMOUNT_CLUSTERS, 0.5).process(p_data, result);
+    });
+
+    p_runner.add("agglomerative", 1000, [](const dataset & p_data) {
+        cluster_data result;
+        agglomerative(BENCHMARK_AMOUNT_CLUSTERS, type_link::SINGLE_LINK).process(p_data, result);
+    });
+
+    p_runner.add("syncnet", 1000, [](const dataset & p_data) {
+        dataset data = p_data;
+        syncnet network(&data, get_benchmark_radius(data[0].size()), false, initial_type::EQUIPARTITION);
+
+        syncnet_analyser analyser;
+        network.process(0.995, solve_type::FAST, false, analyser);
+    });
+
+    p_runner.add("hsyncnet", 100, [](const dataset & p_data) {
+        dataset data = p_data;
+        hsyncnet network(&data, BENCHMARK_AMOUNT_CLUSTERS, initial_type::EQUIPARTITION);
+
+        hsyncnet_analyser analyser;
+        network.process(0.995, solve_type::FAST, false, analyser);
+    });
+}
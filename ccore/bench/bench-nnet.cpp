@@ -0,0 +1,78 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#include "benchmark.hpp"
+
+#include <cmath>
+
+#include "nnet/legion.hpp"
+#include "nnet/pcnn.hpp"
+#include "nnet/som.hpp"
+#include "nnet/sync.hpp"
+
+
+/* networks of oscillators use only size of data - it defines amount of oscillators in square grid */
+static std::size_t get_grid_size(const dataset & p_data) {
+    const std::size_t side = static_cast<std::size_t>(std::sqrt(static_cast<double>(p_data.size())));
+    return side * side;
+}
+
+
+static pcnn_stimulus create_stimulus(const dataset & p_data) {
+    pcnn_stimulus stimulus(get_grid_size(p_data));
+    for (std::size_t index = 0; index < stimulus.size(); index++) {
+        stimulus[index] = (p_data[index][0] > 50.0) ? 1.0 : 0.0;
+    }
+
+    return stimulus;
+}
+
+
+void register_nnet_benchmarks(benchmark_runner & p_runner) {
+    p_runner.add("som", 100000, [](const dataset & p_data) {
+        som_parameters parameters;
+        som network(10, 10, som_conn_type::SOM_GRID_FOUR, parameters);
+        network.train(p_data, 20, false);
+    });
+
+    p_runner.add("sync", 1000, [](const dataset & p_data) {
+        sync_network network(p_data.size(), 1.0, 0.0, connection_t::CONNECTION_ALL_TO_ALL, initial_type::EQUIPARTITION);
+
+        sync_dynamic dynamic;
+        network.simulate_dynamic(0.995, 0.1, solve_type::FAST, false, dynamic);
+    });
+
+    p_runner.add("pcnn", 10000, [](const dataset & p_data) {
+        pcnn_parameters parameters;
+        pcnn network(get_grid_size(p_data), connection_t::CONNECTION_GRID_FOUR, parameters);
+
+        pcnn_dynamic dynamic;
+        network.simulate(100, create_stimulus(p_data), dynamic);
+    });
+
+    p_runner.add("legion", 1000, [](const dataset & p_data) {
+        legion_parameters parameters;
+        legion_network network(get_grid_size(p_data), connection_t::CONNECTION_GRID_FOUR, parameters);
+
+        legion_dynamic dynamic;
+        network.simulate(10, 100, solve_type::RK4, false, create_stimulus(p_data), dynamic);
+    });
+}
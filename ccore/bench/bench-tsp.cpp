@@ -0,0 +1,50 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#include "benchmark.hpp"
+
+#include "tsp/ant_colony.hpp"
+#include "tsp/distance_matrix.hpp"
+
+
+void register_tsp_benchmarks(benchmark_runner & p_runner) {
+    /* points of synthetic data are used as cities */
+    p_runner.add("ant_colony", 1000, [](const dataset & p_data) {
+        std::vector<city_distance::object_coordinate> cities;
+        for (const auto & city : p_data) {
+            cities.emplace_back(city);
+        }
+
+        using AntAPI = ant::ant_colony_TSP_params_initializer;
+        auto parameters = ant::ant_colony_TSP_params::make_param(
+            AntAPI::Q_t{ 1.5 },
+            AntAPI::Ro_t{ 0.7 },
+            AntAPI::Alpha_t{ 1.0 },
+            AntAPI::Beta_t{ 1.0 },
+            AntAPI::Gamma_t{ 2.0 },
+            AntAPI::InitialPheramone_t{ 0.1 },
+            AntAPI::Iterations_t{ 10 },
+            AntAPI::CountAntsInIteration_t{ 10 });
+
+        ant::ant_colony algorithm(city_distance::distance_matrix::make_city_distance_matrix(cities), parameters);
+        algorithm.process();
+    });
+}
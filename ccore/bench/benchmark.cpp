@@ -0,0 +1,141 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+#include "parallel/parallel.hpp"
+#include "utils/distance_kernel.hpp"
+
+
+static const char * get_instruction_set_name(const utils::simd_instruction_set p_set) {
+    switch(p_set) {
+    case utils::simd_instruction_set::SSE2:
+        return "sse2";
+    case utils::simd_instruction_set::AVX2:
+        return "avx2";
+    case utils::simd_instruction_set::AVX512:
+        return "avx512";
+    default:
+        return "scalar";
+    }
+}
+
+
+void benchmark_runner::add(const std::string & p_algorithm, const std::size_t p_max_size, const benchmark_action & p_action) {
+    m_cases.push_back({ p_algorithm, p_max_size, p_action });
+}
+
+
+void benchmark_runner::run(const benchmark_grid & p_grid, const std::size_t p_repeat, const std::string & p_filter, std::ostream & p_output) const {
+    p_output << "{" << std::endl;
+    p_output << "  \"threads\": " << parallel::get_thread_amount() << "," << std::endl;
+    p_output << "  \"simd\": \"" << get_instruction_set_name(utils::get_simd_instruction_set()) << "\"," << std::endl;
+    p_output << "  \"repeat\": " << p_repeat << "," << std::endl;
+    p_output << "  \"results\": [";
+
+    bool first_result = true;
+    for (const auto & bench_case : m_cases) {
+        if (!p_filter.empty() && (p_filter != bench_case.m_algorithm)) {
+            continue;
+        }
+
+        for (const std::size_t size : p_grid.m_sizes) {
+            if (size > bench_case.m_max_size) {
+                continue;
+            }
+
+            for (const std::size_t dimension : p_grid.m_dimensions) {
+                const dataset data = generate_benchmark_data(size, dimension, BENCHMARK_AMOUNT_CLUSTERS);
+
+                std::vector<double> timings;
+                for (std::size_t index_repeat = 0; index_repeat < p_repeat; index_repeat++) {
+                    const auto start = std::chrono::steady_clock::now();
+                    bench_case.m_action(data);
+                    const auto stop = std::chrono::steady_clock::now();
+
+                    timings.push_back(std::chrono::duration<double, std::milli>(stop - start).count());
+                }
+
+                std::sort(timings.begin(), timings.end());
+
+                double total = 0.0;
+                for (const double timing : timings) {
+                    total += timing;
+                }
+
+                p_output << (first_result ? "" : ",") << std::endl;
+                p_output << "    { \"algorithm\": \"" << bench_case.m_algorithm << "\", "
+                         << "\"size\": " << size << ", "
+                         << "\"dimension\": " << dimension << ", "
+                         << std::fixed << std::setprecision(3)
+                         << "\"min_ms\": " << timings.front() << ", "
+                         << "\"median_ms\": " << timings[timings.size() / 2] << ", "
+                         << "\"mean_ms\": " << total / timings.size() << ", "
+                         << "\"max_ms\": " << timings.back() << " }";
+                p_output.unsetf(std::ios_base::floatfield);
+
+                first_result = false;
+
+                std::cerr << bench_case.m_algorithm << " size=" << size << " dimension=" << dimension
+                          << " median=" << timings[timings.size() / 2] << " ms" << std::endl;
+            }
+        }
+    }
+
+    p_output << std::endl << "  ]" << std::endl << "}" << std::endl;
+}
+
+
+dataset generate_benchmark_data(const std::size_t p_size, const std::size_t p_dimension, const std::size_t p_amount_clusters) {
+    std::mt19937 generator(static_cast<std::mt19937::result_type>(p_size * 131 + p_dimension));
+    std::uniform_real_distribution<double> center_distribution(0.0, 100.0);
+    std::normal_distribution<double> point_distribution(0.0, 1.0);
+
+    dataset centers(p_amount_clusters, point(p_dimension));
+    for (auto & center : centers) {
+        for (auto & coordinate : center) {
+            coordinate = center_distribution(generator);
+        }
+    }
+
+    dataset data(p_size, point(p_dimension));
+    for (std::size_t index_point = 0; index_point < p_size; index_point++) {
+        const point & center = centers[index_point % p_amount_clusters];
+        for (std::size_t index_dimension = 0; index_dimension < p_dimension; index_dimension++) {
+            data[index_point][index_dimension] = center[index_dimension] + point_distribution(generator);
+        }
+    }
+
+    return data;
+}
+
+
+double get_benchmark_radius(const std::size_t p_dimension) {
+    /* distance between two points of the same cluster is about sqrt(2 * dimension) for unit variance */
+    return std::sqrt(2.0 * p_dimension);
+}
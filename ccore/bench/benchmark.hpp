@@ -0,0 +1,140 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#ifndef BENCH_BENCHMARK_HPP_
+#define BENCH_BENCHMARK_HPP_
+
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "definitions.hpp"
+
+
+/**
+*
+* @brief    Sizes and dimensions of synthetic data that are used to measure algorithms.
+*
+*/
+struct benchmark_grid {
+    std::vector<std::size_t>    m_sizes;
+    std::vector<std::size_t>    m_dimensions;
+};
+
+
+/**
+*
+* @brief    Action that is measured, it takes synthetic data that has been generated for it.
+*
+*/
+using benchmark_action = std::function<void(const dataset &)>;
+
+
+/**
+*
+* @brief    Measured algorithm.
+*
+*/
+struct benchmark_case {
+    std::string         m_algorithm;
+    std::size_t         m_max_size;
+    benchmark_action    m_action;
+};
+
+
+/**
+*
+* @brief    Runs benchmarks over grid of synthetic data and reports timings in JSON format.
+*
+*/
+class benchmark_runner {
+private:
+    std::vector<benchmark_case>     m_cases;
+
+public:
+    /**
+    *
+    * @brief    Registers algorithm for measurement.
+    *
+    * @param[in] p_algorithm: name of the algorithm that is used in the report.
+    * @param[in] p_max_size: maximum size of data for the algorithm, bigger sizes of grid are skipped
+    *             to keep running time of algorithms with high complexity reasonable.
+    * @param[in] p_action: action that runs the algorithm.
+    *
+    */
+    void add(const std::string & p_algorithm, const std::size_t p_max_size, const benchmark_action & p_action);
+
+    /**
+    *
+    * @brief    Measures all registered algorithms and writes JSON report.
+    *
+    * @param[in]  p_grid: sizes and dimensions of synthetic data.
+    * @param[in]  p_repeat: amount of measurements for each point of the grid.
+    * @param[in]  p_filter: if it is not empty then only algorithms with this name are measured.
+    * @param[out] p_output: stream where JSON report is written.
+    *
+    */
+    void run(const benchmark_grid & p_grid, const std::size_t p_repeat, const std::string & p_filter, std::ostream & p_output) const;
+};
+
+
+/**
+*
+* @brief    Generates synthetic data - points around several gaussian centers.
+* @details  Data is the same for the same arguments, so timings of different runs are comparable.
+*
+* @param[in] p_size: amount of points.
+* @param[in] p_dimension: amount of coordinates of each point.
+* @param[in] p_amount_clusters: amount of gaussian centers.
+*
+* @return   Returns generated data.
+*
+*/
+dataset generate_benchmark_data(const std::size_t p_size, const std::size_t p_dimension, const std::size_t p_amount_clusters);
+
+/**
+*
+* @brief    Returns radius that covers most of neighbors inside of clusters of synthetic data
+*           with the specified dimension.
+*
+*/
+double get_benchmark_radius(const std::size_t p_dimension);
+
+
+/**
+*
+* @brief    Amount of gaussian centers in synthetic data.
+*
+*/
+const std::size_t BENCHMARK_AMOUNT_CLUSTERS = 5;
+
+
+void register_cluster_benchmarks(benchmark_runner & p_runner);
+
+void register_nnet_benchmarks(benchmark_runner & p_runner);
+
+void register_tsp_benchmarks(benchmark_runner & p_runner);
+
+
+#endif
@@ -0,0 +1,93 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "benchmark.hpp"
+
+#include "parallel/parallel.hpp"
+
+
+static void print_usage(void) {
+    std::cout << "Usage: bcore.exe [options]" << std::endl;
+    std::cout << "  --quick            - use small grid of sizes and dimensions." << std::endl;
+    std::cout << "  --repeat <n>       - amount of measurements for each point of the grid (default 3)." << std::endl;
+    std::cout << "  --algorithm <name> - measure only the specified algorithm." << std::endl;
+    std::cout << "  --threads <n>      - amount of threads for parallel algorithms (default all hardware threads)." << std::endl;
+    std::cout << "  --output <file>    - write JSON report to the file instead of standard output." << std::endl;
+}
+
+
+int main(int argc, char *argv[]) {
+    benchmark_grid grid = { { 100, 1000, 10000, 100000 }, { 2, 8, 32 } };
+    std::size_t repeat = 3;
+    std::string filter;
+    std::string output_file;
+
+    for (int index = 1; index < argc; index++) {
+        const bool has_value = (index + 1 < argc);
+
+        if (std::strcmp(argv[index], "--quick") == 0) {
+            grid = { { 100, 1000 }, { 2, 8 } };
+        }
+        else if ((std::strcmp(argv[index], "--repeat") == 0) && has_value) {
+            repeat = std::max(std::strtoul(argv[++index], nullptr, 10), 1UL);
+        }
+        else if ((std::strcmp(argv[index], "--algorithm") == 0) && has_value) {
+            filter = argv[++index];
+        }
+        else if ((std::strcmp(argv[index], "--threads") == 0) && has_value) {
+            parallel::set_thread_amount(std::strtoul(argv[++index], nullptr, 10));
+        }
+        else if ((std::strcmp(argv[index], "--output") == 0) && has_value) {
+            output_file = argv[++index];
+        }
+        else {
+            print_usage();
+            return (std::strcmp(argv[index], "--help") == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    benchmark_runner runner;
+    register_cluster_benchmarks(runner);
+    register_nnet_benchmarks(runner);
+    register_tsp_benchmarks(runner);
+
+    if (output_file.empty()) {
+        runner.run(grid, repeat, filter, std::cout);
+    }
+    else {
+        std::ofstream output(output_file);
+        if (!output.is_open()) {
+            std::cerr << "Impossible to open output file '" << output_file << "'." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        runner.run(grid, repeat, filter, output);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -6,8 +6,8 @@ MKDIR = mkdir -p
 
 
 # Toolchain arguments.
-CFLAGS = -O3 -MMD -MP -std=c++1y -fPIC
-LFLAGS = -static-libstdc++ -shared
+CFLAGS = -O3 -MMD -MP -std=c++1y -fPIC -pthread
+LFLAGS = -static-libstdc++ -shared -pthread
 
 
 # Executable library file
@@ -16,7 +16,7 @@ EXECUTABLE = $(EXECUTABLE_DIRECTORY)/ccore.so
 
 
 # Project sources
-MODULES = . cluster container differential interface nnet tsp
+MODULES = . cluster container differential interface nnet parallel tsp utils
 
 SOURCES_DIRECTORY = src
 SOURCES_DIRECTORIES = $(addprefix $(SOURCES_DIRECTORY)/, $(MODULES))
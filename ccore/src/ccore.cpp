@@ -21,6 +21,7 @@
 #include <string>
 #include <fstream>
 #include <sstream>
+#include <memory>
 
 #include "ccore.h"
 
@@ -197,6 +198,11 @@ void * syncnet_create_network(const data_representation * const sample, const do
 	return (void *) new syncnet(dataset, connectivity_radius, enable_conn_weight, (initial_type) initial_phases);
 }
 
+void * syncnet_create_network_graph(const data_representation * const sample, const void * const graph, const double connectivity_radius, const bool enable_conn_weight, const unsigned int initial_phases) {
+	std::unique_ptr<std::vector<std::vector<double> > > dataset(read_sample(sample));
+	return (void *) new syncnet(dataset.get(), *((const container::neighborhood_graph *) graph), connectivity_radius, enable_conn_weight, (initial_type) initial_phases);
+}
+
 void syncnet_destroy_network(const void * pointer_network) {
 	if (pointer_network != NULL) {
 		delete (syncnet *) pointer_network;
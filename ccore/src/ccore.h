@@ -140,6 +140,27 @@ extern "C" DECLARATION void * syncnet_create_network(const data_representation *
                                                      const bool enable_conn_weight, 
                                                      const unsigned int initial_phases);
 
+/***********************************************************************************************
+ *
+ * @brief   Create oscillatory network SYNC for cluster analysis where connections between
+ *          oscillators are taken from neighborhood graph.
+ *
+ * @param   (in) sample                - input data for clustering.
+ * @param   (in) graph                 - handle of neighborhood graph of input data that is returned
+ *                                       by 'neighborhood_graph_create', its radius should not be
+ *                                       less than connectivity radius.
+ * @param   (in) connectivity_radius   - connectivity radius between points.
+ * @param   (in) enable_conn_weight    - if True - enable mode when strength between oscillators 
+ *                                       depends on distance between two oscillators.
+ * @param   (in) initial_phases        - type of initialization of initial phases of oscillators.
+ *
+ ***********************************************************************************************/
+extern "C" DECLARATION void * syncnet_create_network_graph(const data_representation * const sample, 
+                                                           const void * const graph, 
+                                                           const double connectivity_radius, 
+                                                           const bool enable_conn_weight, 
+                                                           const unsigned int initial_phases);
+
 /***********************************************************************************************
  *
  * @brief   Destroy SyncNet (calls destructor).
@@ -24,32 +24,47 @@
 
 #include "utils.hpp"
 
+#include "utils/pairwise_distance.hpp"
+
 
 namespace cluster_analysis {
 
 
-agglomerative::agglomerative(void) :
+template <typename TypeMetric>
+basic_agglomerative<TypeMetric>::basic_agglomerative(void) :
     m_number_clusters(1),
     m_similarity(type_link::SINGLE_LINK),
+    m_metric(),
     m_centers(0),
     m_ptr_clusters(nullptr),
     m_ptr_data(nullptr)
 { }
 
 
-agglomerative::agglomerative(const size_t number_clusters, const type_link link) :
+template <typename TypeMetric>
+basic_agglomerative<TypeMetric>::basic_agglomerative(const size_t number_clusters, const type_link link, const TypeMetric & metric) :
     m_number_clusters(number_clusters),
     m_similarity(link),
+    m_metric(metric),
     m_centers(0),
     m_ptr_clusters(nullptr),
     m_ptr_data(nullptr)
 { }
 
 
-agglomerative::~agglomerative(void) { }
+template <typename TypeMetric>
+basic_agglomerative<TypeMetric>::~basic_agglomerative(void) { }
+
+
+template <typename TypeMetric>
+void basic_agglomerative<TypeMetric>::process(const dataset & data, cluster_data & result) {
+    const dataset_matrix matrix_data(data);
+    process(matrix_data.view(), result);
+}
 
 
-void agglomerative::process(const dataset & data, cluster_data & result) {
+template <typename TypeMetric>
+void basic_agglomerative<TypeMetric>::process(const dataset_view & data, cluster_data & result) {
     m_ptr_data = &data;
     m_ptr_clusters = result.clusters().get();
 
@@ -61,22 +76,30 @@ void agglomerative::process(const dataset & data, cluster_data & result) {
     m_centers.resize(current_number_clusters);
     m_ptr_clusters->resize(current_number_clusters);
 
-    std::copy(data.begin(), data.end(), m_centers.begin());
+    for (size_t i = 0; i < data.size(); i++) {
+        data.get_point(i, m_centers[i]);
+    }
 
     for (size_t i = 0; i < data.size(); i++) {
         (*m_ptr_clusters)[i].push_back(i);
     }
 
+    if ((m_similarity != type_link::CENTROID_LINK) && (current_number_clusters > m_number_clusters)) {
+        m_distances = utils::condensed_distance_matrix(data, m_metric);
+    }
+
     while(current_number_clusters > m_number_clusters) {
         merge_similar_clusters();
         current_number_clusters = m_ptr_clusters->size();
     }
 
+    m_distances = container::condensed_matrix<double>();
     m_ptr_data = nullptr;
 }
 
 
-void agglomerative::merge_similar_clusters(void) {
+template <typename TypeMetric>
+void basic_agglomerative<TypeMetric>::merge_similar_clusters(void) {
     switch(m_similarity) {
         case type_link::SINGLE_LINK:
             merge_by_signle_link();
@@ -96,11 +119,10 @@ void agglomerative::merge_similar_clusters(void) {
 }
 
 
-void agglomerative::merge_by_average_link(void) {
+template <typename TypeMetric>
+void basic_agglomerative<TypeMetric>::merge_by_average_link(void) {
     double minimum_average_distance = std::numeric_limits<double>::max();
 
-    const std::vector<point> & data = *m_ptr_data;
-
     size_t index1 = 0;
     size_t index2 = 1;
 
@@ -110,7 +132,7 @@ void agglomerative::merge_by_average_link(void) {
 
             for (auto index_object1 : (*m_ptr_clusters)[index_cluster1]) {
                 for (auto index_object2 : (*m_ptr_clusters)[index_cluster2]) {
-                    candidate_average_distance += euclidean_distance_sqrt(&data[index_object1], &data[index_object2]);
+                    candidate_average_distance += m_distances(index_object1, index_object2);
                 }
             }
 
@@ -130,7 +152,8 @@ void agglomerative::merge_by_average_link(void) {
 }
 
 
-void agglomerative::merge_by_centroid_link(void) {
+template <typename TypeMetric>
+void basic_agglomerative<TypeMetric>::merge_by_centroid_link(void) {
     double minimum_average_distance = std::numeric_limits<double>::max();
 
     size_t index_cluster1 = 0;
@@ -138,7 +161,7 @@ void agglomerative::merge_by_centroid_link(void) {
 
     for (size_t index1 = 0; index1 < m_centers.size(); index1++) {
         for (size_t index2 = index1 + 1; index2 < m_centers.size(); index2++) {
-            double distance = euclidean_distance_sqrt(&m_centers[index1], &m_centers[index2]);
+            double distance = m_metric.distance(m_centers[index1].data(), m_centers[index2].data(), m_centers[index1].size());
             if (distance < minimum_average_distance) {
                 minimum_average_distance = distance;
 
@@ -156,21 +179,20 @@ void agglomerative::merge_by_centroid_link(void) {
 }
 
 
-void agglomerative::merge_by_complete_link(void) {
+template <typename TypeMetric>
+void basic_agglomerative<TypeMetric>::merge_by_complete_link(void) {
     double minimum_complete_distance = std::numeric_limits<double>::max();
 
     size_t index1 = 0;
     size_t index2 = 1;
 
-    const std::vector<point> & data = *m_ptr_data;
-
     for (size_t index_cluster1 = 0; index_cluster1 < m_ptr_clusters->size(); index_cluster1++) {
         for (size_t index_cluster2 = index_cluster1 + 1; index_cluster2 < m_ptr_clusters->size(); index_cluster2++) {
             double candidate_maximum_distance = 0.0;
 
             for (auto index_object1 : (*m_ptr_clusters)[index_cluster1]) {
                 for (auto index_object2 : (*m_ptr_clusters)[index_cluster2]) {
-                    double distance = euclidean_distance_sqrt(&data[index_object1], &data[index_object2]);
+                    double distance = m_distances(index_object1, index_object2);
                     if (distance > candidate_maximum_distance) {
                         candidate_maximum_distance = distance;
                     }
@@ -191,21 +213,20 @@ void agglomerative::merge_by_complete_link(void) {
 }
 
 
-void agglomerative::merge_by_signle_link(void) {
+template <typename TypeMetric>
+void basic_agglomerative<TypeMetric>::merge_by_signle_link(void) {
     double minimum_single_distance = std::numeric_limits<double>::max();
 
     size_t index1 = 0;
     size_t index2 = 1;
 
-    const std::vector<point> & data = *m_ptr_data;
-
     for (size_t index_cluster1 = 0; index_cluster1 < m_ptr_clusters->size(); index_cluster1++) {
         for (size_t index_cluster2 = index_cluster1 + 1; index_cluster2 < m_ptr_clusters->size(); index_cluster2++) {
             double candidate_minimum_distance = std::numeric_limits<double>::max();
 
             for (auto index_object1 : (*m_ptr_clusters)[index_cluster1]) {
                 for (auto index_object2 : (*m_ptr_clusters)[index_cluster2]) {
-                    double distance = euclidean_distance_sqrt(&data[index_object1], &data[index_object2]);
+                    double distance = m_distances(index_object1, index_object2);
                     if (distance < candidate_minimum_distance) {
                         candidate_minimum_distance = distance;
                     }
@@ -226,10 +247,11 @@ void agglomerative::merge_by_signle_link(void) {
 }
 
 
-void agglomerative::calculate_center(const cluster & cluster, point & center) {
-    const std::vector<point> & data = *m_ptr_data;
+template <typename TypeMetric>
+void basic_agglomerative<TypeMetric>::calculate_center(const cluster & cluster, point & center) {
+    const dataset_view & data = *m_ptr_data;
 
-    const size_t dimension = data[0].size();
+    const size_t dimension = data.dimension();
 
     center.resize(dimension, 0.0);
 
@@ -245,4 +267,12 @@ void agglomerative::calculate_center(const cluster & cluster, point & center) {
 }
 
 
+template class basic_agglomerative<utils::metric::euclidean>;
+template class basic_agglomerative<utils::metric::euclidean_square>;
+template class basic_agglomerative<utils::metric::manhattan>;
+template class basic_agglomerative<utils::metric::chebyshev>;
+template class basic_agglomerative<utils::metric::minkowski>;
+template class basic_agglomerative<utils::metric::cosine>;
+
+
 }
@@ -26,6 +26,10 @@
 
 #include "cluster/cluster_algorithm.hpp"
 
+#include "container/condensed_matrix.hpp"
+
+#include "utils/metric.hpp"
+
 #include "definitions.hpp"
 
 
@@ -51,20 +55,26 @@ enum class type_link {
 /**
 *
 * @brief    Agglomerative algorithm implementation that is used bottom up approach for clustering.
-* @details  The algorithm related to hierarchical class.
+* @details  The algorithm related to hierarchical class. Metric that is used to calculate distance
+*           between points is defined by policy 'TypeMetric' (see 'utils::metric').
 *
 */
-class agglomerative : public cluster_algorithm {
+template <typename TypeMetric>
+class basic_agglomerative : public cluster_algorithm {
 private:
     size_t                  m_number_clusters;
 
     type_link               m_similarity;
 
+    TypeMetric              m_metric;
+
     dataset                 m_centers;
 
     cluster_sequence        * m_ptr_clusters;
 
-    const dataset           * m_ptr_data;
+    const dataset_view      * m_ptr_data;
+
+    container::condensed_matrix<double> m_distances;    /* distances between objects, they are calculated once for single, complete and average links */
 
 public:
     /**
@@ -72,7 +82,7 @@ public:
     * @brief    Default constructor of clustering algorithm.
     *
     */
-    agglomerative(void);
+    basic_agglomerative(void);
 
     /**
     *
@@ -81,16 +91,17 @@ public:
     *
     * @param[in] number_clusters: amount of clusters that should be allocated.
     * @param[in] link: type of linking clustering during processing.
+    * @param[in] metric: metric that is used to calculate distance between points.
     *
     */
-    agglomerative(const size_t number_clusters, const type_link link);
+    basic_agglomerative(const size_t number_clusters, const type_link link, const TypeMetric & metric = TypeMetric());
 
     /**
     *
     * @brief    Default destructor of the algorithm.
     *
     */
-    ~agglomerative(void);
+    ~basic_agglomerative(void);
 
 public:
     /**
@@ -101,7 +112,17 @@ public:
     * @param[out] p_result: clustering result of an input data.
     *
     */
-     void process(const dataset & data, cluster_data & result);
+    virtual void process(const dataset & data, cluster_data & result) override;
+
+    /**
+    *
+    * @brief    Performs cluster analysis of an input data that is stored in contiguous memory.
+    *
+    * @param[in]  p_data: input data for cluster analysis.
+    * @param[out] p_result: clustering result of an input data.
+    *
+    */
+    virtual void process(const dataset_view & data, cluster_data & result) override;
 
 private:
     /**
@@ -151,6 +172,14 @@ private:
 };
 
 
+/**
+*
+* @brief    Agglomerative algorithm that uses square of Euclidean distance.
+*
+*/
+using agglomerative = basic_agglomerative<utils::metric::euclidean_square>;
+
+
 }
 
 #endif
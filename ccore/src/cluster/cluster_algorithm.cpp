@@ -28,4 +28,36 @@ namespace cluster_analysis {
 cluster_algorithm::~cluster_algorithm(void) { }
 
 
+void cluster_algorithm::process(const dataset_view & p_data, cluster_data & p_result) {
+    dataset data(p_data.size());
+    for (std::size_t index = 0; index < p_data.size(); index++) {
+        p_data.get_point(index, data[index]);
+    }
+
+    process(data, p_result);
+}
+
+
+void cluster_algorithm::process(const dataset_view_f32 & p_data, cluster_data & p_result) {
+    dataset_matrix data(p_data.size(), p_data.dimension());
+    for (std::size_t index_point = 0; index_point < p_data.size(); index_point++) {
+        for (std::size_t index_dimension = 0; index_dimension < p_data.dimension(); index_dimension++) {
+            data[index_point][index_dimension] = p_data[index_point][index_dimension];
+        }
+    }
+
+    process(data.view(), p_result);
+}
+
+
+void cluster_algorithm::set_execution_control(const utils::execution_control & p_control) {
+    m_control = p_control;
+}
+
+
+const utils::execution_control & cluster_algorithm::get_execution_control(void) const {
+    return m_control;
+}
+
+
 }
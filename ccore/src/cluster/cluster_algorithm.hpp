@@ -28,6 +28,8 @@
 
 #include "definitions.hpp"
 
+#include "utils/execution_control.hpp"
+
 
 namespace cluster_analysis {
 
@@ -38,6 +40,9 @@ namespace cluster_analysis {
 *
 */
 class cluster_algorithm {
+protected:
+    utils::execution_control    m_control;
+
 public:
     /**
     *
@@ -56,6 +61,51 @@ public:
     *
     */
     virtual void process(const dataset & p_data, cluster_data & p_result) = 0;
+
+    /**
+    *
+    * @brief    Performs cluster analysis of an input data that is stored in contiguous row-major
+    *           memory block.
+    * @details  Default implementation copies points to 'dataset' and uses overloaded method,
+    *           algorithms that are able to work with contiguous data should override it.
+    *
+    * @param[in]  p_data: input data for cluster analysis.
+    * @param[out] p_result: clustering result of an input data.
+    *
+    */
+    virtual void process(const dataset_view & p_data, cluster_data & p_result);
+
+    /**
+    *
+    * @brief    Performs cluster analysis of an input data with single precision coordinates that is
+    *           stored in contiguous row-major memory block.
+    * @details  Default implementation converts points to double precision and uses overloaded
+    *           method, algorithms that have single precision path should override it.
+    *
+    * @param[in]  p_data: input data for cluster analysis.
+    * @param[out] p_result: clustering result of an input data.
+    *
+    */
+    virtual void process(const dataset_view_f32 & p_data, cluster_data & p_result);
+
+    /**
+    *
+    * @brief    Sets cancellation token, budgets and progress callback that are used by iterative
+    *           algorithms during processing.
+    * @details  Algorithms that are stopped by cancellation or budget return the best result that has
+    *           been obtained so far and report the reason by status of clustering data.
+    *
+    * @param[in] p_control: limits and observers of processing.
+    *
+    */
+    void set_execution_control(const utils::execution_control & p_control);
+
+    /**
+    *
+    * @brief    Returns cancellation token, budgets and progress callback that are used during processing.
+    *
+    */
+    const utils::execution_control & get_execution_control(void) const;
 };
 
 
@@ -20,17 +20,31 @@
 
 #include "cluster_data.hpp"
 
+#include <algorithm>
+#include <stdexcept>
+
 
 namespace cluster_analysis {
 
 
+const std::int32_t cluster_data::NOISE_LABEL = -1;
+
+
 cluster_data::cluster_data(void) : m_clusters(new cluster_sequence()) { }
 
 
-cluster_data::cluster_data(const cluster_data & p_other) : m_clusters(p_other.m_clusters) { }
+cluster_data::cluster_data(const cluster_data & p_other) :
+    m_clusters(p_other.m_clusters),
+    m_statistics(p_other.m_statistics),
+    m_status(p_other.m_status)
+{ }
 
 
-cluster_data::cluster_data(cluster_data && p_other) : m_clusters(std::move(p_other.m_clusters)) { }
+cluster_data::cluster_data(cluster_data && p_other) :
+    m_clusters(std::move(p_other.m_clusters)),
+    m_statistics(std::move(p_other.m_statistics)),
+    m_status(p_other.m_status)
+{ }
 
 
 cluster_data::~cluster_data(void) { }
@@ -39,9 +53,36 @@ cluster_data::~cluster_data(void) { }
 cluster_sequence_ptr cluster_data::clusters(void) { return m_clusters; }
 
 
+utils::statistics_ptr cluster_data::statistics(void) const { return m_statistics; }
+
+
+void cluster_data::set_statistics(const utils::statistics_ptr & p_statistics) { m_statistics = p_statistics; }
+
+
+utils::execution_status cluster_data::status(void) const { return m_status; }
+
+
+void cluster_data::set_status(const utils::execution_status p_status) { m_status = p_status; }
+
+
 size_t cluster_data::size(void) const { return m_clusters->size(); }
 
 
+void cluster_data::export_labels(std::int32_t * const p_labels, const std::size_t p_size) const {
+    std::fill(p_labels, p_labels + p_size, NOISE_LABEL);
+
+    for (std::size_t index_cluster = 0; index_cluster < m_clusters->size(); index_cluster++) {
+        for (const auto index_object : (*m_clusters)[index_cluster]) {
+            if (index_object >= p_size) {
+                throw std::out_of_range("CCORE [cluster_data]: clusters contain object that is out of label array.");
+            }
+
+            p_labels[index_object] = static_cast<std::int32_t>(index_cluster);
+        }
+    }
+}
+
+
 cluster & cluster_data::operator[](const size_t p_index) { return (*m_clusters)[p_index]; }
 
 
@@ -51,6 +92,8 @@ const cluster & cluster_data::operator[](const size_t p_index) const { return (*
 cluster_data & cluster_data::operator=(const cluster_data & p_other) {
     if (this != &p_other) {
         m_clusters = p_other.m_clusters;
+        m_statistics = p_other.m_statistics;
+        m_status = p_other.m_status;
     }
 
     return *this;
@@ -60,6 +103,8 @@ cluster_data & cluster_data::operator=(const cluster_data & p_other) {
 cluster_data & cluster_data::operator=(cluster_data && p_other) {
     if (this != &p_other) {
         m_clusters = std::move(p_other.m_clusters);
+        m_statistics = std::move(p_other.m_statistics);
+        m_status = p_other.m_status;
     }
 
     return *this;
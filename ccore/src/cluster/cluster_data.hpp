@@ -22,9 +22,13 @@
 #define SRC_CLUSTER_CLUSTER_DATA_HPP_
 
 
+#include <cstdint>
 #include <vector>
 #include <memory>
 
+#include "utils/execution_control.hpp"
+#include "utils/statistics.hpp"
+
 
 namespace cluster_analysis {
 
@@ -45,8 +49,13 @@ using cluster_sequence_ptr = std::shared_ptr<cluster_sequence>;
 *
 */
 class cluster_data {
+public:
+    static const std::int32_t NOISE_LABEL;     /* label of objects that are not assigned to any cluster */
+
 protected:
     cluster_sequence_ptr    m_clusters;
+    utils::statistics_ptr   m_statistics;
+    utils::execution_status m_status = utils::execution_status::COMPLETED;
 
 public:
     /**
@@ -89,6 +98,41 @@ public:
     */
     cluster_sequence_ptr clusters(void);
 
+    /**
+    *
+    * @brief    Returns performance statistics of the call that has produced the data.
+    * @details  Null pointer is returned if collecting of statistics was disabled.
+    *
+    */
+    utils::statistics_ptr statistics(void) const;
+
+    /**
+    *
+    * @brief    Sets performance statistics of the call that produces the data.
+    *
+    * @param[in] p_statistics: statistics of the call.
+    *
+    */
+    void set_statistics(const utils::statistics_ptr & p_statistics);
+
+    /**
+    *
+    * @brief    Returns status of the call that has produced the data.
+    * @details  If processing has been stopped by cancellation or budget then data contains the best
+    *           result that has been obtained before the stop.
+    *
+    */
+    utils::execution_status status(void) const;
+
+    /**
+    *
+    * @brief    Sets status of the call that produces the data.
+    *
+    * @param[in] p_status: status of the call.
+    *
+    */
+    void set_status(const utils::execution_status p_status);
+
     /**
     *
     * @brief    Returns amount of clusters that is stored.
@@ -96,6 +140,18 @@ public:
     */
     size_t size(void) const;
 
+    /**
+    *
+    * @brief    Writes index of cluster of each object to flat label array.
+    * @details  Objects that are not assigned to any cluster (for example, noise) are marked by
+    *           'NOISE_LABEL'.
+    *
+    * @param[out] p_labels: array where labels are written, it should contain 'p_size' elements.
+    * @param[in]  p_size: amount of objects in the input data that has been clustered.
+    *
+    */
+    void export_labels(std::int32_t * const p_labels, const std::size_t p_size) const;
+
 public:
     /**
     *
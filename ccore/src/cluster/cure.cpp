@@ -25,6 +25,9 @@
 
 #include "cluster/cure.hpp"
 
+#include "container/ball_tree.hpp"
+#include "container/static_kdtree.hpp"
+
 #include "utils.hpp"
 
 
@@ -32,16 +35,16 @@ namespace cluster_analysis {
 
 
 cure_cluster::cure_cluster(void) : closest(nullptr), distance_closest(0), mean(nullptr) {
-    points = new std::vector< std::vector<double> * >();
+    points = new std::vector<std::size_t>();
     rep = new std::vector< std::vector<double> * >();
 }
 
 
-cure_cluster::cure_cluster(std::vector<double> * point) : closest(nullptr), distance_closest(0) {
-    mean = new std::vector<double>(*point);
+cure_cluster::cure_cluster(const std::size_t p_index, const dataset_view & p_data) : closest(nullptr), distance_closest(0) {
+    mean = new std::vector<double>(p_data[p_index], p_data[p_index] + p_data.dimension());
 
-    points = new std::vector< std::vector<double> * >(1, point);    /* use user data points */
-    rep = new std::vector< std::vector<double> * >(1, new std::vector<double>(*point));       /* it's our - despite at the beginning it the same */
+    points = new std::vector<std::size_t>(1, p_index);    /* use user data points */
+    rep = new std::vector< std::vector<double> * >(1, new std::vector<double>(*mean));       /* it's our - despite at the beginning it the same */
 }
 
 
@@ -51,7 +54,7 @@ cure_cluster::~cure_cluster() {
         mean = nullptr;
     }
 
-    delete points;	/* only storage, we are not owners of points */
+    delete points;	/* only indexes, we are not owners of points */
     points = nullptr;
 
     for (auto point_ptr : *rep) {
@@ -69,9 +72,14 @@ cure_queue::cure_queue(void) {
 }
 
 
-cure_queue::cure_queue(const std::vector< std::vector<double> > * data) {
+cure_queue::cure_queue(const dataset_view & p_data, utils::statistics * p_statistics) :
+    data(p_data),
+    statistics(p_statistics)
+{
+    utils::statistics_timer timer(statistics, utils::statistic_phase::INITIALIZATION);
+
     queue = new std::list<cure_cluster *>();
-    create_queue(data);
+    create_queue(p_data);
 
     tree = new kdtree();
 
@@ -100,12 +108,55 @@ cure_queue::~cure_queue() {
 }
 
 
-void cure_queue::create_queue(const std::vector< std::vector<double> > * data) {
-    for (std::vector< std::vector<double> >::const_iterator iter = data->begin(); iter != data->end(); iter++) {
-        cure_cluster * cluster = new cure_cluster((std::vector<double> *) &(*iter));
+void cure_queue::create_queue(const dataset_view & p_data) {
+    std::vector<cure_cluster *> clusters;
+    clusters.reserve(p_data.size());
+
+    for (std::size_t index = 0; index < p_data.size(); index++) {
+        cure_cluster * cluster = new cure_cluster(index, p_data);
         queue->push_back(cluster);
+        clusters.push_back(cluster);
     }
 
+    /* each cluster consists of one point, so the closest cluster is the nearest point except itself */
+    std::vector<std::size_t> indexes;
+    std::vector<double> distances;
+
+    auto assign_closest = [this, &clusters, &indexes](const std::size_t p_index, const std::size_t p_calculated_distances) {
+        utils::increase_counter(statistics, utils::statistic_counter::DISTANCE_EVALUATIONS, p_calculated_distances);
+
+        const std::size_t index_closest = (indexes.front() != p_index) ? indexes.front() : indexes.back();
+
+        clusters[p_index]->closest = clusters[index_closest];
+        clusters[p_index]->distance_closest = get_distance(clusters[p_index], clusters[index_closest]);
+    };
+
+    if ( (p_data.size() >= container::static_kdtree::MINIMUM_SIZE) && (p_data.dimension() <= container::static_kdtree::DIMENSION_LIMIT) ) {
+        const container::static_kdtree points_tree(p_data);
+        const utils::metric::euclidean metric;
+
+        for (std::size_t index = 0; index < clusters.size(); index++) {
+            assign_closest(index, points_tree.find_nearest(p_data[index], 2, metric, indexes, distances));
+        }
+    }
+    else if (p_data.size() >= container::ball_tree::MINIMUM_SIZE) {
+        /* KD-tree degrades to scan for high-dimensional data */
+        const container::ball_tree points_tree(p_data);
+
+        for (std::size_t index = 0; index < clusters.size(); index++) {
+            assign_closest(index, points_tree.find_nearest(p_data[index], 2, indexes, distances));
+        }
+    }
+    else {
+        find_closest_clusters();
+    }
+
+    auto distance_comparison = [](cure_cluster * cluster1, cure_cluster * cluster2) { return cluster1->distance_closest < cluster2->distance_closest; };
+    queue->sort(distance_comparison);
+}
+
+
+void cure_queue::find_closest_clusters(void) {
     for (std::list<cure_cluster *>::iterator first_cluster = queue->begin(); first_cluster != queue->end(); first_cluster++) {
         double minimal_distance = std::numeric_limits<double>::max();
         cure_cluster * closest_cluster = nullptr;
@@ -123,13 +174,12 @@ void cure_queue::create_queue(const std::vector< std::vector<double> > * data) {
         (*first_cluster)->closest = closest_cluster;
         (*first_cluster)->distance_closest = minimal_distance;
     }
-
-    auto distance_comparison = [](cure_cluster * cluster1, cure_cluster * cluster2) { return cluster1->distance_closest < cluster2->distance_closest; };
-    queue->sort(distance_comparison);
 }
 
 
 double cure_queue::get_distance(cure_cluster * cluster1, cure_cluster * cluster2) {
+    utils::increase_counter(statistics, utils::statistic_counter::DISTANCE_EVALUATIONS, cluster1->rep->size() * cluster2->rep->size());
+
     double distance = std::numeric_limits<double>::max();
     for (std::vector<std::vector<double> *>::const_iterator point1 = cluster1->rep->begin(); point1 != cluster1->rep->end(); point1++) {
         for (std::vector<std::vector<double> *>::const_iterator point2 = cluster2->rep->begin(); point2 != cluster2->rep->end(); point2++) {
@@ -145,15 +195,14 @@ double cure_queue::get_distance(cure_cluster * cluster1, cure_cluster * cluster2
 
 
 bool cure_queue::are_all_elements_same(cure_cluster * merged_cluster) {
-    std::vector< std::vector<double> * > * points;
+    std::vector<std::size_t> * points;
     points = merged_cluster->points;
     bool are_all_same = true;
-    std::vector<double> *first_point;
-    first_point = points->front();
-    std::vector<double> *point;
+    const double * first_point = data[points->front()];
+    const double * point;
     for (unsigned int i = 0; i < points->size(); i++) {
-        point = (*points)[i];
-        if (*point != *first_point) {
+        point = data[(*points)[i]];
+        if (!std::equal(point, point + data.dimension(), first_point)) {
             are_all_same = false;
             break;
         }
@@ -174,12 +223,13 @@ void cure_queue::merge(cure_cluster * cluster1, cure_cluster * cluster2, const s
     merged_cluster->insert_points(cluster1->points);
     merged_cluster->insert_points(cluster2->points);
 
-    merged_cluster->mean = new std::vector<double>((*cluster1->points)[0]->size(), 0);
+    merged_cluster->mean = new std::vector<double>(data.dimension(), 0);
 
     //If all elements were same then avoid calculating the mean mathematically as it may lead to precision error.
     if (are_all_elements_same(merged_cluster)) {
-        for (unsigned int i = 0; i < (*merged_cluster->points)[0]->size(); i++) {
-            (*merged_cluster->mean)[i] = (*(*merged_cluster->points)[0])[i];
+        const double * first_point = data[(*merged_cluster->points)[0]];
+        for (unsigned int i = 0; i < data.dimension(); i++) {
+            (*merged_cluster->mean)[i] = first_point[i];
         }
 
     }
@@ -189,21 +239,21 @@ void cure_queue::merge(cure_cluster * cluster1, cure_cluster * cluster2, const s
         }
     }
 
-    std::set<std::vector<double> *> * temporary = new std::set<std::vector<double> *>();
+    std::set<std::size_t> * temporary = new std::set<std::size_t>();
 
     for (unsigned int index = 0; index < number_repr_points; index++) {
         double maximal_distance = 0;
-        std::vector<double> * maximal_point = nullptr;
+        std::size_t maximal_point = 0;
 
-        for (std::vector<std::vector<double> *>::const_iterator point = merged_cluster->points->begin(); point != merged_cluster->points->end(); point++) {
+        for (std::vector<std::size_t>::const_iterator point = merged_cluster->points->begin(); point != merged_cluster->points->end(); point++) {
             double minimal_distance = 0;
             if (index == 0) {
-                minimal_distance = euclidean_distance(*point, merged_cluster->mean);
+                minimal_distance = euclidean_distance(data[*point], merged_cluster->mean->data(), data.dimension());
             }
             else {
                 double temp_minimal_distance = std::numeric_limits<double>::max();
                 for (auto p : (*temporary)) {
-                    double minimal_candidate = euclidean_distance(*point, p);
+                    double minimal_candidate = euclidean_distance(data[*point], data[p], data.dimension());
                     if (minimal_candidate < temp_minimal_distance) {
                         temp_minimal_distance = minimal_candidate;
                     }
@@ -223,10 +273,12 @@ void cure_queue::merge(cure_cluster * cluster1, cure_cluster * cluster2, const s
         }
     }
 
-    for (std::set<std::vector<double> *>::iterator point = temporary->begin(); point != temporary->end(); point++) {
-        std::vector<double> * representative_point = new std::vector<double>((*point)->size(), 0);
-        for (unsigned int index = 0; index < (*point)->size(); index++) {
-            (*representative_point)[index] = (*(*point))[index] + compression * ( (*merged_cluster->mean)[index] - (*(*point))[index] );
+    for (std::set<std::size_t>::iterator index_point = temporary->begin(); index_point != temporary->end(); index_point++) {
+        const double * point = data[*index_point];
+
+        std::vector<double> * representative_point = new std::vector<double>(data.dimension(), 0);
+        for (unsigned int index = 0; index < data.dimension(); index++) {
+            (*representative_point)[index] = point[index] + compression * ( (*merged_cluster->mean)[index] - point[index] );
         }
 
         merged_cluster->rep->push_back(representative_point);
@@ -265,18 +317,17 @@ void cure_queue::merge(cure_cluster * cluster1, cure_cluster * cluster2, const s
                     for (std::vector<std::vector<double> * >::iterator point = (*cluster)->rep->begin(); point != (*cluster)->rep->end(); point++) {
                         kdtree_searcher searcher(*point, tree->get_root(), distance);
 
-                        std::vector<double> * nearest_node_distances = new std::vector<double>();
-                        std::vector<kdnode *> * nearest_nodes = searcher.find_nearest_nodes(nearest_node_distances);
+                        /* representative points of the cluster itself are skipped by the searcher */
+                        double candidate_distance = 0.0;
+                        kdnode * nearest_node = searcher.find_nearest_node(&candidate_distance, *cluster);
 
-                        for (unsigned int index = 0; index < nearest_nodes->size(); index++) {
-                            if ( ((*nearest_node_distances)[index] < nearest_distance) && ( (*nearest_nodes)[index]->get_payload() != (*cluster) ) ) {
-                                nearest_distance = (*nearest_node_distances)[index];
-                                nearest_cluster = (cure_cluster *) (*nearest_nodes)[index]->get_payload();
-                            }
+                        if ( (nearest_node != nullptr) && (candidate_distance < nearest_distance) ) {
+                            nearest_distance = candidate_distance;
+                            nearest_cluster = (cure_cluster *) nearest_node->get_payload();
                         }
 
-                        delete nearest_nodes;
-                        delete nearest_node_distances;
+                        utils::increase_counter(statistics, utils::statistic_counter::NEIGHBOR_QUERIES);
+                        utils::increase_counter(statistics, utils::statistic_counter::KDTREE_VISITED_NODES, searcher.get_visited_nodes());
                     }
 
                     if (nearest_cluster == nullptr) {
@@ -358,11 +409,23 @@ cure::~cure() {
 
 
 void cure::process(const dataset & p_data, cluster_data & p_result) {
-    queue = new cure_queue(&p_data);
+    const dataset_matrix matrix_data(p_data);
+    process(matrix_data.view(), p_result);
+}
+
+
+void cure::process(const dataset_view & p_data, cluster_data & p_result) {
+    utils::statistics_ptr statistics = utils::statistics::create();
+    utils::statistics_timer total_timer(statistics.get(), utils::statistic_phase::TOTAL);
+
+    queue = new cure_queue(p_data, statistics.get());
     data = &p_data;
 
     std::size_t allocated_clusters = queue->size();
     while(allocated_clusters > number_clusters) {
+        utils::statistics_timer timer(statistics.get(), utils::statistic_phase::UPDATE);
+        utils::increase_counter(statistics.get(), utils::statistic_counter::ITERATIONS);
+
         cure_cluster * cluster1 = *(queue->begin());
         cure_cluster * cluster2 = cluster1->closest;
 
@@ -372,7 +435,11 @@ void cure::process(const dataset & p_data, cluster_data & p_result) {
         allocated_clusters = queue->size();
     }
 
+    utils::statistics_timer extraction_timer(statistics.get(), utils::statistic_phase::EXTRACTION);
+
     p_result = cure_data();
+    p_result.set_statistics(statistics);
+
     cure_data result = (cure_data &) p_result;
 
     /* prepare standard representation of clusters */
@@ -381,10 +448,7 @@ void cure::process(const dataset & p_data, cluster_data & p_result) {
     size_t cluster_index = 0;
     for (cure_queue::const_iterator cure_cluster = queue->begin(); cure_cluster != queue->end(); cure_cluster++, cluster_index++) {
         cluster & standard_cluster = (*clusters)[cluster_index];
-        for (std::vector<std::vector<double> * >::const_iterator point = (*cure_cluster)->points->begin(); point != (*cure_cluster)->points->end(); point++) {
-            size_t index_point = (size_t) (*point - &(*(data->begin())));
-            standard_cluster.push_back(index_point);
-        }
+        standard_cluster.insert(standard_cluster.end(), (*cure_cluster)->points->begin(), (*cure_cluster)->points->end());
 
         representor_sequence_ptr representors = result.representors();
         representors->resize(queue->size());
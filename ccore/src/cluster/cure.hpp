@@ -48,7 +48,7 @@ namespace cluster_analysis {
 struct cure_cluster {
 public:
     std::vector<double> * mean;
-    std::vector< std::vector<double> * > * points;
+    std::vector<std::size_t> * points;          /* indexes of points from input data */
     std::vector< std::vector<double> * > * rep;
 
     cure_cluster *			closest;
@@ -66,8 +66,11 @@ public:
     *
     * @brief   Default constructor of cure cluster that corresponds to specified point.
     *
+    * @param[in] p_index: index of the point in input data.
+    * @param[in] p_data: input data where the point is stored.
+    *
     */
-    cure_cluster(std::vector<double> * point);
+    cure_cluster(const std::size_t p_index, const dataset_view & p_data);
 
     /**
     *
@@ -80,8 +83,10 @@ public:
     *
     * @brief   Insert points to cluster.
     *
+    * @param[in] append_points: indexes of points from input data that should be inserted.
+    *
     */
-    inline void insert_points(std::vector<std::vector<double> *> * append_points) {
+    inline void insert_points(std::vector<std::size_t> * append_points) {
         points->insert(points->end(), append_points->begin(), append_points->end());
     }
 };
@@ -99,16 +104,25 @@ class cure_queue {
 private:
     std::list<cure_cluster *> * queue;
     kdtree * tree;
+    dataset_view data;
+    utils::statistics * statistics = nullptr;     /* statistics of the current call, null if it is not collected */
 
 private:
     /**
     *
     * @brief   Creates sorted queue of points for specified data.
     *
-    * @param[in] data: pointer to points.
+    * @param[in] p_data: input data.
+    *
+    */
+    void create_queue(const dataset_view & p_data);
+
+    /**
+    *
+    * @brief   Finds the closest cluster for each cluster in the queue by comparison with all clusters.
     *
     */
-    void create_queue(const std::vector< std::vector<double> > * data);
+    void find_closest_clusters(void);
 
     /**
     *
@@ -166,10 +180,11 @@ public:
     *
     * @brief   Default constructor of sorted queue of cure clusters.
     *
-    * @param[in] data: pointer to points.
+    * @param[in] p_data: input data, it should be alive while the queue is used.
+    * @param[in] p_statistics: statistics of the call that is updated by the queue, it can be null.
     *
     */
-    cure_queue(const std::vector< std::vector<double> > * data);
+    cure_queue(const dataset_view & p_data, utils::statistics * p_statistics = nullptr);
 
     /**
     *
@@ -265,7 +280,7 @@ private:
 
     double compression;
 
-    const dataset   * data;
+    const dataset_view  * data;
 
 public:
     /**
@@ -297,12 +312,25 @@ public:
     /**
     *
     * @brief    Performs cluster analysis of an input data.
+    * @details  Points are copied to contiguous block and processed through view, so the method
+    *           temporarily requires additional memory for one more copy of the input data. Use
+    *           view overload to avoid the copy when data is already placed in one memory block.
+    *
+    * @param[in]  p_data: input data for cluster analysis.
+    * @param[out] p_result: clustering result of an input data.
+    *
+    */
+    virtual void process(const dataset & p_data, cluster_data & p_result) override;
+
+    /**
+    *
+    * @brief    Performs cluster analysis of an input data that is stored in contiguous memory.
     *
     * @param[in]  p_data: input data for cluster analysis.
     * @param[out] p_result: clustering result of an input data.
     *
     */
-    virtual void process(const dataset & p_data, cluster_data & p_result);
+    virtual void process(const dataset_view & p_data, cluster_data & p_result) override;
 };
 
 
@@ -26,8 +26,8 @@
 namespace cluster_analysis {
 
 
-dbscan::dbscan(void) :
-    m_data_ptr(nullptr),
+template <typename TypeMetric>
+basic_dbscan<TypeMetric>::basic_dbscan(void) :
     m_result_ptr(nullptr),
     m_radius(0.0),
     m_neighbors(0),
@@ -36,28 +36,162 @@ dbscan::dbscan(void) :
 { }
 
 
-dbscan::dbscan(const double p_radius_connectivity, const size_t p_minimum_neighbors) :
-    m_data_ptr(nullptr),
+template <typename TypeMetric>
+basic_dbscan<TypeMetric>::basic_dbscan(const double p_radius_connectivity, const size_t p_minimum_neighbors, const TypeMetric & p_metric) :
     m_result_ptr(nullptr),
-    m_radius(p_radius_connectivity * p_radius_connectivity),
+    m_metric(p_metric),
+    m_radius(p_metric.to_comparable(p_radius_connectivity)),
     m_neighbors(p_minimum_neighbors),
     m_visited(std::vector<bool>()),
     m_belong(std::vector<bool>())
 { }
 
 
-dbscan::~dbscan(void) { }
+template <typename TypeMetric>
+basic_dbscan<TypeMetric>::~basic_dbscan(void) { }
 
 
-void dbscan::process(const dataset & p_data, cluster_data & p_result) {
-    m_data_ptr = &p_data;
+template <typename TypeMetric>
+void basic_dbscan<TypeMetric>::process(const dataset & p_data, cluster_data & p_result) {
+    const dataset_matrix matrix_data(p_data);
+    process(matrix_data.view(), p_result);
+}
+
+
+template <typename TypeMetric>
+void basic_dbscan<TypeMetric>::process(const dataset_view & p_data, cluster_data & p_result) {
+    std::vector<double> distances;
+
+    if ( (p_data.size() >= container::static_kdtree::MINIMUM_SIZE) && container::static_kdtree::is_suitable(p_data.dimension(), m_metric) ) {
+        process_tree(container::static_kdtree(p_data), p_data, p_result);
+    }
+    else if ( (p_data.size() >= container::basic_ball_tree<TypeMetric>::MINIMUM_SIZE) && container::basic_ball_tree<TypeMetric>::is_suitable(m_metric) ) {
+        const container::basic_ball_tree<TypeMetric> tree(p_data, m_metric);
+        typename container::basic_ball_tree<TypeMetric>::search_buffer buffer;
+
+        allocate_clusters(p_data.size(), [this, &tree, &p_data, &buffer, &distances](const size_t p_index, std::vector<size_t> & p_neighbors) {
+            get_neighbors(tree, p_data, p_index, buffer, distances, p_neighbors);
+        }, p_result);
+    }
+    else {
+        process_data(p_data, p_result);
+    }
+}
+
+
+template <typename TypeMetric>
+void basic_dbscan<TypeMetric>::process(const dataset_view_f32 & p_data, cluster_data & p_result) {
+    if ( (p_data.size() >= container::static_kdtree_f32::MINIMUM_SIZE) && container::static_kdtree_f32::is_suitable(p_data.dimension(), m_metric) ) {
+        process_tree(container::static_kdtree_f32(p_data), p_data, p_result);
+    }
+    else {
+        process_data(p_data, p_result);
+    }
+}
+
+
+template <typename TypeMetric>
+void basic_dbscan<TypeMetric>::process(const container::neighborhood_graph & p_graph, cluster_data & p_result) {
+    if (!p_graph.is_built_with(m_metric)) {
+        throw std::invalid_argument("CCORE [dbscan]: neighborhood graph is built with another metric.");
+    }
+
+    if (m_radius > m_metric.to_comparable(p_graph.radius())) {
+        throw std::invalid_argument("CCORE [dbscan]: radius of neighborhood graph is less than connectivity radius.");
+    }
+
+    allocate_clusters(p_graph.size(), [this, &p_graph](const size_t p_index, std::vector<size_t> & p_neighbors) {
+        get_neighbors(p_graph, p_index, p_neighbors);
+    }, p_result);
+}
+
+
+template <typename TypeMetric>
+void basic_dbscan<TypeMetric>::process(const container::static_kdtree & p_tree, const dataset_view & p_data, cluster_data & p_result) {
+    process_tree(p_tree, p_data, p_result);
+}
+
+
+template <typename TypeMetric>
+void basic_dbscan<TypeMetric>::process(const container::static_kdtree_f32 & p_tree, const dataset_view_f32 & p_data, cluster_data & p_result) {
+    process_tree(p_tree, p_data, p_result);
+}
+
+
+template <typename TypeMetric>
+template <typename TypeValue>
+void basic_dbscan<TypeMetric>::process_tree(const container::basic_static_kdtree<TypeValue> & p_tree, const container::dense_matrix_view<TypeValue> & p_data, cluster_data & p_result) {
+    if (!p_tree.is_built_for(p_data)) {
+        throw std::invalid_argument("CCORE [dbscan]: static KD-tree is not built for the input data.");
+    }
+
+    if (m_metric.comparable_axis_bound(1.0) <= 0.0) {
+        throw std::invalid_argument("CCORE [dbscan]: metric can not be used with static KD-tree.");
+    }
+
+    /* queries are performed one by one, so they share scratch memory of the tree */
+    typename container::basic_static_kdtree<TypeValue>::search_buffer buffer;
+    std::vector<double> distances;
+
+    allocate_clusters(p_data.size(), [this, &p_tree, &p_data, &buffer](const size_t p_index) {
+        return is_core(p_tree, p_data, p_index, buffer);
+    },
+    [this, &p_tree, &p_data, &buffer, &distances](const size_t p_index, std::vector<size_t> & p_neighbors) {
+        get_neighbors(p_tree, p_data, p_index, buffer, distances, p_neighbors);
+    }, p_result);
+}
+
+
+template <typename TypeMetric>
+void basic_dbscan<TypeMetric>::process(const container::basic_hnsw<TypeMetric> & p_index, cluster_data & p_result) {
+    if (!p_index.is_built_with(m_metric)) {
+        throw std::invalid_argument("CCORE [dbscan]: HNSW graph is built with another metric.");
+    }
+
+    const dataset_view data = p_index.points();
+    std::vector<double> distances;
+
+    /* visited marks of the buffer are reset once instead of each query */
+    typename container::basic_hnsw<TypeMetric>::search_buffer buffer;
 
-    m_visited = std::vector<bool>(m_data_ptr->size(), false);
-    m_belong = std::vector<bool>(m_data_ptr->size(), false);
+    allocate_clusters(data.size(), [this, &p_index, &data, &buffer, &distances](const size_t p_index_point, std::vector<size_t> & p_neighbors) {
+        get_neighbors(p_index, data, p_index_point, buffer, distances, p_neighbors);
+    }, p_result);
+}
+
+
+template <typename TypeMetric>
+template <typename TypeValue>
+void basic_dbscan<TypeMetric>::process_data(const container::dense_matrix_view<TypeValue> & p_data, cluster_data & p_result) {
+    std::vector<TypeValue> distances(p_data.size());
+
+    allocate_clusters(p_data.size(), [this, &p_data, &distances](const size_t p_index, std::vector<size_t> & p_neighbors) {
+        get_neighbors(p_data, p_index, distances, p_neighbors);
+    }, p_result);
+}
+
+
+template <typename TypeMetric>
+template <typename TypeNeighborSearch>
+void basic_dbscan<TypeMetric>::allocate_clusters(const size_t p_size, const TypeNeighborSearch & p_get_neighbors, cluster_data & p_result) {
+    allocate_clusters(p_size, [](const size_t) { return true; }, p_get_neighbors, p_result);
+}
+
+
+template <typename TypeMetric>
+template <typename TypeCoreCheck, typename TypeNeighborSearch>
+void basic_dbscan<TypeMetric>::allocate_clusters(const size_t p_size, const TypeCoreCheck & p_is_core, const TypeNeighborSearch & p_get_neighbors, cluster_data & p_result) {
+    m_visited = std::vector<bool>(p_size, false);
+    m_belong = std::vector<bool>(p_size, false);
 
     m_result_ptr = (dbscan_data *) &p_result;
 
-    for (size_t i = 0; i < m_data_ptr->size(); i++) {
+    p_result.set_statistics(utils::statistics::create());
+    m_statistics = p_result.statistics().get();
+
+    utils::statistics_timer total_timer(m_statistics, utils::statistic_phase::TOTAL);
+
+    for (size_t i = 0; i < p_size; i++) {
         if (m_visited[i] == true) {
             continue;
         }
@@ -68,7 +202,9 @@ void dbscan::process(const dataset & p_data, cluster_data & p_result) {
         cluster allocated_cluster;
 
         std::vector<size_t> index_matrix_neighbors;
-        get_neighbors(i, index_matrix_neighbors);
+        if (p_is_core(i)) {
+            p_get_neighbors(i, index_matrix_neighbors);
+        }
 
         if (index_matrix_neighbors.size() >= m_neighbors) {
             allocated_cluster.push_back(i);
@@ -82,7 +218,8 @@ void dbscan::process(const dataset & p_data, cluster_data & p_result) {
 
                     /* check for neighbors of the current neighbor - maybe it's noise */
                     std::vector<size_t> neighbor_neighbor_indexes;
-                    get_neighbors(index_neighbor, neighbor_neighbor_indexes);
+                    p_get_neighbors(index_neighbor, neighbor_neighbor_indexes);
+
                     if (neighbor_neighbor_indexes.size() >= m_neighbors) {
 
                         /* Add neighbors of the neighbor for checking */
@@ -115,18 +252,97 @@ void dbscan::process(const dataset & p_data, cluster_data & p_result) {
         }
     }
 
-    m_data_ptr = nullptr;
     m_result_ptr = nullptr;
+    m_statistics = nullptr;
 }
 
 
-void dbscan::get_neighbors(const size_t p_index, std::vector<size_t> & p_neighbors) {
-    for (size_t index = 0; index < m_data_ptr->size(); index++) {
-        if ( ( p_index != index ) && ( euclidean_distance_sqrt(&((*m_data_ptr)[index]), &((*m_data_ptr)[p_index])) <= m_radius ) ) {
+template <typename TypeMetric>
+template <typename TypeValue>
+void basic_dbscan<TypeMetric>::get_neighbors(const container::dense_matrix_view<TypeValue> & p_data, const size_t p_index, std::vector<TypeValue> & p_distances, std::vector<size_t> & p_neighbors) {
+    utils::statistics_timer timer(m_statistics, utils::statistic_phase::NEIGHBOR_SEARCH);
+    utils::increase_counter(m_statistics, utils::statistic_counter::NEIGHBOR_QUERIES);
+    utils::increase_counter(m_statistics, utils::statistic_counter::DISTANCE_EVALUATIONS, p_data.size());
+
+    m_metric.comparable_block(p_data[p_index], p_data, p_distances.data());
+
+    for (size_t index = 0; index < p_data.size(); index++) {
+        if ( ( p_index != index ) && ( p_distances[index] <= m_radius ) ) {
             p_neighbors.push_back(index);
         }
     }
 }
 
 
+template <typename TypeMetric>
+void basic_dbscan<TypeMetric>::get_neighbors(const container::neighborhood_graph & p_graph, const size_t p_index, std::vector<size_t> & p_neighbors) {
+    utils::statistics_timer timer(m_statistics, utils::statistic_phase::NEIGHBOR_SEARCH);
+    utils::increase_counter(m_statistics, utils::statistic_counter::NEIGHBOR_QUERIES);
+
+    p_graph.for_each_neighbor(p_index, [this, &p_neighbors](const size_t p_index_neighbor, const double p_distance) {
+        if (p_distance <= m_radius) {
+            p_neighbors.push_back(p_index_neighbor);
+        }
+    });
+}
+
+
+template <typename TypeMetric>
+template <typename TypeValue>
+void basic_dbscan<TypeMetric>::get_neighbors(const container::basic_static_kdtree<TypeValue> & p_tree, const container::dense_matrix_view<TypeValue> & p_data, const size_t p_index, typename container::basic_static_kdtree<TypeValue>::search_buffer & p_buffer, std::vector<double> & p_distances, std::vector<size_t> & p_neighbors) {
+    utils::statistics_timer timer(m_statistics, utils::statistic_phase::NEIGHBOR_SEARCH);
+    utils::increase_counter(m_statistics, utils::statistic_counter::NEIGHBOR_QUERIES);
+
+    p_neighbors.clear();
+    p_distances.clear();
+
+    const size_t calculated_distances = p_tree.find_radius(p_data[p_index], m_radius, m_metric, p_buffer, p_neighbors, p_distances);
+    utils::increase_counter(m_statistics, utils::statistic_counter::DISTANCE_EVALUATIONS, calculated_distances);
+
+    /* neighbors are sorted to expand clusters in the same order as without tree */
+    p_neighbors.erase(std::remove(p_neighbors.begin(), p_neighbors.end(), p_index), p_neighbors.end());
+    std::sort(p_neighbors.begin(), p_neighbors.end());
+}
+
+
+template <typename TypeMetric>
+template <typename TypeValue>
+bool basic_dbscan<TypeMetric>::is_core(const container::basic_static_kdtree<TypeValue> & p_tree, const container::dense_matrix_view<TypeValue> & p_data, const size_t p_index, typename container::basic_static_kdtree<TypeValue>::search_buffer & p_buffer) {
+    utils::statistics_timer timer(m_statistics, utils::statistic_phase::NEIGHBOR_SEARCH);
+    utils::increase_counter(m_statistics, utils::statistic_counter::NEIGHBOR_QUERIES);
+
+    /* the point itself is in radius but it is not its own neighbor */
+    size_t calculated_distances = 0;
+    const bool core = p_tree.count_radius(p_data[p_index], m_radius, m_metric, m_neighbors + 1, p_buffer, calculated_distances) >= m_neighbors + 1;
+
+    utils::increase_counter(m_statistics, utils::statistic_counter::DISTANCE_EVALUATIONS, calculated_distances);
+    return core;
+}
+
+
+template <typename TypeMetric>
+template <typename TypeIndex, typename TypeValue>
+void basic_dbscan<TypeMetric>::get_neighbors(const TypeIndex & p_tree, const container::dense_matrix_view<TypeValue> & p_data, const size_t p_index, typename TypeIndex::search_buffer & p_buffer, std::vector<double> & p_distances, std::vector<size_t> & p_neighbors) {
+    utils::statistics_timer timer(m_statistics, utils::statistic_phase::NEIGHBOR_SEARCH);
+    utils::increase_counter(m_statistics, utils::statistic_counter::NEIGHBOR_QUERIES);
+
+    p_neighbors.clear();
+    p_distances.clear();
+
+    const size_t calculated_distances = p_tree.find_radius(p_data[p_index], m_radius, p_buffer, p_neighbors, p_distances);
+    utils::increase_counter(m_statistics, utils::statistic_counter::DISTANCE_EVALUATIONS, calculated_distances);
+
+    p_neighbors.erase(std::remove(p_neighbors.begin(), p_neighbors.end(), p_index), p_neighbors.end());
+    std::sort(p_neighbors.begin(), p_neighbors.end());
+}
+
+
+template class basic_dbscan<utils::metric::euclidean>;
+template class basic_dbscan<utils::metric::euclidean_square>;
+template class basic_dbscan<utils::metric::manhattan>;
+template class basic_dbscan<utils::metric::chebyshev>;
+template class basic_dbscan<utils::metric::minkowski>;
+template class basic_dbscan<utils::metric::cosine>;
+
+
 }
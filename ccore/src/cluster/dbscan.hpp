@@ -28,6 +28,13 @@
 #include "cluster/cluster_algorithm.hpp"
 #include "cluster/dbscan_data.hpp"
 
+#include "container/ball_tree.hpp"
+#include "container/hnsw.hpp"
+#include "container/neighborhood_graph.hpp"
+#include "container/static_kdtree.hpp"
+
+#include "utils/metric.hpp"
+
 
 namespace cluster_analysis {
 
@@ -35,30 +42,34 @@ namespace cluster_analysis {
 /**
 *
 * @brief    Represents DBSCAN clustering algorithm for cluster analysis.
-* @details  The algorithm related to density-based class.
+* @details  The algorithm related to density-based class. Metric that is used to calculate distance
+*           between objects is defined by policy 'TypeMetric' (see 'utils::metric').
 *
 */
-class dbscan {
+template <typename TypeMetric>
+class basic_dbscan : public cluster_algorithm {
 private:
-    const dataset       * m_data_ptr;         /* temporary pointer to input data that is used only during processing */
-
     dbscan_data         * m_result_ptr;       /* temporary pointer to clustering result that is used only during processing */
 
     std::vector<bool>   m_visited;
 
     std::vector<bool>   m_belong;
 
-    double              m_radius;
+    TypeMetric          m_metric;
+
+    double              m_radius;             /* connectivity radius in comparable form of the metric */
 
     size_t              m_neighbors;
 
+    utils::statistics   * m_statistics = nullptr;   /* statistics of the current call, null if it is not collected */
+
 public:
     /**
     *
     * @brief    Default constructor of clustering algorithm.
     *
     */
-    dbscan(void);
+    basic_dbscan(void);
 
     /**
     *
@@ -68,41 +79,254 @@ public:
     * @param[in] p_radius_connectivity: connectivity radius between objects.
     * @param[in] p_minimum_neighbors: minimum amount of shared neighbors that is require to connect
     *             two object (if distance between them is less than connectivity radius).
+    * @param[in] p_metric: metric that is used to calculate distance between objects.
     *
     */
-    dbscan(const double p_radius_connectivity, const size_t p_minimum_neighbors);
+    basic_dbscan(const double p_radius_connectivity, const size_t p_minimum_neighbors, const TypeMetric & p_metric = TypeMetric());
 
     /**
     *
     * @brief    Default destructor of the algorithm.
     *
     */
-    virtual ~dbscan(void);
+    virtual ~basic_dbscan(void);
 
 public:
     /**
     *
     * @brief    Performs cluster analysis of an input data.
+    * @details  Points are copied to contiguous block and processed through view, so the method
+    *           temporarily requires additional memory for one more copy of the input data. Use
+    *           view overload to avoid the copy when data is already placed in one memory block.
+    *
+    * @param[in]  p_data: input data for cluster analysis.
+    * @param[out] p_result: clustering result of an input data.
+    *
+    */
+    virtual void process(const dataset & p_data, cluster_data & p_result) override;
+
+    /**
+    *
+    * @brief    Performs cluster analysis of an input data that is stored in contiguous memory.
+    * @details  Neighbors of large data are searched by static KD-tree if it is suitable for
+    *           dimension of data and the metric, otherwise by ball tree if the metric satisfies
+    *           triangle inequality (high-dimensional data).
+    *
+    * @param[in]  p_data: input data for cluster analysis.
+    * @param[out] p_result: clustering result of an input data.
+    *
+    */
+    virtual void process(const dataset_view & p_data, cluster_data & p_result) override;
+
+    /**
+    *
+    * @brief    Performs cluster analysis of an input data in single precision.
+    * @details  Neighbors of large data are searched by static KD-tree with single precision
+    *           coordinates if it is suitable for dimension of data and the metric, otherwise
+    *           distances are calculated using single precision distance kernels.
     *
     * @param[in]  p_data: input data for cluster analysis.
     * @param[out] p_result: clustering result of an input data.
     *
     */
-    virtual void process(const dataset & p_data, cluster_data & p_result);
+    virtual void process(const dataset_view_f32 & p_data, cluster_data & p_result) override;
+
+    /**
+    *
+    * @brief    Performs cluster analysis using neighborhood graph that has been built for input data
+    *           instead of searching neighbors, so the same graph can be used for several values of
+    *           minimum amount of neighbors.
+    * @details  The graph should be built using the same metric as the algorithm and its radius
+    *           should not be less than connectivity radius of the algorithm, otherwise exception
+    *           'std::invalid_argument' is thrown.
+    *
+    * @param[in]  p_graph: neighborhood graph of input data.
+    * @param[out] p_result: clustering result of an input data.
+    *
+    */
+    void process(const container::neighborhood_graph & p_graph, cluster_data & p_result);
+
+    /**
+    *
+    * @brief    Performs cluster analysis using static KD-tree that has been built for input data,
+    *           for example tree that has been opened from file, so the tree is not rebuilt.
+    * @details  The tree should be built for exactly the same data: neighbors are found by
+    *           coordinates that are stored in the tree, so result is undefined for the tree of
+    *           other data. Only sample of points is compared with the data (see
+    *           'static_kdtree::is_built_for'), exception 'std::invalid_argument' is thrown if they
+    *           differ, if size or dimension differ or if the metric can't be used with KD-tree.
+    *
+    * @param[in]  p_tree: static KD-tree of input data.
+    * @param[in]  p_data: input data for cluster analysis.
+    * @param[out] p_result: clustering result of an input data.
+    *
+    */
+    void process(const container::static_kdtree & p_tree, const dataset_view & p_data, cluster_data & p_result);
+
+    /**
+    *
+    * @brief    Performs cluster analysis of an input data in single precision using static KD-tree
+    *           that has been built for the data.
+    * @details  Requirements to the tree are the same as for the tree of double precision data.
+    *
+    * @param[in]  p_tree: static KD-tree of input data.
+    * @param[in]  p_data: input data for cluster analysis.
+    * @param[out] p_result: clustering result of an input data.
+    *
+    */
+    void process(const container::static_kdtree_f32 & p_tree, const dataset_view_f32 & p_data, cluster_data & p_result);
+
+    /**
+    *
+    * @brief    Performs cluster analysis of points of approximate nearest neighbor graph, neighbors
+    *           are searched by the graph, so some of them can be missed and clusters are
+    *           approximate in exchange for speed on large data of high dimension.
+    * @details  The graph should be built using the same metric as the algorithm with the same
+    *           parameters (see 'basic_hnsw::is_built_with'), otherwise exception
+    *           'std::invalid_argument' is thrown.
+    *
+    * @param[in]  p_index: HNSW graph that is built for input data.
+    * @param[out] p_result: clustering result of an input data.
+    *
+    */
+    void process(const container::basic_hnsw<TypeMetric> & p_index, cluster_data & p_result);
 
 private:
+    /**
+    *
+    * @brief    Allocates clusters and noise using specified procedure of neighbor search.
+    *
+    * @param[in]  p_size: amount of points in input data.
+    * @param[in]  p_get_neighbors: procedure that is called as 'p_get_neighbors(index, neighbors)'
+    *              to obtain neighbors of the point.
+    * @param[out] p_result: clustering result of an input data.
+    *
+    */
+    template <typename TypeNeighborSearch>
+    void allocate_clusters(const size_t p_size, const TypeNeighborSearch & p_get_neighbors, cluster_data & p_result);
+
+    /**
+    *
+    * @brief    Allocates clusters and noise using specified procedures of core point check and
+    *           neighbor search.
+    * @details  Point that is not reached from already allocated clusters is mostly noise, so it is
+    *           checked before neighbor search and its neighbors are obtained only if it can be core
+    *           one. Points that are reached during expansion of a cluster are mostly core ones, so
+    *           their neighbors are obtained without the check to avoid the second query.
+    *
+    * @param[in]  p_size: amount of points in input data.
+    * @param[in]  p_is_core: procedure that is called as 'p_is_core(index)', it returns false only
+    *              if the point has less neighbors than it is required for core point.
+    * @param[in]  p_get_neighbors: procedure that is called as 'p_get_neighbors(index, neighbors)'
+    *              to obtain neighbors of the point.
+    * @param[out] p_result: clustering result of an input data.
+    *
+    */
+    template <typename TypeCoreCheck, typename TypeNeighborSearch>
+    void allocate_clusters(const size_t p_size, const TypeCoreCheck & p_is_core, const TypeNeighborSearch & p_get_neighbors, cluster_data & p_result);
+
+    /**
+    *
+    * @brief    Performs cluster analysis of an input data with specified type of coordinates.
+    *
+    * @param[in]  p_data: input data for cluster analysis.
+    * @param[out] p_result: clustering result of an input data.
+    *
+    */
+    template <typename TypeValue>
+    void process_data(const container::dense_matrix_view<TypeValue> & p_data, cluster_data & p_result);
+
+    /**
+    *
+    * @brief    Performs cluster analysis of an input data using static KD-tree that is built for it.
+    *
+    * @param[in]  p_tree: static KD-tree of input data.
+    * @param[in]  p_data: input data for cluster analysis.
+    * @param[out] p_result: clustering result of an input data.
+    *
+    */
+    template <typename TypeValue>
+    void process_tree(const container::basic_static_kdtree<TypeValue> & p_tree, const container::dense_matrix_view<TypeValue> & p_data, cluster_data & p_result);
+
     /**
     *
     * @brief    Obtains neighbors of the specified node (data object).
     *
+    * @param[in]  p_data: input data that is processed.
+    * @param[in]  p_index: index of the node (data object).
+    * @param[in]  p_distances: buffer for distances from the node to each point of input data.
+    * @param[out] p_neighbors: neighbor indexes of the specified node (data object).
+    *
+    */
+    template <typename TypeValue>
+    void get_neighbors(const container::dense_matrix_view<TypeValue> & p_data, const size_t p_index, std::vector<TypeValue> & p_distances, std::vector<size_t> & p_neighbors);
+
+    /**
+    *
+    * @brief    Obtains neighbors of the specified node (data object) from neighborhood graph.
+    *
+    * @param[in]  p_graph: neighborhood graph of input data.
     * @param[in]  p_index: index of the node (data object).
     * @param[out] p_neighbors: neighbor indexes of the specified node (data object).
     *
     */
-    void get_neighbors(const size_t p_index, std::vector<size_t> & p_neighbors);
+    void get_neighbors(const container::neighborhood_graph & p_graph, const size_t p_index, std::vector<size_t> & p_neighbors);
+
+    /**
+    *
+    * @brief    Obtains neighbors of the specified node (data object) using static KD-tree.
+    *
+    * @param[in]  p_tree: KD-tree that is built for input data.
+    * @param[in]  p_data: input data that is processed.
+    * @param[in]  p_index: index of the node (data object).
+    * @param[in]  p_buffer: scratch memory of the tree that is reused between queries.
+    * @param[in]  p_distances: buffer for distances to found neighbors.
+    * @param[out] p_neighbors: neighbor indexes of the specified node (data object).
+    *
+    */
+    template <typename TypeValue>
+    void get_neighbors(const container::basic_static_kdtree<TypeValue> & p_tree, const container::dense_matrix_view<TypeValue> & p_data, const size_t p_index, typename container::basic_static_kdtree<TypeValue>::search_buffer & p_buffer, std::vector<double> & p_distances, std::vector<size_t> & p_neighbors);
+
+    /**
+    *
+    * @brief    Checks whether the specified node (data object) has enough neighbors to be core one
+    *           by count-only query to static KD-tree that stops when the required amount is found.
+    *
+    * @param[in]  p_tree: KD-tree that is built for input data.
+    * @param[in]  p_data: input data that is processed.
+    * @param[in]  p_index: index of the node (data object).
+    * @param[in]  p_buffer: scratch memory of the tree that is reused between queries.
+    *
+    */
+    template <typename TypeValue>
+    bool is_core(const container::basic_static_kdtree<TypeValue> & p_tree, const container::dense_matrix_view<TypeValue> & p_data, const size_t p_index, typename container::basic_static_kdtree<TypeValue>::search_buffer & p_buffer);
+
+    /**
+    *
+    * @brief    Obtains neighbors of the specified node (data object) using index that is built for
+    *           the metric of the algorithm (ball tree or HNSW graph).
+    *
+    * @param[in]  p_tree: index that is built for input data.
+    * @param[in]  p_data: input data that is processed.
+    * @param[in]  p_index: index of the node (data object).
+    * @param[in]  p_buffer: scratch memory of the index that is reused between queries.
+    * @param[in]  p_distances: buffer for distances to found neighbors.
+    * @param[out] p_neighbors: neighbor indexes of the specified node (data object).
+    *
+    */
+    template <typename TypeIndex, typename TypeValue>
+    void get_neighbors(const TypeIndex & p_tree, const container::dense_matrix_view<TypeValue> & p_data, const size_t p_index, typename TypeIndex::search_buffer & p_buffer, std::vector<double> & p_distances, std::vector<size_t> & p_neighbors);
 };
 
 
+/**
+*
+* @brief    DBSCAN algorithm that uses Euclidean distance.
+*
+*/
+using dbscan = basic_dbscan<utils::metric::euclidean>;
+
+
 }
 
 
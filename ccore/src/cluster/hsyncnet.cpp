@@ -52,6 +52,22 @@ hsyncnet::hsyncnet(std::vector<std::vector<double> > * input_data,
 { }
 
 
+hsyncnet::hsyncnet(std::vector<std::vector<double> > * input_data,
+    const container::hnsw & index,
+    const std::size_t cluster_number,
+    const initial_type initial_phases,
+    const std::size_t initial_neighbors,
+    const double increase_persent) :
+
+    syncnet(input_data, index, 0, initial_phases),
+    m_number_clusters(cluster_number),
+    m_initial_neighbors(initial_neighbors),
+    m_increase_persent(increase_persent),
+    m_time(0.0),
+    m_index_ptr(&index)
+{ }
+
+
 hsyncnet::~hsyncnet() { }
 
 
@@ -59,16 +75,24 @@ void hsyncnet::process(const double order, const solve_type solver, const bool c
     std::size_t number_neighbors = m_initial_neighbors;
     std::size_t current_number_clusters = std::numeric_limits<std::size_t>::max();
 
-    double radius = average_neighbor_distance(oscillator_locations, number_neighbors);
+    double radius = (m_index_ptr != nullptr) ? average_neighbor_distance(*m_index_ptr, number_neighbors) : average_neighbor_distance(oscillator_locations, number_neighbors);
     
     std::size_t increase_step = (std::size_t) round(oscillator_locations->size() * m_increase_persent);
     if (increase_step < 1) {
         increase_step = DEFAULT_INCREASE_STEP;
     }
 
+    utils::execution_monitor monitor(m_control);
+    m_monitor = &monitor;
+
     sync_dynamic current_dynamic;
     while(current_number_clusters > m_number_clusters) {
-        create_connections(radius, false);
+        if (m_index_ptr != nullptr) {
+            create_connections(*m_index_ptr, radius);
+        }
+        else {
+            create_connections(radius, false);
+        }
 
         simulate_dynamic(order, 0.1, solver, collect_dynamic, current_dynamic);
 
@@ -88,6 +112,10 @@ void hsyncnet::process(const double order, const solve_type solver, const bool c
 
         current_number_clusters = clusters.size();
 
+        if (monitor.is_stopped()) {
+            break;      /* the last simulated state is the best result */
+        }
+
         number_neighbors += increase_step;
         radius = calculate_radius(radius, number_neighbors);
     }
@@ -95,6 +123,9 @@ void hsyncnet::process(const double order, const solve_type solver, const bool c
     if (!collect_dynamic) {
         store_state(*(current_dynamic.end() - 1), analyser);
     }
+
+    m_status = monitor.get_status();
+    m_monitor = nullptr;
 }
 
 
@@ -111,6 +142,9 @@ double hsyncnet::calculate_radius(const double radius, const std::size_t amount_
     if (amount_neighbors >= oscillator_locations->size()) {
         next_radius = radius * m_increase_persent + radius;
     }
+    else if (m_index_ptr != nullptr) {
+        next_radius = average_neighbor_distance(*m_index_ptr, amount_neighbors);
+    }
     else {
         next_radius = average_neighbor_distance(oscillator_locations, amount_neighbors);
     }
@@ -37,6 +37,7 @@ private:
     std::size_t m_initial_neighbors;
     double m_increase_persent;
     double m_time;
+    const container::hnsw * m_index_ptr = nullptr;     /* approximate neighbor search, if it is null then all points are compared */
 
 private:
     const static double         DEFAULT_TIME_STEP;
@@ -53,6 +54,14 @@ public:
         const std::size_t initial_neighbors,
         const double increase_persent);
 
+    /* neighbors are searched by HNSW graph of input data that is used during whole processing */
+    hsyncnet(std::vector<std::vector<double> > * input_data,
+        const container::hnsw & index,
+        const std::size_t cluster_number,
+        const initial_type initial_phases,
+        const std::size_t initial_neighbors,
+        const double increase_persent);
+
     virtual ~hsyncnet(void);
 
 public:
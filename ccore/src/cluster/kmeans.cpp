@@ -23,6 +23,8 @@
 #include <algorithm>
 #include <limits>
 
+#include "parallel/parallel.hpp"
+
 #include "utils.hpp"
 
 
@@ -32,54 +34,97 @@ namespace cluster_analysis {
 kmeans::kmeans(void) :
     m_tolerance(0.025),
     m_initial_centers(0, point()),
-    m_ptr_result(nullptr),
-    m_ptr_data(nullptr) { }
+    m_ptr_result(nullptr) { }
 
 
 kmeans::kmeans(const dataset & p_initial_centers, const double p_tolerance) :
     m_tolerance(p_tolerance * p_tolerance),
     m_initial_centers(p_initial_centers),
-    m_ptr_result(nullptr),
-    m_ptr_data(nullptr) { }
+    m_ptr_result(nullptr) { }
 
 
 kmeans::~kmeans(void) { }
 
 
 void kmeans::process(const dataset & data, cluster_data & output_result) {
-    m_ptr_data = &data;
+    const dataset_matrix matrix_data(data);
+    process(matrix_data.view(), output_result);
+}
+
+
+void kmeans::process(const dataset_view & data, cluster_data & output_result) {
+    process_data(data, output_result);
+}
+
 
+void kmeans::process(const dataset_view_f32 & data, cluster_data & output_result) {
+    process_data(data, output_result);
+}
+
+
+template <typename TypeValue>
+void kmeans::process_data(const container::dense_matrix_view<TypeValue> & data, cluster_data & output_result) {
     output_result = kmeans_data();
     m_ptr_result = (kmeans_data *) &output_result;
 
-    if (data[0].size() != m_initial_centers[0].size()) {
+    output_result.set_statistics(utils::statistics::create());
+    m_statistics = output_result.statistics().get();
+
+    utils::statistics_timer total_timer(m_statistics, utils::statistic_phase::TOTAL);
+
+    if (data.dimension() != m_initial_centers[0].size()) {
         throw std::runtime_error("CCORE [kmeans]: dimension of the input data and dimension of the initial cluster centers must be equal.");
     }
 
     m_ptr_result->centers()->assign(m_initial_centers.begin(), m_initial_centers.end());
 
     double current_change = std::numeric_limits<double>::max();
+    utils::execution_monitor monitor(m_control);
+
+    /* at least one iteration is performed to return clusters that correspond to centers */
+    do {
+        utils::increase_counter(m_statistics, utils::statistic_counter::ITERATIONS);
 
-    while(current_change > m_tolerance) {
-        update_clusters(*m_ptr_result->centers(), *m_ptr_result->clusters());
-        current_change = update_centers(*m_ptr_result->clusters(), *m_ptr_result->centers());
+        update_clusters(data, *m_ptr_result->centers(), *m_ptr_result->clusters());
+        current_change = update_centers(data, *m_ptr_result->clusters(), *m_ptr_result->centers());
+
+        monitor.next_iteration(current_change);
     }
+    while((current_change > m_tolerance) && monitor.can_continue());
+
+    output_result.set_status(monitor.get_status());
+
+    m_statistics = nullptr;
 }
 
 
-void kmeans::update_clusters(const dataset & centers, cluster_sequence & clusters) {
-    const dataset & data = *m_ptr_data;
+template <typename TypeValue>
+void kmeans::update_clusters(const container::dense_matrix_view<TypeValue> & data, const dataset & centers, cluster_sequence & clusters) {
+    utils::statistics_timer timer(m_statistics, utils::statistic_phase::ASSIGNMENT);
+    utils::increase_counter(m_statistics, utils::statistic_counter::DISTANCE_EVALUATIONS, data.size() * centers.size());
 
     clusters.clear();
     clusters.resize(centers.size());
 
-    /* fill clusters again in line with centers. */
-    for (size_t index_object = 0; index_object < data.size(); index_object++) {
+    /* centers are placed to contiguous block (in precision of input data) to score each object against all of them by one call */
+    container::dense_matrix<TypeValue> centers_block(centers.size(), data.dimension());
+    for (size_t index_cluster = 0; index_cluster < centers.size(); index_cluster++) {
+        std::copy(centers[index_cluster].begin(), centers[index_cluster].end(), centers_block[index_cluster]);
+    }
+
+    /* objects are labeled independently by threads and then placed to clusters in original order */
+    std::vector<size_t> labels(data.size());
+    parallel::parallel_for(size_t(0), data.size(), [&](const size_t p_index_object) {
+        thread_local std::vector<TypeValue> distances;
+        distances.resize(centers.size());
+
+        utils::euclidean_distance_square(data[p_index_object], centers_block.view(), distances.data());
+
         double    minimum_distance = std::numeric_limits<double>::max();
         size_t    suitable_index_cluster = 0;
 
-        for (size_t index_cluster = 0; index_cluster < clusters.size(); index_cluster++) {
-            double distance = euclidean_distance_sqrt(&centers[index_cluster], &data[index_object]);
+        for (size_t index_cluster = 0; index_cluster < distances.size(); index_cluster++) {
+            const double distance = static_cast<double>(distances[index_cluster]);
 
             if (distance < minimum_distance) {
                 minimum_distance = distance;
@@ -87,7 +132,11 @@ void kmeans::update_clusters(const dataset & centers, cluster_sequence & cluster
             }
         }
 
-        clusters[suitable_index_cluster].push_back(index_object);
+        labels[p_index_object] = suitable_index_cluster;
+    });
+
+    for (size_t index_object = 0; index_object < data.size(); index_object++) {
+        clusters[labels[index_object]].push_back(index_object);
     }
 
     erase_empty_clusters(clusters);
@@ -103,9 +152,12 @@ void kmeans::erase_empty_clusters(cluster_sequence & p_clusters) {
 }
 
 
-double kmeans::update_centers(const cluster_sequence & clusters, dataset & centers) {
-    const dataset & data = *m_ptr_data;
-    const size_t dimension = data[0].size();
+template <typename TypeValue>
+double kmeans::update_centers(const container::dense_matrix_view<TypeValue> & data, const cluster_sequence & clusters, dataset & centers) {
+    const size_t dimension = data.dimension();
+
+    utils::statistics_timer timer(m_statistics, utils::statistic_phase::UPDATE);
+    utils::increase_counter(m_statistics, utils::statistic_counter::DISTANCE_EVALUATIONS, clusters.size());
 
     double maximum_change = 0;
 
@@ -45,7 +45,7 @@ private:
 
     kmeans_data     * m_ptr_result;   /* temporary pointer to output result */
 
-    const dataset   * m_ptr_data;     /* used only during processing */
+    utils::statistics   * m_statistics = nullptr;   /* statistics of the current call, null if it is not collected */
 
 public:
     /**
@@ -85,10 +85,36 @@ public:
     */
     virtual void process(const dataset & data, cluster_data & output_result) override;
 
+    /**
+    *
+    * @brief    Performs cluster analysis of an input data that is stored in contiguous memory.
+    *
+    * @param[in]  p_data: input data for cluster analysis.
+    * @param[out] p_result: clustering result of an input data.
+    *
+    */
+    virtual void process(const dataset_view & data, cluster_data & output_result) override;
+
+    /**
+    *
+    * @brief    Performs cluster analysis of an input data in single precision, objects are assigned
+    *           to clusters using single precision distance kernels, centers are kept in double precision.
+    *
+    * @param[in]  p_data: input data for cluster analysis.
+    * @param[out] p_result: clustering result of an input data.
+    *
+    */
+    virtual void process(const dataset_view_f32 & data, cluster_data & output_result) override;
+
 private:
-    void update_clusters(const dataset & centers, cluster_sequence & clusters);
+    template <typename TypeValue>
+    void process_data(const container::dense_matrix_view<TypeValue> & data, cluster_data & output_result);
+
+    template <typename TypeValue>
+    void update_clusters(const container::dense_matrix_view<TypeValue> & data, const dataset & centers, cluster_sequence & clusters);
 
-    double update_centers(const cluster_sequence & clusters, dataset & centers);
+    template <typename TypeValue>
+    double update_centers(const container::dense_matrix_view<TypeValue> & data, const cluster_sequence & clusters, dataset & centers);
 
     /**
     *
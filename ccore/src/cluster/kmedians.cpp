@@ -59,6 +59,8 @@ void kmedians::process(const dataset & data, cluster_data & output_result) {
 
     size_t counter_repeaters = 0;
 
+    utils::execution_monitor monitor(m_control);
+
     do {
         update_clusters(*m_ptr_result->medians(), *m_ptr_result->clusters());
         changes = update_medians(*m_ptr_result->clusters(), *m_ptr_result->medians());
@@ -72,8 +74,12 @@ void kmedians::process(const dataset & data, cluster_data & output_result) {
         }
 
         prev_changes = changes;
+
+        monitor.next_iteration(changes);
     }
-    while ((changes > stop_condition) && (counter_repeaters < 10));
+    while ((changes > stop_condition) && (counter_repeaters < 10) && monitor.can_continue());
+
+    output_result.set_status(monitor.get_status());
 
     m_ptr_data = nullptr;
     m_ptr_result = nullptr;
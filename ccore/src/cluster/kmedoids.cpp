@@ -28,26 +28,32 @@
 namespace cluster_analysis {
 
 
-kmedoids::kmedoids(void) :
+template <typename TypeMetric>
+basic_kmedoids<TypeMetric>::basic_kmedoids(void) :
         m_data_ptr(nullptr),
         m_result_ptr(nullptr),
         m_initial_medoids(std::vector<size_t>()),
-        m_tolerance(0.0)
+        m_tolerance(0.0),
+        m_metric()
 { }
 
 
-kmedoids::kmedoids(const std::vector<size_t> & p_initial_medoids, const double p_tolerance) :
+template <typename TypeMetric>
+basic_kmedoids<TypeMetric>::basic_kmedoids(const std::vector<size_t> & p_initial_medoids, const double p_tolerance, const TypeMetric & p_metric) :
         m_data_ptr(nullptr),
         m_result_ptr(nullptr),
         m_initial_medoids(p_initial_medoids),
-        m_tolerance(p_tolerance)
+        m_tolerance(p_tolerance),
+        m_metric(p_metric)
 { }
 
 
-kmedoids::~kmedoids(void) { }
+template <typename TypeMetric>
+basic_kmedoids<TypeMetric>::~basic_kmedoids(void) { }
 
 
-void kmedoids::process(const dataset & p_data, cluster_data & p_result) {
+template <typename TypeMetric>
+void basic_kmedoids<TypeMetric>::process(const dataset & p_data, cluster_data & p_result) {
     m_data_ptr = &p_data;
     m_result_ptr = (kmedoids_data *) &p_result;
 
@@ -72,7 +78,8 @@ void kmedoids::process(const dataset & p_data, cluster_data & p_result) {
 }
 
 
-void kmedoids::update_clusters(void) {
+template <typename TypeMetric>
+void basic_kmedoids<TypeMetric>::update_clusters(void) {
     cluster_sequence & clusters = *(m_result_ptr->clusters());
     medoid_sequence & medoids = *(m_result_ptr->medoids());
 
@@ -85,7 +92,7 @@ void kmedoids::update_clusters(void) {
 
         for (size_t index = 0; index < medoids.size(); index++) {
             const size_t index_medoid = medoids[index];
-            const double distance = euclidean_distance_sqrt(&(*m_data_ptr)[index_point], &(*m_data_ptr)[index_medoid]);
+            const double distance = calculate_distance(index_point, index_medoid);
 
             if ( (distance < dist_optim) || (index == 0) ) {
                 index_optim = index;
@@ -100,7 +107,8 @@ void kmedoids::update_clusters(void) {
 }
 
 
-void kmedoids::erase_empty_clusters(cluster_sequence & p_clusters) {
+template <typename TypeMetric>
+void basic_kmedoids<TypeMetric>::erase_empty_clusters(cluster_sequence & p_clusters) {
     for (size_t index_cluster = p_clusters.size() - 1; index_cluster != (size_t) -1; index_cluster--) {
         if (p_clusters[index_cluster].empty()) {
             p_clusters.erase(p_clusters.begin() + index_cluster);
@@ -109,7 +117,8 @@ void kmedoids::erase_empty_clusters(cluster_sequence & p_clusters) {
 }
 
 
-void kmedoids::calculate_medoids(std::vector<size_t> & p_medoids) {
+template <typename TypeMetric>
+void basic_kmedoids<TypeMetric>::calculate_medoids(std::vector<size_t> & p_medoids) {
     cluster_sequence & clusters = *(m_result_ptr->clusters());
 
     p_medoids.clear();
@@ -121,14 +130,15 @@ void kmedoids::calculate_medoids(std::vector<size_t> & p_medoids) {
 }
 
 
-size_t kmedoids::calculate_cluster_medoid(const cluster & p_cluster) const {
+template <typename TypeMetric>
+size_t basic_kmedoids<TypeMetric>::calculate_cluster_medoid(const cluster & p_cluster) const {
     size_t index_medoid = 0;
     double distance = std::numeric_limits<double>::max();
 
     for (auto index_candidate : p_cluster) {
         double distance_candidate = 0.0;
         for (auto index_point : p_cluster) {
-            distance_candidate += euclidean_distance_sqrt( &(*m_data_ptr)[index_point], &(*m_data_ptr)[index_candidate] );
+            distance_candidate += calculate_distance(index_point, index_candidate);
         }
 
         if (distance_candidate < distance) {
@@ -141,13 +151,14 @@ size_t kmedoids::calculate_cluster_medoid(const cluster & p_cluster) const {
 }
 
 
-double kmedoids::calculate_changes(const medoid_sequence & p_medoids) const {
+template <typename TypeMetric>
+double basic_kmedoids<TypeMetric>::calculate_changes(const medoid_sequence & p_medoids) const {
     double maximum_difference = 0.0;
     for (size_t index = 0; index < p_medoids.size(); index++) {
         const size_t index_point1 = p_medoids[index];
         const size_t index_point2 = (*m_result_ptr->medoids())[index];
 
-        const double distance = euclidean_distance_sqrt( &(*m_data_ptr)[index_point1], &(*m_data_ptr)[index_point2] );
+        const double distance = calculate_distance(index_point1, index_point2);
         if (distance > maximum_difference) {
             maximum_difference = distance;
         }
@@ -157,4 +168,21 @@ double kmedoids::calculate_changes(const medoid_sequence & p_medoids) const {
 }
 
 
+template <typename TypeMetric>
+double basic_kmedoids<TypeMetric>::calculate_distance(const size_t p_index_point1, const size_t p_index_point2) const {
+    const point & point1 = (*m_data_ptr)[p_index_point1];
+    const point & point2 = (*m_data_ptr)[p_index_point2];
+
+    return m_metric.distance(point1.data(), point2.data(), point1.size());
+}
+
+
+template class basic_kmedoids<utils::metric::euclidean>;
+template class basic_kmedoids<utils::metric::euclidean_square>;
+template class basic_kmedoids<utils::metric::manhattan>;
+template class basic_kmedoids<utils::metric::chebyshev>;
+template class basic_kmedoids<utils::metric::minkowski>;
+template class basic_kmedoids<utils::metric::cosine>;
+
+
 }
@@ -27,6 +27,8 @@
 #include "cluster/cluster_algorithm.hpp"
 #include "cluster/kmedoids_data.hpp"
 
+#include "utils/metric.hpp"
+
 
 namespace cluster_analysis {
 
@@ -35,10 +37,13 @@ namespace cluster_analysis {
 *
 * @brief    Represents K-Medoids clustering algorithm for cluster analysis.
 * @details  The algorithm related to partitional class when input data is divided into groups.
-*           K-Medoids algorithm is also known as the PAM (Partitioning Around Medoids).
+*           K-Medoids algorithm is also known as the PAM (Partitioning Around Medoids). Metric that
+*           is used to calculate distance between points is defined by policy 'TypeMetric' (see
+*           'utils::metric').
 *
 */
-class kmedoids : public cluster_algorithm {
+template <typename TypeMetric>
+class basic_kmedoids : public cluster_algorithm {
 private:
     const dataset                   * m_data_ptr;         /* temporary pointer to input data that is used only during processing */
 
@@ -48,13 +53,15 @@ private:
 
     double                          m_tolerance;
 
+    TypeMetric                      m_metric;
+
 public:
     /**
     *
     * @brief    Default constructor of clustering algorithm.
     *
     */
-    kmedoids(void);
+    basic_kmedoids(void);
 
     /**
     *
@@ -64,16 +71,17 @@ public:
     * @param[in] p_initial_medoids: initial medoids that are used for processing.
     * @param[in] p_tolerance: stop condition in following way: when maximum value of distance change of
     *             medoids of clusters is less than tolerance than algorithm will stop processing.
+    * @param[in] p_metric: metric that is used to calculate distance between points.
     *
     */
-    kmedoids(const medoid_sequence & p_initial_medoids, const double p_tolerance = 0.25);
+    basic_kmedoids(const medoid_sequence & p_initial_medoids, const double p_tolerance = 0.25, const TypeMetric & p_metric = TypeMetric());
 
     /**
     *
     * @brief    Default destructor of the algorithm.
     *
     */
-    virtual ~kmedoids(void);
+    virtual ~basic_kmedoids(void);
 
 public:
     /**
@@ -133,9 +141,24 @@ private:
     *
     */
     double calculate_changes(const medoid_sequence & p_medoids) const;
+
+    /**
+    *
+    * @brief    Calculates distance between two points of input data using metric of the algorithm.
+    *
+    */
+    double calculate_distance(const size_t p_index_point1, const size_t p_index_point2) const;
 };
 
 
+/**
+*
+* @brief    K-Medoids algorithm that uses square of Euclidean distance.
+*
+*/
+using kmedoids = basic_kmedoids<utils::metric::euclidean_square>;
+
+
 }
 
 
@@ -20,6 +20,8 @@
 
 #include "cluster/optics.hpp"
 
+#include <memory>
+
 #include "ordering_analyser.hpp"
 #include "utils.hpp"
 
@@ -42,26 +44,114 @@ void optics_descriptor::clear(void) {
 }
 
 
-const double optics::NONE_DISTANCE = -1.0;
+template <typename TypeMetric>
+const double basic_optics<TypeMetric>::NONE_DISTANCE = -1.0;
 
 
-optics::optics(const double p_radius, const std::size_t p_neighbors) : optics() { 
+template <typename TypeMetric>
+basic_optics<TypeMetric>::basic_optics(const double p_radius, const std::size_t p_neighbors, const TypeMetric & p_metric) : basic_optics() { 
+    m_metric = p_metric;
     m_radius = p_radius;
     m_neighbors = p_neighbors;
 }
 
 
-optics::optics(const double p_radius, const std::size_t p_neighbors, const std::size_t p_amount_clusters) : optics() { 
+template <typename TypeMetric>
+basic_optics<TypeMetric>::basic_optics(const double p_radius, const std::size_t p_neighbors, const std::size_t p_amount_clusters, const TypeMetric & p_metric) : basic_optics() { 
+    m_metric = p_metric;
     m_radius = p_radius;
     m_neighbors = p_neighbors;
     m_amount_clusters = p_amount_clusters;
 }
 
 
-void optics::process(const dataset & p_data, cluster_data & p_result) {
+template <typename TypeMetric>
+void basic_optics<TypeMetric>::process(const dataset & p_data, cluster_data & p_result) {
+    const dataset_matrix matrix_data(p_data);
+    process(matrix_data.view(), p_result);
+}
+
+
+template <typename TypeMetric>
+void basic_optics<TypeMetric>::process(const dataset_view & p_data, cluster_data & p_result) {
     m_data_ptr = &p_data;
+    m_data_f32_ptr = nullptr;
+
+    std::unique_ptr<container::static_kdtree> tree;
+    std::unique_ptr<container::basic_ball_tree<TypeMetric>> ball_tree;
+
+    if ( (p_data.size() >= container::static_kdtree::MINIMUM_SIZE) && container::static_kdtree::is_suitable(p_data.dimension(), m_metric) ) {
+        tree.reset(new container::static_kdtree(p_data));
+        m_tree_ptr = tree.get();
+    }
+    else if ( (p_data.size() >= container::basic_ball_tree<TypeMetric>::MINIMUM_SIZE) && container::basic_ball_tree<TypeMetric>::is_suitable(m_metric) ) {
+        ball_tree.reset(new container::basic_ball_tree<TypeMetric>(p_data, m_metric));
+        m_ball_tree_ptr = ball_tree.get();
+    }
+
+    process_data(p_result);
+}
+
+
+template <typename TypeMetric>
+void basic_optics<TypeMetric>::process(const dataset_view_f32 & p_data, cluster_data & p_result) {
+    m_data_ptr = nullptr;
+    m_data_f32_ptr = &p_data;
+
+    std::unique_ptr<container::static_kdtree_f32> tree;
+
+    if ( (p_data.size() >= container::static_kdtree_f32::MINIMUM_SIZE) && container::static_kdtree_f32::is_suitable(p_data.dimension(), m_metric) ) {
+        tree.reset(new container::static_kdtree_f32(p_data));
+        m_tree_f32_ptr = tree.get();
+    }
+
+    process_data(p_result);
+}
+
+
+template <typename TypeMetric>
+void basic_optics<TypeMetric>::process(const container::neighborhood_graph & p_graph, cluster_data & p_result) {
+    if (!p_graph.is_built_with(m_metric)) {
+        throw std::invalid_argument("CCORE [optics]: neighborhood graph is built with another metric.");
+    }
+
+    if (m_radius > p_graph.radius()) {
+        throw std::invalid_argument("CCORE [optics]: radius of neighborhood graph is less than connectivity radius.");
+    }
+
+    m_data_ptr = nullptr;
+    m_data_f32_ptr = nullptr;
+    m_graph_ptr = &p_graph;
+
+    process_data(p_result);
+}
+
+
+template <typename TypeMetric>
+void basic_optics<TypeMetric>::process(const container::basic_hnsw<TypeMetric> & p_index, cluster_data & p_result) {
+    if (!p_index.is_built_with(m_metric)) {
+        throw std::invalid_argument("CCORE [optics]: HNSW graph is built with another metric.");
+    }
+
+    const dataset_view data = p_index.points();
+
+    m_data_ptr = &data;
+    m_data_f32_ptr = nullptr;
+    m_hnsw_ptr = &p_index;
+
+    process_data(p_result);
+}
+
+
+template <typename TypeMetric>
+void basic_optics<TypeMetric>::process_data(cluster_data & p_result) {
     m_result_ptr = (optics_data *) &p_result;
 
+    p_result.set_statistics(utils::statistics::create());
+    m_statistics = p_result.statistics().get();
+
+    utils::statistics_timer total_timer(m_statistics, utils::statistic_phase::TOTAL);
+
     calculate_cluster_result();
 
     if ( (m_amount_clusters > 0) && (m_amount_clusters != m_result_ptr->clusters()->size()) ) {
@@ -77,23 +167,43 @@ void optics::process(const dataset & p_data, cluster_data & p_result) {
     m_result_ptr->set_radius(m_radius);
 
     m_data_ptr = nullptr;
+    m_data_f32_ptr = nullptr;
+    m_graph_ptr = nullptr;
+    m_tree_ptr = nullptr;
+    m_tree_f32_ptr = nullptr;
+    m_ball_tree_ptr = nullptr;
+    m_hnsw_ptr = nullptr;
     m_result_ptr = nullptr;
+    m_statistics = nullptr;
 }
 
 
-void optics::calculate_cluster_result(void) {
+template <typename TypeMetric>
+void basic_optics<TypeMetric>::calculate_cluster_result(void) {
+    utils::increase_counter(m_statistics, utils::statistic_counter::ITERATIONS);
+
     initialize();
     allocate_clusters();
     calculate_ordering();
 }
 
 
-void optics::initialize(void) {
+template <typename TypeMetric>
+void basic_optics<TypeMetric>::initialize(void) {
+    utils::statistics_timer timer(m_statistics, utils::statistic_phase::INITIALIZATION);
+
     if (m_optics_objects.empty()) {
-        m_optics_objects.reserve(m_data_ptr->size());
+        std::size_t size = 0;
+        if (m_graph_ptr != nullptr) {
+            size = m_graph_ptr->size();
+        }
+        else {
+            size = (m_data_f32_ptr != nullptr) ? m_data_f32_ptr->size() : m_data_ptr->size();
+        }
+        m_optics_objects.reserve(size);
 
-        for (std::size_t i = 0; i < m_data_ptr->size(); i++) {
-            m_optics_objects.emplace_back(i, optics::NONE_DISTANCE, optics::NONE_DISTANCE);
+        for (std::size_t i = 0; i < size; i++) {
+            m_optics_objects.emplace_back(i, NONE_DISTANCE, NONE_DISTANCE);
         }
     }
     else {
@@ -108,7 +218,8 @@ void optics::initialize(void) {
 }
 
 
-void optics::allocate_clusters(void) {
+template <typename TypeMetric>
+void basic_optics<TypeMetric>::allocate_clusters(void) {
     for (auto & optics_object : m_optics_objects) {
         if (!optics_object.m_processed) {
             expand_cluster_order(optics_object);
@@ -119,7 +230,8 @@ void optics::allocate_clusters(void) {
 }
 
 
-void optics::expand_cluster_order(optics_descriptor & p_object) {
+template <typename TypeMetric>
+void basic_optics<TypeMetric>::expand_cluster_order(optics_descriptor & p_object) {
     p_object.m_processed = true;
 
     std::vector< std::tuple<std::size_t, double> > neighbors;
@@ -151,19 +263,20 @@ void optics::expand_cluster_order(optics_descriptor & p_object) {
                 update_order_seed(*descriptor, neighbors, order_seed);
             }
             else {
-                descriptor->m_core_distance = optics::NONE_DISTANCE;
+                descriptor->m_core_distance = NONE_DISTANCE;
             }
 
             order_seed_length = order_seed.size();
         }
     }
     else {
-        p_object.m_core_distance = optics::NONE_DISTANCE;
+        p_object.m_core_distance = NONE_DISTANCE;
     }
 }
 
 
-void optics::update_order_seed(const optics_descriptor & p_object, const std::vector< std::tuple<std::size_t, double> > & neighbors, std::list<optics_descriptor *> & order_seed) {
+template <typename TypeMetric>
+void basic_optics<TypeMetric>::update_order_seed(const optics_descriptor & p_object, const std::vector< std::tuple<std::size_t, double> > & neighbors, std::list<optics_descriptor *> & order_seed) {
     for (auto & descriptor : neighbors) {
         std::size_t index_neighbor = std::get<0>(descriptor);
         double current_reachability_distance = std::get<1>(descriptor);
@@ -171,7 +284,7 @@ void optics::update_order_seed(const optics_descriptor & p_object, const std::ve
         if (!m_optics_objects[index_neighbor].m_processed) {
             double reachable_distance = std::max({ current_reachability_distance, p_object.m_core_distance });
 
-            if (m_optics_objects[index_neighbor].m_reachability_distance == optics::NONE_DISTANCE) {
+            if (m_optics_objects[index_neighbor].m_reachability_distance == NONE_DISTANCE) {
                 m_optics_objects[index_neighbor].m_reachability_distance = reachable_distance;
 
                 auto position_insertion = order_seed.end();
@@ -195,7 +308,10 @@ void optics::update_order_seed(const optics_descriptor & p_object, const std::ve
 }
 
 
-void optics::extract_clusters(void) {
+template <typename TypeMetric>
+void basic_optics<TypeMetric>::extract_clusters(void) {
+    utils::statistics_timer timer(m_statistics, utils::statistic_phase::EXTRACTION);
+
     cluster_sequence_ptr clusters = m_result_ptr->clusters();
     noise_ptr noise = m_result_ptr->noise();
 
@@ -203,8 +319,8 @@ void optics::extract_clusters(void) {
     clusters->push_back(cluster());
 
     for (auto optics_object : m_ordered_database) {
-        if ( (optics_object->m_reachability_distance == optics::NONE_DISTANCE) || (optics_object->m_reachability_distance > m_radius) ) {
-            if ( (optics_object->m_core_distance != optics::NONE_DISTANCE) && (optics_object->m_core_distance <= m_radius) ) {
+        if ( (optics_object->m_reachability_distance == NONE_DISTANCE) || (optics_object->m_reachability_distance > m_radius) ) {
+            if ( (optics_object->m_core_distance != NONE_DISTANCE) && (optics_object->m_core_distance <= m_radius) ) {
                 if (clusters->at(index_current_cluster).size() > 0) {
                     index_current_cluster++;
                     clusters->push_back(cluster());
@@ -227,16 +343,48 @@ void optics::extract_clusters(void) {
 }
 
 
-void optics::get_neighbors(const size_t p_index, std::vector< std::tuple<std::size_t, double> > & p_neighbors) {
+template <typename TypeMetric>
+void basic_optics<TypeMetric>::get_neighbors(const size_t p_index, std::vector< std::tuple<std::size_t, double> > & p_neighbors) {
+    if (m_graph_ptr != nullptr) {
+        get_neighbors(*m_graph_ptr, p_index, p_neighbors);
+    }
+    else if (m_tree_ptr != nullptr) {
+        get_neighbors(*m_tree_ptr, *m_data_ptr, m_tree_buffer, p_index, p_neighbors);
+    }
+    else if (m_tree_f32_ptr != nullptr) {
+        get_neighbors(*m_tree_f32_ptr, *m_data_f32_ptr, m_tree_f32_buffer, p_index, p_neighbors);
+    }
+    else if (m_ball_tree_ptr != nullptr) {
+        get_neighbors(*m_ball_tree_ptr, m_ball_tree_buffer, p_index, p_neighbors);
+    }
+    else if (m_hnsw_ptr != nullptr) {
+        get_neighbors(*m_hnsw_ptr, m_hnsw_buffer, p_index, p_neighbors);
+    }
+    else if (m_data_f32_ptr != nullptr) {
+        get_neighbors(*m_data_f32_ptr, m_distances_f32, p_index, p_neighbors);
+    }
+    else {
+        get_neighbors(*m_data_ptr, m_distances, p_index, p_neighbors);
+    }
+}
+
+
+template <typename TypeMetric>
+template <typename TypeValue>
+void basic_optics<TypeMetric>::get_neighbors(const container::dense_matrix_view<TypeValue> & p_data, std::vector<TypeValue> & p_distances, const std::size_t p_index, std::vector< std::tuple<std::size_t, double> > & p_neighbors) {
 	p_neighbors.clear();
 
-    for (size_t index = 0; index < m_data_ptr->size(); index++) {
-		if (index == p_index) { continue; }
+    utils::statistics_timer timer(m_statistics, utils::statistic_phase::NEIGHBOR_SEARCH);
+    utils::increase_counter(m_statistics, utils::statistic_counter::NEIGHBOR_QUERIES);
+    utils::increase_counter(m_statistics, utils::statistic_counter::DISTANCE_EVALUATIONS, p_data.size());
+
+    p_distances.resize(p_data.size());
+    m_metric.comparable_block(p_data[p_index], p_data, p_distances.data());
 
-        point object1 = (*m_data_ptr)[index];
-        point object2 = (*m_data_ptr)[p_index];
+    for (size_t index = 0; index < p_data.size(); index++) {
+		if (index == p_index) { continue; }
 
-        const double distance = euclidean_distance(object1, object2);
+        const double distance = m_metric.from_comparable(static_cast<double>(p_distances[index]));
 
         if (distance <= m_radius) {
             p_neighbors.push_back(std::make_tuple(index, distance));
@@ -245,7 +393,75 @@ void optics::get_neighbors(const size_t p_index, std::vector< std::tuple<std::si
 }
 
 
-void optics::calculate_ordering(void) {
+template <typename TypeMetric>
+void basic_optics<TypeMetric>::get_neighbors(const container::neighborhood_graph & p_graph, const std::size_t p_index, std::vector< std::tuple<std::size_t, double> > & p_neighbors) {
+    p_neighbors.clear();
+
+    utils::statistics_timer timer(m_statistics, utils::statistic_phase::NEIGHBOR_SEARCH);
+    utils::increase_counter(m_statistics, utils::statistic_counter::NEIGHBOR_QUERIES);
+
+    p_graph.for_each_neighbor(p_index, [this, &p_neighbors](const std::size_t p_index_neighbor, const double p_distance) {
+        const double distance = m_metric.from_comparable(p_distance);
+        if (distance <= m_radius) {
+            p_neighbors.push_back(std::make_tuple(p_index_neighbor, distance));
+        }
+    });
+}
+
+
+template <typename TypeMetric>
+template <typename TypeValue>
+void basic_optics<TypeMetric>::get_neighbors(const container::basic_static_kdtree<TypeValue> & p_tree, const container::dense_matrix_view<TypeValue> & p_data, typename container::basic_static_kdtree<TypeValue>::search_buffer & p_buffer, const std::size_t p_index, std::vector< std::tuple<std::size_t, double> > & p_neighbors) {
+    p_neighbors.clear();
+    m_tree_neighbors.clear();
+    m_distances.clear();
+
+    utils::statistics_timer timer(m_statistics, utils::statistic_phase::NEIGHBOR_SEARCH);
+    utils::increase_counter(m_statistics, utils::statistic_counter::NEIGHBOR_QUERIES);
+
+    const std::size_t calculated_distances = p_tree.find_radius(p_data[p_index], m_metric.to_comparable(m_radius), m_metric, p_buffer, m_tree_neighbors, m_distances);
+    utils::increase_counter(m_statistics, utils::statistic_counter::DISTANCE_EVALUATIONS, calculated_distances);
+
+    collect_tree_neighbors(p_index, p_neighbors);
+}
+
+
+template <typename TypeMetric>
+template <typename TypeIndex>
+void basic_optics<TypeMetric>::get_neighbors(const TypeIndex & p_tree, typename TypeIndex::search_buffer & p_buffer, const std::size_t p_index, std::vector< std::tuple<std::size_t, double> > & p_neighbors) {
+    p_neighbors.clear();
+    m_tree_neighbors.clear();
+    m_distances.clear();
+
+    utils::statistics_timer timer(m_statistics, utils::statistic_phase::NEIGHBOR_SEARCH);
+    utils::increase_counter(m_statistics, utils::statistic_counter::NEIGHBOR_QUERIES);
+
+    const std::size_t calculated_distances = p_tree.find_radius((*m_data_ptr)[p_index], m_metric.to_comparable(m_radius), p_buffer, m_tree_neighbors, m_distances);
+    utils::increase_counter(m_statistics, utils::statistic_counter::DISTANCE_EVALUATIONS, calculated_distances);
+
+    collect_tree_neighbors(p_index, p_neighbors);
+}
+
+
+template <typename TypeMetric>
+void basic_optics<TypeMetric>::collect_tree_neighbors(const std::size_t p_index, std::vector< std::tuple<std::size_t, double> > & p_neighbors) {
+    for (std::size_t position = 0; position < m_tree_neighbors.size(); position++) {
+        const std::size_t index_neighbor = m_tree_neighbors[position];
+        if (index_neighbor == p_index) { continue; }
+
+        const double distance = m_metric.from_comparable(m_distances[position]);
+        if (distance <= m_radius) {
+            p_neighbors.push_back(std::make_tuple(index_neighbor, distance));
+        }
+    }
+
+    /* neighbors are sorted by index to process them in the same order as without tree */
+    std::sort(p_neighbors.begin(), p_neighbors.end());
+}
+
+
+template <typename TypeMetric>
+void basic_optics<TypeMetric>::calculate_ordering(void) {
     if (!m_result_ptr->ordering()->empty()) { return; }
 
     ordering_ptr ordering = m_result_ptr->ordering();
@@ -254,7 +470,7 @@ void optics::calculate_ordering(void) {
     for (auto & cluster : *clusters) {
         for (auto index_object : cluster) {
             const optics_descriptor & optics_object = m_optics_objects[index_object];
-            if (optics_object.m_reachability_distance != optics::NONE_DISTANCE) {
+            if (optics_object.m_reachability_distance != NONE_DISTANCE) {
                 ordering->push_back(optics_object.m_reachability_distance);
             }
         }
@@ -262,4 +478,12 @@ void optics::calculate_ordering(void) {
 }
 
 
+template class basic_optics<utils::metric::euclidean>;
+template class basic_optics<utils::metric::euclidean_square>;
+template class basic_optics<utils::metric::manhattan>;
+template class basic_optics<utils::metric::chebyshev>;
+template class basic_optics<utils::metric::minkowski>;
+template class basic_optics<utils::metric::cosine>;
+
+
 }
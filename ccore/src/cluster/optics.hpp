@@ -28,6 +28,13 @@
 #include "cluster/cluster_algorithm.hpp"
 #include "cluster/optics_data.hpp"
 
+#include "container/neighborhood_graph.hpp"
+#include "container/ball_tree.hpp"
+#include "container/hnsw.hpp"
+#include "container/static_kdtree.hpp"
+
+#include "utils/metric.hpp"
+
 
 namespace cluster_analysis {
 
@@ -101,18 +108,34 @@ public:
  * @details OPTICS is a density-based algorithm. Purpose of the algorithm is to provide explicit clusters, but create clustering-ordering representation of the input data.
  *          Clustering-ordering information contains information about internal structures of data set in terms of density and proper connectivity radius can be obtained
  *          for allocation required amount of clusters using this diagram. In case of usage additional input parameter 'amount of clusters' connectivity radius should be
- *          bigger than real - because it will be calculated by the algorithms.
+ *          bigger than real - because it will be calculated by the algorithms. Metric that is used to calculate
+ *          distance between objects is defined by policy 'TypeMetric' (see 'utils::metric').
  *
  */
-class optics : public cluster_algorithm  {
+template <typename TypeMetric>
+class basic_optics : public cluster_algorithm  {
 public:
     static const double NONE_DISTANCE;
 
 private:
-    const dataset       * m_data_ptr;
+    const dataset_view  * m_data_ptr = nullptr;
+
+    const dataset_view_f32  * m_data_f32_ptr = nullptr;   /* used instead of 'm_data_ptr' when input data is in single precision */
+
+    const container::neighborhood_graph * m_graph_ptr = nullptr;    /* used instead of input data when neighbors are already found */
+
+    const container::static_kdtree * m_tree_ptr = nullptr;      /* KD-tree of 'm_data_ptr' that is used for neighbor search of large data */
+
+    const container::static_kdtree_f32 * m_tree_f32_ptr = nullptr;  /* KD-tree of 'm_data_f32_ptr' */
+
+    const container::basic_ball_tree<TypeMetric> * m_ball_tree_ptr = nullptr;   /* used instead of KD-tree for high-dimensional data */
+
+    const container::basic_hnsw<TypeMetric> * m_hnsw_ptr = nullptr;     /* approximate neighbor search that is chosen by user */
 
     optics_data         * m_result_ptr;
 
+    TypeMetric          m_metric;
+
     double              m_radius;
 
     std::size_t         m_neighbors;
@@ -123,27 +146,43 @@ private:
 
     std::vector<optics_descriptor *>    m_ordered_database;
 
+    std::vector<double>                 m_distances;
+
+    std::vector<float>                  m_distances_f32;
+
+    std::vector<std::size_t>            m_tree_neighbors;
+
+    container::static_kdtree::search_buffer     m_tree_buffer;          /* scratch memory of KD-tree queries */
+
+    container::static_kdtree_f32::search_buffer m_tree_f32_buffer;
+
+    typename container::basic_ball_tree<TypeMetric>::search_buffer  m_ball_tree_buffer;
+
+    typename container::basic_hnsw<TypeMetric>::search_buffer       m_hnsw_buffer;      /* visited marks are reset once instead of each query */
+
+    utils::statistics *                 m_statistics = nullptr;     /* statistics of the current call, null if it is not collected */
+
 public:
     /**
      *
      * @brief Default constructor to create algorithm instance.
      *
      */
-    optics(void) = default;
+    basic_optics(void) = default;
 
     /**
      *
      * @brief Default copy constructor to create algorithm instance.
      *
      */
-    optics(const optics & p_other) = default;
+    basic_optics(const basic_optics & p_other) = default;
 
     /**
      *
      * @brief Default move constructor to create algorithm instance.
      *
      */
-    optics(optics && p_other) = default;
+    basic_optics(basic_optics && p_other) = default;
 
     /**
      *
@@ -152,9 +191,10 @@ public:
      * @param[in] p_radius: connectivity radius between objects.
      * @param[in] p_neighbors: minimum amount of shared neighbors that is require to connect
      *             two object (if distance between them is less than connectivity radius).
+     * @param[in] p_metric: metric that is used to calculate distance between objects.
      *
      */
-    optics(const double p_radius, const std::size_t p_neighbors);
+    basic_optics(const double p_radius, const std::size_t p_neighbors, const TypeMetric & p_metric = TypeMetric());
 
     /**
      *
@@ -165,20 +205,24 @@ public:
      *             two object (if distance between them is less than connectivity radius).
      * @param[in] p_amount_clusters: amount of clusters that should be allocated (in this case
      *             connectivity radius may be changed by the algorithm.
+     * @param[in] p_metric: metric that is used to calculate distance between objects.
      */
-    optics(const double p_radius, const std::size_t p_neighbors, const std::size_t p_amount_clusters);
+    basic_optics(const double p_radius, const std::size_t p_neighbors, const std::size_t p_amount_clusters, const TypeMetric & p_metric = TypeMetric());
 
     /**
      *
      * @brief Default destructor to destroy algorithm instance.
      *
      */
-    virtual ~optics(void) = default;
+    virtual ~basic_optics(void) = default;
 
 public:
     /**
     *
     * @brief    Performs cluster analysis of an input data.
+    * @details  Points are copied to contiguous block and processed through view, so the method
+    *           temporarily requires additional memory for one more copy of the input data. Use
+    *           view overload to avoid the copy when data is already placed in one memory block.
     *
     * @param[in]  p_data: input data for cluster analysis.
     * @param[out] p_result: clustering result of an input data (consists of allocated clusters,
@@ -187,7 +231,69 @@ public:
     */
     virtual void process(const dataset & p_data, cluster_data & p_result) override;
 
+    /**
+    *
+    * @brief    Performs cluster analysis of an input data that is stored in contiguous memory.
+    * @details  Neighbors of large data are searched by static KD-tree if it is suitable for
+    *           dimension of data and the metric, otherwise by ball tree if the metric satisfies
+    *           triangle inequality (high-dimensional data).
+    *
+    * @param[in]  p_data: input data for cluster analysis.
+    * @param[out] p_result: clustering result of an input data (consists of allocated clusters,
+    *              cluster-ordering, noise and proper connectivity radius).
+    *
+    */
+    virtual void process(const dataset_view & p_data, cluster_data & p_result) override;
+
+    /**
+    *
+    * @brief    Performs cluster analysis of an input data in single precision.
+    * @details  Neighbors of large data are searched by static KD-tree with single precision
+    *           coordinates if it is suitable for dimension of data and the metric, otherwise
+    *           distances are calculated using single precision distance kernels.
+    *
+    * @param[in]  p_data: input data for cluster analysis.
+    * @param[out] p_result: clustering result of an input data (consists of allocated clusters,
+    *              cluster-ordering, noise and proper connectivity radius).
+    *
+    */
+    virtual void process(const dataset_view_f32 & p_data, cluster_data & p_result) override;
+
+    /**
+    *
+    * @brief    Performs cluster analysis using neighborhood graph that has been built for input data
+    *           instead of searching neighbors, so the same graph can be used for several values of
+    *           minimum amount of neighbors or amount of clusters.
+    * @details  The graph should be built using the same metric as the algorithm and its radius
+    *           should not be less than connectivity radius of the algorithm, otherwise exception
+    *           'std::invalid_argument' is thrown.
+    *
+    * @param[in]  p_graph: neighborhood graph of input data.
+    * @param[out] p_result: clustering result of an input data (consists of allocated clusters,
+    *              cluster-ordering, noise and proper connectivity radius).
+    *
+    */
+    void process(const container::neighborhood_graph & p_graph, cluster_data & p_result);
+
+    /**
+    *
+    * @brief    Performs cluster analysis of points of approximate nearest neighbor graph, neighbors
+    *           are searched by the graph, so some of them can be missed and cluster-ordering is
+    *           approximate in exchange for speed on large data of high dimension.
+    * @details  The graph should be built using the same metric as the algorithm with the same
+    *           parameters (see 'basic_hnsw::is_built_with'), otherwise exception
+    *           'std::invalid_argument' is thrown.
+    *
+    * @param[in]  p_index: HNSW graph that is built for input data.
+    * @param[out] p_result: clustering result of an input data (consists of allocated clusters,
+    *              cluster-ordering, noise and proper connectivity radius).
+    *
+    */
+    void process(const container::basic_hnsw<TypeMetric> & p_index, cluster_data & p_result);
+
 private:
+    void process_data(cluster_data & p_result);
+
     void initialize(void);
 
     void allocate_clusters(void);
@@ -198,6 +304,19 @@ private:
 
     void get_neighbors(const std::size_t p_index, std::vector< std::tuple<std::size_t, double> > & p_neighbors);
 
+    void get_neighbors(const container::neighborhood_graph & p_graph, const std::size_t p_index, std::vector< std::tuple<std::size_t, double> > & p_neighbors);
+
+    template <typename TypeValue>
+    void get_neighbors(const container::basic_static_kdtree<TypeValue> & p_tree, const container::dense_matrix_view<TypeValue> & p_data, typename container::basic_static_kdtree<TypeValue>::search_buffer & p_buffer, const std::size_t p_index, std::vector< std::tuple<std::size_t, double> > & p_neighbors);
+
+    template <typename TypeIndex>
+    void get_neighbors(const TypeIndex & p_tree, typename TypeIndex::search_buffer & p_buffer, const std::size_t p_index, std::vector< std::tuple<std::size_t, double> > & p_neighbors);
+
+    void collect_tree_neighbors(const std::size_t p_index, std::vector< std::tuple<std::size_t, double> > & p_neighbors);
+
+    template <typename TypeValue>
+    void get_neighbors(const container::dense_matrix_view<TypeValue> & p_data, std::vector<TypeValue> & p_distances, const std::size_t p_index, std::vector< std::tuple<std::size_t, double> > & p_neighbors);
+
 	void update_order_seed(const optics_descriptor & p_object, const std::vector< std::tuple<std::size_t, double> > & neighbors, std::list<optics_descriptor *> & order_seed);
 
 	void calculate_ordering(void);
@@ -206,4 +325,12 @@ private:
 };
 
 
+/**
+ *
+ * @brief OPTICS algorithm that uses Euclidean distance.
+ *
+ */
+using optics = basic_optics<utils::metric::euclidean>;
+
+
 }
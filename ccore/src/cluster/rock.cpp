@@ -26,11 +26,14 @@
 
 #include "utils.hpp"
 
+#include "utils/pairwise_distance.hpp"
+
 
 namespace cluster_analysis {
 
 
-rock::rock(void) :
+template <typename TypeMetric>
+basic_rock<TypeMetric>::basic_rock(void) :
     m_adjacency_matrix(adjacency_matrix()),
     m_radius(0.0),
     m_degree_normalization(0.0),
@@ -38,22 +41,61 @@ rock::rock(void) :
 { }
 
 
-rock::rock(const double radius, const size_t num_clusters, const double threshold) :
+template <typename TypeMetric>
+basic_rock<TypeMetric>::basic_rock(const double radius, const size_t num_clusters, const double threshold, const TypeMetric & metric) :
     m_adjacency_matrix(adjacency_matrix()),
-    m_radius(radius * radius),
+    m_metric(metric),
+    m_radius(metric.to_comparable(radius)),
     m_degree_normalization(1.0 + 2.0 * ( (1.0 - threshold) / (1.0 + threshold) )),
     m_number_clusters(num_clusters)
 { }
 
 
-rock::~rock(void) { }
+template <typename TypeMetric>
+basic_rock<TypeMetric>::~basic_rock(void) { }
+
+
+template <typename TypeMetric>
+void basic_rock<TypeMetric>::process(const dataset & p_data, cluster_data & p_result) {
+    const dataset_matrix matrix_data(p_data);
+    process(matrix_data.view(), p_result);
+}
+
+
+template <typename TypeMetric>
+void basic_rock<TypeMetric>::process(const dataset_view & p_data, cluster_data & p_result) {
+    if ( (p_data.size() >= static_kdtree::MINIMUM_SIZE) && static_kdtree::is_suitable(p_data.dimension(), m_metric) ) {
+        /* neighborhoods of all points are found by one dual-tree traversal */
+        const container::neighborhood_graph graph = container::neighborhood_graph::create(p_data, m_metric.from_comparable(m_radius), m_metric);
+        create_adjacency_matrix(graph);
+    }
+    else {
+        create_adjacency_matrix(p_data);
+    }
+
+    allocate_clusters(p_result);
+}
 
 
-void rock::process(const dataset & p_data, cluster_data & p_result) {
-    create_adjacency_matrix(p_data);
+template <typename TypeMetric>
+void basic_rock<TypeMetric>::process(const container::neighborhood_graph & p_graph, cluster_data & p_result) {
+    if (!p_graph.is_built_with(m_metric)) {
+        throw std::invalid_argument("CCORE [rock]: neighborhood graph is built with another metric.");
+    }
 
+    if (m_radius > m_metric.to_comparable(p_graph.radius())) {
+        throw std::invalid_argument("CCORE [rock]: radius of neighborhood graph is less than connectivity radius.");
+    }
+
+    create_adjacency_matrix(p_graph);
+    allocate_clusters(p_result);
+}
+
+
+template <typename TypeMetric>
+void basic_rock<TypeMetric>::allocate_clusters(cluster_data & p_result) {
     /* initialize first version of clusters */
-    for (size_t index = 0; index < p_data.size(); index++) {
+    for (size_t index = 0; index < m_adjacency_matrix.size(); index++) {
         m_clusters.push_back(cluster(1, index));
     }
 
@@ -68,22 +110,41 @@ void rock::process(const dataset & p_data, cluster_data & p_result) {
 }
 
 
-void rock::create_adjacency_matrix(const dataset & p_data) {
+template <typename TypeMetric>
+void basic_rock<TypeMetric>::create_adjacency_matrix(const dataset_view & p_data) {
     m_adjacency_matrix = adjacency_matrix(p_data.size());
-    for (size_t i = 0; i < m_adjacency_matrix.size(); i++) {
-        for (size_t j = i + 1; j < m_adjacency_matrix.size(); j++) {
-            double distance = euclidean_distance_sqrt(&p_data[i], &p_data[j]);
 
-            if (distance < m_radius) {
-                m_adjacency_matrix.set_connection(i, j);
-                m_adjacency_matrix.set_connection(j, i);
+    utils::for_each_distance_block(p_data, m_metric, [this](const size_t p_begin, const size_t p_amount, const double * const p_distances) {
+        const size_t size = m_adjacency_matrix.size();
+        for (size_t i = p_begin; i < p_begin + p_amount; i++) {
+            const double * const distances = p_distances + (i - p_begin) * size;
+            for (size_t j = i + 1; j < size; j++) {
+                if (distances[j] < m_radius) {
+                    m_adjacency_matrix.set_connection(i, j);
+                    m_adjacency_matrix.set_connection(j, i);
+                }
             }
         }
+    });
+}
+
+
+template <typename TypeMetric>
+void basic_rock<TypeMetric>::create_adjacency_matrix(const container::neighborhood_graph & p_graph) {
+    m_adjacency_matrix = adjacency_matrix(p_graph.size());
+
+    for (size_t i = 0; i < p_graph.size(); i++) {
+        p_graph.for_each_neighbor(i, [this, i](const size_t p_index_neighbor, const double p_distance) {
+            if (p_distance < m_radius) {
+                m_adjacency_matrix.set_connection(i, p_index_neighbor);
+            }
+        });
     }
 }
 
 
-bool rock::merge_cluster(void) {
+template <typename TypeMetric>
+bool basic_rock<TypeMetric>::merge_cluster(void) {
     auto cluster1 = m_clusters.end();
     auto cluster2 = m_clusters.end();
 
@@ -112,7 +173,8 @@ bool rock::merge_cluster(void) {
     return true;
 }
 
-size_t rock::calculate_links(const cluster & cluster1, const cluster & cluster2) const {
+template <typename TypeMetric>
+size_t basic_rock<TypeMetric>::calculate_links(const cluster & cluster1, const cluster & cluster2) const {
     size_t number_links = 0;
     for (auto i : cluster1) {
         for (auto j : cluster2) {
@@ -123,7 +185,8 @@ size_t rock::calculate_links(const cluster & cluster1, const cluster & cluster2)
     return number_links;
 }
 
-double rock::calculate_goodness(const cluster & cluster1, const cluster & cluster2) const {
+template <typename TypeMetric>
+double basic_rock<TypeMetric>::calculate_goodness(const cluster & cluster1, const cluster & cluster2) const {
     const double number_links = (double) calculate_links(cluster1, cluster2);
 
     const double size_cluster1 = (double) cluster1.size();
@@ -135,4 +198,12 @@ double rock::calculate_goodness(const cluster & cluster1, const cluster & cluste
 }
 
 
+template class basic_rock<utils::metric::euclidean>;
+template class basic_rock<utils::metric::euclidean_square>;
+template class basic_rock<utils::metric::manhattan>;
+template class basic_rock<utils::metric::chebyshev>;
+template class basic_rock<utils::metric::minkowski>;
+template class basic_rock<utils::metric::cosine>;
+
+
 }
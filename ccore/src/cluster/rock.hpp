@@ -26,9 +26,12 @@
 #include <list>
 
 #include "container/adjacency_matrix.hpp"
+#include "container/neighborhood_graph.hpp"
 
 #include "cluster/cluster_algorithm.hpp"
 
+#include "utils/metric.hpp"
+
 #include "definitions.hpp"
 
 
@@ -41,7 +44,14 @@ namespace cluster_analysis {
 using rock_data = cluster_data;
 
 
-class rock : public cluster_algorithm {
+/**
+*
+* @brief    Represents ROCK clustering algorithm, metric that is used to calculate distance between
+*           points is defined by policy 'TypeMetric' (see 'utils::metric').
+*
+*/
+template <typename TypeMetric>
+class basic_rock : public cluster_algorithm {
 private:
     /* for optimization list representation is of clusters is used and than
      * it is moved to output result */
@@ -50,7 +60,9 @@ private:
 private:
     adjacency_matrix        m_adjacency_matrix;
 
-    double                  m_radius;
+    TypeMetric              m_metric;
+
+    double                  m_radius;             /* connectivity radius in comparable form of the metric */
 
     double                  m_degree_normalization;
 
@@ -64,7 +76,7 @@ public:
     * @brief    Default constructor of clustering algorithm.
     *
     */
-    rock(void);
+    basic_rock(void);
 
     /**
     *
@@ -73,29 +85,67 @@ public:
     * @param[in] radius: connectivity radius (similarity threshold), points are neighbors if distance between them is less than connectivity radius.
     * @param[in] number_clusters: amount of clusters that should be allocated.
     * @param[in] threshold: defines degree of normalization that influences on choice of clusters for merging during processing.
+    * @param[in] metric: metric that is used to calculate distance between points.
     *
     */
-    rock(const double radius, const size_t number_clusters, const double threshold);
+    basic_rock(const double radius, const size_t number_clusters, const double threshold, const TypeMetric & metric = TypeMetric());
 
     /**
     *
     * @brief    Default destructor of the algorithm.
     *
     */
-    virtual ~rock(void);
+    virtual ~basic_rock(void);
 
 public:
     /**
     *
     * @brief    Performs cluster analysis of an input data.
+    * @details  Points are copied to contiguous block and processed through view, so the method
+    *           temporarily requires additional memory for one more copy of the input data. Use
+    *           view overload to avoid the copy when data is already placed in one memory block.
+    *
+    * @param[in]  p_data: input data for cluster analysis.
+    * @param[out] p_result: clustering result of an input data.
+    *
+    */
+    virtual void process(const dataset & p_data, cluster_data & p_result) override;
+
+    /**
+    *
+    * @brief    Performs cluster analysis of an input data that is stored in contiguous memory.
     *
     * @param[in]  p_data: input data for cluster analysis.
     * @param[out] p_result: clustering result of an input data.
     *
     */
-    virtual void process(const dataset & p_data, cluster_data & p_result);
+    virtual void process(const dataset_view & p_data, cluster_data & p_result) override;
+
+    /**
+    *
+    * @brief    Performs cluster analysis using neighborhood graph that has been built for input data
+    *           instead of calculating distances between all points, so the same graph can be used
+    *           for several amounts of clusters.
+    * @details  The graph should be built using the same metric as the algorithm and its radius
+    *           should not be less than connectivity radius of the algorithm, otherwise exception
+    *           'std::invalid_argument' is thrown.
+    *
+    * @param[in]  p_graph: neighborhood graph of input data.
+    * @param[out] p_result: clustering result of an input data.
+    *
+    */
+    void process(const container::neighborhood_graph & p_graph, cluster_data & p_result);
 
 private:
+    /**
+    *
+    * @brief    Merges clusters using links that are stored in adjacency matrix.
+    *
+    * @param[out] p_result: clustering result of an input data.
+    *
+    */
+    void allocate_clusters(cluster_data & p_result);
+
     /**
     *
     * @brief    Creates adjacency matrix where each element described existence of link between points (means that points are neighbors).
@@ -103,7 +153,16 @@ private:
     * @param[in]  p_data: input data for cluster analysis.
     *
     */
-    void create_adjacency_matrix(const dataset & p_data);
+    void create_adjacency_matrix(const dataset_view & p_data);
+
+    /**
+    *
+    * @brief    Creates adjacency matrix using neighbors that are stored in neighborhood graph.
+    *
+    * @param[in]  p_graph: neighborhood graph of input data.
+    *
+    */
+    void create_adjacency_matrix(const container::neighborhood_graph & p_graph);
 
     /**
     *
@@ -140,6 +199,14 @@ private:
 };
 
 
+/**
+*
+* @brief    ROCK algorithm that uses Euclidean distance.
+*
+*/
+using rock = basic_rock<utils::metric::euclidean>;
+
+
 }
 
 
@@ -24,6 +24,8 @@
 
 #include "utils.hpp"
 
+#include "utils/pairwise_distance.hpp"
+
 
 syncnet::syncnet(std::vector<std::vector<double> > * input_data, const double connectivity_radius, const bool enable_conn_weight, const initial_type initial_phases) :
 sync_network(input_data->size(), 1, 0, connection_t::CONNECTION_NONE, initial_type::RANDOM_GAUSSIAN)
@@ -35,6 +37,44 @@ sync_network(input_data->size(), 1, 0, connection_t::CONNECTION_NONE, initial_ty
 }
 
 
+syncnet::syncnet(std::vector<std::vector<double> > * input_data, const container::neighborhood_graph & graph, const double connectivity_radius, const bool enable_conn_weight, const initial_type initial_phases) :
+sync_network(input_data->size(), 1, 0, connection_t::CONNECTION_NONE, initial_type::RANDOM_GAUSSIAN)
+{
+	if ( (graph.size() != input_data->size()) || (connectivity_radius > graph.radius()) ) {
+		throw std::invalid_argument("CCORE [syncnet]: neighborhood graph does not correspond to input data or connectivity radius.");
+	}
+
+	if (!graph.is_built_with(utils::metric::euclidean())) {
+		throw std::invalid_argument("CCORE [syncnet]: neighborhood graph should be built with Euclidean metric.");
+	}
+
+	set_callback_solver(&syncnet::adapter_phase_kuramoto);
+
+	oscillator_locations = new std::vector<std::vector<double> >(*input_data);
+
+	if (enable_conn_weight == true) {
+		create_connections(connectivity_radius, enable_conn_weight);
+	}
+	else {
+		create_connections(graph, connectivity_radius);
+	}
+}
+
+
+syncnet::syncnet(std::vector<std::vector<double> > * input_data, const container::hnsw & index, const double connectivity_radius, const initial_type initial_phases) :
+sync_network(input_data->size(), 1, 0, connection_t::CONNECTION_NONE, initial_type::RANDOM_GAUSSIAN)
+{
+	if (index.size() != input_data->size()) {
+		throw std::invalid_argument("CCORE [syncnet]: HNSW graph does not correspond to input data.");
+	}
+
+	set_callback_solver(&syncnet::adapter_phase_kuramoto);
+
+	oscillator_locations = new std::vector<std::vector<double> >(*input_data);
+	create_connections(index, connectivity_radius);
+}
+
+
 syncnet::~syncnet() {
 	if (oscillator_locations != NULL) {
 		delete oscillator_locations;
@@ -51,9 +91,12 @@ syncnet::~syncnet() {
 void syncnet::create_connections(const double connectivity_radius, const bool enable_conn_weight) {
 	double sqrt_connectivity_radius = connectivity_radius * connectivity_radius;
 
+	if (distance_conn_weights != NULL) {
+		delete distance_conn_weights;
+	}
+
 	if (enable_conn_weight == true) {
-		std::vector<double> instance(size(), 0);
-		distance_conn_weights = new std::vector<std::vector<double> >(size(), instance);
+		distance_conn_weights = new container::condensed_matrix<double>(size());
 	}
 	else {
 		distance_conn_weights = NULL;
@@ -62,29 +105,33 @@ void syncnet::create_connections(const double connectivity_radius, const bool en
 	double maximum_distance = 0;
 	double minimum_distance = std::numeric_limits<double>::max();
 
-	for (unsigned int i = 0; i < size(); i++) {
-		for (unsigned int j = i + 1; j < size(); j++) {
-			double distance = euclidean_distance_sqrt( &(*oscillator_locations)[i], &(*oscillator_locations)[j] );
+	const dataset_matrix locations(*oscillator_locations);
 
-			if (distance <= sqrt_connectivity_radius) {
-				m_connections->set_connection(j, i);
-                m_connections->set_connection(i, j);
-			}
+	utils::for_each_distance_block(locations.view(), utils::metric::euclidean_square(), [&](const std::size_t p_begin, const std::size_t p_amount, const double * const p_distances) {
+		for (std::size_t i = p_begin; i < p_begin + p_amount; i++) {
+			const double * const distances = p_distances + (i - p_begin) * size();
+			for (std::size_t j = i + 1; j < size(); j++) {
+				double distance = distances[j];
 
-			if (enable_conn_weight == true) {
-				(*distance_conn_weights)[i][j] = distance;
-				(*distance_conn_weights)[j][i] = distance;
-
-				if (distance > maximum_distance) {
-					maximum_distance = distance;
+				if (distance <= sqrt_connectivity_radius) {
+					m_connections->set_connection(j, i);
+					m_connections->set_connection(i, j);
 				}
 
-				if (distance < maximum_distance) {
-					maximum_distance = distance;
+				if (enable_conn_weight == true) {
+					distance_conn_weights->set(i, j, distance);
+
+					if (distance > maximum_distance) {
+						maximum_distance = distance;
+					}
+
+					if (distance < maximum_distance) {
+						maximum_distance = distance;
+					}
 				}
 			}
 		}
-	}
+	});
 
 	if (enable_conn_weight == true) {
 		double multiplier = 1;
@@ -97,10 +144,46 @@ void syncnet::create_connections(const double connectivity_radius, const bool en
 
 		for (unsigned int i = 0; i < size(); i++) {
 			for (unsigned int j = i + 1; j < size(); j++) {
-				double value_weight = ((*distance_conn_weights)[i][j] - subtractor) / multiplier;
+				double value_weight = (distance_conn_weights->get(i, j) - subtractor) / multiplier;
+
+				distance_conn_weights->set(i, j, value_weight);
+			}
+		}
+	}
+}
+
+
+void syncnet::create_connections(const container::neighborhood_graph & graph, const double connectivity_radius) {
+	const double sqrt_connectivity_radius = connectivity_radius * connectivity_radius;
+
+	if (distance_conn_weights != NULL) {
+		delete distance_conn_weights;
+		distance_conn_weights = NULL;
+	}
+
+	for (std::size_t i = 0; i < graph.size(); i++) {
+		graph.for_each_neighbor(i, [this, i, sqrt_connectivity_radius](const std::size_t index_neighbor, const double distance) {
+			if (distance <= sqrt_connectivity_radius) {
+				m_connections->set_connection(i, index_neighbor);
+			}
+		});
+	}
+}
+
+
+void syncnet::create_connections(const container::hnsw & index, const double connectivity_radius) {
+	if (distance_conn_weights != NULL) {
+		delete distance_conn_weights;
+		distance_conn_weights = NULL;
+	}
+
+	const container::neighbor_lists neighbors = index.find_radius(index.points(), index.metric().to_comparable(connectivity_radius));
 
-				(*distance_conn_weights)[i][j] = value_weight;
-				(*distance_conn_weights)[j][i] = value_weight;
+	for (std::size_t i = 0; i < neighbors.size(); i++) {
+		for (auto neighbor = neighbors.begin_neighbors(i); neighbor != neighbors.end_neighbors(i); neighbor++) {
+			if (*neighbor != i) {
+				m_connections->set_connection(i, *neighbor);
+				m_connections->set_connection(*neighbor, i);
 			}
 		}
 	}
@@ -116,7 +199,7 @@ double syncnet::phase_kuramoto(const double t, const double teta, const std::vec
 	if (distance_conn_weights != NULL) {
 		for (unsigned int k = 0; k < size(); k++) {
 			if (m_connections->has_connection(index, k)) {
-				phase += (*distance_conn_weights)[index][k] * std::sin( m_oscillators[k].phase - teta );
+				phase += distance_conn_weights->get(index, k) * std::sin( m_oscillators[k].phase - teta );
 				num_neighbors++;
 			}
 		}
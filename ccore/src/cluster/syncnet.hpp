@@ -23,6 +23,10 @@
 
 #include <vector>
 
+#include "container/condensed_matrix.hpp"
+#include "container/hnsw.hpp"
+#include "container/neighborhood_graph.hpp"
+
 #include "nnet/sync.hpp"
 
 typedef std::vector<unsigned int>			syncnet_cluster;
@@ -47,7 +51,7 @@ public:
 class syncnet: public sync_network {
 protected:
 	std::vector<std::vector<double> >	* oscillator_locations;
-	std::vector<std::vector<double> >	* distance_conn_weights;
+	container::condensed_matrix<double>	* distance_conn_weights = NULL;
 	double								connection_weight;
 
 public:
@@ -65,6 +69,41 @@ public:
 	 ***********************************************************************************************/
 	syncnet(std::vector<std::vector<double> > * input_data, const double connectivity_radius, const bool enable_conn_weight, const initial_type initial_phases);
 
+	/***********************************************************************************************
+	 *
+	 * @brief   Contructor of the adapted oscillatory network SYNC for cluster analysis where
+	 *          connections are created using neighborhood graph of input data.
+	 * @details The graph should be built using Euclidean metric and its radius should not be less
+	 *          than connectivity radius, otherwise exception 'std::invalid_argument' is thrown. Weights of connections depend on
+	 *          distances between all oscillators, therefore they are still calculated from input
+	 *          data if they are enabled.
+	 *
+	 * @param   (in) input_data            - input data for clustering.
+	 * @param   (in) graph                 - neighborhood graph of input data.
+	 * @param   (in) connectivity_radius   - connectivity radius between points.
+	 * @param   (in) enable_conn_weight    - if True - enable mode when strength between oscillators 
+	 *                                       depends on distance between two oscillators.
+	 * @param   (in) initial_phases        - type of initialization of initial phases of oscillators.
+	 *
+	 ***********************************************************************************************/
+	syncnet(std::vector<std::vector<double> > * input_data, const container::neighborhood_graph & graph, const double connectivity_radius, const bool enable_conn_weight, const initial_type initial_phases);
+
+	/***********************************************************************************************
+	 *
+	 * @brief   Contructor of the adapted oscillatory network SYNC for cluster analysis where
+	 *          connections are created using approximate neighbor search by HNSW graph, so some
+	 *          of connections can be missed in exchange for speed on large data.
+	 * @details All connections have the same strength because weights depend on distances
+	 *          between all oscillators.
+	 *
+	 * @param   (in) input_data            - input data for clustering.
+	 * @param   (in) index                 - HNSW graph of input data.
+	 * @param   (in) connectivity_radius   - connectivity radius between points.
+	 * @param   (in) initial_phases        - type of initialization of initial phases of oscillators.
+	 *
+	 ***********************************************************************************************/
+	syncnet(std::vector<std::vector<double> > * input_data, const container::hnsw & index, const double connectivity_radius, const initial_type initial_phases);
+
 	/***********************************************************************************************
 	 *
 	 * @brief   Default destructor.
@@ -112,6 +151,26 @@ protected:
 	 ***********************************************************************************************/
 	void create_connections(const double connectivity_radius, const bool enable_conn_weight);
 
+	/***********************************************************************************************
+	 *
+	 * @brief   Create connections between oscillators using neighbors from neighborhood graph.
+	 *
+	 * @param   (in) graph                - neighborhood graph of oscillator locations.
+	 * @param   (in) connectivity_radius  - connectivity radius between oscillators.
+	 *
+	 ***********************************************************************************************/
+	void create_connections(const container::neighborhood_graph & graph, const double connectivity_radius);
+
+	/***********************************************************************************************
+	 *
+	 * @brief   Create connections between oscillators using neighbors that are found by HNSW graph.
+	 *
+	 * @param   (in) index                - HNSW graph of oscillator locations.
+	 * @param   (in) connectivity_radius  - connectivity radius between oscillators.
+	 *
+	 ***********************************************************************************************/
+	void create_connections(const container::hnsw & index, const double connectivity_radius);
+
 private:
 	static void adapter_phase_kuramoto(const double t, const differ_state<double> & inputs, const differ_extra<void *> & argv, differ_state<double> & outputs);
 };
@@ -50,30 +50,61 @@ void xmeans::process(const dataset & data, cluster_data & output_result) {
     output_result = xmeans_data();
     m_ptr_result = (xmeans_data *)&output_result;
 
+    output_result.set_statistics(utils::statistics::create());
+    m_statistics = output_result.statistics().get();
+
+    utils::statistics_timer total_timer(m_statistics, utils::statistic_phase::TOTAL);
+
     m_ptr_result->centers()->assign(m_centers.begin(), m_centers.end());
 
     size_t current_number_clusters = m_ptr_result->centers()->size();
     const index_sequence dummy;
 
+    utils::execution_monitor monitor(m_control);
+    m_monitor = &monitor;
+
     while (current_number_clusters < m_maximum_clusters) {
         improve_parameters(*(m_ptr_result->clusters()), m_centers, dummy);
+
+        /* structure is not changed after stop to keep clusters that correspond to current centers */
+        if (monitor.is_stopped()) {
+            break;
+        }
+
         improve_structure();
 
-        if (current_number_clusters == m_centers.size()) {
+        if (current_number_clusters == m_centers.size() || monitor.is_stopped()) {
             break;
         }
 
         current_number_clusters = m_centers.size();
     }
+
+    output_result.set_status(monitor.get_status());
+
+    m_monitor = nullptr;
+    m_statistics = nullptr;
 }
 
 void xmeans::improve_parameters(cluster_sequence & improved_clusters, dataset & improved_centers, const index_sequence & available_indexes) {
     double current_change = std::numeric_limits<double>::max();
 
-    while(current_change > m_tolerance) {
-        update_clusters(improved_clusters, improved_centers, available_indexes);
-        current_change = update_centers(improved_clusters, improved_centers);
+    do {
+        utils::increase_counter(m_statistics, utils::statistic_counter::ITERATIONS);
+
+        {
+            utils::statistics_timer timer(m_statistics, utils::statistic_phase::ASSIGNMENT);
+            update_clusters(improved_clusters, improved_centers, available_indexes);
+        }
+
+        {
+            utils::statistics_timer timer(m_statistics, utils::statistic_phase::UPDATE);
+            current_change = update_centers(improved_clusters, improved_centers);
+        }
+
+        m_monitor->next_iteration(current_change);
     }
+    while((current_change > m_tolerance) && m_monitor->can_continue());
 }
 
 
@@ -97,7 +128,14 @@ void xmeans::improve_structure() {
         /* solve k-means problem for children where data of parent are used */
         cluster_sequence parent_child_clusters(2, cluster());
 
+        if (!m_monitor->can_continue()) {
+            return;     /* children are not optimized, current centers are kept */
+        }
+
         improve_parameters(parent_child_clusters, parent_child_centers, current_cluster);
+        if (m_monitor->is_stopped()) {
+            return;
+        }
 
         /* splitting criterion */
         cluster_sequence parent_cluster(1, current_cluster);
@@ -154,6 +192,9 @@ void xmeans::update_clusters(cluster_sequence & analysed_clusters, const dataset
     analysed_clusters.clear();
     analysed_clusters.resize(analysed_centers.size(), cluster());
 
+    const std::size_t amount_objects = available_indexes.empty() ? m_ptr_data->size() : available_indexes.size();
+    utils::increase_counter(m_statistics, utils::statistic_counter::DISTANCE_EVALUATIONS, amount_objects * analysed_centers.size());
+
     if (available_indexes.empty()) {
         for (std::size_t index_object = 0; index_object < m_ptr_data->size(); index_object++) {
             std::size_t index_cluster = find_proper_cluster(analysed_centers, (*m_ptr_data)[index_object]);
@@ -51,6 +51,10 @@ private:
 
     splitting_type  m_criterion;
 
+    utils::statistics   * m_statistics = nullptr;   /* statistics of the current call, null if it is not collected */
+
+    utils::execution_monitor    * m_monitor = nullptr;  /* used only during processing */
+
 public:
     /**
     *
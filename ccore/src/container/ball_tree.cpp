@@ -0,0 +1,334 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#include "container/ball_tree.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace container {
+
+
+/* relative error of distance to center of node that is taken into account to avoid wrong pruning */
+static const double BOUND_ROUNDING_ERROR = 1e-12;
+
+
+template <typename TypeMetric>
+const std::size_t basic_ball_tree<TypeMetric>::DEFAULT_BUCKET_SIZE = 32;
+
+template <typename TypeMetric>
+const std::size_t basic_ball_tree<TypeMetric>::MINIMUM_SIZE = 256;
+
+
+template <typename TypeMetric>
+basic_ball_tree<TypeMetric>::basic_ball_tree(const dataset_view & p_data, const TypeMetric & p_metric, const std::size_t p_bucket_size) :
+    m_points(p_data.size(), p_data.dimension()),
+    m_metric(p_metric),
+    m_bucket_size(std::max(std::size_t(1), p_bucket_size))
+{
+    if (!is_suitable(p_metric)) {
+        throw std::invalid_argument("CCORE [ball_tree]: metric should satisfy triangle inequality.");
+    }
+
+    if (p_data.empty()) {
+        return;
+    }
+
+    std::vector<std::size_t> order(p_data.size());
+    for (std::size_t index = 0; index < order.size(); index++) {
+        order[index] = index;
+    }
+
+    m_nodes.reserve(2 * (p_data.size() / m_bucket_size) + 1);
+    m_centers.reserve(m_nodes.capacity() * p_data.dimension());
+
+    create_node(order, 0, p_data.size(), p_data);
+
+    for (std::size_t position = 0; position < order.size(); position++) {
+        std::copy(p_data[order[position]], p_data[order[position]] + p_data.dimension(), m_points[position]);
+    }
+
+    m_indexes = std::move(order);
+}
+
+
+template <typename TypeMetric>
+bool basic_ball_tree<TypeMetric>::is_suitable(const TypeMetric &) {
+    return TypeMetric::TRIANGLE_INEQUALITY;
+}
+
+
+template <typename TypeMetric>
+std::size_t basic_ball_tree<TypeMetric>::size(void) const {
+    return m_points.size();
+}
+
+
+template <typename TypeMetric>
+std::size_t basic_ball_tree<TypeMetric>::dimension(void) const {
+    return m_points.dimension();
+}
+
+
+template <typename TypeMetric>
+std::size_t basic_ball_tree<TypeMetric>::amount_nodes(void) const {
+    return m_nodes.size();
+}
+
+
+template <typename TypeMetric>
+std::size_t basic_ball_tree<TypeMetric>::create_node(std::vector<std::size_t> & p_order, const std::size_t p_begin, const std::size_t p_end, const dataset_view & p_data) {
+    const std::size_t dimension = p_data.dimension();
+    const std::size_t index_node = m_nodes.size();
+
+    m_nodes.emplace_back();
+    m_nodes[index_node].m_begin = p_begin;
+    m_nodes[index_node].m_end = p_end;
+
+    m_centers.resize(m_centers.size() + dimension, 0.0);
+    double * const center = m_centers.data() + index_node * dimension;
+
+    for (std::size_t position = p_begin; position < p_end; position++) {
+        const double * const point = p_data[p_order[position]];
+        for (std::size_t index_dimension = 0; index_dimension < dimension; index_dimension++) {
+            center[index_dimension] += point[index_dimension];
+        }
+    }
+
+    for (std::size_t index_dimension = 0; index_dimension < dimension; index_dimension++) {
+        center[index_dimension] /= static_cast<double>(p_end - p_begin);
+    }
+
+    double radius = 0.0;
+    for (std::size_t position = p_begin; position < p_end; position++) {
+        radius = std::max(radius, m_metric.distance(center, p_data[p_order[position]], dimension));
+    }
+
+    m_nodes[index_node].m_radius = radius;
+
+    if ( (p_end - p_begin <= m_bucket_size) || (radius == 0.0) ) {
+        return index_node;
+    }
+
+    std::size_t discriminator = 0;
+    double largest_spread = -1.0;
+
+    for (std::size_t index_dimension = 0; index_dimension < dimension; index_dimension++) {
+        double minimum = p_data[p_order[p_begin]][index_dimension];
+        double maximum = minimum;
+
+        for (std::size_t position = p_begin + 1; position < p_end; position++) {
+            const double value = p_data[p_order[position]][index_dimension];
+            minimum = std::min(minimum, value);
+            maximum = std::max(maximum, value);
+        }
+
+        if (maximum - minimum > largest_spread) {
+            largest_spread = maximum - minimum;
+            discriminator = index_dimension;
+        }
+    }
+
+    const std::size_t middle = p_begin + (p_end - p_begin) / 2;
+    std::nth_element(p_order.begin() + p_begin, p_order.begin() + middle, p_order.begin() + p_end,
+        [&p_data, discriminator](const std::size_t p_index1, const std::size_t p_index2) {
+            return p_data[p_index1][discriminator] < p_data[p_index2][discriminator];
+        });
+
+    create_node(p_order, p_begin, middle, p_data);
+    const std::size_t index_right = create_node(p_order, middle, p_end, p_data);
+    m_nodes[index_node].m_right = index_right;
+
+    return index_node;
+}
+
+
+template <typename TypeMetric>
+double basic_ball_tree<TypeMetric>::lower_bound(const double * p_point, const std::size_t p_index_node) const {
+    const std::size_t dimension = m_points.dimension();
+    const double center_distance = m_metric.distance(p_point, m_centers.data() + p_index_node * dimension, dimension);
+    const double radius = m_nodes[p_index_node].m_radius;
+
+    const double bound = center_distance - radius - BOUND_ROUNDING_ERROR * (center_distance + radius);
+    return m_metric.to_comparable(std::max(0.0, bound));
+}
+
+
+template <typename TypeMetric>
+std::size_t basic_ball_tree<TypeMetric>::find_radius(const double * p_point, const double p_radius, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) const {
+    p_indexes.clear();
+    p_distances.clear();
+
+    search_buffer buffer;
+    return find_radius(p_point, p_radius, buffer, p_indexes, p_distances);
+}
+
+
+template <typename TypeMetric>
+std::size_t basic_ball_tree<TypeMetric>::find_nearest(const double * p_point, const std::size_t p_amount, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) const {
+    p_indexes.clear();
+    p_distances.clear();
+
+    search_buffer buffer;
+    return find_nearest(p_point, p_amount, buffer, p_indexes, p_distances);
+}
+
+
+template <typename TypeMetric>
+neighbor_lists basic_ball_tree<TypeMetric>::find_radius(const dataset_view & p_queries, const double p_radius) const {
+    return neighbor_lists::create(p_queries.size(), []() { return search_buffer(); },
+        [this, &p_queries, p_radius](search_buffer & p_buffer, const std::size_t p_index, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) {
+            find_radius(p_queries[p_index], p_radius, p_buffer, p_indexes, p_distances);
+        });
+}
+
+
+template <typename TypeMetric>
+neighbor_lists basic_ball_tree<TypeMetric>::find_nearest(const dataset_view & p_queries, const std::size_t p_amount) const {
+    return neighbor_lists::create(p_queries.size(), []() { return search_buffer(); },
+        [this, &p_queries, p_amount](search_buffer & p_buffer, const std::size_t p_index, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) {
+            find_nearest(p_queries[p_index], p_amount, p_buffer, p_indexes, p_distances);
+        });
+}
+
+
+template <typename TypeMetric>
+std::size_t basic_ball_tree<TypeMetric>::find_radius(const double * p_point, const double p_radius, search_buffer & p_buffer, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) const {
+    if (m_nodes.empty()) {
+        return 0;
+    }
+
+    const std::size_t dimension = m_points.dimension();
+    std::size_t calculated_distances = 0;
+
+    std::vector<std::size_t> & stack = p_buffer.m_stack;
+    stack.clear();
+    stack.push_back(0);
+
+    while (!stack.empty()) {
+        const std::size_t index_current = stack.back();
+        stack.pop_back();
+
+        calculated_distances++;
+        if (lower_bound(p_point, index_current) > p_radius) {
+            continue;
+        }
+
+        const node & current = m_nodes[index_current];
+        if (current.m_right == 0) {
+            calculated_distances += current.m_end - current.m_begin;
+
+            for (std::size_t position = current.m_begin; position < current.m_end; position++) {
+                const double distance = m_metric.comparable_distance(p_point, m_points[position], dimension);
+                if (distance <= p_radius) {
+                    p_indexes.push_back(m_indexes[position]);
+                    p_distances.push_back(distance);
+                }
+            }
+        }
+        else {
+            stack.push_back(current.m_right);
+            stack.push_back(index_current + 1);
+        }
+    }
+
+    return calculated_distances;
+}
+
+
+template <typename TypeMetric>
+std::size_t basic_ball_tree<TypeMetric>::find_nearest(const double * p_point, const std::size_t p_amount, search_buffer & p_buffer, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) const {
+    if (m_nodes.empty() || (p_amount == 0)) {
+        return 0;
+    }
+
+    const std::size_t dimension = m_points.dimension();
+    std::size_t calculated_distances = 1;
+
+    std::vector<candidate> & heap = p_buffer.m_heap;      /* max-heap where the farthest candidate is on the top */
+    heap.clear();
+
+    /* each node is stored with lower bound of distance to its points */
+    std::vector<candidate> & stack = p_buffer.m_bounded_stack;
+    stack.clear();
+    stack.emplace_back(lower_bound(p_point, 0), 0);
+
+    while (!stack.empty()) {
+        const candidate subtree = stack.back();
+        stack.pop_back();
+
+        if ( (heap.size() == p_amount) && (subtree.first > heap.front().first) ) {
+            continue;
+        }
+
+        const node & current = m_nodes[subtree.second];
+        if (current.m_right == 0) {
+            calculated_distances += current.m_end - current.m_begin;
+
+            for (std::size_t position = current.m_begin; position < current.m_end; position++) {
+                const candidate point(m_metric.comparable_distance(p_point, m_points[position], dimension), m_indexes[position]);
+                if (heap.size() < p_amount) {
+                    heap.push_back(point);
+                    std::push_heap(heap.begin(), heap.end());
+                }
+                else if (point < heap.front()) {
+                    std::pop_heap(heap.begin(), heap.end());
+                    heap.back() = point;
+                    std::push_heap(heap.begin(), heap.end());
+                }
+            }
+        }
+        else {
+            const candidate left(lower_bound(p_point, subtree.second + 1), subtree.second + 1);
+            const candidate right(lower_bound(p_point, current.m_right), current.m_right);
+            calculated_distances += 2;
+
+            /* the closest child is processed first, so bound becomes tight before the farthest one */
+            if (left.first < right.first) {
+                stack.push_back(right);
+                stack.push_back(left);
+            }
+            else {
+                stack.push_back(left);
+                stack.push_back(right);
+            }
+        }
+    }
+
+    std::sort_heap(heap.begin(), heap.end());
+    for (const auto & point : heap) {
+        p_distances.push_back(point.first);
+        p_indexes.push_back(point.second);
+    }
+
+    return calculated_distances;
+}
+
+
+template class basic_ball_tree<utils::metric::euclidean>;
+template class basic_ball_tree<utils::metric::euclidean_square>;
+template class basic_ball_tree<utils::metric::manhattan>;
+template class basic_ball_tree<utils::metric::chebyshev>;
+template class basic_ball_tree<utils::metric::minkowski>;
+template class basic_ball_tree<utils::metric::cosine>;
+
+
+}
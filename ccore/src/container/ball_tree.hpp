@@ -0,0 +1,266 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#ifndef SRC_CONTAINER_BALL_TREE_HPP_
+#define SRC_CONTAINER_BALL_TREE_HPP_
+
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "container/neighbor_lists.hpp"
+
+#include "definitions.hpp"
+
+#include "utils/metric.hpp"
+
+
+namespace container {
+
+
+/**
+*
+* @brief    Static ball tree (metric tree) that is intended for radius and k-nearest neighbor
+*           queries in data of high dimension where KD-tree does not prune search space.
+* @details  Each node is a ball - center of its points and the largest distance from the center to
+*           them. Distance from a query point to points of the ball is not less than distance to
+*           the center minus radius of the ball due to triangle inequality, so the tree is suitable
+*           only for metrics that satisfy it. Nodes are stored in one array in depth-first order
+*           (left child follows its parent), points are reordered so points of each leaf are placed
+*           contiguously. Queries have the same form as queries of 'static_kdtree' and the tree is
+*           safe for concurrent queries.
+*
+*/
+template <typename TypeMetric>
+class basic_ball_tree {
+public:
+    /**
+    *
+    * @brief    Default maximum amount of points in a leaf.
+    *
+    */
+    static const std::size_t DEFAULT_BUCKET_SIZE;
+
+    /**
+    *
+    * @brief    Amount of points starting from which search by the tree is faster than comparison
+    *           of a point with all other points.
+    *
+    */
+    static const std::size_t MINIMUM_SIZE;
+
+private:
+    using candidate = std::pair<double, std::size_t>;
+
+    struct node {
+        double          m_radius        = 0.0;      /* the largest distance from the center to points of the node */
+        std::size_t     m_begin         = 0;
+        std::size_t     m_end           = 0;
+        std::size_t     m_right         = 0;        /* index of right child, zero for leaf */
+    };
+
+public:
+    /**
+    *
+    * @brief    Scratch memory of queries, it is reused by consecutive queries of one thread to
+    *           avoid allocation per query. Buffer should not be shared between threads.
+    *
+    */
+    struct search_buffer {
+        std::vector<std::size_t>    m_stack;
+        std::vector<candidate>      m_heap;
+        std::vector<candidate>      m_bounded_stack;
+    };
+
+private:
+    std::vector<node>           m_nodes;
+    std::vector<double>         m_centers;          /* center of node 'i' starts from 'i * dimension' */
+    dataset_matrix              m_points;           /* points in order of leaves */
+    std::vector<std::size_t>    m_indexes;          /* index of point in input data for each position */
+    TypeMetric                  m_metric;
+    std::size_t                 m_bucket_size       = 0;
+
+public:
+    /**
+    *
+    * @brief    Default constructor that creates tree without points.
+    *
+    */
+    basic_ball_tree(void) = default;
+
+    /**
+    *
+    * @brief    Builds tree for the specified points, they are copied to the tree.
+    * @details  Each node is split by median of coordinate with the largest spread of values.
+    *
+    * @param[in] p_data: points for that tree is built.
+    * @param[in] p_metric: metric that is used to build balls and to search neighbors.
+    * @param[in] p_bucket_size: maximum amount of points in a leaf.
+    *
+    */
+    explicit basic_ball_tree(const dataset_view & p_data, const TypeMetric & p_metric = TypeMetric(), const std::size_t p_bucket_size = DEFAULT_BUCKET_SIZE);
+
+    basic_ball_tree(const basic_ball_tree & p_other) = default;
+
+    basic_ball_tree(basic_ball_tree && p_other) = default;
+
+    ~basic_ball_tree(void) = default;
+
+public:
+    /**
+    *
+    * @brief    Returns true if the tree can be built for the metric (it satisfies triangle inequality).
+    *
+    * @param[in] p_metric: metric that is used to calculate distance between points.
+    *
+    */
+    static bool is_suitable(const TypeMetric & p_metric);
+
+    /**
+    *
+    * @brief    Returns amount of points in the tree.
+    *
+    */
+    std::size_t size(void) const;
+
+    /**
+    *
+    * @brief    Returns amount of coordinates of each point.
+    *
+    */
+    std::size_t dimension(void) const;
+
+    /**
+    *
+    * @brief    Returns amount of nodes (including leaves) in the tree.
+    *
+    */
+    std::size_t amount_nodes(void) const;
+
+    /**
+    *
+    * @brief    Finds all points whose distance to the specified point is less or equal to radius.
+    *
+    * @param[in]  p_point: point for that neighbors are searched, it has dimension of the tree.
+    * @param[in]  p_radius: radius of search in comparable form of the metric.
+    * @param[out] p_indexes: indexes of found points in input data (in arbitrary order).
+    * @param[out] p_distances: distances to found points in comparable form of the metric.
+    *
+    * @return   Returns amount of calculated distances (to points and to centers of nodes).
+    *
+    */
+    std::size_t find_radius(const double * p_point, const double p_radius, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) const;
+
+    /**
+    *
+    * @brief    Finds all points whose distance to the specified point is less or equal to radius
+    *           using scratch memory of the caller.
+    *
+    * @param[in]  p_point: point for that neighbors are searched, it has dimension of the tree.
+    * @param[in]  p_radius: radius of search in comparable form of the metric.
+    * @param[in]  p_buffer: scratch memory that is reused between queries.
+    * @param[out] p_indexes: indexes of found points in input data are appended to it.
+    * @param[out] p_distances: distances to found points in comparable form of the metric are
+    *              appended to it.
+    *
+    * @return   Returns amount of calculated distances (to points and to centers of nodes).
+    *
+    */
+    std::size_t find_radius(const double * p_point, const double p_radius, search_buffer & p_buffer, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) const;
+
+    /**
+    *
+    * @brief    Finds the specified amount of points that are the closest to the specified point.
+    * @details  Points with equal distance are ordered by index.
+    *
+    * @param[in]  p_point: point for that neighbors are searched, it has dimension of the tree.
+    * @param[in]  p_amount: amount of neighbors that should be found.
+    * @param[out] p_indexes: indexes of found points in input data sorted by distance.
+    * @param[out] p_distances: distances to found points in comparable form of the metric.
+    *
+    * @return   Returns amount of calculated distances (to points and to centers of nodes).
+    *
+    */
+    std::size_t find_nearest(const double * p_point, const std::size_t p_amount, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) const;
+
+    /**
+    *
+    * @brief    Finds the specified amount of points that are the closest to the specified point
+    *           using scratch memory of the caller.
+    *
+    * @param[in]  p_point: point for that neighbors are searched, it has dimension of the tree.
+    * @param[in]  p_amount: amount of neighbors that should be found.
+    * @param[in]  p_buffer: scratch memory that is reused between queries.
+    * @param[out] p_indexes: indexes of found points sorted by distance are appended to it.
+    * @param[out] p_distances: distances to found points in comparable form of the metric are
+    *              appended to it.
+    *
+    * @return   Returns amount of calculated distances (to points and to centers of nodes).
+    *
+    */
+    std::size_t find_nearest(const double * p_point, const std::size_t p_amount, search_buffer & p_buffer, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) const;
+
+    /**
+    *
+    * @brief    Finds points in radius of each query point using threads of the global pool.
+    *
+    * @param[in] p_queries: points for that neighbors are searched, they have dimension of the tree.
+    * @param[in] p_radius: radius of search in comparable form of the metric.
+    *
+    * @return   Returns indexes of found points (in arbitrary order) and comparable distances to
+    *           them for each query.
+    *
+    */
+    neighbor_lists find_radius(const dataset_view & p_queries, const double p_radius) const;
+
+    /**
+    *
+    * @brief    Finds the specified amount of the closest points to each query point using threads
+    *           of the global pool.
+    *
+    * @param[in] p_queries: points for that neighbors are searched, they have dimension of the tree.
+    * @param[in] p_amount: amount of neighbors that should be found for each query.
+    *
+    * @return   Returns indexes of found points sorted by distance and comparable distances to them
+    *           for each query.
+    *
+    */
+    neighbor_lists find_nearest(const dataset_view & p_queries, const std::size_t p_amount) const;
+
+private:
+    std::size_t create_node(std::vector<std::size_t> & p_order, const std::size_t p_begin, const std::size_t p_end, const dataset_view & p_data);
+
+    double lower_bound(const double * p_point, const std::size_t p_index_node) const;
+};
+
+
+/**
+*
+* @brief    Ball tree that uses Euclidean distance.
+*
+*/
+using ball_tree = basic_ball_tree<utils::metric::euclidean>;
+
+
+}
+
+
+#endif
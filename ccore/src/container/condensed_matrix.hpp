@@ -0,0 +1,247 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#ifndef SRC_CONTAINER_CONDENSED_MATRIX_HPP_
+#define SRC_CONTAINER_CONDENSED_MATRIX_HPP_
+
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+namespace container {
+
+
+/**
+*
+* @brief    Symmetric square matrix with constant diagonal where only elements above the diagonal
+*           are stored (condensed form).
+* @details  Element (i, j), i < j, is placed at position 'i * (2n - i - 1) / 2 + (j - i - 1)', so
+*           elements of the upper part of each row are stored contiguously. The matrix requires
+*           n * (n - 1) / 2 elements instead of n * n, type of elements can be 'float' to halve
+*           memory once again. It is intended for distances between objects.
+*
+*/
+template <typename TypeValue>
+class condensed_matrix {
+public:
+    using value_type = TypeValue;
+
+private:
+    std::vector<value_type>     m_data;
+    std::size_t                 m_size      = 0;
+    value_type                  m_diagonal  = value_type();
+
+public:
+    /**
+    *
+    * @brief    Default constructor that creates empty matrix.
+    *
+    */
+    condensed_matrix(void) = default;
+
+    /**
+    *
+    * @brief    Creates matrix with specified size where each element is equal to initial value.
+    *
+    * @param[in] p_size: amount of rows (and columns) of the matrix.
+    * @param[in] p_value: initial value of elements that are not placed on the diagonal.
+    * @param[in] p_diagonal: value of diagonal elements.
+    *
+    */
+    explicit condensed_matrix(const std::size_t p_size, const value_type p_value = value_type(), const value_type p_diagonal = value_type()) :
+        m_data(p_size * (p_size - ((p_size > 0) ? 1 : 0)) / 2, p_value),
+        m_size(p_size),
+        m_diagonal(p_diagonal)
+    { }
+
+    condensed_matrix(const condensed_matrix & p_other) = default;
+
+    condensed_matrix(condensed_matrix && p_other) = default;
+
+    ~condensed_matrix(void) = default;
+
+public:
+    /**
+    *
+    * @brief    Returns amount of rows (and columns) of the matrix.
+    *
+    */
+    inline std::size_t size(void) const { return m_size; }
+
+    /**
+    *
+    * @brief    Returns true if the matrix does not have any row.
+    *
+    */
+    inline bool empty(void) const { return m_size == 0; }
+
+    /**
+    *
+    * @brief    Returns amount of elements that are stored (elements above the diagonal).
+    *
+    */
+    inline std::size_t elements(void) const { return m_data.size(); }
+
+    /**
+    *
+    * @brief    Returns element (i, j) of the matrix.
+    *
+    * @param[in] p_row: index of the row.
+    * @param[in] p_column: index of the column.
+    *
+    */
+    inline value_type get(const std::size_t p_row, const std::size_t p_column) const {
+        if (p_row == p_column) {
+            return m_diagonal;
+        }
+
+        return (p_row < p_column) ? m_data[position(p_row, p_column)] : m_data[position(p_column, p_row)];
+    }
+
+    /**
+    *
+    * @brief    Sets elements (i, j) and (j, i) of the matrix.
+    * @details  Diagonal elements are not stored, exception 'std::invalid_argument' is thrown if
+    *           diagonal element is specified.
+    *
+    * @param[in] p_row: index of the row.
+    * @param[in] p_column: index of the column.
+    * @param[in] p_value: new value of elements.
+    *
+    */
+    inline void set(const std::size_t p_row, const std::size_t p_column, const value_type p_value) {
+        if (p_row == p_column) {
+            throw std::invalid_argument("CCORE [condensed_matrix]: diagonal elements can not be changed.");
+        }
+
+        if (p_row < p_column) {
+            m_data[position(p_row, p_column)] = p_value;
+        }
+        else {
+            m_data[position(p_column, p_row)] = p_value;
+        }
+    }
+
+    /**
+    *
+    * @brief    Returns pointer to the stored part of the row - elements (i, i + 1), ..., (i, n - 1)
+    *           that are placed one by one, amount of them is 'n - i - 1'.
+    *
+    * @param[in] p_row: index of the row.
+    *
+    */
+    inline value_type * upper_row(const std::size_t p_row) { return m_data.data() + position(p_row, p_row + 1); }
+
+    /**
+    *
+    * @brief    Returns pointer to the stored part of the row - elements (i, i + 1), ..., (i, n - 1)
+    *           that are placed one by one, amount of them is 'n - i - 1'.
+    *
+    * @param[in] p_row: index of the row.
+    *
+    */
+    inline const value_type * upper_row(const std::size_t p_row) const { return m_data.data() + position(p_row, p_row + 1); }
+
+    /**
+    *
+    * @brief    Calls action for each element of the row except diagonal one in order of columns.
+    *
+    * @param[in] p_row: index of the row.
+    * @param[in] p_action: callable object that takes index of the column and value of the element.
+    *
+    */
+    template <typename TypeAction>
+    void for_each_in_row(const std::size_t p_row, const TypeAction & p_action) const {
+        /* elements below the diagonal are placed in upper parts of previous rows */
+        std::size_t index = p_row - 1;
+        for (std::size_t column = 0; column < p_row; column++) {
+            p_action(column, m_data[index]);
+            index += m_size - column - 2;
+        }
+
+        const value_type * row = upper_row(p_row);
+        for (std::size_t column = p_row + 1; column < m_size; column++) {
+            p_action(column, row[column - p_row - 1]);
+        }
+    }
+
+    /**
+    *
+    * @brief    Copies the specified row (including diagonal element) to the output array.
+    *
+    * @param[in]  p_row: index of the row.
+    * @param[out] p_result: array with size that is not less than size of the matrix.
+    *
+    */
+    inline void get_row(const std::size_t p_row, value_type * const p_result) const {
+        for_each_in_row(p_row, [p_result](const std::size_t p_column, const value_type p_value) { p_result[p_column] = p_value; });
+        p_result[p_row] = m_diagonal;
+    }
+
+    /**
+    *
+    * @brief    Assigns value to all elements that are not placed on the diagonal.
+    *
+    * @param[in] p_value: new value of elements.
+    *
+    */
+    inline void fill(const value_type p_value) { std::fill(m_data.begin(), m_data.end(), p_value); }
+
+    /**
+    *
+    * @brief    Returns pointer to the condensed elements.
+    *
+    */
+    inline value_type * data(void) { return m_data.data(); }
+
+    /**
+    *
+    * @brief    Returns pointer to the condensed elements.
+    *
+    */
+    inline const value_type * data(void) const { return m_data.data(); }
+
+public:
+    /**
+    *
+    * @brief    Returns element (i, j) of the matrix.
+    *
+    */
+    inline value_type operator()(const std::size_t p_row, const std::size_t p_column) const { return get(p_row, p_column); }
+
+    condensed_matrix & operator=(const condensed_matrix & p_other) = default;
+
+    condensed_matrix & operator=(condensed_matrix && p_other) = default;
+
+private:
+    inline std::size_t position(const std::size_t p_row, const std::size_t p_column) const {
+        return p_row * (2 * m_size - p_row - 1) / 2 + (p_column - p_row - 1);
+    }
+};
+
+
+}
+
+
+#endif
@@ -0,0 +1,386 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#ifndef SRC_CONTAINER_DENSE_MATRIX_HPP_
+#define SRC_CONTAINER_DENSE_MATRIX_HPP_
+
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+
+namespace container {
+
+
+/**
+*
+* @brief    Non-owning row-major view to a contiguous block of points.
+* @details  Point with index 'i' starts at 'data() + i * stride()', coordinates of the point are
+*           stored one by one. The view never frees the block, so the owner of the memory should
+*           keep it alive while the view is in use.
+*
+*/
+template <typename TypeValue>
+class dense_matrix_view {
+public:
+    using value_type = TypeValue;
+
+private:
+    const value_type    * m_data        = nullptr;
+    std::size_t         m_size          = 0;
+    std::size_t         m_dimension     = 0;
+    std::size_t         m_stride        = 0;
+
+public:
+    /**
+    *
+    * @brief    Default constructor that creates empty view.
+    *
+    */
+    dense_matrix_view(void) = default;
+
+    /**
+    *
+    * @brief    Creates view to the specified memory block.
+    *
+    * @param[in] p_data: pointer to the first coordinate of the first point.
+    * @param[in] p_size: amount of points in the block.
+    * @param[in] p_dimension: amount of coordinates of each point.
+    * @param[in] p_stride: distance in elements between beginnings of neighbor points, if it is
+    *             zero then points are considered as densely packed ('p_stride' = 'p_dimension').
+    *
+    */
+    dense_matrix_view(const value_type * p_data, const std::size_t p_size, const std::size_t p_dimension, const std::size_t p_stride = 0) :
+        m_data(p_data),
+        m_size(p_size),
+        m_dimension(p_dimension),
+        m_stride((p_stride == 0) ? p_dimension : p_stride)
+    {
+        if (m_stride < m_dimension) {
+            throw std::invalid_argument("CCORE [dense_matrix_view]: stride can not be less than dimension.");
+        }
+    }
+
+    dense_matrix_view(const dense_matrix_view & p_other) = default;
+
+    dense_matrix_view(dense_matrix_view && p_other) = default;
+
+    ~dense_matrix_view(void) = default;
+
+public:
+    /**
+    *
+    * @brief    Returns amount of points in the view.
+    *
+    */
+    inline std::size_t size(void) const { return m_size; }
+
+    /**
+    *
+    * @brief    Returns amount of coordinates of each point.
+    *
+    */
+    inline std::size_t dimension(void) const { return m_dimension; }
+
+    /**
+    *
+    * @brief    Returns distance in elements between beginnings of neighbor points.
+    *
+    */
+    inline std::size_t stride(void) const { return m_stride; }
+
+    /**
+    *
+    * @brief    Returns true if there is no any point in the view.
+    *
+    */
+    inline bool empty(void) const { return m_size == 0; }
+
+    /**
+    *
+    * @brief    Returns pointer to the first coordinate of the first point.
+    *
+    */
+    inline const value_type * data(void) const { return m_data; }
+
+    /**
+    *
+    * @brief    Copies coordinates of the specified point to the output container.
+    *
+    * @param[in]  p_index: index of the point in the view.
+    * @param[out] p_point: container where coordinates are placed.
+    *
+    */
+    inline void get_point(const std::size_t p_index, std::vector<value_type> & p_point) const {
+        const value_type * row = (*this)[p_index];
+        p_point.assign(row, row + m_dimension);
+    }
+
+public:
+    /**
+    *
+    * @brief    Returns pointer to the first coordinate of the specified point.
+    *
+    * @param[in] p_index: index of the point in the view.
+    *
+    */
+    inline const value_type * operator[](const std::size_t p_index) const { return m_data + p_index * m_stride; }
+
+    dense_matrix_view & operator=(const dense_matrix_view & p_other) = default;
+
+    dense_matrix_view & operator=(dense_matrix_view && p_other) = default;
+};
+
+
+/**
+*
+* @brief    Owning row-major storage of points where all coordinates are placed in one contiguous
+*           aligned memory block.
+* @details  Points are densely packed (stride is equal to dimension), beginning of the block is
+*           aligned to 'ALIGNMENT' bytes for vector loads. In comparison with vector of vectors
+*           it requires only one allocation for whole dataset.
+*
+*/
+template <typename TypeValue>
+class dense_matrix {
+public:
+    using value_type    = TypeValue;
+    using view_type     = dense_matrix_view<TypeValue>;
+
+public:
+    static const std::size_t ALIGNMENT = 64;
+
+private:
+    std::unique_ptr<unsigned char []>   m_memory    = nullptr;
+    value_type                          * m_data    = nullptr;
+    std::size_t                         m_size      = 0;
+    std::size_t                         m_dimension = 0;
+
+public:
+    /**
+    *
+    * @brief    Default constructor that creates empty matrix.
+    *
+    */
+    dense_matrix(void) = default;
+
+    /**
+    *
+    * @brief    Creates matrix with specified amount of points where each coordinate is equal to
+    *           initial value.
+    *
+    * @param[in] p_size: amount of points.
+    * @param[in] p_dimension: amount of coordinates of each point.
+    * @param[in] p_value: initial value of coordinates.
+    *
+    */
+    dense_matrix(const std::size_t p_size, const std::size_t p_dimension, const value_type p_value = value_type()) {
+        allocate(p_size, p_dimension);
+        std::fill(m_data, m_data + m_size * m_dimension, p_value);
+    }
+
+    /**
+    *
+    * @brief    Creates matrix by copying points from nested vectors.
+    *
+    * @param[in] p_data: points that should be copied, all of them should have the same dimension.
+    *
+    */
+    explicit dense_matrix(const std::vector< std::vector<value_type> > & p_data) {
+        allocate(p_data.size(), p_data.empty() ? 0 : p_data[0].size());
+
+        value_type * row = m_data;
+        for (const auto & point : p_data) {
+            if (point.size() != m_dimension) {
+                throw std::invalid_argument("CCORE [dense_matrix]: all points should have the same dimension.");
+            }
+
+            std::copy(point.begin(), point.end(), row);
+            row += m_dimension;
+        }
+    }
+
+    /**
+    *
+    * @brief    Creates matrix by copying points from the view (stride of the view is removed).
+    *
+    * @param[in] p_view: points that should be copied.
+    *
+    */
+    explicit dense_matrix(const view_type & p_view) {
+        allocate(p_view.size(), p_view.dimension());
+
+        for (std::size_t index = 0; index < m_size; index++) {
+            std::copy(p_view[index], p_view[index] + m_dimension, (*this)[index]);
+        }
+    }
+
+    dense_matrix(const dense_matrix & p_other) : dense_matrix(p_other.view()) { }
+
+    dense_matrix(dense_matrix && p_other) :
+        m_memory(std::move(p_other.m_memory)),
+        m_data(p_other.m_data),
+        m_size(p_other.m_size),
+        m_dimension(p_other.m_dimension)
+    {
+        p_other.m_data = nullptr;
+        p_other.m_size = 0;
+        p_other.m_dimension = 0;
+    }
+
+    ~dense_matrix(void) = default;
+
+public:
+    /**
+    *
+    * @brief    Returns amount of points in the matrix.
+    *
+    */
+    inline std::size_t size(void) const { return m_size; }
+
+    /**
+    *
+    * @brief    Returns amount of coordinates of each point.
+    *
+    */
+    inline std::size_t dimension(void) const { return m_dimension; }
+
+    /**
+    *
+    * @brief    Returns true if there is no any point in the matrix.
+    *
+    */
+    inline bool empty(void) const { return m_size == 0; }
+
+    /**
+    *
+    * @brief    Returns pointer to the first coordinate of the first point.
+    *
+    */
+    inline value_type * data(void) { return m_data; }
+
+    /**
+    *
+    * @brief    Returns pointer to the first coordinate of the first point.
+    *
+    */
+    inline const value_type * data(void) const { return m_data; }
+
+    /**
+    *
+    * @brief    Returns non-owning view to the matrix that is valid while the matrix is alive.
+    *
+    */
+    inline view_type view(void) const { return view_type(m_data, m_size, m_dimension); }
+
+    /**
+    *
+    * @brief    Converts points of the matrix to nested vectors.
+    *
+    * @param[out] p_data: container where points are placed.
+    *
+    */
+    inline void get_points(std::vector< std::vector<value_type> > & p_data) const {
+        p_data.resize(m_size);
+        for (std::size_t index = 0; index < m_size; index++) {
+            p_data[index].assign((*this)[index], (*this)[index] + m_dimension);
+        }
+    }
+
+public:
+    /**
+    *
+    * @brief    Returns pointer to the first coordinate of the specified point.
+    *
+    * @param[in] p_index: index of the point in the matrix.
+    *
+    */
+    inline value_type * operator[](const std::size_t p_index) { return m_data + p_index * m_dimension; }
+
+    /**
+    *
+    * @brief    Returns pointer to the first coordinate of the specified point.
+    *
+    * @param[in] p_index: index of the point in the matrix.
+    *
+    */
+    inline const value_type * operator[](const std::size_t p_index) const { return m_data + p_index * m_dimension; }
+
+    /**
+    *
+    * @brief    Returns non-owning view to the matrix.
+    *
+    */
+    inline operator view_type(void) const { return view(); }
+
+    dense_matrix & operator=(const dense_matrix & p_other) {
+        if (this != &p_other) {
+            dense_matrix copy(p_other);
+            *this = std::move(copy);
+        }
+
+        return *this;
+    }
+
+    dense_matrix & operator=(dense_matrix && p_other) {
+        if (this != &p_other) {
+            m_memory = std::move(p_other.m_memory);
+            m_data = p_other.m_data;
+            m_size = p_other.m_size;
+            m_dimension = p_other.m_dimension;
+
+            p_other.m_data = nullptr;
+            p_other.m_size = 0;
+            p_other.m_dimension = 0;
+        }
+
+        return *this;
+    }
+
+private:
+    void allocate(const std::size_t p_size, const std::size_t p_dimension) {
+        m_size = p_size;
+        m_dimension = p_dimension;
+
+        const std::size_t length = m_size * m_dimension;
+        if (length == 0) {
+            m_memory = nullptr;
+            m_data = nullptr;
+            return;
+        }
+
+        m_memory.reset(new unsigned char[length * sizeof(value_type) + ALIGNMENT]);
+
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(m_memory.get());
+        const std::uintptr_t aligned_address = (address + ALIGNMENT - 1) & ~(std::uintptr_t) (ALIGNMENT - 1);
+
+        m_data = reinterpret_cast<value_type *>(aligned_address);
+    }
+};
+
+
+}
+
+
+#endif
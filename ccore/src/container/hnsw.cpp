@@ -0,0 +1,511 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#include "container/hnsw.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+
+namespace container {
+
+
+/* marks the end of chain of duplicates */
+static const std::size_t NO_DUPLICATE = std::numeric_limits<std::size_t>::max();
+
+
+/* metrics without parameters are equal if they have the same type */
+template <typename TypeMetric>
+static bool is_same_metric(const TypeMetric &, const TypeMetric &) {
+    return true;
+}
+
+
+static bool is_same_metric(const utils::metric::minkowski & p_left, const utils::metric::minkowski & p_right) {
+    return p_left.get_degree() == p_right.get_degree();
+}
+
+
+template <typename TypeMetric>
+basic_hnsw<TypeMetric>::basic_hnsw(const dataset_view & p_data, const hnsw_parameters & p_parameters, const TypeMetric & p_metric) :
+    m_points(p_data),
+    m_parameters(p_parameters),
+    m_metric(p_metric)
+{
+    if (p_parameters.m_connections < 2) {
+        throw std::invalid_argument("CCORE [hnsw]: amount of connections should be at least 2.");
+    }
+
+    m_parameters.m_construction_candidates = std::max(p_parameters.m_construction_candidates, p_parameters.m_connections);
+    m_parameters.m_search_candidates = std::max(p_parameters.m_search_candidates, std::size_t(1));
+
+    m_base_capacity = 2 * m_parameters.m_connections;
+    m_links.resize(p_data.size() * m_base_capacity);
+    m_degrees.assign(p_data.size(), 0);
+    m_upper_links.resize(p_data.size());
+    m_duplicates.assign(p_data.size(), NO_DUPLICATE);
+
+    std::default_random_engine generator(m_parameters.m_seed);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+    /* probability that node belongs to the next layer is equal to 1 / connections */
+    const double layer_multiplier = 1.0 / std::log(static_cast<double>(m_parameters.m_connections));
+
+    search_buffer buffer;
+    for (std::size_t index = 0; index < p_data.size(); index++) {
+        const std::size_t layer = static_cast<std::size_t>(-std::log(1.0 - distribution(generator)) * layer_multiplier);
+        m_upper_links[index].resize(layer);
+
+        insert(index, layer, buffer);
+    }
+}
+
+
+template <typename TypeMetric>
+std::size_t basic_hnsw<TypeMetric>::size(void) const {
+    return m_points.size();
+}
+
+
+template <typename TypeMetric>
+std::size_t basic_hnsw<TypeMetric>::dimension(void) const {
+    return m_points.dimension();
+}
+
+
+template <typename TypeMetric>
+dataset_view basic_hnsw<TypeMetric>::points(void) const {
+    return m_points.view();
+}
+
+
+template <typename TypeMetric>
+const TypeMetric & basic_hnsw<TypeMetric>::metric(void) const {
+    return m_metric;
+}
+
+
+template <typename TypeMetric>
+bool basic_hnsw<TypeMetric>::is_built_with(const TypeMetric & p_metric) const {
+    return is_same_metric(m_metric, p_metric);
+}
+
+
+template <typename TypeMetric>
+const hnsw_parameters & basic_hnsw<TypeMetric>::parameters(void) const {
+    return m_parameters;
+}
+
+
+template <typename TypeMetric>
+void basic_hnsw<TypeMetric>::set_search_candidates(const std::size_t p_search_candidates) {
+    m_parameters.m_search_candidates = std::max(p_search_candidates, std::size_t(1));
+}
+
+
+template <typename TypeMetric>
+std::size_t basic_hnsw<TypeMetric>::find_radius(const double * p_point, const double p_radius, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) const {
+    p_indexes.clear();
+    p_distances.clear();
+
+    search_buffer buffer;
+    return find_radius(p_point, p_radius, buffer, p_indexes, p_distances);
+}
+
+
+template <typename TypeMetric>
+std::size_t basic_hnsw<TypeMetric>::find_nearest(const double * p_point, const std::size_t p_amount, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) const {
+    p_indexes.clear();
+    p_distances.clear();
+
+    search_buffer buffer;
+    return find_nearest(p_point, p_amount, buffer, p_indexes, p_distances);
+}
+
+
+template <typename TypeMetric>
+neighbor_lists basic_hnsw<TypeMetric>::find_radius(const dataset_view & p_queries, const double p_radius) const {
+    return neighbor_lists::create(p_queries.size(), []() { return search_buffer(); },
+        [this, &p_queries, p_radius](search_buffer & p_buffer, const std::size_t p_index, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) {
+            find_radius(p_queries[p_index], p_radius, p_buffer, p_indexes, p_distances);
+        });
+}
+
+
+template <typename TypeMetric>
+neighbor_lists basic_hnsw<TypeMetric>::find_nearest(const dataset_view & p_queries, const std::size_t p_amount) const {
+    return neighbor_lists::create(p_queries.size(), []() { return search_buffer(); },
+        [this, &p_queries, p_amount](search_buffer & p_buffer, const std::size_t p_index, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) {
+            find_nearest(p_queries[p_index], p_amount, p_buffer, p_indexes, p_distances);
+        });
+}
+
+
+template <typename TypeMetric>
+void basic_hnsw<TypeMetric>::insert(const std::size_t p_index, const std::size_t p_layer, search_buffer & p_buffer) {
+    if (p_index == 0) {
+        m_entry = 0;
+        m_top_layer = p_layer;
+        return;
+    }
+
+    const double * const point = m_points[p_index];
+
+    std::size_t calculated_distances = 0;
+    std::size_t entry = descend(point, p_layer, calculated_distances);
+
+    std::vector<candidate> candidates;
+    for (std::size_t layer = std::min(p_layer, m_top_layer) + 1; layer-- > 0; ) {
+        search_layer(point, entry, layer, m_parameters.m_construction_candidates, p_buffer, calculated_distances);
+
+        candidates = p_buffer.m_results;
+        entry = candidates.front().second;
+
+        if ( (candidates.front().first == 0.0) && (layer == std::min(p_layer, m_top_layer)) ) {
+            /* the point is equal to the node that is already linked */
+            m_duplicates[p_index] = m_duplicates[entry];
+            m_duplicates[entry] = p_index;
+            m_upper_links[p_index].clear();
+            return;
+        }
+
+        const std::size_t amount = select_links(candidates, m_parameters.m_connections);
+        for (std::size_t position = 0; position < amount; position++) {
+            add_link(p_index, candidates[position].second, layer);
+            add_link(candidates[position].second, p_index, layer);
+        }
+    }
+
+    if (p_layer > m_top_layer) {
+        m_entry = p_index;
+        m_top_layer = p_layer;
+    }
+}
+
+
+template <typename TypeMetric>
+std::size_t basic_hnsw<TypeMetric>::select_links(std::vector<candidate> & p_candidates, const std::size_t p_amount) const {
+    /* candidate is skipped if it is closer to already selected one than to the node, so links are
+     * directed to different regions instead of the densest one */
+    std::size_t amount = 0;
+    for (std::size_t position = 0; (position < p_candidates.size()) && (amount < p_amount); position++) {
+        const candidate & current = p_candidates[position];
+
+        bool diverse = true;
+        for (std::size_t index_selected = 0; (index_selected < amount) && diverse; index_selected++) {
+            const double distance = m_metric.comparable_distance(m_points[current.second], m_points[p_candidates[index_selected].second], m_points.dimension());
+            diverse = (distance >= current.first);
+        }
+
+        if (diverse) {
+            p_candidates[amount++] = current;
+        }
+    }
+
+    return amount;
+}
+
+
+template <typename TypeMetric>
+void basic_hnsw<TypeMetric>::add_link(const std::size_t p_index, const std::size_t p_neighbor, const std::size_t p_layer) {
+    const std::size_t capacity = (p_layer == 0) ? m_base_capacity : m_parameters.m_connections;
+    const std::size_t amount = amount_links(p_index, p_layer);
+
+    if (amount < capacity) {
+        if (p_layer == 0) {
+            m_links[p_index * m_base_capacity + amount] = p_neighbor;
+            m_degrees[p_index]++;
+        }
+        else {
+            m_upper_links[p_index][p_layer - 1].push_back(p_neighbor);
+        }
+
+        return;
+    }
+
+    /* node is full - links are selected again among existing ones and the new one */
+    const std::size_t * const links = begin_links(p_index, p_layer);
+    const double * const point = m_points[p_index];
+
+    std::vector<candidate> candidates;
+    candidates.reserve(amount + 1);
+    for (std::size_t position = 0; position < amount; position++) {
+        candidates.emplace_back(m_metric.comparable_distance(point, m_points[links[position]], m_points.dimension()), links[position]);
+    }
+    candidates.emplace_back(m_metric.comparable_distance(point, m_points[p_neighbor], m_points.dimension()), p_neighbor);
+
+    std::sort(candidates.begin(), candidates.end());
+    const std::size_t selected = select_links(candidates, capacity);
+
+    if (p_layer == 0) {
+        for (std::size_t position = 0; position < selected; position++) {
+            m_links[p_index * m_base_capacity + position] = candidates[position].second;
+        }
+        m_degrees[p_index] = selected;
+    }
+    else {
+        std::vector<std::size_t> & upper_links = m_upper_links[p_index][p_layer - 1];
+        upper_links.clear();
+        for (std::size_t position = 0; position < selected; position++) {
+            upper_links.push_back(candidates[position].second);
+        }
+    }
+}
+
+
+template <typename TypeMetric>
+std::size_t basic_hnsw<TypeMetric>::amount_links(const std::size_t p_index, const std::size_t p_layer) const {
+    return (p_layer == 0) ? m_degrees[p_index] : m_upper_links[p_index][p_layer - 1].size();
+}
+
+
+template <typename TypeMetric>
+const std::size_t * basic_hnsw<TypeMetric>::begin_links(const std::size_t p_index, const std::size_t p_layer) const {
+    return (p_layer == 0) ? m_links.data() + p_index * m_base_capacity : m_upper_links[p_index][p_layer - 1].data();
+}
+
+
+template <typename TypeMetric>
+std::size_t basic_hnsw<TypeMetric>::descend(const double * p_point, const std::size_t p_layer, std::size_t & p_calculated_distances) const {
+    std::size_t current = m_entry;
+    double current_distance = m_metric.comparable_distance(p_point, m_points[current], m_points.dimension());
+    p_calculated_distances++;
+
+    for (std::size_t layer = m_top_layer; layer > p_layer; layer--) {
+        bool changed = true;
+        while (changed) {
+            changed = false;
+
+            const std::size_t * const links = begin_links(current, layer);
+            const std::size_t amount = amount_links(current, layer);
+            p_calculated_distances += amount;
+
+            for (std::size_t position = 0; position < amount; position++) {
+                const double distance = m_metric.comparable_distance(p_point, m_points[links[position]], m_points.dimension());
+                if (distance < current_distance) {
+                    current_distance = distance;
+                    current = links[position];
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    return current;
+}
+
+
+template <typename TypeMetric>
+void basic_hnsw<TypeMetric>::search_layer(const double * p_point, const std::size_t p_entry, const std::size_t p_layer, const std::size_t p_amount, search_buffer & p_buffer, std::size_t & p_calculated_distances) const {
+    start_search(p_buffer);
+
+    std::vector<candidate> & candidates = p_buffer.m_candidates;     /* min-heap where the closest candidate is on the top */
+    std::vector<candidate> & results = p_buffer.m_results;           /* max-heap where the farthest result is on the top */
+    candidates.clear();
+    results.clear();
+
+    const candidate entry(m_metric.comparable_distance(p_point, m_points[p_entry], m_points.dimension()), p_entry);
+    p_calculated_distances++;
+
+    p_buffer.m_visited[p_entry] = p_buffer.m_epoch;
+    candidates.push_back(entry);
+    results.push_back(entry);
+
+    while (!candidates.empty()) {
+        std::pop_heap(candidates.begin(), candidates.end(), std::greater<candidate>());
+        const candidate current = candidates.back();
+        candidates.pop_back();
+
+        if ( (results.size() >= p_amount) && (current.first > results.front().first) ) {
+            break;
+        }
+
+        const std::size_t * const links = begin_links(current.second, p_layer);
+        const std::size_t amount = amount_links(current.second, p_layer);
+
+        for (std::size_t position = 0; position < amount; position++) {
+            const std::size_t neighbor = links[position];
+            if (p_buffer.m_visited[neighbor] == p_buffer.m_epoch) {
+                continue;
+            }
+
+            p_buffer.m_visited[neighbor] = p_buffer.m_epoch;
+
+            const double distance = m_metric.comparable_distance(p_point, m_points[neighbor], m_points.dimension());
+            p_calculated_distances++;
+
+            if ( (results.size() < p_amount) || (distance < results.front().first) ) {
+                candidates.emplace_back(distance, neighbor);
+                std::push_heap(candidates.begin(), candidates.end(), std::greater<candidate>());
+
+                results.emplace_back(distance, neighbor);
+                std::push_heap(results.begin(), results.end());
+
+                if (results.size() > p_amount) {
+                    std::pop_heap(results.begin(), results.end());
+                    results.pop_back();
+                }
+            }
+        }
+    }
+
+    std::sort_heap(results.begin(), results.end());
+}
+
+
+template <typename TypeMetric>
+void basic_hnsw<TypeMetric>::start_search(search_buffer & p_buffer) const {
+    if (p_buffer.m_visited.size() != m_points.size()) {
+        p_buffer.m_visited.assign(m_points.size(), 0);
+        p_buffer.m_epoch = 0;
+    }
+
+    p_buffer.m_epoch++;
+    if (p_buffer.m_epoch == 0) {
+        /* marks are reset when counter overflows */
+        std::fill(p_buffer.m_visited.begin(), p_buffer.m_visited.end(), 0);
+        p_buffer.m_epoch = 1;
+    }
+}
+
+
+template <typename TypeMetric>
+std::size_t basic_hnsw<TypeMetric>::find_radius(const double * p_point, const double p_radius, search_buffer & p_buffer, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) const {
+    if (m_points.empty()) {
+        return 0;
+    }
+
+    std::size_t calculated_distances = 0;
+    const std::size_t entry = descend(p_point, 0, calculated_distances);
+    search_layer(p_point, entry, 0, m_parameters.m_search_candidates, p_buffer, calculated_distances);
+
+    /* points in radius are expanded through links, points that have been visited by beam search
+     * but are not in its results are evaluated again, so new marks are used */
+    start_search(p_buffer);
+
+    std::vector<std::size_t> & queue = p_buffer.m_queue;
+    queue.clear();
+
+    for (const auto & result : p_buffer.m_results) {
+        if (result.first > p_radius) {
+            break;
+        }
+
+        p_buffer.m_visited[result.second] = p_buffer.m_epoch;
+        queue.push_back(result.second);
+
+        append_result(p_point, result.second, result.first, p_radius, p_indexes, p_distances, calculated_distances);
+    }
+
+    while (!queue.empty()) {
+        const std::size_t current = queue.back();
+        queue.pop_back();
+
+        const std::size_t * const links = begin_links(current, 0);
+        const std::size_t amount = m_degrees[current];
+
+        for (std::size_t position = 0; position < amount; position++) {
+            const std::size_t neighbor = links[position];
+            if (p_buffer.m_visited[neighbor] == p_buffer.m_epoch) {
+                continue;
+            }
+
+            p_buffer.m_visited[neighbor] = p_buffer.m_epoch;
+
+            const double distance = m_metric.comparable_distance(p_point, m_points[neighbor], m_points.dimension());
+            calculated_distances++;
+
+            if (distance <= p_radius) {
+                queue.push_back(neighbor);
+                append_result(p_point, neighbor, distance, p_radius, p_indexes, p_distances, calculated_distances);
+            }
+        }
+    }
+
+    return calculated_distances;
+}
+
+
+template <typename TypeMetric>
+std::size_t basic_hnsw<TypeMetric>::find_nearest(const double * p_point, const std::size_t p_amount, search_buffer & p_buffer, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) const {
+    if (m_points.empty() || (p_amount == 0)) {
+        return 0;
+    }
+
+    std::size_t calculated_distances = 0;
+    const std::size_t entry = descend(p_point, 0, calculated_distances);
+    search_layer(p_point, entry, 0, std::max(m_parameters.m_search_candidates, p_amount), p_buffer, calculated_distances);
+
+    /* duplicates of the closest nodes are also candidates */
+    std::vector<candidate> & results = p_buffer.m_candidates;
+    results.clear();
+
+    for (std::size_t position = 0; (position < p_buffer.m_results.size()) && (results.size() < p_amount); position++) {
+        const candidate & current = p_buffer.m_results[position];
+        results.push_back(current);
+
+        for (std::size_t duplicate = m_duplicates[current.second]; duplicate != NO_DUPLICATE; duplicate = m_duplicates[duplicate]) {
+            results.emplace_back(m_metric.comparable_distance(p_point, m_points[duplicate], m_points.dimension()), duplicate);
+            calculated_distances++;
+        }
+    }
+
+    std::sort(results.begin(), results.end());
+
+    const std::size_t amount = std::min(p_amount, results.size());
+    for (std::size_t position = 0; position < amount; position++) {
+        p_indexes.push_back(results[position].second);
+        p_distances.push_back(results[position].first);
+    }
+
+    return calculated_distances;
+}
+
+
+template <typename TypeMetric>
+void basic_hnsw<TypeMetric>::append_result(const double * p_point, const std::size_t p_index, const double p_distance, const double p_radius, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances, std::size_t & p_calculated_distances) const {
+    p_indexes.push_back(p_index);
+    p_distances.push_back(p_distance);
+
+    for (std::size_t duplicate = m_duplicates[p_index]; duplicate != NO_DUPLICATE; duplicate = m_duplicates[duplicate]) {
+        const double distance = m_metric.comparable_distance(p_point, m_points[duplicate], m_points.dimension());
+        p_calculated_distances++;
+
+        if (distance <= p_radius) {
+            p_indexes.push_back(duplicate);
+            p_distances.push_back(distance);
+        }
+    }
+}
+
+
+template class basic_hnsw<utils::metric::euclidean>;
+template class basic_hnsw<utils::metric::euclidean_square>;
+template class basic_hnsw<utils::metric::manhattan>;
+template class basic_hnsw<utils::metric::chebyshev>;
+template class basic_hnsw<utils::metric::minkowski>;
+template class basic_hnsw<utils::metric::cosine>;
+
+
+}
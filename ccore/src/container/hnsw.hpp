@@ -0,0 +1,304 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#ifndef SRC_CONTAINER_HNSW_HPP_
+#define SRC_CONTAINER_HNSW_HPP_
+
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "container/neighbor_lists.hpp"
+
+#include "definitions.hpp"
+
+#include "utils/metric.hpp"
+
+
+namespace container {
+
+
+/**
+*
+* @brief    Parameters of hierarchical navigable small world graph that define trade-off between
+*           recall of queries and time of construction and queries.
+*
+*/
+struct hnsw_parameters {
+    std::size_t     m_connections               = 16;   /* maximum amount of links of a node on upper layers, the bottom layer has twice more */
+    std::size_t     m_construction_candidates   = 100;  /* size of candidate list that is used to find links of inserted point */
+    std::size_t     m_search_candidates         = 64;   /* size of candidate list of queries, it is not less than amount of requested neighbors */
+    unsigned int    m_seed                      = 1;    /* seed of random generator of node layers, so construction is reproducible */
+};
+
+
+/**
+*
+* @brief    Hierarchical navigable small world (HNSW) graph that is intended for approximate radius
+*           and k-nearest neighbor queries in large data of high dimension.
+* @details  Each point is a node of the bottom layer and belongs to upper layers with exponentially
+*           decreasing probability. Query descends greedily from the single node of the top layer
+*           to the bottom layer where the best candidates are refined by beam search, radius query
+*           additionally expands found points through links to points in the radius. Results are
+*           approximate - some of the closest points can be missed, recall grows with amount of
+*           search candidates. Point that is equal to already inserted one (distance is zero) is
+*           attached to it instead of linking, so duplicates do not make graph disconnected. Graph does not rely on triangle inequality, so it is suitable for
+*           all metrics. Points are inserted sequentially during construction (result does not
+*           depend on amount of threads) and the graph is safe for concurrent queries.
+*
+*/
+template <typename TypeMetric>
+class basic_hnsw {
+private:
+    using candidate = std::pair<double, std::size_t>;
+
+public:
+    /**
+    *
+    * @brief    Scratch memory of queries, it is reused by consecutive queries of one thread to
+    *           avoid allocation per query. Marks of visited nodes are stamped by query counter,
+    *           so they are cleared only when the graph size changes or the counter overflows.
+    *
+    */
+    struct search_buffer {
+        std::vector<unsigned int>   m_visited;          /* node is visited by the current query if its mark is equal to epoch */
+        unsigned int                m_epoch             = 0;
+        std::vector<candidate>      m_candidates;
+        std::vector<candidate>      m_results;
+        std::vector<std::size_t>    m_queue;
+    };
+
+private:
+    dataset_matrix                              m_points;
+    std::vector<std::size_t>                    m_links;            /* links of node 'i' on the bottom layer start from 'i * m_base_capacity' */
+    std::vector<std::size_t>                    m_degrees;          /* amount of links of each node on the bottom layer */
+    std::vector<std::vector<std::vector<std::size_t>>> m_upper_links;  /* links of node on layers above the bottom one, empty for most nodes */
+    std::vector<std::size_t>                    m_duplicates;       /* next point in chain of points that are equal to the node, they are not linked */
+    std::size_t                                 m_base_capacity     = 0;
+    std::size_t                                 m_entry             = 0;
+    std::size_t                                 m_top_layer         = 0;
+    hnsw_parameters                             m_parameters;
+    TypeMetric                                  m_metric;
+
+public:
+    /**
+    *
+    * @brief    Default constructor that creates graph without points.
+    *
+    */
+    basic_hnsw(void) = default;
+
+    /**
+    *
+    * @brief    Builds graph for the specified points, they are copied to the graph.
+    *
+    * @param[in] p_data: points for that graph is built.
+    * @param[in] p_parameters: parameters of construction and queries.
+    * @param[in] p_metric: metric that is used to calculate distance between points.
+    *
+    */
+    explicit basic_hnsw(const dataset_view & p_data, const hnsw_parameters & p_parameters = hnsw_parameters(), const TypeMetric & p_metric = TypeMetric());
+
+    basic_hnsw(const basic_hnsw & p_other) = default;
+
+    basic_hnsw(basic_hnsw && p_other) = default;
+
+    ~basic_hnsw(void) = default;
+
+public:
+    /**
+    *
+    * @brief    Returns amount of points in the graph.
+    *
+    */
+    std::size_t size(void) const;
+
+    /**
+    *
+    * @brief    Returns amount of coordinates of each point.
+    *
+    */
+    std::size_t dimension(void) const;
+
+    /**
+    *
+    * @brief    Returns points of the graph in order of input data.
+    *
+    */
+    dataset_view points(void) const;
+
+    /**
+    *
+    * @brief    Returns metric that is used to calculate distance between points.
+    *
+    */
+    const TypeMetric & metric(void) const;
+
+    /**
+    *
+    * @brief    Returns true if the graph has been built using the specified metric parameters
+    *           (for example, degree of Minkowski metric), so its distances are expressed in terms
+    *           of the metric.
+    *
+    * @param[in] p_metric: metric that is compared with the metric of the graph.
+    *
+    */
+    bool is_built_with(const TypeMetric & p_metric) const;
+
+    /**
+    *
+    * @brief    Returns parameters of the graph.
+    *
+    */
+    const hnsw_parameters & parameters(void) const;
+
+    /**
+    *
+    * @brief    Changes size of candidate list of queries to tune recall and speed of queries
+    *           without rebuilding of the graph, it should not be changed during queries.
+    *
+    * @param[in] p_search_candidates: size of candidate list of queries.
+    *
+    */
+    void set_search_candidates(const std::size_t p_search_candidates);
+
+    /**
+    *
+    * @brief    Finds points whose distance to the specified point is less or equal to radius.
+    *
+    * @param[in]  p_point: point for that neighbors are searched, it has dimension of the graph.
+    * @param[in]  p_radius: radius of search in comparable form of the metric.
+    * @param[out] p_indexes: indexes of found points in input data (in arbitrary order).
+    * @param[out] p_distances: distances to found points in comparable form of the metric.
+    *
+    * @return   Returns amount of calculated distances.
+    *
+    */
+    std::size_t find_radius(const double * p_point, const double p_radius, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) const;
+
+    /**
+    *
+    * @brief    Finds points whose distance to the specified point is less or equal to radius using
+    *           scratch memory of the caller.
+    *
+    * @param[in]  p_point: point for that neighbors are searched, it has dimension of the graph.
+    * @param[in]  p_radius: radius of search in comparable form of the metric.
+    * @param[in]  p_buffer: scratch memory that is reused between queries.
+    * @param[out] p_indexes: indexes of found points in input data are appended to it.
+    * @param[out] p_distances: distances to found points in comparable form of the metric are
+    *              appended to it.
+    *
+    * @return   Returns amount of calculated distances.
+    *
+    */
+    std::size_t find_radius(const double * p_point, const double p_radius, search_buffer & p_buffer, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) const;
+
+    /**
+    *
+    * @brief    Finds the specified amount of points that are the closest to the specified point.
+    *
+    * @param[in]  p_point: point for that neighbors are searched, it has dimension of the graph.
+    * @param[in]  p_amount: amount of neighbors that should be found.
+    * @param[out] p_indexes: indexes of found points in input data sorted by distance.
+    * @param[out] p_distances: distances to found points in comparable form of the metric.
+    *
+    * @return   Returns amount of calculated distances.
+    *
+    */
+    std::size_t find_nearest(const double * p_point, const std::size_t p_amount, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) const;
+
+    /**
+    *
+    * @brief    Finds the specified amount of points that are the closest to the specified point
+    *           using scratch memory of the caller.
+    *
+    * @param[in]  p_point: point for that neighbors are searched, it has dimension of the graph.
+    * @param[in]  p_amount: amount of neighbors that should be found.
+    * @param[in]  p_buffer: scratch memory that is reused between queries.
+    * @param[out] p_indexes: indexes of found points sorted by distance are appended to it.
+    * @param[out] p_distances: distances to found points in comparable form of the metric are
+    *              appended to it.
+    *
+    * @return   Returns amount of calculated distances.
+    *
+    */
+    std::size_t find_nearest(const double * p_point, const std::size_t p_amount, search_buffer & p_buffer, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) const;
+
+    /**
+    *
+    * @brief    Finds points in radius of each query point using threads of the global pool.
+    *
+    * @param[in] p_queries: points for that neighbors are searched, they have dimension of the graph.
+    * @param[in] p_radius: radius of search in comparable form of the metric.
+    *
+    * @return   Returns indexes of found points (in arbitrary order) and comparable distances to
+    *           them for each query.
+    *
+    */
+    neighbor_lists find_radius(const dataset_view & p_queries, const double p_radius) const;
+
+    /**
+    *
+    * @brief    Finds the specified amount of the closest points to each query point using threads
+    *           of the global pool.
+    *
+    * @param[in] p_queries: points for that neighbors are searched, they have dimension of the graph.
+    * @param[in] p_amount: amount of neighbors that should be found for each query.
+    *
+    * @return   Returns indexes of found points sorted by distance and comparable distances to them
+    *           for each query.
+    *
+    */
+    neighbor_lists find_nearest(const dataset_view & p_queries, const std::size_t p_amount) const;
+
+private:
+    void insert(const std::size_t p_index, const std::size_t p_layer, search_buffer & p_buffer);
+
+    std::size_t select_links(std::vector<candidate> & p_candidates, const std::size_t p_amount) const;
+
+    void add_link(const std::size_t p_index, const std::size_t p_neighbor, const std::size_t p_layer);
+
+    void append_result(const double * p_point, const std::size_t p_index, const double p_distance, const double p_radius, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances, std::size_t & p_calculated_distances) const;
+
+    std::size_t amount_links(const std::size_t p_index, const std::size_t p_layer) const;
+
+    const std::size_t * begin_links(const std::size_t p_index, const std::size_t p_layer) const;
+
+    std::size_t descend(const double * p_point, const std::size_t p_layer, std::size_t & p_calculated_distances) const;
+
+    void search_layer(const double * p_point, const std::size_t p_entry, const std::size_t p_layer, const std::size_t p_amount, search_buffer & p_buffer, std::size_t & p_calculated_distances) const;
+
+    void start_search(search_buffer & p_buffer) const;
+};
+
+
+/**
+*
+* @brief    Hierarchical navigable small world graph that uses Euclidean distance.
+*
+*/
+using hnsw = basic_hnsw<utils::metric::euclidean>;
+
+
+}
+
+
+#endif
@@ -20,25 +20,92 @@
 
 #include "container/kdtree.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <new>
+
+#include "parallel/task_group.hpp"
+
 #include "utils.hpp"
 
 
 namespace container {
 
 kdnode::kdnode(std::vector<double> * p_data, void * p_payload,  kdnode * p_left, kdnode * p_right, kdnode * p_parent, unsigned int disc) :
-	data(p_data), payload(p_payload), left(p_left), right(p_right), parent(p_parent), discriminator(disc)
+	data(p_data), payload(p_payload), left(p_left), right(p_right), parent(p_parent), discriminator(disc), value((*p_data)[disc]), removed(false)
 	{ }
 
 
 kdnode::~kdnode() { }
 
 
-kdtree::kdtree() : root(nullptr), dimension(0) { }
+const std::size_t kdnode_pool::INITIAL_SLAB_SIZE = 64;
+
+const std::size_t kdnode_pool::MAXIMUM_SLAB_SIZE = 4096;
+
+
+kdnode * kdnode_pool::allocate(std::vector<double> * data, void * payload, kdnode * parent, const unsigned int discriminator) {
+	void * memory = nullptr;
+
+	if (!released.empty()) {
+		memory = released.back();
+		released.pop_back();
+	}
+	else {
+		if (slab_used == slab_size) {
+			/* slabs grow geometrically, so small trees do not reserve much memory */
+			slab_size = (slab_size == 0) ? INITIAL_SLAB_SIZE : std::min(slab_size * 2, MAXIMUM_SLAB_SIZE);
+			slab_used = 0;
+
+			slabs.emplace_back(new node_storage[slab_size]);
+			capacity += slab_size;
+		}
+
+		memory = &slabs.back()[slab_used];
+		slab_used++;
+	}
+
+	return new (memory) kdnode(data, payload, nullptr, nullptr, parent, discriminator);
+}
+
+
+void kdnode_pool::release(kdnode * node) {
+	node->~kdnode();
+	released.push_back(node);
+}
+
+
+void kdnode_pool::clear(void) {
+	slabs.clear();
+	released.clear();
+
+	slab_size = 0;
+	slab_used = 0;
+	capacity = 0;
+}
+
+
+std::size_t kdnode_pool::size(void) const {
+	return capacity - (slab_size - slab_used) - released.size();
+}
+
+
+std::size_t kdnode_pool::get_capacity(void) const {
+	return capacity;
+}
+
+
+const double kdtree::BALANCE_FACTOR = 0.75;
+
+
+kdtree::kdtree() : root(nullptr), dimension(0), size(0), removed(0) { }
 
 
 kdtree::kdtree(const std::vector< std::vector<double> *> * data, const std::vector<void *> * payloads) {
 	root = nullptr;
 	dimension = (*(*data)[0]).size();
+	size = 0;
+	removed = 0;
 
 	if (payloads) {
 		if (data->size() != payloads->size()) {
@@ -57,72 +124,168 @@ kdtree::kdtree(const std::vector< std::vector<double> *> * data, const std::vect
 }
 
 
-kdtree::~kdtree(void) {
-	if (root != nullptr) {
-		recursive_destroy(root);
+/* subtrees with less amount of nodes are built by the thread that builds their parent */
+static const std::ptrdiff_t PARALLEL_SUBTREE_SIZE = 4096;
+
+
+kdtree::kdtree(const std::vector< std::vector<double> *> * data, const std::vector<void *> * payloads, const kdtree_split split) :
+	root(nullptr), dimension(0), size(0), removed(0)
+{
+	if ( (payloads != nullptr) && (data->size() != payloads->size()) ) {
+		throw std::runtime_error("Number of points should be equal to number of according payloads");
+	}
+
+	if (data->empty()) {
+		return;
+	}
+
+	dimension = (*data)[0]->size();
+
+	std::vector<kdnode *> nodes(data->size());
+	for (std::size_t index = 0; index < data->size(); index++) {
+		void * payload = (payloads != nullptr) ? (*payloads)[index] : nullptr;
+		nodes[index] = pool.allocate((*data)[index], payload, nullptr, 0);
 	}
+
+	root = create_subtree(nodes.data(), nodes.data() + nodes.size(), nullptr, split);
+	size = nodes.size();
 }
 
 
-void kdtree::recursive_destroy(kdnode * node) {
-	if (node->get_right() != nullptr) {
-		recursive_destroy(node->get_right());
+kdnode * kdtree::create_subtree(kdnode ** begin, kdnode ** end, kdnode * parent, const kdtree_split split) {
+	if (begin == end) {
+		return nullptr;
+	}
+
+	/* subtree is split by coordinate with the largest spread of values */
+	unsigned int discriminator = 0;
+	double minimum = 0.0;
+	double maximum = 0.0;
+	double largest_spread = -1.0;
+
+	for (unsigned int index_dimension = 0; index_dimension < dimension; index_dimension++) {
+		double dimension_minimum = (*begin)->get_value(index_dimension);
+		double dimension_maximum = dimension_minimum;
+
+		for (kdnode ** node = begin + 1; node != end; node++) {
+			const double value = (*node)->get_value(index_dimension);
+			dimension_minimum = std::min(dimension_minimum, value);
+			dimension_maximum = std::max(dimension_maximum, value);
+		}
+
+		if (dimension_maximum - dimension_minimum > largest_spread) {
+			largest_spread = dimension_maximum - dimension_minimum;
+			minimum = dimension_minimum;
+			maximum = dimension_maximum;
+			discriminator = index_dimension;
+		}
+	}
+
+	auto less_value = [discriminator](kdnode * node1, kdnode * node2) {
+		return node1->get_value(discriminator) < node2->get_value(discriminator);
+	};
+
+	/* left subtree contains only nodes that are less than splitting node, equal nodes are placed to the right one */
+	kdnode ** position = begin;
+	if (split == kdtree_split::MEDIAN) {
+		kdnode ** median = begin + (end - begin) / 2;
+		std::nth_element(begin, median, end, less_value);
+
+		const double median_value = (*median)->get_value(discriminator);
+		position = std::partition(begin, median, [discriminator, median_value](kdnode * node) {
+			return node->get_value(discriminator) < median_value;
+		});
 	}
-	
-	if (node->get_left() != nullptr) {
-		recursive_destroy(node->get_left());
+	else {
+		const double middle = minimum + (maximum - minimum) / 2.0;
+		position = std::partition(begin, end, [discriminator, middle](kdnode * node) {
+			return node->get_value(discriminator) < middle;
+		});
+
+		std::iter_swap(position, std::min_element(position, end, less_value));
 	}
 
-	delete node;
-	node = nullptr;
+	kdnode * node = *position;
+	node->set_parent(parent);
+	node->set_discriminator(discriminator);
+
+	if (end - begin >= PARALLEL_SUBTREE_SIZE) {
+		kdnode * left = nullptr;
+
+		parallel::task_group group;
+		group.run([this, begin, position, node, split, &left]() {
+			left = create_subtree(begin, position, node, split);
+		});
+
+		node->set_right(create_subtree(position + 1, end, node, split));
+		group.wait();
+
+		node->set_left(left);
+	}
+	else {
+		node->set_left(create_subtree(begin, position, node, split));
+		node->set_right(create_subtree(position + 1, end, node, split));
+	}
+
+	return node;
+}
+
+
+kdtree::~kdtree(void) {
+	/* all nodes are freed with slabs of the pool */
+	root = nullptr;
+	pool.clear();
 }
 
 
 kdnode * kdtree::insert(std::vector<double> * point, void * payload) {
+	size++;
+
 	if (root == nullptr) {
-		kdnode * node = new kdnode(point, payload, nullptr, nullptr, nullptr, 0);
+		kdnode * node = pool.allocate(point, payload, nullptr, 0);
 
 		root = node;
 		dimension = node->get_data()->size();
 
 		return node;
 	}
-	else {
-		kdnode * cur_node = root;
-
-		while(true) {
-			/* If new node is greater or equal than current node then check right leaf */
-			if (*cur_node <= *point) {
-				if (cur_node->get_right() == nullptr) {
-					unsigned int discriminator = cur_node->get_discriminator() + 1;
-					if (discriminator >= dimension) {
-						discriminator = 0;
-					}
-
-					cur_node->set_right(new kdnode(point, payload, nullptr, nullptr, cur_node, discriminator));
-					return cur_node->get_right();
-				}
-				else {
-					cur_node = cur_node->get_right();
-				}
-			}
-			/* If new node is less than current then check left leaf */
-			else {
-				if (cur_node->get_left() == nullptr) {
-					unsigned int discriminator = cur_node->get_discriminator() + 1;
-					if (discriminator >= dimension) {
-						discriminator = 0;
-					}
-
-					cur_node->set_left(new kdnode(point, payload, nullptr, nullptr, cur_node, discriminator));
-					return cur_node->get_left();
-				}
-				else {
-					cur_node = cur_node->get_left();
-				}
-			}
+
+	kdnode * cur_node = root;
+	kdnode * node = nullptr;
+	std::size_t depth = 1;
+
+	while (node == nullptr) {
+		/* If new node is greater or equal than current node then check right leaf, otherwise left one */
+		const bool right_side = (*cur_node <= *point);
+		kdnode * child = right_side ? cur_node->get_right() : cur_node->get_left();
+
+		if (child != nullptr) {
+			cur_node = child;
+			depth++;
+			continue;
+		}
+
+		unsigned int discriminator = cur_node->get_discriminator() + 1;
+		if (discriminator >= dimension) {
+			discriminator = 0;
+		}
+
+		node = pool.allocate(point, payload, cur_node, discriminator);
+		if (right_side) {
+			cur_node->set_right(node);
+		}
+		else {
+			cur_node->set_left(node);
 		}
 	}
+
+	/* depth of balanced tree is not greater than logarithm of its size by base '1 / BALANCE_FACTOR' */
+	const double maximum_depth = std::log((double) (size + removed)) / std::log(1.0 / BALANCE_FACTOR);
+	if ((double) depth > maximum_depth) {
+		rebalance(node);
+	}
+
+	return node;
 }
 
 
@@ -133,115 +296,139 @@ void kdtree::remove(std::vector<double> * point) {
 	}
 
 	remove(node_for_remove);
-
-	delete node_for_remove;
-	node_for_remove = nullptr;
 }
 
 
 void kdtree::remove(kdnode * node_for_remove) {
-	kdnode * parent = node_for_remove->get_parent();
-	kdnode * node = recursive_remove(node_for_remove);
+	if (node_for_remove->is_removed()) {
+		return;
+	}
 
-	if (parent == nullptr) {
-		root = node;
+	size--;
 
-		/* if tree is almost destroyed */
-		if (node != nullptr) {
-			node->set_parent(nullptr);
-		}
+	if ( (node_for_remove->get_left() == nullptr) && (node_for_remove->get_right() == nullptr) ) {
+		unlink_leaf(node_for_remove);
 	}
 	else {
-		if (parent->get_left() == node_for_remove) {
-			parent->set_left(node);
+		/* inner node still separates its subtrees, so it is kept until rebuilding */
+		node_for_remove->mark_removed();
+		removed++;
+	}
+
+	if ( (root != nullptr) && (removed > size) ) {
+		rebuild_subtree(root);
+	}
+}
+
+
+void kdtree::unlink_leaf(kdnode * node) {
+	kdnode * leaf = node;
+
+	while (leaf != nullptr) {
+		kdnode * parent = leaf->get_parent();
+
+		if (parent == nullptr) {
+			root = nullptr;
 		}
-		else if (parent->get_right() == node_for_remove) {
-			parent->set_right(node);
+		else if (parent->get_left() == leaf) {
+			parent->set_left(nullptr);
+		}
+		else if (parent->get_right() == leaf) {
+			parent->set_right(nullptr);
 		}
 		else {
 			throw std::runtime_error("Structure of KD Tree is corrupted");
 		}
+
+		if (leaf->is_removed()) {
+			removed--;
+		}
+
+		pool.release(leaf);
+
+		/* removed parent is not needed as a separator when it has no children */
+		const bool parent_is_leaf = (parent != nullptr) && (parent->get_left() == nullptr) && (parent->get_right() == nullptr);
+		leaf = (parent_is_leaf && parent->is_removed()) ? parent : nullptr;
 	}
 }
 
 
-kdnode * kdtree::recursive_remove(kdnode * node) {
-	if ( (node->get_right() == nullptr) && (node->get_left() == nullptr) ) {
-		return nullptr;
+void kdtree::rebalance(kdnode * node) {
+	std::vector<kdnode *> sibling_nodes;
+
+	kdnode * child = node;
+	std::size_t child_size = 1;
+
+	/* sizes of subtrees are not stored, they are counted on the way up until the first unbalanced ancestor */
+	for (kdnode * parent = node->get_parent(); parent != nullptr; parent = parent->get_parent()) {
+		kdnode * sibling = (parent->get_left() == child) ? parent->get_right() : parent->get_left();
+
+		sibling_nodes.clear();
+		collect_nodes(sibling, sibling_nodes);
+
+		const std::size_t parent_size = child_size + sibling_nodes.size() + 1;
+		if ((double) child_size > BALANCE_FACTOR * (double) parent_size) {
+			rebuild_subtree(parent);
+			return;
+		}
+
+		child = parent;
+		child_size = parent_size;
 	}
+}
 
-	unsigned int discriminator = node->get_discriminator();
 
-	/* Check if only left branch exist */
-	if (node->get_right() == nullptr) {
-		node->set_right(node->get_left());
-		node->set_left(nullptr);
+void kdtree::rebuild_subtree(kdnode * subtree) {
+	kdnode * parent = subtree->get_parent();
+	const bool left_side = (parent != nullptr) && (parent->get_left() == subtree);
+
+	std::vector<kdnode *> nodes;
+	collect_nodes(subtree, nodes);
+
+	std::size_t amount = 0;
+	for (kdnode * node : nodes) {
+		if (node->is_removed()) {
+			pool.release(node);
+			removed--;
+		}
+		else {
+			node->set_left(nullptr);
+			node->set_right(nullptr);
+			nodes[amount++] = node;
+		}
 	}
 
-	/* Find minimal node in line with coordinate that is defined by discriminator */
-	kdnode * minimal_node = find_minimal_node(node->get_right(), discriminator);
-	kdnode * parent = minimal_node->get_parent();
+	kdnode * balanced_subtree = create_subtree(nodes.data(), nodes.data() + amount, parent, kdtree_split::MEDIAN);
 
-	if (parent->get_left() == minimal_node) {
-		parent->set_left(recursive_remove(minimal_node));
+	if (parent == nullptr) {
+		root = balanced_subtree;
 	}
-	else if (parent->get_right() == minimal_node) {
-		parent->set_right(recursive_remove(minimal_node));
+	else if (left_side) {
+		parent->set_left(balanced_subtree);
 	}
 	else {
-		throw std::runtime_error("Structure of KD Tree is corrupted");
+		parent->set_right(balanced_subtree);
 	}
+}
 
-	minimal_node->set_parent(node->get_parent());
-	minimal_node->set_discriminator(node->get_discriminator());
-	minimal_node->set_right(node->get_right());
-	minimal_node->set_left(node->get_left());
-
-	/* Update parent for successors of previous parent */
-	if (minimal_node->get_right() != nullptr) {
-		minimal_node->get_right()->set_parent(minimal_node);
-	}
 
-	if (minimal_node->get_left() != nullptr) {
-		minimal_node->get_left()->set_parent(minimal_node);
+void kdtree::collect_nodes(kdnode * node, std::vector<kdnode *> & nodes) {
+	const std::size_t first_position = nodes.size();
+	if (node != nullptr) {
+		nodes.push_back(node);
 	}
 
-	return minimal_node;
-}
-
+	for (std::size_t position = first_position; position < nodes.size(); position++) {
+		kdnode * current = nodes[position];
 
-kdnode * kdtree::find_minimal_node(kdnode * node, unsigned int discriminator) {
-
-	std::stack <kdnode *> stack;
-	kdnode * minimal_node = node;
-	std::vector<kdnode *> candidates;
-	bool is_done = false;
-
-	while (!is_done) {
-		if (node != nullptr) {
-			stack.push(node);
-			node = node->get_left();
-		}
-		else {
-			if (stack.size() != 0) {
-				node = stack.top();
-				candidates.push_back(node);
-				stack.pop();
-				node = node->get_right();
-			}
-			else {
-				is_done = true;
-			}
+		if (current->get_left() != nullptr) {
+			nodes.push_back(current->get_left());
 		}
-	}
 
-	for (size_t i = 0; i < candidates.size(); i++) {
-		if (candidates[i]->get_value(discriminator) <= minimal_node->get_value(discriminator)) {
-			minimal_node = candidates[i];
+		if (current->get_right() != nullptr) {
+			nodes.push_back(current->get_right());
 		}
 	}
-
-	return minimal_node;
 }
 
 
@@ -258,7 +445,7 @@ kdnode * kdtree::find_node(std::vector<double> * point, kdnode * node) {
 
 	while(true) {
 		if (*cur_node <= *point) {
-			if (cur_node->get_data() == point) {
+			if ( (cur_node->get_data() == point) && !cur_node->is_removed() ) {
 				req_node = cur_node;
 				break;
 			}
@@ -287,26 +474,44 @@ kdnode * kdtree::find_node(std::vector<double> * point, kdnode * node) {
 unsigned int kdtree::traverse(kdnode * node) {
 	unsigned int number_nodes = 0;
 
+	std::vector<kdnode *> stack;
 	if (node != nullptr) {
-		if (node->get_left() != nullptr) {
-			number_nodes += traverse(node->get_left());
+		stack.push_back(node);
+	}
+
+	while (!stack.empty()) {
+		kdnode * current = stack.back();
+		stack.pop_back();
+
+		if (current->get_left() != nullptr) {
+			stack.push_back(current->get_left());
 		}
 
-		if (node->get_right() != nullptr) {
-			number_nodes += traverse(node->get_right());
+		if (current->get_right() != nullptr) {
+			stack.push_back(current->get_right());
 		}
 
-		number_nodes++;
+		if (!current->is_removed()) {
+			number_nodes++;
+		}
 	}
 
 	return number_nodes;
 }
 
 
-kdtree_searcher::kdtree_searcher() : distance(0), sqrt_distance(0), initial_node(nullptr), search_point(nullptr) { }
+/* candidates of the nearest nodes are ordered by distance only */
+static bool compare_candidates(const std::pair<double, kdnode *> & candidate1, const std::pair<double, kdnode *> & candidate2) {
+	return candidate1.first < candidate2.first;
+}
+
 
+template <typename TypeMetric>
+basic_kdtree_searcher<TypeMetric>::basic_kdtree_searcher() : metric(), distance(0), sqrt_distance(0), initial_node(nullptr), search_point(nullptr) { }
 
-kdtree_searcher::~kdtree_searcher() {
+
+template <typename TypeMetric>
+basic_kdtree_searcher<TypeMetric>::~basic_kdtree_searcher() {
 	if (nodes_distance != nullptr) {
 		delete nodes_distance;
 		nodes_distance = nullptr;
@@ -319,21 +524,33 @@ kdtree_searcher::~kdtree_searcher() {
 }
 
 
-kdtree_searcher::kdtree_searcher(std::vector<double> * point, kdnode * node, const double radius_search) {
+template <typename TypeMetric>
+basic_kdtree_searcher<TypeMetric>::basic_kdtree_searcher(const TypeMetric & metric_search) :
+	metric(metric_search)
+{ }
+
+
+template <typename TypeMetric>
+basic_kdtree_searcher<TypeMetric>::basic_kdtree_searcher(std::vector<double> * point, kdnode * node, const double radius_search, const TypeMetric & metric_search) :
+	metric(metric_search)
+{
 	initialize(point, node, radius_search);
 }
 
 
-void kdtree_searcher::initialize(std::vector<double> * point, kdnode * node, const double radius_search) {
+template <typename TypeMetric>
+void basic_kdtree_searcher<TypeMetric>::initialize(std::vector<double> * point, kdnode * node, const double radius_search) {
 	distance = radius_search;
-	sqrt_distance = radius_search * radius_search;
+	sqrt_distance = metric.to_comparable(radius_search);
 
 	initial_node = node;
 	search_point = point;
+	visited_nodes = 0;
 }
 
 
-void kdtree_searcher::prepare_storages() {
+template <typename TypeMetric>
+void basic_kdtree_searcher<TypeMetric>::prepare_storages() {
 	if (nodes_distance == nullptr) {
 		nodes_distance = new std::vector<double>();
 	}
@@ -342,31 +559,52 @@ void kdtree_searcher::prepare_storages() {
 }
 
 
-void kdtree_searcher::recursive_nearest_nodes(kdnode * node) {
-	double minimum = node->get_value() - distance;
-	double maximum = node->get_value() + distance;
+template <typename TypeMetric>
+void basic_kdtree_searcher<TypeMetric>::traverse_nearest_nodes(kdnode * node) {
+	const std::size_t first_position = nearest_nodes->size();
+
+	/* pre-order traversal (node, left subtree, right subtree) is performed and found nodes are
+	 * reversed, that gives the same order as post-order traversal (right, left, node) */
+	stack.clear();
+	stack.emplace_back(0.0, node);
+
+	while (!stack.empty()) {
+		kdnode * current = stack.back().second;
+		stack.pop_back();
 
-	if (node->get_right() != nullptr) {
-		if ((*search_point)[node->get_discriminator()] >= minimum) {
-			recursive_nearest_nodes(node->get_right());
+		visited_nodes++;
+
+		if (!current->is_removed()) {
+			const double candidate_distance = metric.comparable_distance(search_point->data(), current->get_data()->data(), search_point->size());
+			if (candidate_distance <= sqrt_distance) {
+				nearest_nodes->push_back(current);
+				nodes_distance->push_back(candidate_distance);
+			}
 		}
-	}
 
-	if (node->get_left() != nullptr) {
-		if ((*search_point)[node->get_discriminator()] < maximum) {
-			recursive_nearest_nodes(node->get_left());
+		/* difference by discriminator gives lower bound of distance to points of the opposite subtree */
+		const double difference = current->get_value() - (*search_point)[current->get_discriminator()];
+
+		if (current->get_right() != nullptr) {
+			if ( (difference <= 0.0) || (metric.comparable_axis_bound(difference) <= sqrt_distance) ) {
+				stack.emplace_back(0.0, current->get_right());
+			}
 		}
-	}
 
-	double candidate_distance = euclidean_distance_sqrt(search_point, node->get_data());
-	if (candidate_distance <= sqrt_distance) {
-		nearest_nodes->push_back(node);
-		nodes_distance->push_back(candidate_distance);
+		if (current->get_left() != nullptr) {
+			if ( (difference > 0.0) || (metric.comparable_axis_bound(-difference) < sqrt_distance) ) {
+				stack.emplace_back(0.0, current->get_left());
+			}
+		}
 	}
+
+	std::reverse(nearest_nodes->begin() + first_position, nearest_nodes->end());
+	std::reverse(nodes_distance->end() - (nearest_nodes->size() - first_position), nodes_distance->end());
 }
 
 
-std::vector<kdnode *> * kdtree_searcher::find_nearest_nodes(std::vector<double> * distances) {
+template <typename TypeMetric>
+std::vector<kdnode *> * basic_kdtree_searcher<TypeMetric>::find_nearest_nodes(std::vector<double> * distances) {
 	if (distances != nullptr) {
 		nodes_distance = distances;
 	}
@@ -375,7 +613,7 @@ std::vector<kdnode *> * kdtree_searcher::find_nearest_nodes(std::vector<double>
 
 	std::vector<kdnode *> * result = nearest_nodes;
 
-	recursive_nearest_nodes(initial_node);
+	traverse_nearest_nodes(initial_node);
 
 	nearest_nodes = nullptr; /* application responds for the vector */
 
@@ -392,30 +630,134 @@ std::vector<kdnode *> * kdtree_searcher::find_nearest_nodes(std::vector<double>
 }
 
 
-kdnode * kdtree_searcher::find_nearest_node() {
-	prepare_storages();
+template <typename TypeMetric>
+void basic_kdtree_searcher<TypeMetric>::traverse_k_nearest_nodes(kdnode * node, const std::size_t amount, const void * excluded_payload, std::vector<nearest_candidate> & candidates) {
+	/* lower bound of distance is checked when subtree is taken from the stack, so the farthest
+	 * subtree is checked using radius that has been shrunk by the nearest one as by recursion */
+	stack.clear();
+	stack.emplace_back(0.0, node);
 
-	kdnode * node = nullptr;
+	while (!stack.empty()) {
+		const nearest_candidate subtree = stack.back();
+		stack.pop_back();
+
+		const double radius = (candidates.size() == amount) ? candidates.front().first : sqrt_distance;
+		if (subtree.first > radius) {
+			continue;
+		}
 
-	recursive_nearest_nodes(initial_node);
+		kdnode * current = subtree.second;
+		visited_nodes++;
 
-	if (nodes_distance->size() > 0) {
-		double minimal_distance = (*nodes_distance)[0];
-		for (unsigned int index = 1; index < nodes_distance->size(); index++) {
-			if ((*nodes_distance)[index] < minimal_distance) {
-				minimal_distance = (*nodes_distance)[index];
-				node = (*nearest_nodes)[index];
+		if ( !current->is_removed() && ((excluded_payload == nullptr) || (current->get_payload() != excluded_payload)) ) {
+			const double candidate_distance = metric.comparable_distance(search_point->data(), current->get_data()->data(), search_point->size());
+			if (candidate_distance <= sqrt_distance) {
+				if (candidates.size() < amount) {
+					candidates.emplace_back(candidate_distance, current);
+					std::push_heap(candidates.begin(), candidates.end(), compare_candidates);
+				}
+				else if (candidate_distance < candidates.front().first) {
+					std::pop_heap(candidates.begin(), candidates.end(), compare_candidates);
+					candidates.back() = nearest_candidate(candidate_distance, current);
+					std::push_heap(candidates.begin(), candidates.end(), compare_candidates);
+				}
 			}
 		}
+
+		/* subtree where the point is located is visited first to shrink radius before the opposite one */
+		const double difference = current->get_value() - (*search_point)[current->get_discriminator()];
+
+		kdnode * nearest_subtree = (difference > 0.0) ? current->get_left() : current->get_right();
+		kdnode * farthest_subtree = (difference > 0.0) ? current->get_right() : current->get_left();
+
+		if (farthest_subtree != nullptr) {
+			stack.emplace_back(metric.comparable_axis_bound(difference), farthest_subtree);
+		}
+
+		if (nearest_subtree != nullptr) {
+			stack.emplace_back(-1.0, nearest_subtree);
+		}
+	}
+}
+
+
+template <typename TypeMetric>
+void basic_kdtree_searcher<TypeMetric>::find_nearest_nodes(std::vector<kdnode *> & nodes, std::vector<double> & distances) {
+	if (initial_node == nullptr) {
+		return;
 	}
 
-	delete nearest_nodes;
-	nearest_nodes = nullptr;
+	nearest_nodes = &nodes;
+	nodes_distance = &distances;
 
-	delete nodes_distance;
+	traverse_nearest_nodes(initial_node);
+
+	nearest_nodes = nullptr;	/* containers belong to application */
 	nodes_distance = nullptr;
+}
 
-	return node;
+
+template <typename TypeMetric>
+std::vector<kdnode *> * basic_kdtree_searcher<TypeMetric>::find_k_nearest_nodes(const std::size_t amount, std::vector<double> * distances, const void * excluded_payload) {
+	std::vector<kdnode *> * result = new std::vector<kdnode *>();
+
+	std::vector<double> result_distances;
+	find_k_nearest_nodes(amount, *result, result_distances, excluded_payload);
+
+	if (distances != nullptr) {
+		distances->swap(result_distances);
+	}
+
+	return result;
+}
+
+
+template <typename TypeMetric>
+void basic_kdtree_searcher<TypeMetric>::find_k_nearest_nodes(const std::size_t amount, std::vector<kdnode *> & nodes, std::vector<double> & distances, const void * excluded_payload) {
+	candidates.clear();
+	if ( (initial_node != nullptr) && (amount > 0) ) {
+		traverse_k_nearest_nodes(initial_node, amount, excluded_payload, candidates);
+	}
+
+	std::sort_heap(candidates.begin(), candidates.end(), compare_candidates);
+
+	for (const auto & candidate : candidates) {
+		nodes.push_back(candidate.second);
+		distances.push_back(candidate.first);
+	}
+}
+
+
+template <typename TypeMetric>
+kdnode * basic_kdtree_searcher<TypeMetric>::find_nearest_node(double * nearest_distance, const void * excluded_payload) {
+	candidates.clear();
+	if (initial_node != nullptr) {
+		traverse_k_nearest_nodes(initial_node, 1, excluded_payload, candidates);
+	}
+
+	if (candidates.empty()) {
+		return nullptr;
+	}
+
+	if (nearest_distance != nullptr) {
+		*nearest_distance = candidates.front().first;
+	}
+
+	return candidates.front().second;
 }
 
+
+template <typename TypeMetric>
+std::size_t basic_kdtree_searcher<TypeMetric>::get_visited_nodes(void) const {
+	return visited_nodes;
+}
+
+
+template class basic_kdtree_searcher<utils::metric::euclidean>;
+template class basic_kdtree_searcher<utils::metric::euclidean_square>;
+template class basic_kdtree_searcher<utils::metric::manhattan>;
+template class basic_kdtree_searcher<utils::metric::chebyshev>;
+template class basic_kdtree_searcher<utils::metric::minkowski>;
+template class basic_kdtree_searcher<utils::metric::cosine>;
+
 }
@@ -22,10 +22,35 @@
 #define _KDTREE_H_
 
 
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
 #include <vector>
+
+#include "container/neighbor_lists.hpp"
+
+#include "definitions.hpp"
+
+#include "utils/metric.hpp"
 
 
 namespace container {
+
+/***********************************************************************************************
+ *
+ * @brief   Rule that defines node that splits points of subtree during balanced construction.
+ * @details In both cases subtree is split by coordinate with the largest spread of values.
+ *          MEDIAN - median point is chosen, depth of tree is logarithmic.
+ *          SLIDING_MIDPOINT - point that is the closest to the middle of the spread from above is
+ *          chosen, so empty space is cut off faster for clustered data.
+ *
+ ***********************************************************************************************/
+enum class kdtree_split {
+	MEDIAN,
+	SLIDING_MIDPOINT
+};
+
 
 /***********************************************************************************************
  *
@@ -41,6 +66,8 @@ private:
 	kdnode  *		right;
 	kdnode  *		parent;
 	unsigned int	discriminator;
+	double			value;			/* coordinate by discriminator, it is kept when point of removed node is destroyed */
+	bool			removed;		/* node is removed from the tree but it is kept as a separator of its subtrees */
 
 public:
 	kdnode(std::vector<double> * p_data, void * p_payload,  kdnode * p_left, kdnode * p_right, kdnode * p_parent, unsigned int disc);
@@ -50,7 +77,7 @@ public:
 	inline void set_left(kdnode * node) { left = node; }
 	inline void set_right(kdnode * node) { right = node; }
 	inline void set_parent(kdnode * node) { parent = node; }
-	inline void set_discriminator(const unsigned int disc) { discriminator = disc; }
+	inline void set_discriminator(const unsigned int disc) { discriminator = disc; value = (*data)[disc]; }
 
 	inline kdnode * get_left(void) { return left; }
 	inline kdnode * get_right(void) { return right; }
@@ -59,16 +86,18 @@ public:
 	inline void * get_payload(void) { return payload; }
 	inline const std::vector<double> * get_data(void) { return data; }
 
-	inline double get_value(void) const { return (*data)[discriminator]; }
+	inline double get_value(void) const { return value; }
 	inline double get_value(const unsigned int discr) { return (*data)[discr]; }
 	inline unsigned int get_discriminator(void) const { return discriminator; }
 
-	inline std::vector<kdnode *> * get_children(void) {
-		std::vector<kdnode *> * children = new std::vector<kdnode *>();
-		if (left != nullptr) { children->push_back(left); }
-		if (right != nullptr) { children->push_back(right); }
+	/* point and payload of removed node can be destroyed by application, so they are not kept */
+	inline bool is_removed(void) const { return removed; }
+	inline void mark_removed(void) { removed = true; data = nullptr; payload = nullptr; }
 
-		return children;
+	inline void get_children(std::vector<kdnode *> & children) {
+		children.clear();
+		if (left != nullptr) { children.push_back(left); }
+		if (right != nullptr) { children.push_back(right); }
 	}
 };
 
@@ -89,48 +118,178 @@ inline bool operator == (const kdnode & node, const std::vector<double> & point)
 inline bool operator == (const std::vector<double> & point, const kdnode & node) { return node == point; }
 
 
+/***********************************************************************************************
+ *
+ * @brief   Slab allocator of nodes of KD Tree.
+ * @details Nodes are placed in slabs of growing size instead of separate allocation of each node,
+ *          removed nodes are kept in list of released nodes and reused by following allocations.
+ *          All nodes are freed at once with slabs, so destruction of tree does not traverse it.
+ *
+ ***********************************************************************************************/
+class kdnode_pool {
+private:
+	using node_storage = std::aligned_storage<sizeof(kdnode), alignof(kdnode)>::type;
+
+private:
+	static const std::size_t	INITIAL_SLAB_SIZE;
+	static const std::size_t	MAXIMUM_SLAB_SIZE;
+
+private:
+	std::vector< std::unique_ptr<node_storage []> >	slabs;
+	std::vector<kdnode *>							released;		/* removed nodes that are reused first */
+
+	std::size_t		slab_size		= 0;	/* capacity of the last slab */
+	std::size_t		slab_used		= 0;	/* amount of used nodes in the last slab */
+	std::size_t		capacity		= 0;	/* total amount of nodes in all slabs */
+
+public:
+	kdnode_pool(void) = default;
+
+	kdnode_pool(const kdnode_pool & other) = delete;
+
+	kdnode_pool(kdnode_pool && other) = default;
+
+	~kdnode_pool(void) = default;
+
+public:
+	/***********************************************************************************************
+	*
+	* @brief   Creates node without children in memory of the pool.
+	*
+	* @param   data               - coordinates of the node.
+	* @param   payload            - payload of the node (can be nullptr if it's not required).
+	* @param   parent             - parent of the node.
+	* @param   discriminator      - discriminator of the node.
+	*
+	* @return  Pointer to created node that is valid until it is released or the pool is cleared.
+	*
+	***********************************************************************************************/
+	kdnode * allocate(std::vector<double> * data, void * payload, kdnode * parent, const unsigned int discriminator);
+
+	/***********************************************************************************************
+	*
+	* @brief   Returns memory of the node to the pool for reuse.
+	*
+	* @param   node               - node that has been allocated by the pool.
+	*
+	***********************************************************************************************/
+	void release(kdnode * node);
+
+	/***********************************************************************************************
+	*
+	* @brief   Frees all nodes of the pool at once.
+	*
+	***********************************************************************************************/
+	void clear(void);
+
+	/***********************************************************************************************
+	*
+	* @brief   Returns amount of nodes that are placed in the pool and have not been released.
+	*
+	***********************************************************************************************/
+	std::size_t size(void) const;
+
+	/***********************************************************************************************
+	*
+	* @brief   Returns amount of nodes that can be placed in allocated slabs.
+	*
+	***********************************************************************************************/
+	std::size_t get_capacity(void) const;
+
+public:
+	kdnode_pool & operator=(const kdnode_pool & other) = delete;
+
+	kdnode_pool & operator=(kdnode_pool && other) = default;
+};
+
+
+/***********************************************************************************************
+ *
+ * @brief   Results of a batch of queries to KD Tree where neighbors are represented by nodes.
+ *
+ ***********************************************************************************************/
+using kdtree_neighbor_lists = basic_neighbor_lists<kdnode *>;
+
+
 /***********************************************************************************************
  *
  * @brief   KD Tree - structure for storing data where fast distance searching is required.
+ * @details Searches do not modify the tree, so several threads can search in the tree at the
+ *          same time (each of them by its own searcher) while it is not modified. Nodes are
+ *          placed in the pool of the tree, so pointers to them are valid until they are removed
+ *          or the tree is destroyed.
+ *
+ *          Removed leaves are unlinked at once, removed inner nodes are marked as removed and
+ *          skipped by searches (tombstones). The tree is rebuilt when there are more removed nodes
+ *          than points. Subtree where inserted node is too deep is rebuilt as balanced one
+ *          (scapegoat tree), so the tree keeps logarithmic depth under insertions and removals.
  *
  ***********************************************************************************************/
 class kdtree {
+private:
+	/* subtree is rebuilt when one of its children contains more than this part of its nodes */
+	static const double		BALANCE_FACTOR;
+
 private:
 	kdnode *		root;
 	std::size_t		dimension;
+	kdnode_pool		pool;
+	std::size_t		size;			/* amount of points in the tree */
+	std::size_t		removed;		/* amount of removed nodes that are kept in the tree */
 
 private:
 	/***********************************************************************************************
 	*
-	* @brief   Recursive remove of node in tree.
+	* @brief   Unlinks removed leaf from the tree, removed parents that become leaves are
+	*          unlinked too.
 	*
-	* @param   node            - node that should be removed.
-	*
-	* @return  Node that should replace removed node (if it's not leaf).
+	* @param   node            - leaf that should be unlinked.
 	*
 	***********************************************************************************************/
-	kdnode * recursive_remove(kdnode * node);
+	void unlink_leaf(kdnode * node);
 
 	/***********************************************************************************************
 	*
-	* @brief   Recursive destroy tree (used by destructor).
+	* @brief   Finds the highest ancestor of inserted node whose child is unbalanced and rebuilds
+	*          subtree of the ancestor.
 	*
-	* @param   node            - node that should be destroyed.
+	* @param   node            - inserted node that is too deep.
 	*
 	***********************************************************************************************/
-	void recursive_destroy(kdnode * node);
-
-	/***********************************************************************************************
-	*
-	* @brief   Find minimal node in subtree in line with specified discriminator.
-	*
-	* @param   node            - root of subtree where searching should be performed.
-	* @param   discriminator   - discriminator that is used for comparison of nodes.
-	*
-	* @return  Return the smallest node in specified subtree in line with discriminator.
-	*
+	void rebalance(kdnode * node);
+
+	/***********************************************************************************************
+	*
+	* @brief   Rebuilds subtree as balanced one, removed nodes of the subtree are released.
+	*
+	* @param   subtree         - root of subtree that should be rebuilt.
+	*
+	***********************************************************************************************/
+	void rebuild_subtree(kdnode * subtree);
+
+	/***********************************************************************************************
+	*
+	* @brief   Appends all nodes of subtree including removed ones.
+	*
+	* @param   node            - root of subtree.
+	* @param   nodes           - container where nodes are appended.
+	*
+	***********************************************************************************************/
+	static void collect_nodes(kdnode * node, std::vector<kdnode *> & nodes);
+
+	/***********************************************************************************************
+	*
+	* @brief   Builds balanced subtree from nodes without links, nodes are reordered.
+	*
+	* @param   begin           - the first node of the subtree.
+	* @param   end             - node after the last node of the subtree.
+	* @param   parent          - parent of the subtree.
+	* @param   split           - rule that defines splitting node.
+	*
+	* @return  Root of the subtree.
+	*
 	***********************************************************************************************/
-	kdnode * find_minimal_node(kdnode * cur_node, unsigned int discriminator);
+	kdnode * create_subtree(kdnode ** begin, kdnode ** end, kdnode * parent, const kdtree_split split);
 
 public:
 	/***********************************************************************************************
@@ -150,6 +309,20 @@ public:
 	***********************************************************************************************/
 	kdtree(const std::vector< std::vector<double> *> * data, const std::vector<void *> * payloads);
 
+	/***********************************************************************************************
+	*
+	* @brief   Constructor of balanced kd tree with pre-defined information.
+	* @details All points are split at once in line with specified rule instead of insertion one by
+	*          one, therefore shape of tree does not depend on order of points (sorted points do not
+	*          produce degenerated tree). Large subtrees are built in parallel by global thread pool.
+	*
+	* @param   data               - coordinates that describe nodes in tree.
+	* @param   payloads           - payloads of nodes (can be nullptr if it's not required).
+	* @param   split              - rule that defines node that splits each subtree.
+	*
+	***********************************************************************************************/
+	kdtree(const std::vector< std::vector<double> *> * data, const std::vector<void *> * payloads, const kdtree_split split);
+
 	/***********************************************************************************************
 	*
 	* @brief   Default destructor.
@@ -180,7 +353,9 @@ public:
 
 	/***********************************************************************************************
 	*
-	* @brief   Remove node from the tree.
+	* @brief   Remove node from the tree, memory of the node is reused by following insertions.
+	* @details Leaf is unlinked at once, inner node is kept in the tree as removed one until the
+	*          tree or its subtree is rebuilt. Pointers to other nodes stay valid.
 	*
 	* @param   node_for_remove    - pointer to node that is located in tree.
 	*
@@ -212,7 +387,8 @@ public:
 
 	/***********************************************************************************************
 	*
-	* @brief   Traverse tree from specified node and returns number of nodes in subtree.
+	* @brief   Traverse tree from specified node and returns number of nodes in subtree that have
+	*          not been removed, traversal uses explicit stack instead of recursion.
 	*
 	* @param   node               - pointer to node of tree.
 	*
@@ -229,33 +405,116 @@ public:
 	*
 	***********************************************************************************************/
 	inline kdnode * get_root(void) { return root; }
+
+	/***********************************************************************************************
+	*
+	* @brief   Return amount of points in the tree (removed nodes are not counted).
+	*
+	***********************************************************************************************/
+	inline std::size_t get_size(void) const { return size; }
+
+	/***********************************************************************************************
+	*
+	* @brief   Return pool where nodes of the tree are placed.
+	*
+	***********************************************************************************************/
+	inline const kdnode_pool & get_pool(void) const { return pool; }
+
+	/***********************************************************************************************
+	*
+	* @brief   Search nodes that are located in specified distance from each query point using
+	*          threads of the global pool.
+	*
+	* @param   (in) queries            - points for which nearest nodes should be found.
+	* @param   (in) radius_search      - allowable distance for searching from each point.
+	* @param   (in) metric_search      - metric that is used to calculate distance between points.
+	*
+	* @return  Returns found nodes and comparable distances to them for each query point.
+	*
+	***********************************************************************************************/
+	template <typename TypeMetric = utils::metric::euclidean>
+	kdtree_neighbor_lists find_nearest_nodes(const dataset_view & queries, const double radius_search, const TypeMetric & metric_search = TypeMetric()) const;
+
+	/***********************************************************************************************
+	*
+	* @brief   Search the specified amount of the nearest nodes for each query point using threads
+	*          of the global pool.
+	*
+	* @param   (in) queries            - points for which nearest nodes should be found.
+	* @param   (in) amount             - maximum amount of nodes that should be found for each point.
+	* @param   (in) metric_search      - metric that is used to calculate distance between points.
+	*
+	* @return  Returns found nodes sorted by distance and comparable distances to them for each
+	*          query point.
+	*
+	***********************************************************************************************/
+	template <typename TypeMetric = utils::metric::euclidean>
+	kdtree_neighbor_lists find_k_nearest_nodes(const dataset_view & queries, const std::size_t amount, const TypeMetric & metric_search = TypeMetric()) const;
+
+private:
+	/***********************************************************************************************
+	*
+	* @brief   Performs query for each point in parallel, each task uses its own searcher.
+	*
+	***********************************************************************************************/
+	template <typename TypeMetric, typename TypeQuery>
+	kdtree_neighbor_lists find_batch(const dataset_view & queries, const double radius_search, const TypeMetric & metric_search, const TypeQuery & query) const;
 };
 
 
 /***********************************************************************************************
  *
  * @brief   Searcher in KD Tree provides services related to searching in KD Tree.
+ * @details Metric that is used for searching is defined by policy 'TypeMetric' (see
+ *          'utils::metric'), distances that are returned by the searcher are represented in
+ *          comparable form of the metric (for example, square of Euclidean distance). Tree is
+ *          traversed using explicit stack that is kept by the searcher, so consecutive searches
+ *          by the same searcher do not allocate memory when capacity of the stack is enough.
  *
  ***********************************************************************************************/
-class kdtree_searcher {
+template <typename TypeMetric>
+class basic_kdtree_searcher {
+private:
+	using nearest_candidate = std::pair<double, kdnode *>;
+
 private:
-	std::vector<double>	*	nodes_distance;
-	std::vector<kdnode *> * nearest_nodes;
+	std::vector<double>	*	nodes_distance	= nullptr;
+	std::vector<kdnode *> * nearest_nodes	= nullptr;
+
+	TypeMetric				metric;
+	double					distance			= 0.0;
+	double					sqrt_distance		= 0.0;		/* radius of searching in comparable form of the metric */
+	kdnode *				initial_node		= nullptr;
+	std::vector<double> *	search_point		= nullptr;
+	std::size_t				visited_nodes		= 0;	/* amount of nodes visited since the request has been initialized */
 
-	double					distance;
-	double					sqrt_distance;
-	kdnode *				initial_node;
-	std::vector<double> *	search_point;
+	std::vector<nearest_candidate>	candidates;		/* max-heap of the nearest nodes that is reused by searches */
+	std::vector<nearest_candidate>	stack;			/* subtrees that should be visited with lower bounds of distance to them */
 
 private:
 	/***********************************************************************************************
 	*
-	* @brief   Recursive method for searching nodes that satisfy the request.
+	* @brief   Searches nodes that satisfy the request, found nodes are appended in the same order
+	*          as by post-order traversal (right subtree, left subtree, node).
 	*
 	* @param   node               - initial node in tree from which searching should performed.
 	*
 	***********************************************************************************************/
-	void recursive_nearest_nodes(kdnode * node);
+	void traverse_nearest_nodes(kdnode * node);
+
+	/***********************************************************************************************
+	*
+	* @brief   Searches the specified amount of the nearest nodes.
+	* @details Candidates are stored in max-heap, when the heap is full the farthest candidate
+	*          becomes radius of searching that is used to skip subtrees.
+	*
+	* @param   node               - initial node in tree from which searching should performed.
+	* @param   amount             - maximum amount of nodes that should be found.
+	* @param   excluded_payload   - nodes with this payload are not considered (if it is not null).
+	* @param   candidates         - max-heap of found nodes and distances to them.
+	*
+	***********************************************************************************************/
+	void traverse_k_nearest_nodes(kdnode * node, const std::size_t amount, const void * excluded_payload, std::vector<nearest_candidate> & candidates);
 
 	/***********************************************************************************************
 	*
@@ -270,7 +529,17 @@ public:
 	* @brief   Default constructor. Search will not be performed until it's initialized.
 	*
 	***********************************************************************************************/
-	kdtree_searcher(void);
+	basic_kdtree_searcher(void);
+
+	/***********************************************************************************************
+	*
+	* @brief   Constructor of searcher that uses specified metric, search will not be performed
+	*          until it's initialized.
+	*
+	* @param   (in) metric_search      - metric that is used to calculate distance between points.
+	*
+	***********************************************************************************************/
+	explicit basic_kdtree_searcher(const TypeMetric & metric_search);
 
 	/***********************************************************************************************
 	*
@@ -279,16 +548,17 @@ public:
 	* @param   (in) point              - point for which nearest nodes should be found.
 	* @param   (in) node               - initial node in tree from which searching should started.
 	* @param   (in) radius_search      - allowable distance for searching from the point.
+	* @param   (in) metric_search      - metric that is used to calculate distance between points.
 	*
 	***********************************************************************************************/
-	kdtree_searcher(std::vector<double> * point, kdnode * node, const double radius_search);
+	basic_kdtree_searcher(std::vector<double> * point, kdnode * node, const double radius_search, const TypeMetric & metric_search = TypeMetric());
 
 	/***********************************************************************************************
 	*
 	* @brief   Default destructor.
 	*
 	***********************************************************************************************/
-	~kdtree_searcher(void);
+	~basic_kdtree_searcher(void);
 
 	/***********************************************************************************************
 	*
@@ -311,16 +581,116 @@ public:
 	***********************************************************************************************/
 	std::vector<kdnode *> * find_nearest_nodes(std::vector<double> * distances = nullptr);
 
+	/***********************************************************************************************
+	*
+	* @brief   Search nodes that are located in specified distance from specified point without
+	*          allocation of result containers.
+	*
+	* @param   (out) nodes             - vector where found nodes are appended.
+	* @param   (out) distances         - vector where distances to found nodes are appended.
+	*
+	***********************************************************************************************/
+	void find_nearest_nodes(std::vector<kdnode *> & nodes, std::vector<double> & distances);
+
+	/***********************************************************************************************
+	*
+	* @brief   Search the specified amount of the nearest nodes in specified location for specified
+	*          point in the request.
+	*
+	* @param   (in) amount             - maximum amount of nodes that should be found.
+	* @param   (out) distances         - distances to found nodes (optional).
+	* @param   (in) excluded_payload   - nodes with this payload are not considered (optional).
+	*
+	* @return  Return vector of found nodes sorted by distance from the point, the vector is owned
+	*          by application. Less nodes are returned if there are not enough nodes in the location.
+	*
+	***********************************************************************************************/
+	std::vector<kdnode *> * find_k_nearest_nodes(const std::size_t amount, std::vector<double> * distances = nullptr, const void * excluded_payload = nullptr);
+
+	/***********************************************************************************************
+	*
+	* @brief   Search the specified amount of the nearest nodes without allocation of result
+	*          containers, memory of candidates is reused by consecutive searches.
+	*
+	* @param   (in) amount             - maximum amount of nodes that should be found.
+	* @param   (out) nodes             - vector where found nodes are appended in order of distance.
+	* @param   (out) distances         - vector where distances to found nodes are appended.
+	* @param   (in) excluded_payload   - nodes with this payload are not considered (optional).
+	*
+	***********************************************************************************************/
+	void find_k_nearest_nodes(const std::size_t amount, std::vector<kdnode *> & nodes, std::vector<double> & distances, const void * excluded_payload = nullptr);
+
 	/***********************************************************************************************
 	*
 	* @brief   Search the nearest node in specified location for specified point in the request.
 	*
-	* @return  Return pointer to the nearest node in kd tree that satisfy the request.
+	* @param   (out) nearest_distance  - distance to the nearest node (optional).
+	* @param   (in) excluded_payload   - nodes with this payload are not considered (optional).
+	*
+	* @return  Return pointer to the nearest node in kd tree that satisfy the request, null if
+	*          there is no such node.
 	*
 	***********************************************************************************************/
-	kdnode * find_nearest_node(void);
+	kdnode * find_nearest_node(double * nearest_distance = nullptr, const void * excluded_payload = nullptr);
+
+	/***********************************************************************************************
+	*
+	* @brief   Returns amount of tree nodes that have been visited by searches of the current request.
+	*
+	***********************************************************************************************/
+	std::size_t get_visited_nodes(void) const;
 };
 
+
+/***********************************************************************************************
+ *
+ * @brief   Searcher in KD Tree that uses Euclidean distance.
+ *
+ ***********************************************************************************************/
+using kdtree_searcher = basic_kdtree_searcher<utils::metric::euclidean>;
+
+
+template <typename TypeMetric, typename TypeQuery>
+kdtree_neighbor_lists kdtree::find_batch(const dataset_view & queries, const double radius_search, const TypeMetric & metric_search, const TypeQuery & query) const {
+	struct query_scratch {
+		std::unique_ptr<basic_kdtree_searcher<TypeMetric>>	searcher;
+		std::vector<double>									point;
+	};
+
+	return kdtree_neighbor_lists::create(queries.size(),
+		[&metric_search, &queries]() {
+			query_scratch scratch;
+			scratch.searcher.reset(new basic_kdtree_searcher<TypeMetric>(metric_search));
+			scratch.point.resize(queries.dimension());
+			return scratch;
+		},
+		[this, &queries, radius_search, &query](query_scratch & scratch, const std::size_t index, std::vector<kdnode *> & nodes, std::vector<double> & distances) {
+			if (root == nullptr) {
+				return;
+			}
+
+			std::copy(queries[index], queries[index] + queries.dimension(), scratch.point.begin());
+			scratch.searcher->initialize(&scratch.point, root, radius_search);
+			query(*scratch.searcher, nodes, distances);
+		});
+}
+
+
+template <typename TypeMetric>
+kdtree_neighbor_lists kdtree::find_nearest_nodes(const dataset_view & queries, const double radius_search, const TypeMetric & metric_search) const {
+	return find_batch(queries, radius_search, metric_search, [](basic_kdtree_searcher<TypeMetric> & searcher, std::vector<kdnode *> & nodes, std::vector<double> & distances) {
+		searcher.find_nearest_nodes(nodes, distances);
+	});
+}
+
+
+template <typename TypeMetric>
+kdtree_neighbor_lists kdtree::find_k_nearest_nodes(const dataset_view & queries, const std::size_t amount, const TypeMetric & metric_search) const {
+	return find_batch(queries, std::numeric_limits<double>::max(), metric_search, [amount](basic_kdtree_searcher<TypeMetric> & searcher, std::vector<kdnode *> & nodes, std::vector<double> & distances) {
+		searcher.find_k_nearest_nodes(amount, nodes, distances);
+	});
+}
+
 }
 
 #endif
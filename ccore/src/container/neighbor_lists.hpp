@@ -0,0 +1,249 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#ifndef SRC_CONTAINER_NEIGHBOR_LISTS_HPP_
+#define SRC_CONTAINER_NEIGHBOR_LISTS_HPP_
+
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "parallel/parallel.hpp"
+
+
+namespace container {
+
+
+/**
+*
+* @brief    Results of a batch of neighbor queries packed in compressed sparse row (CSR) form.
+* @details  Neighbors of query 'i' and distances to them are stored at positions
+*           [offsets[i], offsets[i + 1]) of 'neighbors' and 'distances'. Type of neighbor depends
+*           on the container that is queried, for example, index of point or pointer to tree node.
+*
+*/
+template <typename TypeNeighbor>
+class basic_neighbor_lists {
+public:
+    using neighbor_type = TypeNeighbor;
+
+    /**
+    *
+    * @brief    Amount of queries that are processed by a task with common scratch buffers.
+    *
+    */
+    static const std::size_t QUERY_BLOCK_SIZE = 128;
+
+private:
+    std::vector<std::size_t>    m_offsets;
+    std::vector<neighbor_type>  m_neighbors;
+    std::vector<double>         m_distances;
+
+public:
+    /**
+    *
+    * @brief    Default constructor that creates results without queries.
+    *
+    */
+    basic_neighbor_lists(void) :
+        m_offsets(1, 0)
+    { }
+
+    /**
+    *
+    * @brief    Creates results from arrays of compressed sparse row form.
+    *
+    * @param[in] p_offsets: offsets of neighbors of each query, amount of offsets is amount of queries plus one.
+    * @param[in] p_neighbors: neighbors of all queries one after another.
+    * @param[in] p_distances: distances to neighbors of all queries one after another.
+    *
+    */
+    basic_neighbor_lists(std::vector<std::size_t> && p_offsets, std::vector<neighbor_type> && p_neighbors, std::vector<double> && p_distances) :
+        m_offsets(std::move(p_offsets)),
+        m_neighbors(std::move(p_neighbors)),
+        m_distances(std::move(p_distances))
+    { }
+
+    basic_neighbor_lists(const basic_neighbor_lists & p_other) = default;
+
+    basic_neighbor_lists(basic_neighbor_lists && p_other) = default;
+
+    ~basic_neighbor_lists(void) = default;
+
+public:
+    /**
+    *
+    * @brief    Performs queries in parallel and packs their results.
+    * @details  Queries are split into blocks of 'QUERY_BLOCK_SIZE', each block is processed by one
+    *           task that reuses scratch buffers and stores results of the block contiguously, then
+    *           blocks are copied to the final arrays.
+    *
+    * @param[in] p_amount: amount of queries.
+    * @param[in] p_create_scratch: callable object that returns scratch state of a task.
+    * @param[in] p_query: callable object that is called as 'p_query(scratch, index_query, neighbors,
+    *             distances)' and appends results of the query to the vectors.
+    *
+    * @return   Returns results of all queries.
+    *
+    */
+    template <typename TypeCreateScratch, typename TypeQuery>
+    static basic_neighbor_lists create(const std::size_t p_amount, const TypeCreateScratch & p_create_scratch, const TypeQuery & p_query) {
+        struct query_block {
+            std::vector<std::size_t>    m_lengths;
+            std::vector<neighbor_type>  m_neighbors;
+            std::vector<double>         m_distances;
+        };
+
+        const std::size_t amount_blocks = (p_amount + QUERY_BLOCK_SIZE - 1) / QUERY_BLOCK_SIZE;
+        std::vector<query_block> blocks(amount_blocks);
+
+        parallel::parallel_for(std::size_t(0), amount_blocks, [&](const std::size_t p_index_block) {
+            auto scratch = p_create_scratch();
+
+            query_block & block = blocks[p_index_block];
+            const std::size_t begin = p_index_block * QUERY_BLOCK_SIZE;
+            const std::size_t end = std::min(begin + QUERY_BLOCK_SIZE, p_amount);
+
+            for (std::size_t index = begin; index < end; index++) {
+                const std::size_t length_before = block.m_neighbors.size();
+                p_query(scratch, index, block.m_neighbors, block.m_distances);
+                block.m_lengths.push_back(block.m_neighbors.size() - length_before);
+            }
+        });
+
+        basic_neighbor_lists result;
+        result.m_offsets.resize(p_amount + 1, 0);
+
+        std::vector<std::size_t> block_offsets(amount_blocks + 1, 0);
+        for (std::size_t index_block = 0; index_block < amount_blocks; index_block++) {
+            block_offsets[index_block + 1] = block_offsets[index_block] + blocks[index_block].m_neighbors.size();
+
+            std::size_t index_query = index_block * QUERY_BLOCK_SIZE;
+            for (const std::size_t length : blocks[index_block].m_lengths) {
+                result.m_offsets[index_query + 1] = result.m_offsets[index_query] + length;
+                index_query++;
+            }
+        }
+
+        result.m_neighbors.resize(block_offsets.back());
+        result.m_distances.resize(block_offsets.back());
+
+        parallel::parallel_for(std::size_t(0), amount_blocks, [&](const std::size_t p_index_block) {
+            query_block & block = blocks[p_index_block];
+            std::copy(block.m_neighbors.begin(), block.m_neighbors.end(), result.m_neighbors.begin() + block_offsets[p_index_block]);
+            std::copy(block.m_distances.begin(), block.m_distances.end(), result.m_distances.begin() + block_offsets[p_index_block]);
+
+            block = query_block();
+        });
+
+        return result;
+    }
+
+public:
+    /**
+    *
+    * @brief    Returns amount of queries.
+    *
+    */
+    std::size_t size(void) const { return m_offsets.size() - 1; }
+
+    /**
+    *
+    * @brief    Returns total amount of found neighbors of all queries.
+    *
+    */
+    std::size_t total(void) const { return m_neighbors.size(); }
+
+    /**
+    *
+    * @brief    Returns amount of neighbors that are found for the specified query.
+    *
+    * @param[in] p_index: index of the query.
+    *
+    */
+    std::size_t amount(const std::size_t p_index) const { return m_offsets[p_index + 1] - m_offsets[p_index]; }
+
+    /**
+    *
+    * @brief    Returns pointer to the first neighbor of the specified query.
+    *
+    * @param[in] p_index: index of the query.
+    *
+    */
+    const neighbor_type * begin_neighbors(const std::size_t p_index) const { return m_neighbors.data() + m_offsets[p_index]; }
+
+    /**
+    *
+    * @brief    Returns pointer that follows the last neighbor of the specified query.
+    *
+    * @param[in] p_index: index of the query.
+    *
+    */
+    const neighbor_type * end_neighbors(const std::size_t p_index) const { return m_neighbors.data() + m_offsets[p_index + 1]; }
+
+    /**
+    *
+    * @brief    Returns pointer to distance to the first neighbor of the specified query.
+    *
+    * @param[in] p_index: index of the query.
+    *
+    */
+    const double * begin_distances(const std::size_t p_index) const { return m_distances.data() + m_offsets[p_index]; }
+
+    /**
+    *
+    * @brief    Returns offsets of neighbors of each query, amount of offsets is 'size() + 1'.
+    *
+    */
+    const std::vector<std::size_t> & offsets(void) const { return m_offsets; }
+
+    /**
+    *
+    * @brief    Returns neighbors of all queries one after another.
+    *
+    */
+    const std::vector<neighbor_type> & neighbors(void) const { return m_neighbors; }
+
+    /**
+    *
+    * @brief    Returns distances to neighbors of all queries one after another.
+    *
+    */
+    const std::vector<double> & distances(void) const { return m_distances; }
+};
+
+
+template <typename TypeNeighbor>
+const std::size_t basic_neighbor_lists<TypeNeighbor>::QUERY_BLOCK_SIZE;
+
+
+/**
+*
+* @brief    Results of a batch of neighbor queries where neighbors are represented by indexes of points.
+*
+*/
+using neighbor_lists = basic_neighbor_lists<std::size_t>;
+
+
+}
+
+
+#endif
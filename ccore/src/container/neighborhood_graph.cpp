@@ -0,0 +1,140 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#include "container/neighborhood_graph.hpp"
+
+
+namespace container {
+
+
+neighborhood_graph::neighborhood_graph(void) :
+    m_offsets(1, 0)
+{ }
+
+
+neighborhood_graph::neighborhood_graph(const neighbor_lists & p_lists, const double p_radius, const utils::metric::type_metric p_metric, const double p_degree) :
+    m_offsets(p_lists.size() + 1, 0),
+    m_radius(p_radius),
+    m_metric(p_metric),
+    m_degree(p_degree)
+{
+    /* the point itself is expected in its list, but it is not required: offsets are built from neighbors that are actually copied */
+    parallel::parallel_for(std::size_t(0), p_lists.size(), [this, &p_lists](const std::size_t p_index) {
+        m_offsets[p_index + 1] = static_cast<std::size_t>(std::count_if(p_lists.begin_neighbors(p_index), p_lists.end_neighbors(p_index),
+            [p_index](const std::size_t p_neighbor) { return p_neighbor != p_index; }));
+    });
+
+    for (std::size_t index = 0; index < p_lists.size(); index++) {
+        m_offsets[index + 1] += m_offsets[index];
+    }
+
+    m_neighbors.resize(m_offsets.back());
+    m_distances.resize(m_offsets.back());
+
+    parallel::parallel_for(std::size_t(0), p_lists.size(), [this, &p_lists](const std::size_t p_index) {
+        std::size_t position = m_offsets[p_index];
+
+        const std::size_t * neighbor = p_lists.begin_neighbors(p_index);
+        const double * distance = p_lists.begin_distances(p_index);
+
+        for (; neighbor != p_lists.end_neighbors(p_index); neighbor++, distance++) {
+            if (*neighbor != p_index) {
+                m_neighbors[position] = *neighbor;
+                m_distances[position] = *distance;
+                position++;
+            }
+        }
+    });
+}
+
+
+void neighborhood_graph::sort_by_index(const std::size_t p_begin, neighbor_row & p_row, std::vector<std::size_t> & p_neighbors, std::vector<double> & p_distances) {
+    p_row.clear();
+    for (std::size_t index = p_begin; index < p_neighbors.size(); index++) {
+        p_row.emplace_back(p_neighbors[index], p_distances[index]);
+    }
+
+    std::sort(p_row.begin(), p_row.end(), [](const auto & p_left, const auto & p_right) { return p_left.first < p_right.first; });
+
+    std::size_t position = p_begin;
+    for (const auto & neighbor : p_row) {
+        p_neighbors[position] = neighbor.first;
+        p_distances[position] = neighbor.second;
+        position++;
+    }
+}
+
+
+std::size_t neighborhood_graph::size(void) const {
+    return m_offsets.size() - 1;
+}
+
+
+std::size_t neighborhood_graph::edges(void) const {
+    return m_neighbors.size();
+}
+
+
+double neighborhood_graph::radius(void) const {
+    return m_radius;
+}
+
+
+utils::metric::type_metric neighborhood_graph::metric(void) const {
+    return m_metric;
+}
+
+
+std::size_t neighborhood_graph::degree(const std::size_t p_index) const {
+    return m_offsets[p_index + 1] - m_offsets[p_index];
+}
+
+
+const std::size_t * neighborhood_graph::begin_neighbors(const std::size_t p_index) const {
+    return m_neighbors.data() + m_offsets[p_index];
+}
+
+
+const std::size_t * neighborhood_graph::end_neighbors(const std::size_t p_index) const {
+    return m_neighbors.data() + m_offsets[p_index + 1];
+}
+
+
+const double * neighborhood_graph::begin_distances(const std::size_t p_index) const {
+    return m_distances.data() + m_offsets[p_index];
+}
+
+
+const std::vector<std::size_t> & neighborhood_graph::offsets(void) const {
+    return m_offsets;
+}
+
+
+const std::vector<std::size_t> & neighborhood_graph::neighbors(void) const {
+    return m_neighbors;
+}
+
+
+const std::vector<double> & neighborhood_graph::distances(void) const {
+    return m_distances;
+}
+
+
+}
@@ -0,0 +1,294 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#ifndef SRC_CONTAINER_NEIGHBORHOOD_GRAPH_HPP_
+#define SRC_CONTAINER_NEIGHBORHOOD_GRAPH_HPP_
+
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "container/ball_tree.hpp"
+#include "container/static_kdtree.hpp"
+
+#include "definitions.hpp"
+
+#include "parallel/parallel.hpp"
+
+#include "utils/metric.hpp"
+
+
+namespace container {
+
+
+/**
+*
+* @brief    Graph of radius neighborhoods of points (eps-neighborhood graph) that is stored in
+*           compressed sparse row (CSR) form.
+* @details  Neighbors of point 'i' are placed in range [offsets[i], offsets[i + 1]) of arrays of
+*           neighbors and distances, they are sorted by index and the point itself is not included.
+*           Distances are stored in comparable form of the metric that has been used to build the
+*           graph, so algorithms that use the same metric filter them by their own radius that is
+*           less or equal to radius of the graph without any distance calculation. It allows to
+*           build the graph once per data and radius and run the algorithm with several parameters.
+*           The graph keeps type of the metric, so algorithms reject graphs that are built with
+*           another metric (see 'is_built_with').
+*
+*/
+class neighborhood_graph {
+private:
+    using neighbor_row = std::vector< std::pair<std::size_t, double> >;
+
+private:
+    std::vector<std::size_t>    m_offsets;
+    std::vector<std::size_t>    m_neighbors;
+    std::vector<double>         m_distances;    /* distances to neighbors in comparable form of the metric */
+    double                      m_radius        = 0.0;
+    utils::metric::type_metric  m_metric        = utils::metric::type_metric::EUCLIDEAN;
+    double                      m_degree        = 0.0;          /* degree of Minkowski metric, zero for other metrics */
+
+public:
+    /**
+    *
+    * @brief    Default constructor that creates graph without points.
+    *
+    */
+    neighborhood_graph(void);
+
+    neighborhood_graph(const neighborhood_graph & p_other) = default;
+
+    neighborhood_graph(neighborhood_graph && p_other) = default;
+
+    ~neighborhood_graph(void) = default;
+
+private:
+    /**
+    *
+    * @brief    Creates graph from result of all-pairs range search where each point is usually
+    *           neighbor of itself, such neighbors are removed.
+    *
+    * @param[in] p_lists: neighbors of each point sorted by index and comparable distances to them.
+    * @param[in] p_radius: connectivity radius that has been used to find neighbors.
+    * @param[in] p_metric: type of the metric that has been used to find neighbors.
+    * @param[in] p_degree: degree of Minkowski metric, zero for other metrics.
+    *
+    */
+    neighborhood_graph(const neighbor_lists & p_lists, const double p_radius, const utils::metric::type_metric p_metric, const double p_degree);
+
+public:
+    /**
+    *
+    * @brief    Builds graph where points are connected if distance between them is less or equal
+    *           to specified radius.
+    * @details  Neighbors are found by dual-tree traversal of static KD-tree if it is suitable for
+    *           dimension of data and the metric (see 'static_kdtree::is_suitable'), otherwise by
+    *           ball tree if the metric satisfies triangle inequality and there are enough points,
+    *           otherwise each point is compared with all points. Work is distributed between threads
+    *           of the global pool.
+    *
+    * @param[in] p_data: points for that graph is built.
+    * @param[in] p_radius: connectivity radius in terms of the metric.
+    * @param[in] p_metric: metric that is used to calculate distance between points.
+    *
+    */
+    template <typename TypeMetric>
+    static neighborhood_graph create(const dataset_view & p_data, const double p_radius, const TypeMetric & p_metric = TypeMetric());
+
+private:
+    template <typename TypeMetric>
+    static double get_degree(const TypeMetric &) { return 0.0; }
+
+    static double get_degree(const utils::metric::minkowski & p_metric) { return p_metric.get_degree(); }
+
+    static void sort_by_index(const std::size_t p_begin, neighbor_row & p_row, std::vector<std::size_t> & p_neighbors, std::vector<double> & p_distances);
+
+public:
+    /**
+    *
+    * @brief    Returns amount of points (vertices) in the graph.
+    *
+    */
+    std::size_t size(void) const;
+
+    /**
+    *
+    * @brief    Returns amount of stored edges, each connection between two points is stored twice -
+    *           in neighbors of both points.
+    *
+    */
+    std::size_t edges(void) const;
+
+    /**
+    *
+    * @brief    Returns connectivity radius that has been used to build the graph.
+    *
+    */
+    double radius(void) const;
+
+    /**
+    *
+    * @brief    Returns type of the metric that has been used to build the graph.
+    *
+    */
+    utils::metric::type_metric metric(void) const;
+
+    /**
+    *
+    * @brief    Returns true if the graph has been built using the specified metric, so its radius
+    *           and distances are expressed in terms of the metric.
+    *
+    * @param[in] p_metric: metric that is compared with the metric of the graph.
+    *
+    */
+    template <typename TypeMetric>
+    bool is_built_with(const TypeMetric & p_metric) const {
+        return (m_metric == TypeMetric::TYPE) && (m_degree == get_degree(p_metric));
+    }
+
+    /**
+    *
+    * @brief    Returns amount of neighbors of the specified point.
+    *
+    * @param[in] p_index: index of the point.
+    *
+    */
+    std::size_t degree(const std::size_t p_index) const;
+
+    /**
+    *
+    * @brief    Returns pointer to the first neighbor of the specified point.
+    *
+    * @param[in] p_index: index of the point.
+    *
+    */
+    const std::size_t * begin_neighbors(const std::size_t p_index) const;
+
+    /**
+    *
+    * @brief    Returns pointer that follows the last neighbor of the specified point.
+    *
+    * @param[in] p_index: index of the point.
+    *
+    */
+    const std::size_t * end_neighbors(const std::size_t p_index) const;
+
+    /**
+    *
+    * @brief    Returns pointer to comparable distance to the first neighbor of the specified point.
+    *
+    * @param[in] p_index: index of the point.
+    *
+    */
+    const double * begin_distances(const std::size_t p_index) const;
+
+    /**
+    *
+    * @brief    Calls action for each neighbor of the specified point with index of the neighbor
+    *           and comparable distance to it.
+    *
+    * @param[in] p_index: index of the point.
+    * @param[in] p_action: action that is called as 'p_action(index_neighbor, distance)'.
+    *
+    */
+    template <typename TypeAction>
+    void for_each_neighbor(const std::size_t p_index, const TypeAction & p_action) const {
+        for (std::size_t position = m_offsets[p_index]; position < m_offsets[p_index + 1]; position++) {
+            p_action(m_neighbors[position], m_distances[position]);
+        }
+    }
+
+    /**
+    *
+    * @brief    Returns offsets of neighbors of each point, amount of offsets is 'size() + 1'.
+    *
+    */
+    const std::vector<std::size_t> & offsets(void) const;
+
+    /**
+    *
+    * @brief    Returns neighbors of all points one after another.
+    *
+    */
+    const std::vector<std::size_t> & neighbors(void) const;
+
+    /**
+    *
+    * @brief    Returns comparable distances to neighbors of all points one after another.
+    *
+    */
+    const std::vector<double> & distances(void) const;
+};
+
+
+template <typename TypeMetric>
+neighborhood_graph neighborhood_graph::create(const dataset_view & p_data, const double p_radius, const TypeMetric & p_metric) {
+    if (p_radius < 0.0) {
+        throw std::invalid_argument("CCORE [neighborhood_graph]: connectivity radius should not be negative.");
+    }
+
+    const double degree = get_degree(p_metric);
+    if (p_data.empty()) {
+        return neighborhood_graph(neighbor_lists(), p_radius, TypeMetric::TYPE, degree);
+    }
+
+    const double comparable_radius = p_metric.to_comparable(p_radius);
+
+    if (static_kdtree::is_suitable(p_data.dimension(), p_metric)) {
+        const static_kdtree tree(p_data);
+        return neighborhood_graph(tree.find_all_neighbors(comparable_radius, p_metric), p_radius, TypeMetric::TYPE, degree);
+    }
+    else if ( (p_data.size() >= basic_ball_tree<TypeMetric>::MINIMUM_SIZE) && basic_ball_tree<TypeMetric>::is_suitable(p_metric) ) {
+        using scratch = std::pair<typename basic_ball_tree<TypeMetric>::search_buffer, neighbor_row>;
+
+        const basic_ball_tree<TypeMetric> tree(p_data, p_metric);
+        const neighbor_lists lists = neighbor_lists::create(p_data.size(), []() { return scratch(); },
+            [&tree, &p_data, comparable_radius](scratch & p_scratch, const std::size_t p_index, std::vector<std::size_t> & p_neighbors, std::vector<double> & p_distances) {
+                const std::size_t begin = p_neighbors.size();
+                tree.find_radius(p_data[p_index], comparable_radius, p_scratch.first, p_neighbors, p_distances);
+                sort_by_index(begin, p_scratch.second, p_neighbors, p_distances);
+            });
+
+        return neighborhood_graph(lists, p_radius, TypeMetric::TYPE, degree);
+    }
+
+    /* distances from a point to all points are placed to the buffer of the task that processes the point */
+    const neighbor_lists lists = neighbor_lists::create(p_data.size(), [&p_data]() { return std::vector<double>(p_data.size()); },
+        [&p_data, &p_metric, comparable_radius](std::vector<double> & p_buffer, const std::size_t p_index, std::vector<std::size_t> & p_neighbors, std::vector<double> & p_distances) {
+            p_metric.comparable_block(p_data[p_index], p_data, p_buffer.data());
+
+            for (std::size_t index_neighbor = 0; index_neighbor < p_data.size(); index_neighbor++) {
+                if (p_buffer[index_neighbor] <= comparable_radius) {
+                    p_neighbors.push_back(index_neighbor);
+                    p_distances.push_back(p_buffer[index_neighbor]);
+                }
+            }
+        });
+
+    return neighborhood_graph(lists, p_radius, TypeMetric::TYPE, degree);
+}
+
+
+}
+
+
+#endif
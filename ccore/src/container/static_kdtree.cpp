@@ -0,0 +1,460 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#include "container/static_kdtree.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+
+namespace container {
+
+
+template <typename TypeValue>
+const std::size_t basic_static_kdtree<TypeValue>::DEFAULT_BUCKET_SIZE = 32;
+
+template <typename TypeValue>
+const std::size_t basic_static_kdtree<TypeValue>::DIMENSION_LIMIT = 16;
+
+template <typename TypeValue>
+const std::size_t basic_static_kdtree<TypeValue>::MINIMUM_SIZE = 256;
+
+template <typename TypeValue>
+const std::size_t basic_static_kdtree<TypeValue>::DUAL_TREE_TASKS = 256;
+
+template <typename TypeValue>
+const std::size_t basic_static_kdtree<TypeValue>::FILE_ALIGNMENT = 64;
+
+template <typename TypeValue>
+const std::uint32_t basic_static_kdtree<TypeValue>::FILE_VERSION = 1;
+
+template <typename TypeValue>
+const std::size_t basic_static_kdtree<TypeValue>::CHECK_SAMPLES = 64;
+
+
+static const char STATIC_KDTREE_FILE_MAGIC[8] = { 'P', 'Y', 'C', 'L', 'K', 'D', 'T', 'R' };
+
+
+static std::uint64_t align_offset(const std::uint64_t p_offset, const std::size_t p_alignment) {
+    return ((p_offset + p_alignment - 1) / p_alignment) * p_alignment;
+}
+
+
+template <typename TypeValue>
+basic_static_kdtree<TypeValue>::basic_static_kdtree(const container::dense_matrix_view<TypeValue> & p_data, const std::size_t p_bucket_size) :
+    m_size(p_data.size()),
+    m_dimension(p_data.dimension()),
+    m_bucket_size(std::max(std::size_t(1), p_bucket_size))
+{
+    if (p_data.empty()) {
+        return;
+    }
+
+    std::vector<std::size_t> order(m_size);
+    for (std::size_t index = 0; index < m_size; index++) {
+        order[index] = index;
+    }
+
+    m_nodes.reserve(2 * (m_size / m_bucket_size) + 1);
+    m_bounds.reserve(m_nodes.capacity() * 2 * m_dimension);
+    create_node(order, 0, m_size, p_data);
+
+    m_coordinates.resize(m_size * m_dimension);
+    for (std::size_t position = 0; position < m_size; position++) {
+        const TypeValue * const point = p_data[order[position]];
+        for (std::size_t index_dimension = 0; index_dimension < m_dimension; index_dimension++) {
+            m_coordinates[index_dimension * m_size + position] = point[index_dimension];
+        }
+    }
+
+    m_indexes = std::move(order);
+    attach();
+}
+
+
+template <typename TypeValue>
+basic_static_kdtree<TypeValue>::basic_static_kdtree(const basic_static_kdtree & p_other) :
+    m_nodes(p_other.m_nodes),
+    m_coordinates(p_other.m_coordinates),
+    m_bounds(p_other.m_bounds),
+    m_indexes(p_other.m_indexes),
+    m_size(p_other.m_size),
+    m_dimension(p_other.m_dimension),
+    m_bucket_size(p_other.m_bucket_size),
+    m_maximum_leaf(p_other.m_maximum_leaf),
+    m_node_data(p_other.m_node_data),
+    m_coordinate_data(p_other.m_coordinate_data),
+    m_bound_data(p_other.m_bound_data),
+    m_index_data(p_other.m_index_data),
+    m_amount_nodes(p_other.m_amount_nodes),
+    m_file(p_other.m_file)
+{
+    /* mapped file is shared by copies, built arrays are copied and pointers should refer to the copies */
+    if (!m_file) {
+        attach();
+    }
+}
+
+
+template <typename TypeValue>
+std::size_t basic_static_kdtree<TypeValue>::size(void) const {
+    return m_size;
+}
+
+
+template <typename TypeValue>
+std::size_t basic_static_kdtree<TypeValue>::dimension(void) const {
+    return m_dimension;
+}
+
+
+template <typename TypeValue>
+std::size_t basic_static_kdtree<TypeValue>::amount_nodes(void) const {
+    return m_amount_nodes;
+}
+
+
+template <typename TypeValue>
+bool basic_static_kdtree<TypeValue>::is_built_for(const container::dense_matrix_view<TypeValue> & p_data) const {
+    if ( (m_size != p_data.size()) || (!p_data.empty() && (m_dimension != p_data.dimension())) ) {
+        return false;
+    }
+
+    const std::size_t amount_samples = std::min(m_size, CHECK_SAMPLES);
+    for (std::size_t index_sample = 0; index_sample < amount_samples; index_sample++) {
+        /* the first and the last positions are always checked */
+        const std::size_t position = (index_sample + 1 == amount_samples) ? m_size - 1 : index_sample * (m_size / amount_samples);
+        const TypeValue * const point = p_data[m_index_data[position]];
+
+        for (std::size_t index_dimension = 0; index_dimension < m_dimension; index_dimension++) {
+            /* coordinates are copied as is, so they are compared bitwise (NaN is equal to itself) */
+            const TypeValue stored = m_coordinate_data[index_dimension * m_size + position];
+            if (std::memcmp(&stored, point + index_dimension, sizeof(TypeValue)) != 0) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+template <typename TypeValue>
+void basic_static_kdtree<TypeValue>::write(const std::string & p_path) const {
+    const std::uint64_t nodes_length = m_amount_nodes * sizeof(node);
+    const std::uint64_t coordinates_length = m_size * m_dimension * sizeof(TypeValue);
+    const std::uint64_t bounds_length = m_amount_nodes * 2 * m_dimension * sizeof(TypeValue);
+    const std::uint64_t indexes_length = m_size * sizeof(std::size_t);
+
+    file_header header;
+    std::memset(&header, 0, sizeof(file_header));
+    std::memcpy(header.m_magic, STATIC_KDTREE_FILE_MAGIC, sizeof(STATIC_KDTREE_FILE_MAGIC));
+    header.m_version = FILE_VERSION;
+    header.m_node_size = sizeof(node);
+    header.m_value_size = sizeof(TypeValue);
+    header.m_index_size = sizeof(std::size_t);
+    header.m_size = m_size;
+    header.m_dimension = m_dimension;
+    header.m_bucket_size = m_bucket_size;
+    header.m_maximum_leaf = m_maximum_leaf;
+    header.m_amount_nodes = m_amount_nodes;
+    header.m_nodes_offset = align_offset(sizeof(file_header), FILE_ALIGNMENT);
+    header.m_coordinates_offset = align_offset(header.m_nodes_offset + nodes_length, FILE_ALIGNMENT);
+    header.m_bounds_offset = align_offset(header.m_coordinates_offset + coordinates_length, FILE_ALIGNMENT);
+    header.m_indexes_offset = align_offset(header.m_bounds_offset + bounds_length, FILE_ALIGNMENT);
+
+    std::ofstream stream(p_path, std::ios::binary | std::ios::trunc);
+    if (!stream.is_open()) {
+        throw std::runtime_error("CCORE [static_kdtree]: file '" + p_path + "' can not be created.");
+    }
+
+    std::uint64_t position = 0;
+    const auto write_array = [&stream, &position](const std::uint64_t p_offset, const void * p_array, const std::uint64_t p_length) {
+        const std::vector<char> padding(p_offset - position, 0);
+        stream.write(padding.data(), padding.size());
+
+        if (p_length > 0) {
+            stream.write(static_cast<const char *>(p_array), p_length);
+        }
+
+        position = p_offset + p_length;
+    };
+
+    write_array(0, &header, sizeof(file_header));
+    write_array(header.m_nodes_offset, m_node_data, nodes_length);
+    write_array(header.m_coordinates_offset, m_coordinate_data, coordinates_length);
+    write_array(header.m_bounds_offset, m_bound_data, bounds_length);
+    write_array(header.m_indexes_offset, m_index_data, indexes_length);
+
+    if (!stream.good()) {
+        throw std::runtime_error("CCORE [static_kdtree]: file '" + p_path + "' can not be written.");
+    }
+}
+
+
+template <typename TypeValue>
+basic_static_kdtree<TypeValue> basic_static_kdtree<TypeValue>::open(const std::string & p_path) {
+    std::shared_ptr<const utils::mapped_file> file = std::make_shared<const utils::mapped_file>(p_path);
+    if (file->length() < sizeof(file_header)) {
+        throw std::runtime_error("CCORE [static_kdtree]: file '" + p_path + "' is too short to be tree file.");
+    }
+
+    file_header header;
+    std::memcpy(&header, file->data(), sizeof(file_header));
+
+    if (std::memcmp(header.m_magic, STATIC_KDTREE_FILE_MAGIC, sizeof(STATIC_KDTREE_FILE_MAGIC)) != 0) {
+        throw std::runtime_error("CCORE [static_kdtree]: file '" + p_path + "' is not tree file.");
+    }
+
+    if ((header.m_version != FILE_VERSION) || (header.m_node_size != sizeof(node))
+        || (header.m_value_size != sizeof(TypeValue)) || (header.m_index_size != sizeof(std::size_t))) {
+        throw std::runtime_error("CCORE [static_kdtree]: version of file '" + p_path + "' is not supported.");
+    }
+
+    const bool consistent = ((header.m_size == 0) == (header.m_amount_nodes == 0))
+        && (header.m_amount_nodes / 2 <= header.m_size)
+        && (header.m_nodes_offset % FILE_ALIGNMENT == 0) && (header.m_coordinates_offset % FILE_ALIGNMENT == 0)
+        && (header.m_bounds_offset % FILE_ALIGNMENT == 0) && (header.m_indexes_offset % FILE_ALIGNMENT == 0);
+
+    if (!consistent) {
+        throw std::runtime_error("CCORE [static_kdtree]: header of file '" + p_path + "' is corrupted.");
+    }
+
+    const bool complete = file->contains(header.m_nodes_offset, header.m_amount_nodes, 1, sizeof(node))
+        && file->contains(header.m_coordinates_offset, header.m_size, header.m_dimension, sizeof(TypeValue))
+        && file->contains(header.m_bounds_offset, header.m_amount_nodes, header.m_dimension, 2 * sizeof(TypeValue))
+        && file->contains(header.m_indexes_offset, header.m_size, 1, sizeof(std::size_t));
+
+    if (!complete) {
+        throw std::runtime_error("CCORE [static_kdtree]: file '" + p_path + "' is truncated.");
+    }
+
+    basic_static_kdtree tree;
+    tree.m_size = (std::size_t) header.m_size;
+    tree.m_dimension = (std::size_t) header.m_dimension;
+    tree.m_bucket_size = (std::size_t) header.m_bucket_size;
+    tree.m_maximum_leaf = (std::size_t) header.m_maximum_leaf;
+    tree.m_amount_nodes = (std::size_t) header.m_amount_nodes;
+    tree.m_node_data = reinterpret_cast<const node *>(file->data() + header.m_nodes_offset);
+    tree.m_coordinate_data = reinterpret_cast<const TypeValue *>(file->data() + header.m_coordinates_offset);
+    tree.m_bound_data = reinterpret_cast<const TypeValue *>(file->data() + header.m_bounds_offset);
+    tree.m_index_data = reinterpret_cast<const std::size_t *>(file->data() + header.m_indexes_offset);
+
+    /* structure is validated once, so queries don't check ranges and can't leave the mapped memory */
+    for (std::size_t index_node = 0; index_node < tree.m_amount_nodes; index_node++) {
+        const node & current = tree.m_node_data[index_node];
+
+        bool valid = (current.m_begin < current.m_end) && (current.m_end <= tree.m_size);
+        if (current.m_right == 0) {
+            valid = valid && (current.m_end - current.m_begin <= tree.m_maximum_leaf);
+        }
+        else {
+            valid = valid && (current.m_right > index_node + 1) && (current.m_right < tree.m_amount_nodes)
+                && (current.m_discriminator < tree.m_dimension);
+        }
+
+        if (!valid) {
+            throw std::runtime_error("CCORE [static_kdtree]: nodes of file '" + p_path + "' are corrupted.");
+        }
+    }
+
+    for (std::size_t position = 0; position < tree.m_size; position++) {
+        if (tree.m_index_data[position] >= tree.m_size) {
+            throw std::runtime_error("CCORE [static_kdtree]: indexes of file '" + p_path + "' are corrupted.");
+        }
+    }
+
+    tree.m_file = std::move(file);
+    return tree;
+}
+
+
+template <typename TypeValue>
+void basic_static_kdtree<TypeValue>::attach(void) {
+    m_node_data = m_nodes.data();
+    m_coordinate_data = m_coordinates.data();
+    m_bound_data = m_bounds.data();
+    m_index_data = m_indexes.data();
+    m_amount_nodes = m_nodes.size();
+}
+
+
+template <typename TypeValue>
+std::size_t basic_static_kdtree<TypeValue>::create_node(std::vector<std::size_t> & p_order, const std::size_t p_begin, const std::size_t p_end, const container::dense_matrix_view<TypeValue> & p_data) {
+    const std::size_t index_node = m_nodes.size();
+    m_nodes.emplace_back();
+    m_nodes[index_node].m_begin = p_begin;
+    m_nodes[index_node].m_end = p_end;
+
+    m_bounds.resize(m_bounds.size() + 2 * m_dimension);
+
+    if (p_end - p_begin > m_bucket_size) {
+        std::size_t discriminator = 0;
+        double largest_spread = 0.0;
+
+        for (std::size_t index_dimension = 0; index_dimension < m_dimension; index_dimension++) {
+            double minimum = p_data[p_order[p_begin]][index_dimension];
+            double maximum = minimum;
+
+            for (std::size_t position = p_begin + 1; position < p_end; position++) {
+                const double value = p_data[p_order[position]][index_dimension];
+                minimum = std::min(minimum, value);
+                maximum = std::max(maximum, value);
+            }
+
+            if (maximum - minimum > largest_spread) {
+                largest_spread = maximum - minimum;
+                discriminator = index_dimension;
+            }
+        }
+
+        /* points that are equal can't be split, they are stored in one leaf */
+        if (largest_spread > 0.0) {
+            const std::size_t middle = p_begin + (p_end - p_begin) / 2;
+            std::nth_element(p_order.begin() + p_begin, p_order.begin() + middle, p_order.begin() + p_end,
+                [&p_data, discriminator](const std::size_t p_index1, const std::size_t p_index2) {
+                    return p_data[p_index1][discriminator] < p_data[p_index2][discriminator];
+                });
+
+            m_nodes[index_node].m_split = p_data[p_order[middle]][discriminator];
+            m_nodes[index_node].m_discriminator = discriminator;
+
+            create_node(p_order, p_begin, middle, p_data);
+            const std::size_t index_right = create_node(p_order, middle, p_end, p_data);
+            m_nodes[index_node].m_right = index_right;
+
+            /* bounding box of the node is union of boxes of its children */
+            const TypeValue * const left_bounds = m_bounds.data() + (index_node + 1) * 2 * m_dimension;
+            const TypeValue * const right_bounds = m_bounds.data() + index_right * 2 * m_dimension;
+            TypeValue * const bounds = m_bounds.data() + index_node * 2 * m_dimension;
+
+            for (std::size_t index_dimension = 0; index_dimension < m_dimension; index_dimension++) {
+                bounds[index_dimension] = std::min(left_bounds[index_dimension], right_bounds[index_dimension]);
+                bounds[m_dimension + index_dimension] = std::max(left_bounds[m_dimension + index_dimension], right_bounds[m_dimension + index_dimension]);
+            }
+
+            return index_node;
+        }
+    }
+
+    TypeValue * const bounds = m_bounds.data() + index_node * 2 * m_dimension;
+    for (std::size_t index_dimension = 0; index_dimension < m_dimension; index_dimension++) {
+        bounds[index_dimension] = p_data[p_order[p_begin]][index_dimension];
+        bounds[m_dimension + index_dimension] = bounds[index_dimension];
+
+        for (std::size_t position = p_begin + 1; position < p_end; position++) {
+            const TypeValue value = p_data[p_order[position]][index_dimension];
+            bounds[index_dimension] = std::min(bounds[index_dimension], value);
+            bounds[m_dimension + index_dimension] = std::max(bounds[m_dimension + index_dimension], value);
+        }
+    }
+
+    m_maximum_leaf = std::max(m_maximum_leaf, p_end - p_begin);
+    return index_node;
+}
+
+
+template <typename TypeValue>
+double basic_static_kdtree<TypeValue>::square_box_distance(const std::size_t p_index_node1, const std::size_t p_index_node2) const {
+    const TypeValue * const bounds1 = m_bound_data + p_index_node1 * 2 * m_dimension;
+    const TypeValue * const bounds2 = m_bound_data + p_index_node2 * 2 * m_dimension;
+
+    double distance = 0.0;
+    for (std::size_t index_dimension = 0; index_dimension < m_dimension; index_dimension++) {
+        const double gap = std::max(0.0, std::max(double(bounds1[index_dimension]) - bounds2[m_dimension + index_dimension], double(bounds2[index_dimension]) - bounds1[m_dimension + index_dimension]));
+        distance += gap * gap;
+    }
+
+    return distance;
+}
+
+
+template <typename TypeValue>
+neighbor_lists basic_static_kdtree<TypeValue>::create_lists(std::vector<std::vector<neighbor_pair>> & p_pairs, const std::size_t p_size) {
+    std::vector<std::size_t> offsets(p_size + 1, 0);
+    for (const auto & task_pairs : p_pairs) {
+        for (const auto & pair : task_pairs) {
+            offsets[pair.m_first + 1]++;
+            if (pair.m_first != pair.m_second) {
+                offsets[pair.m_second + 1]++;
+            }
+        }
+    }
+
+    for (std::size_t index = 0; index < p_size; index++) {
+        offsets[index + 1] += offsets[index];
+    }
+
+    std::vector<candidate> entries(offsets.back());
+    std::vector<std::size_t> positions(offsets.begin(), offsets.end() - 1);
+
+    for (auto & task_pairs : p_pairs) {
+        for (const auto & pair : task_pairs) {
+            entries[positions[pair.m_first]++] = candidate(pair.m_distance, pair.m_second);
+            if (pair.m_first != pair.m_second) {
+                entries[positions[pair.m_second]++] = candidate(pair.m_distance, pair.m_first);
+            }
+        }
+
+        std::vector<neighbor_pair>().swap(task_pairs);
+    }
+
+    std::vector<std::size_t> neighbors(entries.size());
+    std::vector<double> distances(entries.size());
+
+    parallel::parallel_for(std::size_t(0), p_size, [&](const std::size_t p_index) {
+        /* neighbors of each point are sorted by index */
+        std::sort(entries.begin() + offsets[p_index], entries.begin() + offsets[p_index + 1], [](const candidate & p_left, const candidate & p_right) {
+            return p_left.second < p_right.second;
+        });
+
+        for (std::size_t position = offsets[p_index]; position < offsets[p_index + 1]; position++) {
+            neighbors[position] = entries[position].second;
+            distances[position] = entries[position].first;
+        }
+    });
+
+    return neighbor_lists(std::move(offsets), std::move(neighbors), std::move(distances));
+}
+
+
+template <typename TypeValue>
+void basic_static_kdtree<TypeValue>::calculate_square_distances(const node & p_node, const TypeValue * p_point, double * p_distances) const {
+    const std::size_t amount = p_node.m_end - p_node.m_begin;
+    std::fill(p_distances, p_distances + amount, 0.0);
+
+    for (std::size_t index_dimension = 0; index_dimension < m_dimension; index_dimension++) {
+        const TypeValue * const coordinates = m_coordinate_data + index_dimension * m_size + p_node.m_begin;
+        const double value = p_point[index_dimension];
+
+        for (std::size_t index = 0; index < amount; index++) {
+            const double difference = coordinates[index] - value;
+            p_distances[index] += difference * difference;
+        }
+    }
+}
+
+
+
+template class basic_static_kdtree<double>;
+template class basic_static_kdtree<float>;
+
+}
@@ -0,0 +1,863 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#ifndef SRC_CONTAINER_STATIC_KDTREE_HPP_
+#define SRC_CONTAINER_STATIC_KDTREE_HPP_
+
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "container/neighbor_lists.hpp"
+
+#include "definitions.hpp"
+
+#include "utils/mapped_file.hpp"
+#include "utils/metric.hpp"
+
+
+namespace container {
+
+
+/**
+*
+* @brief    Static KD-tree that is built once for all points and that is intended for bulk radius
+*           and k-nearest neighbor queries.
+* @details  Nodes are stored in one array in depth-first order: left child of a node follows it and
+*           index of right child is stored in the node. Points are reordered so points of each leaf
+*           are placed contiguously and coordinates are stored by dimensions (structure of arrays),
+*           therefore leaf with 'bucket size' points is scanned by loops over contiguous memory that
+*           are vectorized by the compiler for Euclidean metric. Unlike 'kdtree', points can not be
+*           inserted or removed after construction, therefore the tree is safe for concurrent queries.
+*           Coordinates are stored with type 'TypeValue' (double or float), so the tree of single
+*           precision data takes half of memory, distances are calculated in double precision.
+*           All arrays of the tree are flat, so the tree is written to binary file as is and it is
+*           opened by mapping the file to memory without rebuilding and without copying.
+*
+*/
+template <typename TypeValue>
+class basic_static_kdtree {
+public:
+    /**
+    *
+    * @brief    Default maximum amount of points in a leaf.
+    *
+    */
+    static const std::size_t DEFAULT_BUCKET_SIZE;
+
+    /**
+    *
+    * @brief    Dimension of data up to which the tree prunes search space efficiently, points of
+    *           higher dimension should be compared with all points.
+    *
+    */
+    static const std::size_t DIMENSION_LIMIT;
+
+    /**
+    *
+    * @brief    Amount of points starting from which search by the tree is faster than comparison
+    *           of a point with all other points.
+    *
+    */
+    static const std::size_t MINIMUM_SIZE;
+
+private:
+    /* amount of pairs of nodes that are processed by separate tasks during dual-tree search */
+    static const std::size_t DUAL_TREE_TASKS;
+
+    /* alignment of arrays in binary file of the tree */
+    static const std::size_t FILE_ALIGNMENT;
+
+    /* amount of points whose coordinates are compared with data by 'is_built_for' */
+    static const std::size_t CHECK_SAMPLES;
+
+    static const std::uint32_t FILE_VERSION;
+
+private:
+    using candidate = std::pair<double, std::size_t>;
+
+    using node_pair = std::pair<std::size_t, std::size_t>;
+
+    /* pair of points in radius that is found by dual-tree search, each pair is found once */
+    struct neighbor_pair {
+        std::size_t     m_first         = 0;
+        std::size_t     m_second        = 0;
+        double          m_distance      = 0.0;
+    };
+
+    struct node {
+        double          m_split         = 0.0;
+        std::size_t     m_begin         = 0;        /* the first position of points of the node */
+        std::size_t     m_end           = 0;        /* position after the last point of the node */
+        std::size_t     m_right         = 0;        /* index of right child, zero for leaf (root can't be a child) */
+        std::size_t     m_discriminator = 0;
+    };
+
+    /* header of binary file, arrays follow it in native byte order at the specified offsets */
+    struct file_header {
+        char            m_magic[8];                 /* 'PYCLKDTR' */
+        std::uint32_t   m_version;
+        std::uint32_t   m_node_size;                /* size of 'node' in bytes, it differs between platforms */
+        std::uint32_t   m_value_size;               /* size of coordinate in bytes */
+        std::uint32_t   m_index_size;               /* size of index of point in bytes */
+        std::uint64_t   m_size;
+        std::uint64_t   m_dimension;
+        std::uint64_t   m_bucket_size;
+        std::uint64_t   m_maximum_leaf;
+        std::uint64_t   m_amount_nodes;
+        std::uint64_t   m_nodes_offset;
+        std::uint64_t   m_coordinates_offset;
+        std::uint64_t   m_bounds_offset;
+        std::uint64_t   m_indexes_offset;
+    };
+
+public:
+    /**
+    *
+    * @brief    Scratch memory of queries, it is reused by consecutive queries of one thread to
+    *           avoid allocation per query. Buffer should not be shared between threads.
+    *
+    */
+    struct search_buffer {
+        std::vector<double>         m_leaf_distances;
+        std::vector<TypeValue>      m_point;
+        std::vector<TypeValue>      m_corner;
+        std::vector<std::size_t>    m_stack;
+        std::vector<candidate>      m_heap;
+        std::vector<candidate>      m_bounded_stack;
+    };
+
+private:
+    std::vector<node>           m_nodes;
+    std::vector<TypeValue>      m_coordinates;      /* coordinate 'd' of point at position 'i' is placed at 'd * m_size + i' */
+    std::vector<TypeValue>      m_bounds;           /* minimum coordinates of points of node 'i' start from '2 * i * m_dimension', maximum follow them */
+    std::vector<std::size_t>    m_indexes;          /* index of point in input data for each position */
+    std::size_t                 m_size              = 0;
+    std::size_t                 m_dimension         = 0;
+    std::size_t                 m_bucket_size       = 0;
+    std::size_t                 m_maximum_leaf      = 0;    /* leaf can be larger than bucket if all its points are equal */
+
+    /* arrays that are used by queries, they point to the vectors above or to the mapped file */
+    const node                  * m_node_data       = nullptr;
+    const TypeValue             * m_coordinate_data = nullptr;
+    const TypeValue             * m_bound_data      = nullptr;
+    const std::size_t           * m_index_data      = nullptr;
+    std::size_t                 m_amount_nodes      = 0;
+    std::shared_ptr<const utils::mapped_file>   m_file;
+
+public:
+    /**
+    *
+    * @brief    Default constructor that creates tree without points.
+    *
+    */
+    basic_static_kdtree(void) = default;
+
+    /**
+    *
+    * @brief    Builds tree for the specified points, they are copied to the tree.
+    * @details  Each node is split by median of coordinate with the largest spread of values.
+    *
+    * @param[in] p_data: points for that tree is built.
+    * @param[in] p_bucket_size: maximum amount of points in a leaf.
+    *
+    */
+    explicit basic_static_kdtree(const container::dense_matrix_view<TypeValue> & p_data, const std::size_t p_bucket_size = DEFAULT_BUCKET_SIZE);
+
+    basic_static_kdtree(const basic_static_kdtree & p_other);
+
+    basic_static_kdtree(basic_static_kdtree && p_other) = default;
+
+    ~basic_static_kdtree(void) = default;
+
+public:
+    /**
+    *
+    * @brief    Returns true if the tree is able to prune search space for data with specified
+    *           dimension and metric (metric should provide lower bound of distance by coordinate).
+    *
+    * @param[in] p_dimension: dimension of data.
+    * @param[in] p_metric: metric that is used to calculate distance between points.
+    *
+    */
+    template <typename TypeMetric>
+    static bool is_suitable(const std::size_t p_dimension, const TypeMetric & p_metric) {
+        return (p_dimension <= DIMENSION_LIMIT) && (p_metric.comparable_axis_bound(1.0) > 0.0);
+    }
+
+    /**
+    *
+    * @brief    Returns amount of points in the tree.
+    *
+    */
+    std::size_t size(void) const;
+
+    /**
+    *
+    * @brief    Returns amount of coordinates of each point.
+    *
+    */
+    std::size_t dimension(void) const;
+
+    /**
+    *
+    * @brief    Returns amount of nodes (including leaves) in the tree.
+    *
+    */
+    std::size_t amount_nodes(void) const;
+
+    /**
+    *
+    * @brief    Returns true if the tree corresponds to the specified data: amount of points and
+    *           dimension are the same and stored coordinates of sample of points are equal to
+    *           coordinates of the same points in the data.
+    * @details  Points are sampled evenly by their position in the tree, so the check is cheap, but
+    *           it doesn't prove that all points are equal (for example, tree that is opened from
+    *           file built over slightly changed data can pass it).
+    *
+    * @param[in] p_data: data that is compared with the tree.
+    *
+    */
+    bool is_built_for(const container::dense_matrix_view<TypeValue> & p_data) const;
+
+    /**
+    *
+    * @brief    Writes the tree to binary file.
+    * @details  Exception 'std::runtime_error' is thrown if the file can not be written. File is
+    *           stored in native byte order and it can be opened on platform with the same size of
+    *           'std::size_t' only.
+    *
+    * @param[in] p_path: path to the file that is created or overwritten.
+    *
+    */
+    void write(const std::string & p_path) const;
+
+    /**
+    *
+    * @brief    Opens the tree that has been written to binary file by mapping the file to memory.
+    * @details  The tree is not rebuilt and its arrays are not copied: pages of the file are loaded
+    *           on the first access and they are shared between processes that open the same file.
+    *           Copies of the opened tree share the mapping. Exception 'std::runtime_error' is
+    *           thrown if the file can not be opened or it is not a valid tree file.
+    *
+    * @param[in] p_path: path to the binary file of the tree.
+    *
+    * @return   Returns the tree that uses mapped memory of the file.
+    *
+    */
+    static basic_static_kdtree open(const std::string & p_path);
+
+    /**
+    *
+    * @brief    Finds all points whose distance to the specified point is less or equal to radius.
+    *
+    * @param[in]  p_point: point for that neighbors are searched, it has dimension of the tree.
+    * @param[in]  p_radius: radius of search in comparable form of the metric.
+    * @param[in]  p_metric: metric that is used to calculate distance between points.
+    * @param[out] p_indexes: indexes of found points in input data (in arbitrary order).
+    * @param[out] p_distances: distances to found points in comparable form of the metric.
+    *
+    * @return   Returns amount of points whose distance to the specified point has been calculated.
+    *
+    */
+    template <typename TypeMetric>
+    std::size_t find_radius(const TypeValue * p_point, const double p_radius, const TypeMetric & p_metric, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) const {
+        p_indexes.clear();
+        p_distances.clear();
+
+        search_buffer buffer;
+        return find_radius(p_point, p_radius, p_metric, buffer, p_indexes, p_distances);
+    }
+
+    /**
+    *
+    * @brief    Finds all points whose distance to the specified point is less or equal to radius
+    *           using scratch memory of the caller.
+    *
+    * @param[in]  p_point: point for that neighbors are searched, it has dimension of the tree.
+    * @param[in]  p_radius: radius of search in comparable form of the metric.
+    * @param[in]  p_metric: metric that is used to calculate distance between points.
+    * @param[in]  p_buffer: scratch memory that is reused between queries.
+    * @param[out] p_indexes: indexes of found points in input data are appended to it.
+    * @param[out] p_distances: distances to found points in comparable form of the metric are
+    *              appended to it.
+    *
+    * @return   Returns amount of points whose distance to the specified point has been calculated.
+    *
+    */
+    template <typename TypeMetric>
+    std::size_t find_radius(const TypeValue * p_point, const double p_radius, const TypeMetric & p_metric, search_buffer & p_buffer, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) const;
+
+    /**
+    *
+    * @brief    Counts points whose distance to the specified point is less or equal to radius
+    *           without collecting them.
+    * @details  Node whose bounding box is entirely inside the radius is counted by its size
+    *           without distance calculation. Counting stops as soon as the limit is reached, so
+    *           query "are there at least 'k' points in radius" visits only part of the tree.
+    *
+    * @param[in] p_point: point for that neighbors are counted, it has dimension of the tree.
+    * @param[in] p_radius: radius of search in comparable form of the metric.
+    * @param[in] p_metric: metric that is used to calculate distance between points, distance
+    *             should not decrease when difference by any coordinate increases.
+    * @param[in] p_limit: amount of points after which counting is stopped.
+    *
+    * @return   Returns amount of points in radius if it is less than limit, otherwise returns
+    *           value that is greater or equal to limit.
+    *
+    */
+    template <typename TypeMetric>
+    std::size_t count_radius(const TypeValue * p_point, const double p_radius, const TypeMetric & p_metric, const std::size_t p_limit = std::numeric_limits<std::size_t>::max()) const {
+        search_buffer buffer;
+        std::size_t calculated_distances = 0;
+        return count_radius(p_point, p_radius, p_metric, p_limit, buffer, calculated_distances);
+    }
+
+    /**
+    *
+    * @brief    Counts points whose distance to the specified point is less or equal to radius
+    *           using scratch memory of the caller.
+    *
+    * @param[in] p_point: point for that neighbors are counted, it has dimension of the tree.
+    * @param[in] p_radius: radius of search in comparable form of the metric.
+    * @param[in] p_metric: metric that is used to calculate distance between points.
+    * @param[in] p_limit: amount of points after which counting is stopped.
+    * @param[in] p_buffer: scratch memory that is reused between queries.
+    * @param[in,out] p_calculated_distances: amount of calculated distances is added to it (to
+    *                 points and to the closest and the farthest corners of bounding boxes).
+    *
+    * @return   Returns amount of points in radius if it is less than limit, otherwise returns
+    *           value that is greater or equal to limit.
+    *
+    */
+    template <typename TypeMetric>
+    std::size_t count_radius(const TypeValue * p_point, const double p_radius, const TypeMetric & p_metric, const std::size_t p_limit, search_buffer & p_buffer, std::size_t & p_calculated_distances) const;
+
+    /**
+    *
+    * @brief    Finds the specified amount of points that are the closest to the specified point.
+    * @details  Candidates are kept in bounded max-heap, subtrees that are farther than the current
+    *           k-th candidate are skipped. Points with equal distance are ordered by index.
+    *
+    * @param[in]  p_point: point for that neighbors are searched, it has dimension of the tree.
+    * @param[in]  p_amount: amount of neighbors that should be found.
+    * @param[in]  p_metric: metric that is used to calculate distance between points.
+    * @param[out] p_indexes: indexes of found points in input data sorted by distance.
+    * @param[out] p_distances: distances to found points in comparable form of the metric.
+    *
+    * @return   Returns amount of points whose distance to the specified point has been calculated.
+    *
+    */
+    template <typename TypeMetric>
+    std::size_t find_nearest(const TypeValue * p_point, const std::size_t p_amount, const TypeMetric & p_metric, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) const {
+        p_indexes.clear();
+        p_distances.clear();
+
+        search_buffer buffer;
+        return find_nearest(p_point, p_amount, p_metric, buffer, p_indexes, p_distances);
+    }
+
+    /**
+    *
+    * @brief    Finds the specified amount of points that are the closest to the specified point
+    *           using scratch memory of the caller.
+    *
+    * @param[in]  p_point: point for that neighbors are searched, it has dimension of the tree.
+    * @param[in]  p_amount: amount of neighbors that should be found.
+    * @param[in]  p_metric: metric that is used to calculate distance between points.
+    * @param[in]  p_buffer: scratch memory that is reused between queries.
+    * @param[out] p_indexes: indexes of found points sorted by distance are appended to it.
+    * @param[out] p_distances: distances to found points in comparable form of the metric are
+    *              appended to it.
+    *
+    * @return   Returns amount of points whose distance to the specified point has been calculated.
+    *
+    */
+    template <typename TypeMetric>
+    std::size_t find_nearest(const TypeValue * p_point, const std::size_t p_amount, const TypeMetric & p_metric, search_buffer & p_buffer, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) const;
+
+    /**
+    *
+    * @brief    Finds points in radius of each query point using threads of the global pool.
+    * @details  The tree is not modified by queries, so it is safe to query it from several threads.
+    *
+    * @param[in] p_queries: points for that neighbors are searched, they have dimension of the tree.
+    * @param[in] p_radius: radius of search in comparable form of the metric.
+    * @param[in] p_metric: metric that is used to calculate distance between points.
+    *
+    * @return   Returns indexes of found points (in arbitrary order) and comparable distances to
+    *           them for each query.
+    *
+    */
+    template <typename TypeMetric>
+    neighbor_lists find_radius(const container::dense_matrix_view<TypeValue> & p_queries, const double p_radius, const TypeMetric & p_metric) const {
+        return neighbor_lists::create(p_queries.size(), []() { return search_buffer(); },
+            [this, &p_queries, p_radius, &p_metric](search_buffer & p_buffer, const std::size_t p_index, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) {
+                find_radius(p_queries[p_index], p_radius, p_metric, p_buffer, p_indexes, p_distances);
+            });
+    }
+
+    /**
+    *
+    * @brief    Finds the specified amount of the closest points to each query point using threads
+    *           of the global pool.
+    * @details  The tree is not modified by queries, so it is safe to query it from several threads.
+    *
+    * @param[in] p_queries: points for that neighbors are searched, they have dimension of the tree.
+    * @param[in] p_amount: amount of neighbors that should be found for each query.
+    * @param[in] p_metric: metric that is used to calculate distance between points.
+    *
+    * @return   Returns indexes of found points sorted by distance and comparable distances to them
+    *           for each query.
+    *
+    */
+    template <typename TypeMetric>
+    neighbor_lists find_nearest(const container::dense_matrix_view<TypeValue> & p_queries, const std::size_t p_amount, const TypeMetric & p_metric) const {
+        return neighbor_lists::create(p_queries.size(), []() { return search_buffer(); },
+            [this, &p_queries, p_amount, &p_metric](search_buffer & p_buffer, const std::size_t p_index, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) {
+                find_nearest(p_queries[p_index], p_amount, p_metric, p_buffer, p_indexes, p_distances);
+            });
+    }
+
+    /**
+    *
+    * @brief    Finds points in radius of each point of the tree (all-pairs range search) using
+    *           dual-tree traversal and threads of the global pool.
+    * @details  Pairs of nodes are traversed instead of separate queries: pair is skipped if
+    *           distance between bounding boxes of nodes is greater than radius, so far regions are
+    *           pruned for all points of both nodes at once and each pair of points is compared once.
+    *
+    * @param[in] p_radius: radius of search in comparable form of the metric.
+    * @param[in] p_metric: metric that is used to calculate distance between points.
+    *
+    * @return   Returns indexes of found points (including the point itself) sorted by index and
+    *           comparable distances to them for each point of the tree in order of input data.
+    *
+    */
+    template <typename TypeMetric>
+    neighbor_lists find_all_neighbors(const double p_radius, const TypeMetric & p_metric) const;
+
+private:
+    void attach(void);
+
+    std::size_t create_node(std::vector<std::size_t> & p_order, const std::size_t p_begin, const std::size_t p_end, const container::dense_matrix_view<TypeValue> & p_data);
+
+    template <typename TypeMetric>
+    void find_pairs(const node_pair & p_pair, const double p_radius, const TypeMetric & p_metric, search_buffer & p_buffer, std::vector<node_pair> & p_stack, std::vector<neighbor_pair> & p_pairs) const;
+
+    template <typename TypeMetric>
+    bool split_pair(const node_pair & p_pair, const double p_radius, const TypeMetric & p_metric, std::vector<node_pair> & p_children) const;
+
+    template <typename TypeMetric>
+    double box_distance(const std::size_t p_index_node1, const std::size_t p_index_node2, const TypeMetric & p_metric) const {
+        const TypeValue * const bounds1 = m_bound_data + p_index_node1 * 2 * m_dimension;
+        const TypeValue * const bounds2 = m_bound_data + p_index_node2 * 2 * m_dimension;
+
+        /* the largest gap by one coordinate is lower bound of distance for any suitable metric */
+        double distance = 0.0;
+        for (std::size_t index_dimension = 0; index_dimension < m_dimension; index_dimension++) {
+            const double gap = std::max(0.0, std::max(double(bounds1[index_dimension]) - bounds2[m_dimension + index_dimension], double(bounds2[index_dimension]) - bounds1[m_dimension + index_dimension]));
+            distance = std::max(distance, p_metric.comparable_axis_bound(gap));
+        }
+
+        return distance;
+    }
+
+    double box_distance(const std::size_t p_index_node1, const std::size_t p_index_node2, const utils::metric::euclidean &) const {
+        return square_box_distance(p_index_node1, p_index_node2);
+    }
+
+    double box_distance(const std::size_t p_index_node1, const std::size_t p_index_node2, const utils::metric::euclidean_square &) const {
+        return square_box_distance(p_index_node1, p_index_node2);
+    }
+
+    double square_box_distance(const std::size_t p_index_node1, const std::size_t p_index_node2) const;
+
+    static neighbor_lists create_lists(std::vector<std::vector<neighbor_pair>> & p_pairs, const std::size_t p_size);
+
+    void calculate_square_distances(const node & p_node, const TypeValue * p_point, double * p_distances) const;
+
+    template <typename TypeMetric>
+    void calculate_distances(const node & p_node, const TypeValue * p_point, const TypeMetric & p_metric, search_buffer & p_buffer) const {
+        p_buffer.m_point.resize(m_dimension);
+        for (std::size_t position = p_node.m_begin; position < p_node.m_end; position++) {
+            for (std::size_t index_dimension = 0; index_dimension < m_dimension; index_dimension++) {
+                p_buffer.m_point[index_dimension] = m_coordinate_data[index_dimension * m_size + position];
+            }
+
+            p_buffer.m_leaf_distances[position - p_node.m_begin] = p_metric.comparable_distance(p_point, p_buffer.m_point.data(), m_dimension);
+        }
+    }
+
+    void calculate_distances(const node & p_node, const TypeValue * p_point, const utils::metric::euclidean &, search_buffer & p_buffer) const {
+        calculate_square_distances(p_node, p_point, p_buffer.m_leaf_distances.data());
+    }
+
+    void calculate_distances(const node & p_node, const TypeValue * p_point, const utils::metric::euclidean_square &, search_buffer & p_buffer) const {
+        calculate_square_distances(p_node, p_point, p_buffer.m_leaf_distances.data());
+    }
+};
+
+
+template <typename TypeValue>
+template <typename TypeMetric>
+std::size_t basic_static_kdtree<TypeValue>::find_radius(const TypeValue * p_point, const double p_radius, const TypeMetric & p_metric, search_buffer & p_buffer, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) const {
+    if (m_amount_nodes == 0) {
+        return 0;
+    }
+
+    std::size_t calculated_distances = 0;
+    p_buffer.m_leaf_distances.resize(m_maximum_leaf);
+
+    std::vector<std::size_t> & stack = p_buffer.m_stack;
+    stack.clear();
+    stack.push_back(0);
+
+    while (!stack.empty()) {
+        const std::size_t index_current = stack.back();
+        const node & current = m_node_data[index_current];
+        stack.pop_back();
+
+        if (current.m_right == 0) {
+            calculate_distances(current, p_point, p_metric, p_buffer);
+            calculated_distances += current.m_end - current.m_begin;
+
+            for (std::size_t position = current.m_begin; position < current.m_end; position++) {
+                const double distance = p_buffer.m_leaf_distances[position - current.m_begin];
+                if (distance <= p_radius) {
+                    p_indexes.push_back(m_index_data[position]);
+                    p_distances.push_back(distance);
+                }
+            }
+        }
+        else {
+            /* left subtree contains values that are less or equal to the split, right - greater or equal */
+            const double difference = p_point[current.m_discriminator] - current.m_split;
+            if (difference < 0.0) {
+                if (p_metric.comparable_axis_bound(difference) <= p_radius) {
+                    stack.push_back(current.m_right);
+                }
+
+                stack.push_back(index_current + 1);
+            }
+            else {
+                if (p_metric.comparable_axis_bound(difference) <= p_radius) {
+                    stack.push_back(index_current + 1);
+                }
+
+                stack.push_back(current.m_right);
+            }
+        }
+    }
+
+    return calculated_distances;
+}
+
+
+template <typename TypeValue>
+template <typename TypeMetric>
+std::size_t basic_static_kdtree<TypeValue>::find_nearest(const TypeValue * p_point, const std::size_t p_amount, const TypeMetric & p_metric, search_buffer & p_buffer, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) const {
+    if ((m_amount_nodes == 0) || (p_amount == 0)) {
+        return 0;
+    }
+
+    std::vector<candidate> & heap = p_buffer.m_heap;      /* max-heap where the farthest candidate is on the top */
+    heap.clear();
+
+    std::size_t calculated_distances = 0;
+    p_buffer.m_leaf_distances.resize(m_maximum_leaf);
+
+    /* each subtree is stored with lower bound of distance to its points */
+    std::vector<candidate> & stack = p_buffer.m_bounded_stack;
+    stack.clear();
+    stack.emplace_back(0.0, 0);
+
+    while (!stack.empty()) {
+        const candidate subtree = stack.back();
+        stack.pop_back();
+
+        if ( (heap.size() == p_amount) && (subtree.first > heap.front().first) ) {
+            continue;
+        }
+
+        const node & current = m_node_data[subtree.second];
+        if (current.m_right == 0) {
+            calculate_distances(current, p_point, p_metric, p_buffer);
+            calculated_distances += current.m_end - current.m_begin;
+
+            for (std::size_t position = current.m_begin; position < current.m_end; position++) {
+                const candidate point(p_buffer.m_leaf_distances[position - current.m_begin], m_index_data[position]);
+                if (heap.size() < p_amount) {
+                    heap.push_back(point);
+                    std::push_heap(heap.begin(), heap.end());
+                }
+                else if (point < heap.front()) {
+                    std::pop_heap(heap.begin(), heap.end());
+                    heap.back() = point;
+                    std::push_heap(heap.begin(), heap.end());
+                }
+            }
+        }
+        else {
+            const double difference = p_point[current.m_discriminator] - current.m_split;
+            const double far_bound = std::max(subtree.first, p_metric.comparable_axis_bound(difference));
+
+            /* nearest subtree is processed first, so bound becomes tight before the farthest one */
+            if (difference < 0.0) {
+                stack.emplace_back(far_bound, current.m_right);
+                stack.emplace_back(subtree.first, subtree.second + 1);
+            }
+            else {
+                stack.emplace_back(far_bound, subtree.second + 1);
+                stack.emplace_back(subtree.first, current.m_right);
+            }
+        }
+    }
+
+    std::sort_heap(heap.begin(), heap.end());
+    for (const auto & point : heap) {
+        p_distances.push_back(point.first);
+        p_indexes.push_back(point.second);
+    }
+
+    return calculated_distances;
+}
+
+
+template <typename TypeValue>
+template <typename TypeMetric>
+std::size_t basic_static_kdtree<TypeValue>::count_radius(const TypeValue * p_point, const double p_radius, const TypeMetric & p_metric, const std::size_t p_limit, search_buffer & p_buffer, std::size_t & p_calculated_distances) const {
+    if ((m_amount_nodes == 0) || (p_limit == 0)) {
+        return 0;
+    }
+
+    std::size_t amount = 0;
+    p_buffer.m_leaf_distances.resize(m_maximum_leaf);
+    p_buffer.m_point.resize(m_dimension);
+    p_buffer.m_corner.resize(m_dimension);
+
+    std::vector<TypeValue> & nearest_point = p_buffer.m_point;     /* it is rewritten by leaf distance calculation after use */
+
+    std::vector<std::size_t> & stack = p_buffer.m_stack;
+    stack.clear();
+    stack.push_back(0);
+
+    while (!stack.empty()) {
+        const std::size_t index_current = stack.back();
+        const node & current = m_node_data[index_current];
+        stack.pop_back();
+
+        /* the closest and the farthest points of bounding box give bounds of distance to points of the node */
+        const TypeValue * const lower = m_bound_data + index_current * 2 * m_dimension;
+        const TypeValue * const upper = lower + m_dimension;
+
+        for (std::size_t index_dimension = 0; index_dimension < m_dimension; index_dimension++) {
+            const TypeValue value = p_point[index_dimension];
+
+            nearest_point[index_dimension] = std::min(std::max(value, lower[index_dimension]), upper[index_dimension]);
+            p_buffer.m_corner[index_dimension] = (value - lower[index_dimension] > upper[index_dimension] - value) ? lower[index_dimension] : upper[index_dimension];
+        }
+
+        p_calculated_distances++;
+        if (p_metric.comparable_distance(p_point, nearest_point.data(), m_dimension) > p_radius) {
+            continue;
+        }
+
+        p_calculated_distances++;
+        if (p_metric.comparable_distance(p_point, p_buffer.m_corner.data(), m_dimension) <= p_radius) {
+            amount += current.m_end - current.m_begin;
+        }
+        else if (current.m_right == 0) {
+            calculate_distances(current, p_point, p_metric, p_buffer);
+            p_calculated_distances += current.m_end - current.m_begin;
+
+            for (std::size_t position = current.m_begin; position < current.m_end; position++) {
+                if (p_buffer.m_leaf_distances[position - current.m_begin] <= p_radius) {
+                    amount++;
+                }
+            }
+        }
+        else {
+            /* subtree where the point is located is visited first to reach the limit earlier */
+            if (p_point[current.m_discriminator] < current.m_split) {
+                stack.push_back(current.m_right);
+                stack.push_back(index_current + 1);
+            }
+            else {
+                stack.push_back(index_current + 1);
+                stack.push_back(current.m_right);
+            }
+        }
+
+        if (amount >= p_limit) {
+            break;
+        }
+    }
+
+    return amount;
+}
+
+
+template <typename TypeValue>
+template <typename TypeMetric>
+neighbor_lists basic_static_kdtree<TypeValue>::find_all_neighbors(const double p_radius, const TypeMetric & p_metric) const {
+    if (m_amount_nodes == 0) {
+        return neighbor_lists(std::vector<std::size_t>(m_size + 1, 0), { }, { });
+    }
+
+    /* pairs of nodes are split until there are enough independent tasks */
+    std::vector<node_pair> tasks = { node_pair(0, 0) };
+    std::vector<node_pair> children;
+
+    bool split = true;
+    while (split && (tasks.size() < DUAL_TREE_TASKS)) {
+        split = false;
+        children.clear();
+
+        for (const auto & pair : tasks) {
+            split |= split_pair(pair, p_radius, p_metric, children);
+        }
+
+        tasks.swap(children);
+    }
+
+    std::vector<std::vector<neighbor_pair>> pairs(tasks.size());
+    parallel::parallel_for(std::size_t(0), tasks.size(), [&](const std::size_t p_index_task) {
+        search_buffer buffer;
+        std::vector<node_pair> stack;
+
+        find_pairs(tasks[p_index_task], p_radius, p_metric, buffer, stack, pairs[p_index_task]);
+    });
+
+    return create_lists(pairs, m_size);
+}
+
+
+template <typename TypeValue>
+template <typename TypeMetric>
+bool basic_static_kdtree<TypeValue>::split_pair(const node_pair & p_pair, const double p_radius, const TypeMetric & p_metric, std::vector<node_pair> & p_children) const {
+    if ( (p_pair.first != p_pair.second) && (box_distance(p_pair.first, p_pair.second, p_metric) > p_radius) ) {
+        return false;
+    }
+
+    const node & node1 = m_node_data[p_pair.first];
+    const node & node2 = m_node_data[p_pair.second];
+
+    if ( (node1.m_right == 0) && (node2.m_right == 0) ) {
+        p_children.push_back(p_pair);
+        return false;
+    }
+
+    if (p_pair.first == p_pair.second) {
+        p_children.emplace_back(p_pair.first + 1, p_pair.first + 1);
+        p_children.emplace_back(p_pair.first + 1, node1.m_right);
+        p_children.emplace_back(node1.m_right, node1.m_right);
+    }
+    else if ( (node2.m_right == 0) || ( (node1.m_right != 0) && (node1.m_end - node1.m_begin >= node2.m_end - node2.m_begin) ) ) {
+        /* the larger node is split to keep sizes of nodes in pair close */
+        p_children.emplace_back(p_pair.first + 1, p_pair.second);
+        p_children.emplace_back(node1.m_right, p_pair.second);
+    }
+    else {
+        p_children.emplace_back(p_pair.first, p_pair.second + 1);
+        p_children.emplace_back(p_pair.first, node2.m_right);
+    }
+
+    return true;
+}
+
+
+template <typename TypeValue>
+template <typename TypeMetric>
+void basic_static_kdtree<TypeValue>::find_pairs(const node_pair & p_pair, const double p_radius, const TypeMetric & p_metric, search_buffer & p_buffer, std::vector<node_pair> & p_stack, std::vector<neighbor_pair> & p_pairs) const {
+    p_buffer.m_leaf_distances.resize(m_maximum_leaf);
+    p_buffer.m_point.resize(m_dimension);
+
+    std::vector<TypeValue> point(m_dimension);
+
+    p_stack.clear();
+    p_stack.push_back(p_pair);
+
+    while (!p_stack.empty()) {
+        const node_pair current = p_stack.back();
+        p_stack.pop_back();
+
+        const std::size_t amount_before = p_stack.size();
+        if (split_pair(current, p_radius, p_metric, p_stack) || (p_stack.size() == amount_before)) {
+            continue;
+        }
+
+        /* both nodes are leaves that are close enough - points are compared */
+        p_stack.pop_back();
+
+        const node & leaf1 = m_node_data[current.first];
+        const node & leaf2 = m_node_data[current.second];
+        const bool same_leaf = (current.first == current.second);
+
+        for (std::size_t position1 = leaf1.m_begin; position1 < leaf1.m_end; position1++) {
+            for (std::size_t index_dimension = 0; index_dimension < m_dimension; index_dimension++) {
+                point[index_dimension] = m_coordinate_data[index_dimension * m_size + position1];
+            }
+
+            calculate_distances(leaf2, point.data(), p_metric, p_buffer);
+
+            const std::size_t first_position2 = same_leaf ? position1 : leaf2.m_begin;
+            for (std::size_t position2 = first_position2; position2 < leaf2.m_end; position2++) {
+                const double distance = p_buffer.m_leaf_distances[position2 - leaf2.m_begin];
+                if (distance <= p_radius) {
+                    neighbor_pair pair;
+                    pair.m_first = m_index_data[position1];
+                    pair.m_second = m_index_data[position2];
+                    pair.m_distance = (position1 == position2) ? 0.0 : distance;
+
+                    p_pairs.push_back(pair);
+                }
+            }
+        }
+    }
+}
+
+
+
+/**
+*
+* @brief    Static KD-tree of points with double precision coordinates.
+*
+*/
+using static_kdtree = basic_static_kdtree<double>;
+
+/**
+*
+* @brief    Static KD-tree of points with single precision coordinates, distances to them are
+*           calculated in double precision.
+*
+*/
+using static_kdtree_f32 = basic_static_kdtree<float>;
+
+}
+
+
+#endif
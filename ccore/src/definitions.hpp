@@ -25,6 +25,8 @@
 #include <memory>
 #include <vector>
 
+#include "container/dense_matrix.hpp"
+
 
 #if defined (__GNUC__) && defined(__unix__)
     #define DECLARATION __attribute__ ((__visibility__("default")))
@@ -44,6 +46,12 @@ using point_ptr     = std::shared_ptr<point>;
 using dataset       = std::vector<point>;
 using dataset_ptr   = std::shared_ptr<dataset>;
 
+using dataset_matrix    = container::dense_matrix<double>;
+using dataset_view      = container::dense_matrix_view<double>;
+
+using dataset_matrix_f32    = container::dense_matrix<float>;
+using dataset_view_f32      = container::dense_matrix_view<float>;
+
 
 /* TODO: use pyclustering_package instead of this */
 typedef struct data_representation {
@@ -35,3 +35,33 @@ pyclustering_package * agglomerative_algorithm(const data_representation * const
 
     return package;
 }
+
+
+pyclustering_package * agglomerative_algorithm_metric(const data_representation * const p_sample, const size_t p_number_clusters, const size_t p_link, const size_t p_metric, const double p_degree) {
+    std::unique_ptr<dataset> data(read_sample(p_sample));
+
+    return utils::metric::dispatch((utils::metric::type_metric) p_metric, p_degree, [&](const auto & p_metric_policy) {
+        using metric_type = std::decay_t<decltype(p_metric_policy)>;
+
+        cluster_analysis::basic_agglomerative<metric_type> algorithm(p_number_clusters, (cluster_analysis::type_link) p_link, p_metric_policy);
+
+        cluster_analysis::cluster_data result;
+        algorithm.process(*data, result);
+
+        return create_package(result.clusters().get());
+    });
+}
+
+
+pyclustering_package * agglomerative_algorithm_buffer(const double * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride, const size_t p_number_clusters, const size_t p_link) {
+    cluster_analysis::agglomerative algorithm(p_number_clusters, (cluster_analysis::type_link) p_link);
+
+    const dataset_view data(p_data, p_size, p_dimension, p_stride);
+
+    cluster_analysis::cluster_data result;
+    algorithm.process(data, result);
+
+    pyclustering_package * package = create_package(result.clusters().get());
+
+    return package;
+}
@@ -43,5 +43,42 @@
  */
 extern "C" DECLARATION pyclustering_package * agglomerative_algorithm(const data_representation * const p_sample, const size_t p_number_clusters, const size_t p_link);
 
+/**
+ *
+ * @brief   Agglomerative algorithm that uses specified metric to calculate distance between points.
+ * @details Caller should destroy returned result in 'pyclustering_package'.
+ *
+ * @param[in] p_sample: input data for clustering.
+ * @param[in] p_number_clusters: amount of clusters that should be allocated.
+ * @param[in] p_link: type of link that is used for merging clusters.
+ * @param[in] p_metric: type of metric that is used to calculate distance between points:
+ *             0 - Euclidean, 1 - square Euclidean, 2 - Manhattan, 3 - Chebyshev, 4 - Minkowski,
+ *             5 - cosine (see 'utils::metric::type_metric').
+ * @param[in] p_degree: degree of Minkowski metric, it is ignored by other metrics.
+ *
+ * @return  Returns result of clustering - array of allocated clusters.
+ *
+ */
+extern "C" DECLARATION pyclustering_package * agglomerative_algorithm_metric(const data_representation * const p_sample, const size_t p_number_clusters, const size_t p_link, const size_t p_metric, const double p_degree);
+
+/**
+ *
+ * @brief   Agglomerative algorithm that processes data directly from contiguous row-major memory
+ *          block without copying it.
+ * @details Caller should destroy returned result in 'pyclustering_package'.
+ *
+ * @param[in] p_data: pointer to the first coordinate of the first point.
+ * @param[in] p_size: amount of points in the block.
+ * @param[in] p_dimension: amount of coordinates of each point.
+ * @param[in] p_stride: distance in elements between beginnings of neighbor points, zero means
+ *             that points are densely packed.
+ * @param[in] p_number_clusters: amount of clusters that should be allocated.
+ * @param[in] p_link: type of link that is used for merging clusters.
+ *
+ * @return  Returns result of clustering - array of allocated clusters.
+ *
+ */
+extern "C" DECLARATION pyclustering_package * agglomerative_algorithm_buffer(const double * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride, const size_t p_number_clusters, const size_t p_link);
+
 
 #endif
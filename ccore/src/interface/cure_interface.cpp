@@ -24,12 +24,24 @@
 
 
 void * cure_algorithm(const data_representation * const sample, const size_t number_clusters, const size_t number_repr_points, const double compression) {
-    std::unique_ptr<dataset> input_dataset(read_sample(sample));
+    const dataset_matrix input_data = read_sample_matrix(sample);
 
     cluster_analysis::cure solver(number_clusters, number_repr_points, compression);
 
     cluster_analysis::cure_data * output_result = new cluster_analysis::cure_data();
-    solver.process(*input_dataset, *output_result);
+    solver.process(input_data.view(), *output_result);
+
+    return output_result;
+}
+
+
+void * cure_algorithm_buffer(const double * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride, const size_t p_number_clusters, const size_t p_number_repr_points, const double p_compression) {
+    const dataset_view input_data(p_data, p_size, p_dimension, p_stride);
+
+    cluster_analysis::cure solver(p_number_clusters, p_number_repr_points, p_compression);
+
+    cluster_analysis::cure_data * output_result = new cluster_analysis::cure_data();
+    solver.process(input_data, *output_result);
 
     return output_result;
 }
@@ -62,3 +74,17 @@ pyclustering_package * cure_get_means(void * pointer_cure_data) {
     pyclustering_package * package = create_package(output_result.means().get());
     return package;
 }
+
+
+size_t cure_get_labels(const void * pointer_cure_data, const size_t p_size, int32_t * const p_labels) {
+    const cluster_analysis::cure_data & output_result = *((const cluster_analysis::cure_data *) pointer_cure_data);
+
+    output_result.export_labels(p_labels, p_size);
+    return output_result.size();
+}
+
+
+pyclustering_package * cure_get_statistics(const void * pointer_cure_data) {
+    const cluster_analysis::cure_data & output_result = *((const cluster_analysis::cure_data *) pointer_cure_data);
+    return create_statistics_package(output_result.statistics());
+}
@@ -22,7 +22,10 @@
 #define SRC_INTERFACE_CURE_INTERFACE_H_
 
 
+#include <cstdint>
+
 #include "interface/pyclustering_package.hpp"
+#include "interface/statistics_interface.h"
 
 #include "definitions.hpp"
 #include "utils.hpp"
@@ -46,6 +49,27 @@
  */
 extern "C" DECLARATION void * cure_algorithm(const data_representation * const sample, const size_t number_clusters, const size_t number_repr_points, const double compression);
 
+/**
+ *
+ * @brief   Clustering algorithm CURE that processes data directly from contiguous row-major memory
+ *          block without copying it.
+ * @details Caller should destroy returned result using 'cure_data_destroy'.
+ *
+ * @param[in] p_data: pointer to the first coordinate of the first point.
+ * @param[in] p_size: amount of points in the block.
+ * @param[in] p_dimension: amount of coordinates of each point.
+ * @param[in] p_stride: distance in elements between beginnings of neighbor points, zero means
+ *             that points are densely packed.
+ * @param[in] p_number_clusters: number of clusters that should be allocated.
+ * @param[in] p_number_repr_points: number of representative points for each cluster.
+ * @param[in] p_compression: coefficient defines level of shrinking of representation points
+ *             toward the mean of the new created cluster after merging on each step.
+ *
+ * @return  Returns pointer to cure data - result of clustering.
+ *
+ */
+extern "C" DECLARATION void * cure_algorithm_buffer(const double * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride, const size_t p_number_clusters, const size_t p_number_repr_points, const double p_compression);
+
 /**
  *
  * @brief   Destroys CURE clustering data (clustering results).
@@ -91,5 +115,31 @@ extern "C" DECLARATION pyclustering_package * cure_get_representors(void * point
  */
 extern "C" DECLARATION pyclustering_package * cure_get_means(void * pointer_cure_data);
 
+/**
+ *
+ * @brief   Writes allocated clusters by CURE algorithm as flat label array.
+ * @details Label array is written to caller's memory, therefore nothing should be destroyed.
+ *
+ * @param[in] pointer_cure_data: pointer to CURE clustering data.
+ * @param[in] p_size: amount of points in the input data that has been clustered.
+ * @param[out] p_labels: array of 'p_size' elements where index of cluster of each point is written.
+ *
+ * @return  Returns amount of allocated clusters.
+ *
+ */
+extern "C" DECLARATION size_t cure_get_labels(const void * pointer_cure_data, const size_t p_size, int32_t * const p_labels);
+
+
+/**
+ *
+ * @brief   Returns performance statistics of the call that has produced the CURE result.
+ * @details Statistics is collected only if it has been enabled by 'statistics_enable()'. Caller
+ *          should destroy returned package, its layout is described by 'create_statistics_package()'.
+ *
+ * @param[in] pointer_cure_data: pointer to CURE result that is returned by 'cure_algorithm'.
+ *
+ */
+extern "C" DECLARATION pyclustering_package * cure_get_statistics(const void * pointer_cure_data);
+
 
 #endif
@@ -0,0 +1,97 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#include "interface/dataset_file_interface.h"
+
+#include <stdexcept>
+
+#include "utils/dataset_file.hpp"
+
+
+bool dataset_file_write(const char * const p_path, const double * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride) {
+    try {
+        utils::dataset_file::write(p_path, dataset_view(p_data, p_size, p_dimension, p_stride));
+    }
+    catch (std::exception &) {
+        return false;
+    }
+
+    return true;
+}
+
+
+bool dataset_file_write_f32(const char * const p_path, const float * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride) {
+    try {
+        utils::dataset_file::write(p_path, dataset_view_f32(p_data, p_size, p_dimension, p_stride));
+    }
+    catch (std::exception &) {
+        return false;
+    }
+
+    return true;
+}
+
+
+void * dataset_file_open(const char * const p_path) {
+    try {
+        return new utils::dataset_file(p_path);
+    }
+    catch (std::exception &) {
+        return nullptr;
+    }
+}
+
+
+void dataset_file_close(void * p_pointer) {
+    delete (utils::dataset_file *) p_pointer;
+}
+
+
+size_t dataset_file_value_type(const void * p_pointer) {
+    return static_cast<size_t>(((const utils::dataset_file *) p_pointer)->type());
+}
+
+
+const double * dataset_file_data(const void * p_pointer) {
+    const utils::dataset_file * file = (const utils::dataset_file *) p_pointer;
+    return (file->type() == utils::dataset_file_type::FLOAT64) ? file->view().data() : nullptr;
+}
+
+
+const float * dataset_file_data_f32(const void * p_pointer) {
+    const utils::dataset_file * file = (const utils::dataset_file *) p_pointer;
+    return (file->type() == utils::dataset_file_type::FLOAT32) ? file->view_f32().data() : nullptr;
+}
+
+
+size_t dataset_file_size(const void * p_pointer) {
+    return ((const utils::dataset_file *) p_pointer)->size();
+}
+
+
+size_t dataset_file_dimension(const void * p_pointer) {
+    return ((const utils::dataset_file *) p_pointer)->dimension();
+}
+
+
+size_t dataset_file_stride(const void * p_pointer) {
+    return ((const utils::dataset_file *) p_pointer)->stride();
+}
@@ -0,0 +1,143 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#ifndef SRC_INTERFACE_DATASET_FILE_INTERFACE_H_
+#define SRC_INTERFACE_DATASET_FILE_INTERFACE_H_
+
+
+#include <cstddef>
+
+#include "definitions.hpp"
+
+
+/**
+ *
+ * @brief   Writes points from contiguous row-major memory block to binary dataset file.
+ *
+ * @param[in] p_path: path to the file that is created or overwritten.
+ * @param[in] p_data: pointer to the first coordinate of the first point.
+ * @param[in] p_size: amount of points in the block.
+ * @param[in] p_dimension: amount of coordinates of each point.
+ * @param[in] p_stride: distance in elements between beginnings of neighbor points, zero means
+ *             that points are densely packed.
+ *
+ * @return  Returns 'true' if the file has been written successfully.
+ *
+ */
+extern "C" DECLARATION bool dataset_file_write(const char * const p_path, const double * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride);
+
+/**
+ *
+ * @brief   Writes points with single precision coordinates from contiguous row-major memory block
+ *          to binary dataset file.
+ * @details Parameters are the same as for 'dataset_file_write'.
+ *
+ * @return  Returns 'true' if the file has been written successfully.
+ *
+ */
+extern "C" DECLARATION bool dataset_file_write_f32(const char * const p_path, const float * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride);
+
+/**
+ *
+ * @brief   Maps binary dataset file to memory.
+ * @details Mapped points can be passed to any '*_algorithm_buffer' or '*_algorithm_labels'
+ *          function using 'dataset_file_data', 'dataset_file_size', 'dataset_file_dimension'
+ *          and 'dataset_file_stride', in this case algorithm reads points directly from the file
+ *          without parsing and copying. Caller should close returned handle by 'dataset_file_close'.
+ *
+ * @param[in] p_path: path to the binary dataset file.
+ *
+ * @return  Returns handle of mapped file or null if the file can not be mapped.
+ *
+ */
+extern "C" DECLARATION void * dataset_file_open(const char * const p_path);
+
+/**
+ *
+ * @brief   Unmaps binary dataset file, pointer to its data becomes invalid.
+ *
+ * @param[in] p_pointer: handle of mapped file that is returned by 'dataset_file_open'.
+ *
+ */
+extern "C" DECLARATION void dataset_file_close(void * p_pointer);
+
+/**
+ *
+ * @brief   Returns type of coordinates in the mapped file: 0 - double precision, 1 - single precision
+ *          (see 'utils::dataset_file_type').
+ *
+ * @param[in] p_pointer: handle of mapped file.
+ *
+ */
+extern "C" DECLARATION size_t dataset_file_value_type(const void * p_pointer);
+
+/**
+ *
+ * @brief   Returns pointer to the first coordinate of the first point in the mapped file.
+ *
+ * @param[in] p_pointer: handle of mapped file.
+ *
+ * @return  Returns pointer to coordinates or null if coordinates are not stored in double precision.
+ *
+ */
+extern "C" DECLARATION const double * dataset_file_data(const void * p_pointer);
+
+/**
+ *
+ * @brief   Returns pointer to the first single precision coordinate of the first point in the
+ *          mapped file, it can be passed to '*_algorithm_labels_f32' functions.
+ *
+ * @param[in] p_pointer: handle of mapped file.
+ *
+ * @return  Returns pointer to coordinates or null if coordinates are not stored in single precision.
+ *
+ */
+extern "C" DECLARATION const float * dataset_file_data_f32(const void * p_pointer);
+
+/**
+ *
+ * @brief   Returns amount of points in the mapped file.
+ *
+ * @param[in] p_pointer: handle of mapped file.
+ *
+ */
+extern "C" DECLARATION size_t dataset_file_size(const void * p_pointer);
+
+/**
+ *
+ * @brief   Returns amount of coordinates of each point in the mapped file.
+ *
+ * @param[in] p_pointer: handle of mapped file.
+ *
+ */
+extern "C" DECLARATION size_t dataset_file_dimension(const void * p_pointer);
+
+/**
+ *
+ * @brief   Returns distance in elements between beginnings of neighbor points in the mapped file.
+ *
+ * @param[in] p_pointer: handle of mapped file.
+ *
+ */
+extern "C" DECLARATION size_t dataset_file_stride(const void * p_pointer);
+
+
+#endif
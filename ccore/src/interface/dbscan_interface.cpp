@@ -20,27 +20,151 @@
 
 #include "interface/dbscan_interface.h"
 
+#include <stdexcept>
+
 #include "cluster/dbscan.hpp"
 
+#include "container/neighborhood_graph.hpp"
+#include "container/static_kdtree.hpp"
 
-pyclustering_package * dbscan_algorithm(const data_representation * const sample, const double radius, const size_t minumum_neighbors) {
-    std::unique_ptr<dataset> input_dataset(read_sample(sample));
 
-    cluster_analysis::dbscan solver(radius, minumum_neighbors);
+/* statistics of the last call in the thread, each thread that uses the library keeps its own */
+static thread_local utils::statistics_ptr last_statistics;
 
-    cluster_analysis::dbscan_data output_result;
 
-    solver.process(*input_dataset, output_result);
+static pyclustering_package * create_dbscan_package(cluster_analysis::dbscan_data & p_result) {
+    last_statistics = p_result.statistics();
 
     pyclustering_package * package = new pyclustering_package((unsigned int) pyclustering_type_data::PYCLUSTERING_TYPE_LIST);
-    package->size = output_result.size() + 1;   /* the last for noise */
+    package->size = p_result.size() + 1;   /* the last for noise */
     package->data = new pyclustering_package * [package->size + 1];
 
     for (unsigned int i = 0; i < package->size - 1; i++) {
-        ((pyclustering_package **) package->data)[i] = create_package(&output_result[i]);
+        ((pyclustering_package **) package->data)[i] = create_package(&p_result[i]);
     }
 
-    ((pyclustering_package **) package->data)[package->size - 1] = create_package(output_result.noise().get());
+    ((pyclustering_package **) package->data)[package->size - 1] = create_package(p_result.noise().get());
 
     return package;
 }
+
+
+pyclustering_package * dbscan_algorithm(const data_representation * const sample, const double radius, const size_t minumum_neighbors) {
+    const dataset_matrix input_data = read_sample_matrix(sample);
+
+    cluster_analysis::dbscan solver(radius, minumum_neighbors);
+
+    cluster_analysis::dbscan_data output_result;
+
+    solver.process(input_data.view(), output_result);
+
+    return create_dbscan_package(output_result);
+}
+
+
+pyclustering_package * dbscan_algorithm_metric(const data_representation * const p_sample, const double p_radius, const size_t p_minumum_neighbors, const size_t p_metric, const double p_degree) {
+    const dataset_matrix input_data = read_sample_matrix(p_sample);
+
+    return utils::metric::dispatch((utils::metric::type_metric) p_metric, p_degree, [&](const auto & p_metric_policy) {
+        using metric_type = std::decay_t<decltype(p_metric_policy)>;
+
+        cluster_analysis::basic_dbscan<metric_type> solver(p_radius, p_minumum_neighbors, p_metric_policy);
+
+        cluster_analysis::dbscan_data output_result;
+        solver.process(input_data.view(), output_result);
+
+        return create_dbscan_package(output_result);
+    });
+}
+
+
+pyclustering_package * dbscan_algorithm_buffer(const double * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride, const double p_radius, const size_t p_minumum_neighbors) {
+    const dataset_view input_data(p_data, p_size, p_dimension, p_stride);
+
+    cluster_analysis::dbscan solver(p_radius, p_minumum_neighbors);
+
+    cluster_analysis::dbscan_data output_result;
+    solver.process(input_data, output_result);
+
+    return create_dbscan_package(output_result);
+}
+
+
+size_t dbscan_algorithm_labels(const double * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride, const double p_radius, const size_t p_minumum_neighbors, int32_t * const p_labels) {
+    const dataset_view input_data(p_data, p_size, p_dimension, p_stride);
+
+    cluster_analysis::dbscan solver(p_radius, p_minumum_neighbors);
+
+    cluster_analysis::dbscan_data output_result;
+    solver.process(input_data, output_result);
+    last_statistics = output_result.statistics();
+
+    output_result.export_labels(p_labels, p_size);
+    return output_result.size();
+}
+
+
+size_t dbscan_algorithm_labels_f32(const float * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride, const double p_radius, const size_t p_minumum_neighbors, int32_t * const p_labels) {
+    const dataset_view_f32 input_data(p_data, p_size, p_dimension, p_stride);
+
+    cluster_analysis::dbscan solver(p_radius, p_minumum_neighbors);
+
+    cluster_analysis::dbscan_data output_result;
+    solver.process(input_data, output_result);
+    last_statistics = output_result.statistics();
+
+    output_result.export_labels(p_labels, p_size);
+    return output_result.size();
+}
+
+
+pyclustering_package * dbscan_algorithm_labels_package(const double * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride, const double p_radius, const size_t p_minumum_neighbors) {
+    std::unique_ptr<pyclustering_package> package(create_labels_package(p_size));
+    dbscan_algorithm_labels(p_data, p_size, p_dimension, p_stride, p_radius, p_minumum_neighbors, (int32_t *) package->data);
+
+    return package.release();
+}
+
+
+size_t dbscan_algorithm_labels_graph(const void * const p_graph, const double p_radius, const size_t p_minumum_neighbors, int32_t * const p_labels) {
+    try {
+        const container::neighborhood_graph & graph = *((const container::neighborhood_graph *) p_graph);
+
+        cluster_analysis::dbscan solver(p_radius, p_minumum_neighbors);
+
+        cluster_analysis::dbscan_data output_result;
+        solver.process(graph, output_result);
+        last_statistics = output_result.statistics();
+
+        output_result.export_labels(p_labels, graph.size());
+        return output_result.size();
+    }
+    catch (std::exception &) {
+        return SIZE_MAX;
+    }
+}
+
+
+size_t dbscan_algorithm_labels_kdtree(const void * const p_tree, const double * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride, const double p_radius, const size_t p_minumum_neighbors, int32_t * const p_labels) {
+    try {
+        const container::static_kdtree & tree = *((const container::static_kdtree *) p_tree);
+        const dataset_view input_data(p_data, p_size, p_dimension, p_stride);
+
+        cluster_analysis::dbscan solver(p_radius, p_minumum_neighbors);
+
+        cluster_analysis::dbscan_data output_result;
+        solver.process(tree, input_data, output_result);
+        last_statistics = output_result.statistics();
+
+        output_result.export_labels(p_labels, p_size);
+        return output_result.size();
+    }
+    catch (std::exception &) {
+        return SIZE_MAX;
+    }
+}
+
+
+pyclustering_package * dbscan_get_statistics(void) {
+    return create_statistics_package(last_statistics);
+}
@@ -23,6 +23,10 @@
 #include "cluster/kmeans.hpp"
 
 
+/* statistics of the last call in the thread, each thread that uses the library keeps its own */
+static thread_local utils::statistics_ptr last_statistics;
+
+
 pyclustering_package * kmeans_algorithm(const data_representation * const sample, const data_representation * const initial_centers, const double tolerance) {
     std::unique_ptr<dataset> data(read_sample(sample));
     std::unique_ptr<dataset> centers(read_sample(initial_centers));
@@ -31,7 +35,79 @@ pyclustering_package * kmeans_algorithm(const data_representation * const sample
 
     cluster_analysis::kmeans_data output_result;
     algorithm.process(*data, output_result);
+    last_statistics = output_result.statistics();
 
     pyclustering_package * package = create_package(output_result.clusters().get());
     return package;
 }
+
+
+template <typename TypeValue>
+static void kmeans_process_buffer(const TypeValue * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride,
+                                  const TypeValue * const p_centers, const size_t p_amount_centers, const double p_tolerance,
+                                  cluster_analysis::kmeans_data & p_result)
+{
+    const container::dense_matrix_view<TypeValue> input_data(p_data, p_size, p_dimension, p_stride);
+
+    const container::dense_matrix_view<TypeValue> centers_data(p_centers, p_amount_centers, p_dimension);
+
+    dataset centers(p_amount_centers);
+    for (std::size_t index = 0; index < p_amount_centers; index++) {
+        centers[index].assign(centers_data[index], centers_data[index] + p_dimension);
+    }
+
+    cluster_analysis::kmeans algorithm(centers, p_tolerance);
+
+    algorithm.process(input_data, p_result);
+    last_statistics = p_result.statistics();
+}
+
+
+pyclustering_package * kmeans_algorithm_buffer(const double * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride,
+                                               const double * const p_centers, const size_t p_amount_centers, const double p_tolerance)
+{
+    cluster_analysis::kmeans_data output_result;
+    kmeans_process_buffer(p_data, p_size, p_dimension, p_stride, p_centers, p_amount_centers, p_tolerance, output_result);
+
+    pyclustering_package * package = create_package(output_result.clusters().get());
+    return package;
+}
+
+
+size_t kmeans_algorithm_labels(const double * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride,
+                               const double * const p_centers, const size_t p_amount_centers, const double p_tolerance,
+                               int32_t * const p_labels)
+{
+    cluster_analysis::kmeans_data output_result;
+    kmeans_process_buffer(p_data, p_size, p_dimension, p_stride, p_centers, p_amount_centers, p_tolerance, output_result);
+
+    output_result.export_labels(p_labels, p_size);
+    return output_result.size();
+}
+
+
+size_t kmeans_algorithm_labels_f32(const float * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride,
+                                   const float * const p_centers, const size_t p_amount_centers, const double p_tolerance,
+                                   int32_t * const p_labels)
+{
+    cluster_analysis::kmeans_data output_result;
+    kmeans_process_buffer(p_data, p_size, p_dimension, p_stride, p_centers, p_amount_centers, p_tolerance, output_result);
+
+    output_result.export_labels(p_labels, p_size);
+    return output_result.size();
+}
+
+
+pyclustering_package * kmeans_algorithm_labels_package(const double * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride,
+                                                       const double * const p_centers, const size_t p_amount_centers, const double p_tolerance)
+{
+    std::unique_ptr<pyclustering_package> package(create_labels_package(p_size));
+    kmeans_algorithm_labels(p_data, p_size, p_dimension, p_stride, p_centers, p_amount_centers, p_tolerance, (int32_t *) package->data);
+
+    return package.release();
+}
+
+
+pyclustering_package * kmeans_get_statistics(void) {
+    return create_statistics_package(last_statistics);
+}
@@ -22,7 +22,10 @@
 #define SRC_INTERFACE_KMEANS_INTERFACE_H_
 
 
+#include <cstdint>
+
 #include "interface/pyclustering_package.hpp"
+#include "interface/statistics_interface.h"
 
 #include "definitions.hpp"
 #include "utils.hpp"
@@ -42,5 +45,98 @@
  */
 extern "C" DECLARATION pyclustering_package * kmeans_algorithm(const data_representation * const p_sample, const data_representation * const p_centers, const double p_tolerance);
 
+/**
+ *
+ * @brief   Clustering algorithm K-Means that processes data directly from contiguous row-major
+ *          memory block without copying it.
+ * @details Caller should destroy returned result in 'pyclustering_package'.
+ *
+ * @param[in] p_data: pointer to the first coordinate of the first point.
+ * @param[in] p_size: amount of points in the block.
+ * @param[in] p_dimension: amount of coordinates of each point (and each center).
+ * @param[in] p_stride: distance in elements between beginnings of neighbor points, zero means
+ *             that points are densely packed.
+ * @param[in] p_centers: densely packed initial cluster centers.
+ * @param[in] p_amount_centers: amount of initial cluster centers.
+ * @param[in] p_tolerance: stop condition - when changes of medians are less then tolerance value.
+ *
+ * @return  Returns result of clustering - array of allocated clusters.
+ *
+ */
+extern "C" DECLARATION pyclustering_package * kmeans_algorithm_buffer(const double * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride,
+                                                                      const double * const p_centers, const size_t p_amount_centers, const double p_tolerance);
+
+/**
+ *
+ * @brief   Clustering algorithm K-Means that processes data from contiguous row-major memory block
+ *          and writes result as flat label array.
+ * @details Label array is written to caller's memory, therefore nothing should be destroyed after
+ *          the call.
+ *
+ * @param[in] p_data: pointer to the first coordinate of the first point.
+ * @param[in] p_size: amount of points in the block.
+ * @param[in] p_dimension: amount of coordinates of each point (and each center).
+ * @param[in] p_stride: distance in elements between beginnings of neighbor points, zero means
+ *             that points are densely packed.
+ * @param[in] p_centers: densely packed initial cluster centers.
+ * @param[in] p_amount_centers: amount of initial cluster centers.
+ * @param[in] p_tolerance: stop condition - when changes of medians are less then tolerance value.
+ * @param[out] p_labels: array of 'p_size' elements where index of cluster of each point is written.
+ *
+ * @return  Returns amount of allocated clusters.
+ *
+ */
+extern "C" DECLARATION size_t kmeans_algorithm_labels(const double * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride,
+                                                      const double * const p_centers, const size_t p_amount_centers, const double p_tolerance,
+                                                      int32_t * const p_labels);
+
+/**
+ *
+ * @brief   Clustering algorithm K-Means that processes single precision data from contiguous
+ *          row-major memory block and writes result as flat label array.
+ * @details Objects are assigned to clusters using single precision distances, cluster centers are
+ *          updated in double precision.
+ *
+ * @param[in] p_data: pointer to the first coordinate of the first point.
+ * @param[in] p_size: amount of points in the block.
+ * @param[in] p_dimension: amount of coordinates of each point (and each center).
+ * @param[in] p_stride: distance in elements between beginnings of neighbor points, zero means
+ *             that points are densely packed.
+ * @param[in] p_centers: densely packed initial cluster centers.
+ * @param[in] p_amount_centers: amount of initial cluster centers.
+ * @param[in] p_tolerance: stop condition - when changes of medians are less then tolerance value.
+ * @param[out] p_labels: array of 'p_size' elements where index of cluster of each point is written.
+ *
+ * @return  Returns amount of allocated clusters.
+ *
+ */
+extern "C" DECLARATION size_t kmeans_algorithm_labels_f32(const float * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride,
+                                                          const float * const p_centers, const size_t p_amount_centers, const double p_tolerance,
+                                                          int32_t * const p_labels);
+
+/**
+ *
+ * @brief   Clustering algorithm K-Means that processes data from contiguous row-major memory block
+ *          and returns result as flat label array.
+ * @details Parameters are the same as for 'kmeans_algorithm_labels', but label array is allocated
+ *          by the library, it is used when caller does not manage memory itself.
+ *
+ * @return  Returns package with 'p_size' labels of type int32, the package should be destroyed
+ *          by caller.
+ *
+ */
+extern "C" DECLARATION pyclustering_package * kmeans_algorithm_labels_package(const double * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride,
+                                                                              const double * const p_centers, const size_t p_amount_centers, const double p_tolerance);
+
+
+/**
+ *
+ * @brief   Returns performance statistics of the last call of K-Means algorithm in the calling thread.
+ * @details Statistics is collected only if it has been enabled by 'statistics_enable()'. Caller
+ *          should destroy returned package, its layout is described by 'create_statistics_package()'.
+ *
+ */
+extern "C" DECLARATION pyclustering_package * kmeans_get_statistics(void);
+
 
 #endif
@@ -37,3 +37,20 @@ pyclustering_package * kmedoids_algorithm(const data_representation * const samp
     return package;
 }
 
+
+pyclustering_package * kmedoids_algorithm_metric(const data_representation * const p_sample, const pyclustering_package * const p_medoids, const double p_tolerance, const size_t p_metric, const double p_degree) {
+    cluster_analysis::medoid_sequence medoids((size_t *) p_medoids->data, ((size_t *) p_medoids->data) + p_medoids->size);
+
+    std::unique_ptr<dataset> input_dataset(read_sample(p_sample));
+
+    return utils::metric::dispatch((utils::metric::type_metric) p_metric, p_degree, [&](const auto & p_metric_policy) {
+        using metric_type = std::decay_t<decltype(p_metric_policy)>;
+
+        cluster_analysis::basic_kmedoids<metric_type> algorithm(medoids, p_tolerance, p_metric_policy);
+
+        cluster_analysis::kmedoids_data output_result;
+        algorithm.process(*input_dataset, output_result);
+
+        return create_package(output_result.clusters().get());
+    });
+}
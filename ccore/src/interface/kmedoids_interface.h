@@ -42,5 +42,24 @@
  */
 extern "C" DECLARATION pyclustering_package * kmedoids_algorithm(const data_representation * const sample, const pyclustering_package * const medoids, const double tolerance);
 
+/**
+ *
+ * @brief   Clustering algorithm K-Medoids that uses specified metric to calculate distance between
+ *          points.
+ * @details Caller should destroy returned result that is in 'pyclustering_package'.
+ *
+ * @param[in] p_sample: input data for clustering.
+ * @param[in] p_medoids: initial medoids of clusters.
+ * @param[in] p_tolerance: stop condition - when changes of medoids are less then tolerance value.
+ * @param[in] p_metric: type of metric that is used to calculate distance between points:
+ *             0 - Euclidean, 1 - square Euclidean, 2 - Manhattan, 3 - Chebyshev, 4 - Minkowski,
+ *             5 - cosine (see 'utils::metric::type_metric').
+ * @param[in] p_degree: degree of Minkowski metric, it is ignored by other metrics.
+ *
+ * @return  Returns result of clustering - array of allocated clusters.
+ *
+ */
+extern "C" DECLARATION pyclustering_package * kmedoids_algorithm_metric(const data_representation * const p_sample, const pyclustering_package * const p_medoids, const double p_tolerance, const size_t p_metric, const double p_degree);
+
 
 #endif
@@ -0,0 +1,71 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#include "interface/neighborhood_graph_interface.h"
+
+#include <stdexcept>
+
+#include "container/neighborhood_graph.hpp"
+
+
+void * neighborhood_graph_create(const double * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride, const double p_radius) {
+    try {
+        const dataset_view input_data(p_data, p_size, p_dimension, p_stride);
+        return new container::neighborhood_graph(container::neighborhood_graph::create(input_data, p_radius, utils::metric::euclidean()));
+    }
+    catch (std::exception &) {
+        return nullptr;
+    }
+}
+
+
+void neighborhood_graph_destroy(void * p_pointer) {
+    delete (container::neighborhood_graph *) p_pointer;
+}
+
+
+size_t neighborhood_graph_size(const void * p_pointer) {
+    return ((const container::neighborhood_graph *) p_pointer)->size();
+}
+
+
+size_t neighborhood_graph_edges(const void * p_pointer) {
+    return ((const container::neighborhood_graph *) p_pointer)->edges();
+}
+
+
+double neighborhood_graph_radius(const void * p_pointer) {
+    return ((const container::neighborhood_graph *) p_pointer)->radius();
+}
+
+
+const size_t * neighborhood_graph_offsets(const void * p_pointer) {
+    return ((const container::neighborhood_graph *) p_pointer)->offsets().data();
+}
+
+
+const size_t * neighborhood_graph_neighbors(const void * p_pointer) {
+    return ((const container::neighborhood_graph *) p_pointer)->neighbors().data();
+}
+
+
+const double * neighborhood_graph_distances(const void * p_pointer) {
+    return ((const container::neighborhood_graph *) p_pointer)->distances().data();
+}
@@ -0,0 +1,116 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#ifndef SRC_INTERFACE_NEIGHBORHOOD_GRAPH_INTERFACE_H_
+#define SRC_INTERFACE_NEIGHBORHOOD_GRAPH_INTERFACE_H_
+
+
+#include <cstddef>
+
+#include "definitions.hpp"
+
+
+/**
+ *
+ * @brief   Builds Euclidean neighborhood graph of points from contiguous row-major memory block.
+ * @details Points are connected if Euclidean distance between them is less or equal to the radius.
+ *          Returned graph can be passed to '*_algorithm_labels_graph', 'rock_algorithm_graph' and
+ *          'syncnet_create_network_graph' with any connectivity radius that does not exceed radius
+ *          of the graph, so neighbors are searched only once for several runs of algorithms.
+ *          Caller should destroy returned handle by 'neighborhood_graph_destroy'.
+ *
+ * @param[in] p_data: pointer to the first coordinate of the first point.
+ * @param[in] p_size: amount of points in the block.
+ * @param[in] p_dimension: amount of coordinates of each point.
+ * @param[in] p_stride: distance in elements between beginnings of neighbor points, zero means
+ *             that points are densely packed.
+ * @param[in] p_radius: connectivity radius between points.
+ *
+ * @return  Returns handle of the graph or null if the graph can not be built.
+ *
+ */
+extern "C" DECLARATION void * neighborhood_graph_create(const double * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride, const double p_radius);
+
+/**
+ *
+ * @brief   Destroys neighborhood graph.
+ *
+ * @param[in] p_pointer: handle of the graph that is returned by 'neighborhood_graph_create'.
+ *
+ */
+extern "C" DECLARATION void neighborhood_graph_destroy(void * p_pointer);
+
+/**
+ *
+ * @brief   Returns amount of points in neighborhood graph.
+ *
+ * @param[in] p_pointer: handle of the graph.
+ *
+ */
+extern "C" DECLARATION size_t neighborhood_graph_size(const void * p_pointer);
+
+/**
+ *
+ * @brief   Returns amount of stored edges, each connection is stored for both points.
+ *
+ * @param[in] p_pointer: handle of the graph.
+ *
+ */
+extern "C" DECLARATION size_t neighborhood_graph_edges(const void * p_pointer);
+
+/**
+ *
+ * @brief   Returns connectivity radius that has been used to build neighborhood graph.
+ *
+ * @param[in] p_pointer: handle of the graph.
+ *
+ */
+extern "C" DECLARATION double neighborhood_graph_radius(const void * p_pointer);
+
+/**
+ *
+ * @brief   Returns 'size + 1' offsets, neighbors of point 'i' are placed in range
+ *          [offsets[i], offsets[i + 1]) of arrays of neighbors and distances.
+ *
+ * @param[in] p_pointer: handle of the graph.
+ *
+ */
+extern "C" DECLARATION const size_t * neighborhood_graph_offsets(const void * p_pointer);
+
+/**
+ *
+ * @brief   Returns indexes of neighbors of all points, neighbors of each point are sorted.
+ *
+ * @param[in] p_pointer: handle of the graph.
+ *
+ */
+extern "C" DECLARATION const size_t * neighborhood_graph_neighbors(const void * p_pointer);
+
+/**
+ *
+ * @brief   Returns square Euclidean distances to neighbors of all points.
+ *
+ * @param[in] p_pointer: handle of the graph.
+ *
+ */
+extern "C" DECLARATION const double * neighborhood_graph_distances(const void * p_pointer);
+
+
+#endif
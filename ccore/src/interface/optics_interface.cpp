@@ -1,28 +1,32 @@
-/**
-*
-* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
-*
-* GNU_PUBLIC_LICENSE
-*   pyclustering is free software: you can redistribute it and/or modify
-*   it under the terms of the GNU General Public License as published by
-*   the Free Software Foundation, either version 3 of the License, or
-*   (at your option) any later version.
-*
-*   pyclustering is distributed in the hope that it will be useful,
-*   but WITHOUT ANY WARRANTY; without even the implied warranty of
-*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-*   GNU General Public License for more details.
-*
-*   You should have received a copy of the GNU General Public License
-*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
-*
-*/
-
-
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
 #include "interface/optics_interface.h"
 
+#include <stdexcept>
+
 #include "cluster/optics.hpp"
 
+#include "container/neighborhood_graph.hpp"
+
 
 typedef enum optics_package_indexer {
 	OPTICS_PACKAGE_INDEX_CLUSTERS = 0,
@@ -33,24 +37,123 @@ typedef enum optics_package_indexer {
 } optics_package_indexer;
 
 
-pyclustering_package * optics_algorithm(const data_representation * const p_sample, const double p_radius, const size_t p_minumum_neighbors, const size_t p_amount_clusters) {
-    std::unique_ptr<dataset> input_dataset(read_sample(p_sample));
+/* statistics of the last call in the thread, each thread that uses the library keeps its own */
+static thread_local utils::statistics_ptr last_statistics;
 
-    cluster_analysis::optics solver(p_radius, p_minumum_neighbors, p_amount_clusters);
 
-    cluster_analysis::optics_data output_result;
-    solver.process(*input_dataset, output_result);
+static pyclustering_package * create_optics_package(cluster_analysis::optics_data & p_result) {
+	last_statistics = p_result.statistics();
 
 	pyclustering_package * package = new pyclustering_package((unsigned int) pyclustering_type_data::PYCLUSTERING_TYPE_LIST);
 	package->size = OPTICS_PACKAGE_SIZE;
 	package->data = new pyclustering_package * [OPTICS_PACKAGE_SIZE];
 
-    ((pyclustering_package **) package->data)[OPTICS_PACKAGE_INDEX_CLUSTERS] = create_package(output_result.clusters().get());
-	((pyclustering_package **) package->data)[OPTICS_PACKAGE_INDEX_NOISE] = create_package(output_result.noise().get());
-	((pyclustering_package **) package->data)[OPTICS_PACKAGE_INDEX_ORDERING] = create_package(output_result.ordering().get());
+    ((pyclustering_package **) package->data)[OPTICS_PACKAGE_INDEX_CLUSTERS] = create_package(p_result.clusters().get());
+	((pyclustering_package **) package->data)[OPTICS_PACKAGE_INDEX_NOISE] = create_package(p_result.noise().get());
+	((pyclustering_package **) package->data)[OPTICS_PACKAGE_INDEX_ORDERING] = create_package(p_result.ordering().get());
 
-	std::vector<double> radius_storage(1, output_result.get_radius());
+	std::vector<double> radius_storage(1, p_result.get_radius());
 	((pyclustering_package **) package->data)[OPTICS_PACKAGE_INDEX_RADIUS] = create_package(&radius_storage);
-	
+
     return package;
-}
\ No newline at end of file
+}
+
+
+pyclustering_package * optics_algorithm(const data_representation * const p_sample, const double p_radius, const size_t p_minumum_neighbors, const size_t p_amount_clusters) {
+    const dataset_matrix input_data = read_sample_matrix(p_sample);
+
+    cluster_analysis::optics solver(p_radius, p_minumum_neighbors, p_amount_clusters);
+
+    cluster_analysis::optics_data output_result;
+    solver.process(input_data.view(), output_result);
+
+    return create_optics_package(output_result);
+}
+
+
+pyclustering_package * optics_algorithm_metric(const data_representation * const p_sample, const double p_radius, const size_t p_minumum_neighbors, const size_t p_amount_clusters, const size_t p_metric, const double p_degree) {
+    const dataset_matrix input_data = read_sample_matrix(p_sample);
+
+    return utils::metric::dispatch((utils::metric::type_metric) p_metric, p_degree, [&](const auto & p_metric_policy) {
+        using metric_type = std::decay_t<decltype(p_metric_policy)>;
+
+        cluster_analysis::basic_optics<metric_type> solver(p_radius, p_minumum_neighbors, p_amount_clusters, p_metric_policy);
+
+        cluster_analysis::optics_data output_result;
+        solver.process(input_data.view(), output_result);
+
+        return create_optics_package(output_result);
+    });
+}
+
+
+pyclustering_package * optics_algorithm_buffer(const double * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride, const double p_radius, const size_t p_minumum_neighbors, const size_t p_amount_clusters) {
+    const dataset_view input_data(p_data, p_size, p_dimension, p_stride);
+
+    cluster_analysis::optics solver(p_radius, p_minumum_neighbors, p_amount_clusters);
+
+    cluster_analysis::optics_data output_result;
+    solver.process(input_data, output_result);
+
+    return create_optics_package(output_result);
+}
+
+
+size_t optics_algorithm_labels(const double * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride, const double p_radius, const size_t p_minumum_neighbors, const size_t p_amount_clusters, int32_t * const p_labels) {
+    const dataset_view input_data(p_data, p_size, p_dimension, p_stride);
+
+    cluster_analysis::optics solver(p_radius, p_minumum_neighbors, p_amount_clusters);
+
+    cluster_analysis::optics_data output_result;
+    solver.process(input_data, output_result);
+    last_statistics = output_result.statistics();
+
+    output_result.export_labels(p_labels, p_size);
+    return output_result.size();
+}
+
+
+size_t optics_algorithm_labels_f32(const float * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride, const double p_radius, const size_t p_minumum_neighbors, const size_t p_amount_clusters, int32_t * const p_labels) {
+    const dataset_view_f32 input_data(p_data, p_size, p_dimension, p_stride);
+
+    cluster_analysis::optics solver(p_radius, p_minumum_neighbors, p_amount_clusters);
+
+    cluster_analysis::optics_data output_result;
+    solver.process(input_data, output_result);
+    last_statistics = output_result.statistics();
+
+    output_result.export_labels(p_labels, p_size);
+    return output_result.size();
+}
+
+
+pyclustering_package * optics_algorithm_labels_package(const double * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride, const double p_radius, const size_t p_minumum_neighbors, const size_t p_amount_clusters) {
+    std::unique_ptr<pyclustering_package> package(create_labels_package(p_size));
+    optics_algorithm_labels(p_data, p_size, p_dimension, p_stride, p_radius, p_minumum_neighbors, p_amount_clusters, (int32_t *) package->data);
+
+    return package.release();
+}
+
+
+size_t optics_algorithm_labels_graph(const void * const p_graph, const double p_radius, const size_t p_minumum_neighbors, const size_t p_amount_clusters, int32_t * const p_labels) {
+    try {
+        const container::neighborhood_graph & graph = *((const container::neighborhood_graph *) p_graph);
+
+        cluster_analysis::optics solver(p_radius, p_minumum_neighbors, p_amount_clusters);
+
+        cluster_analysis::optics_data output_result;
+        solver.process(graph, output_result);
+        last_statistics = output_result.statistics();
+
+        output_result.export_labels(p_labels, graph.size());
+        return output_result.size();
+    }
+    catch (std::exception &) {
+        return SIZE_MAX;
+    }
+}
+
+
+pyclustering_package * optics_get_statistics(void) {
+    return create_statistics_package(last_statistics);
+}
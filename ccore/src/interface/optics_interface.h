@@ -1,47 +1,178 @@
-/**
-*
-* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
-*
-* GNU_PUBLIC_LICENSE
-*   pyclustering is free software: you can redistribute it and/or modify
-*   it under the terms of the GNU General Public License as published by
-*   the Free Software Foundation, either version 3 of the License, or
-*   (at your option) any later version.
-*
-*   pyclustering is distributed in the hope that it will be useful,
-*   but WITHOUT ANY WARRANTY; without even the implied warranty of
-*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-*   GNU General Public License for more details.
-*
-*   You should have received a copy of the GNU General Public License
-*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
-*
-*/
-
-
-#pragma once
-
-
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#pragma once
+
+
+#include <cstdint>
+
 #include "interface/pyclustering_package.hpp"
+#include "interface/statistics_interface.h"
 
 #include "definitions.hpp"
 #include "utils.hpp"
 
-
-/**
- *
- * @brief   Clustering algorithm OPTICS returns allocated clusters, noise, ordering and proper connectivity radius.
- * @details Caller should destroy returned result in 'pyclustering_package'.
- *
- * @param[in] p_sample: input data for clustering.
- * @param[in] p_radius: connectivity radius between points, points may be connected if distance
- *             between them less then the radius.
- * @param[in] p_minumum_neighbors: minimum number of shared neighbors that is required for
- *             establish links between points.
- *
- * @return  Returns result of clustering - array that consists of four general clustering results that are represented by arrays too:
- *          [ [allocated clusters], [noise], [ordering], [connectivity radius] ]. It is important to note that connectivity radius
- *          is also placed into array.
- *
- */
-extern "C" DECLARATION pyclustering_package * optics_algorithm(const data_representation * const p_sample, const double p_radius, const size_t p_minumum_neighbors, const size_t p_amount_clusters);
+
+/**
+ *
+ * @brief   Clustering algorithm OPTICS returns allocated clusters, noise, ordering and proper connectivity radius.
+ * @details Caller should destroy returned result in 'pyclustering_package'.
+ *
+ * @param[in] p_sample: input data for clustering.
+ * @param[in] p_radius: connectivity radius between points, points may be connected if distance
+ *             between them less then the radius.
+ * @param[in] p_minumum_neighbors: minimum number of shared neighbors that is required for
+ *             establish links between points.
+ *
+ * @return  Returns result of clustering - array that consists of four general clustering results that are represented by arrays too:
+ *          [ [allocated clusters], [noise], [ordering], [connectivity radius] ]. It is important to note that connectivity radius
+ *          is also placed into array.
+ *
+ */
+extern "C" DECLARATION pyclustering_package * optics_algorithm(const data_representation * const p_sample, const double p_radius, const size_t p_minumum_neighbors, const size_t p_amount_clusters);
+
+/**
+ *
+ * @brief   Clustering algorithm OPTICS that uses specified metric to calculate distance between
+ *          points.
+ * @details Caller should destroy returned result in 'pyclustering_package'.
+ *
+ * @param[in] p_sample: input data for clustering.
+ * @param[in] p_radius: connectivity radius between points in terms of the specified metric.
+ * @param[in] p_minumum_neighbors: minimum number of shared neighbors that is required for
+ *             establish links between points.
+ * @param[in] p_amount_clusters: optional parameter, if it is greater than zero then connectivity
+ *             radius is calculated automatically to allocate the specified amount of clusters.
+ * @param[in] p_metric: type of metric that is used to calculate distance between points:
+ *             0 - Euclidean, 1 - square Euclidean, 2 - Manhattan, 3 - Chebyshev, 4 - Minkowski,
+ *             5 - cosine (see 'utils::metric::type_metric').
+ * @param[in] p_degree: degree of Minkowski metric, it is ignored by other metrics.
+ *
+ * @return  Returns result of clustering in the same format as 'optics_algorithm'.
+ *
+ */
+extern "C" DECLARATION pyclustering_package * optics_algorithm_metric(const data_representation * const p_sample, const double p_radius, const size_t p_minumum_neighbors, const size_t p_amount_clusters, const size_t p_metric, const double p_degree);
+
+/**
+ *
+ * @brief   Clustering algorithm OPTICS that processes data directly from contiguous row-major
+ *          memory block without copying it.
+ * @details Caller should destroy returned result in 'pyclustering_package'.
+ *
+ * @param[in] p_data: pointer to the first coordinate of the first point.
+ * @param[in] p_size: amount of points in the block.
+ * @param[in] p_dimension: amount of coordinates of each point.
+ * @param[in] p_stride: distance in elements between beginnings of neighbor points, zero means
+ *             that points are densely packed.
+ * @param[in] p_radius: connectivity radius between points.
+ * @param[in] p_minumum_neighbors: minimum number of shared neighbors that is required for
+ *             establish links between points.
+ * @param[in] p_amount_clusters: optional parameter, if it is greater than zero then connectivity
+ *             radius is calculated automatically to allocate the specified amount of clusters.
+ *
+ * @return  Returns result of clustering in the same format as 'optics_algorithm'.
+ *
+ */
+extern "C" DECLARATION pyclustering_package * optics_algorithm_buffer(const double * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride, const double p_radius, const size_t p_minumum_neighbors, const size_t p_amount_clusters);
+
+
+/**
+ *
+ * @brief   Clustering algorithm OPTICS that processes data from contiguous row-major memory block
+ *          and writes clusters as flat label array.
+ * @details Label array is written to caller's memory, therefore nothing should be destroyed after
+ *          the call. Noise is marked by label -1. Cluster ordering and radius are not returned by
+ *          this function, 'optics_algorithm_buffer' should be used to obtain them.
+ *
+ * @param[in] p_data: pointer to the first coordinate of the first point.
+ * @param[in] p_size: amount of points in the block.
+ * @param[in] p_dimension: amount of coordinates of each point.
+ * @param[in] p_stride: distance in elements between beginnings of neighbor points, zero means
+ *             that points are densely packed.
+ * @param[in] p_radius: connectivity radius between points.
+ * @param[in] p_minumum_neighbors: minimum number of shared neighbors that is required for
+ *             establish links between points.
+ * @param[in] p_amount_clusters: amount of clusters that should be allocated, zero means that
+ *             it is defined by the radius.
+ * @param[out] p_labels: array of 'p_size' elements where index of cluster of each point is written.
+ *
+ * @return  Returns amount of allocated clusters (noise is not counted).
+ *
+ */
+extern "C" DECLARATION size_t optics_algorithm_labels(const double * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride, const double p_radius, const size_t p_minumum_neighbors, const size_t p_amount_clusters, int32_t * const p_labels);
+
+/**
+ *
+ * @brief   Clustering algorithm OPTICS that processes single precision data from contiguous
+ *          row-major memory block and writes clusters as flat label array.
+ * @details Parameters and result are the same as for 'optics_algorithm_labels', distances between
+ *          points are calculated in single precision.
+ *
+ */
+extern "C" DECLARATION size_t optics_algorithm_labels_f32(const float * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride, const double p_radius, const size_t p_minumum_neighbors, const size_t p_amount_clusters, int32_t * const p_labels);
+
+/**
+ *
+ * @brief   Clustering algorithm OPTICS that processes data from contiguous row-major memory block
+ *          and returns clusters as flat label array.
+ * @details Parameters are the same as for 'optics_algorithm_labels', but label array is allocated
+ *          by the library, it is used when caller does not manage memory itself. Amount of
+ *          clusters is greater by one than maximum label.
+ *
+ * @return  Returns package with 'p_size' labels of type int32 (noise is marked by label -1),
+ *          the package should be destroyed by caller.
+ *
+ */
+extern "C" DECLARATION pyclustering_package * optics_algorithm_labels_package(const double * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride, const double p_radius, const size_t p_minumum_neighbors, const size_t p_amount_clusters);
+
+/**
+ *
+ * @brief   Clustering algorithm OPTICS that takes neighbors of points from neighborhood graph
+ *          and writes clusters as flat label array.
+ * @details Neighbors are not searched, so the graph can be reused for several values of minimum
+ *          amount of neighbors or amount of clusters. Result is the same as for
+ *          'optics_algorithm_labels'.
+ *
+ * @param[in] p_graph: handle of the graph that is returned by 'neighborhood_graph_create', its
+ *             radius should not be less than connectivity radius.
+ * @param[in] p_radius: connectivity radius between points.
+ * @param[in] p_minumum_neighbors: minimum number of shared neighbors that is required for
+ *             establish links between points.
+ * @param[in] p_amount_clusters: amount of clusters that should be allocated, zero means that
+ *             it is defined by the radius.
+ * @param[out] p_labels: array where index of cluster of each point of the graph is written.
+ *
+ * @return  Returns amount of allocated clusters (noise is not counted) or SIZE_MAX if the graph
+ *          can not be used with the parameters (for example, it is built with another metric),
+ *          in this case labels are not written.
+ *
+ */
+extern "C" DECLARATION size_t optics_algorithm_labels_graph(const void * const p_graph, const double p_radius, const size_t p_minumum_neighbors, const size_t p_amount_clusters, int32_t * const p_labels);
+
+
+/**
+ *
+ * @brief   Returns performance statistics of the last call of OPTICS algorithm in the calling thread.
+ * @details Statistics is collected only if it has been enabled by 'statistics_enable()'. Caller
+ *          should destroy returned package, its layout is described by 'create_statistics_package()'.
+ *
+ */
+extern "C" DECLARATION pyclustering_package * optics_get_statistics(void);
@@ -0,0 +1,39 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#include "interface/parallel_interface.h"
+
+#include "parallel/parallel.hpp"
+
+
+void parallel_set_thread_amount(const size_t p_amount) {
+    parallel::set_thread_amount(p_amount);
+}
+
+
+size_t parallel_get_thread_amount(void) {
+    return parallel::get_thread_amount();
+}
+
+
+void parallel_set_thread_pinning(const bool p_pinning) {
+    parallel::set_thread_pinning(p_pinning);
+}
@@ -0,0 +1,59 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#ifndef SRC_INTERFACE_PARALLEL_INTERFACE_H_
+#define SRC_INTERFACE_PARALLEL_INTERFACE_H_
+
+
+#include <cstddef>
+
+#include "definitions.hpp"
+
+
+/**
+ *
+ * @brief   Sets amount of threads that are used by parallel algorithms of the library.
+ * @details All callers share one global thread pool. Amount includes the calling thread, so 1 means
+ *          sequential processing and 0 means amount of hardware threads.
+ *
+ * @param[in] p_amount: amount of threads.
+ *
+ */
+extern "C" DECLARATION void parallel_set_thread_amount(const size_t p_amount);
+
+/**
+ *
+ * @brief   Returns amount of threads that are used by parallel algorithms of the library.
+ *
+ */
+extern "C" DECLARATION size_t parallel_get_thread_amount(void);
+
+/**
+ *
+ * @brief   Enables or disables binding of worker threads to processor cores.
+ *
+ * @param[in] p_pinning: if 'true' then each worker thread is bound to its own core.
+ *
+ */
+extern "C" DECLARATION void parallel_set_thread_pinning(const bool p_pinning);
+
+
+#endif
@@ -76,3 +76,14 @@ pyclustering_package::~pyclustering_package(void) {
         }
     }
 }
+
+
+pyclustering_package * create_labels_package(const std::size_t p_size) {
+    static_assert(sizeof(int) == sizeof(std::int32_t), "Labels are stored in package of 'int' type.");
+
+    pyclustering_package * package = new pyclustering_package((unsigned int) pyclustering_type_data::PYCLUSTERING_TYPE_INT);
+    package->size = p_size;
+    package->data = (void *) new int[p_size];
+
+    return package;
+}
@@ -22,6 +22,7 @@
 
 
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <type_traits>
 
@@ -98,6 +99,19 @@ pyclustering_package * create_package(const TypeContainer * const data) {
 }
 
 
+/**
+ *
+ * @brief   Creates package with flat label array where each label is 32-bit signed integer.
+ * @details Labels are not initialized, the array is filled by '*_algorithm_labels' functions.
+ *
+ * @param[in] p_size: amount of labels in the package.
+ *
+ * @return  Returns package with type 'PYCLUSTERING_TYPE_INT'.
+ *
+ */
+pyclustering_package * create_labels_package(const std::size_t p_size);
+
+
 template <class TypeObject>
 pyclustering_package * create_package(const std::vector< std::vector<TypeObject> > * const data) {
    pyclustering_package * package = new pyclustering_package((unsigned int) pyclustering_type_data::PYCLUSTERING_TYPE_LIST);
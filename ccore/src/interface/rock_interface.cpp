@@ -20,17 +20,66 @@
 
 #include "interface/rock_interface.h"
 
+#include <stdexcept>
+
 #include "cluster/rock.hpp"
 
+#include "container/neighborhood_graph.hpp"
+
 
 pyclustering_package * rock_algorithm(const data_representation * const sample, const double radius, const size_t number_clusters, const double threshold) {
-    std::unique_ptr<dataset> input_dataset(read_sample(sample));
+    const dataset_matrix input_data = read_sample_matrix(sample);
 
     cluster_analysis::rock solver(radius, number_clusters, threshold);
 
     cluster_analysis::rock_data output_result;
-    solver.process(*input_dataset, output_result);
+    solver.process(input_data.view(), output_result);
 
     pyclustering_package * package = create_package(output_result.clusters().get());
     return package;
 }
+
+
+pyclustering_package * rock_algorithm_metric(const data_representation * const p_sample, const double p_radius, const size_t p_number_clusters, const double p_threshold, const size_t p_metric, const double p_degree) {
+    const dataset_matrix input_data = read_sample_matrix(p_sample);
+
+    return utils::metric::dispatch((utils::metric::type_metric) p_metric, p_degree, [&](const auto & p_metric_policy) {
+        using metric_type = std::decay_t<decltype(p_metric_policy)>;
+
+        cluster_analysis::basic_rock<metric_type> solver(p_radius, p_number_clusters, p_threshold, p_metric_policy);
+
+        cluster_analysis::rock_data output_result;
+        solver.process(input_data.view(), output_result);
+
+        return create_package(output_result.clusters().get());
+    });
+}
+
+
+pyclustering_package * rock_algorithm_buffer(const double * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride, const double p_radius, const size_t p_number_clusters, const double p_threshold) {
+    const dataset_view input_data(p_data, p_size, p_dimension, p_stride);
+
+    cluster_analysis::rock solver(p_radius, p_number_clusters, p_threshold);
+
+    cluster_analysis::rock_data output_result;
+    solver.process(input_data, output_result);
+
+    pyclustering_package * package = create_package(output_result.clusters().get());
+    return package;
+}
+
+
+pyclustering_package * rock_algorithm_graph(const void * const p_graph, const double p_radius, const size_t p_number_clusters, const double p_threshold) {
+    try {
+        cluster_analysis::rock solver(p_radius, p_number_clusters, p_threshold);
+
+        cluster_analysis::rock_data output_result;
+        solver.process(*((const container::neighborhood_graph *) p_graph), output_result);
+
+        pyclustering_package * package = create_package(output_result.clusters().get());
+        return package;
+    }
+    catch (std::exception &) {
+        return nullptr;
+    }
+}
@@ -44,5 +44,67 @@
  */
 extern "C" DECLARATION pyclustering_package * rock_algorithm(const data_representation * const sample, const double radius, const size_t number_clusters, const double threshold);
 
+/**
+ *
+ * @brief   Clustering algorithm ROCK that uses specified metric to calculate distance between
+ *          points.
+ * @details Caller should destroy returned result in 'pyclustering_package'.
+ *
+ * @param[in] p_sample: input data for clustering.
+ * @param[in] p_radius: connectivity radius (similarity threshold) in terms of the specified metric.
+ * @param[in] p_number_clusters: number of clusters that should be allocated.
+ * @param[in] p_threshold: value that defines degree of normalization that influences on choice
+ *             of clusters for merging during processing.
+ * @param[in] p_metric: type of metric that is used to calculate distance between points:
+ *             0 - Euclidean, 1 - square Euclidean, 2 - Manhattan, 3 - Chebyshev, 4 - Minkowski,
+ *             5 - cosine (see 'utils::metric::type_metric').
+ * @param[in] p_degree: degree of Minkowski metric, it is ignored by other metrics.
+ *
+ * @return  Returns result of clustering - array of allocated clusters.
+ *
+ */
+extern "C" DECLARATION pyclustering_package * rock_algorithm_metric(const data_representation * const p_sample, const double p_radius, const size_t p_number_clusters, const double p_threshold, const size_t p_metric, const double p_degree);
+
+/**
+ *
+ * @brief   Clustering algorithm ROCK that processes data directly from contiguous row-major
+ *          memory block without copying it.
+ * @details Caller should destroy returned result in 'pyclustering_package'.
+ *
+ * @param[in] p_data: pointer to the first coordinate of the first point.
+ * @param[in] p_size: amount of points in the block.
+ * @param[in] p_dimension: amount of coordinates of each point.
+ * @param[in] p_stride: distance in elements between beginnings of neighbor points, zero means
+ *             that points are densely packed.
+ * @param[in] p_radius: connectivity radius (similarity threshold).
+ * @param[in] p_number_clusters: number of clusters that should be allocated.
+ * @param[in] p_threshold: value that defines degree of normalization that influences on choice
+ *             of clusters for merging during processing.
+ *
+ * @return  Returns result of clustering - array of allocated clusters.
+ *
+ */
+extern "C" DECLARATION pyclustering_package * rock_algorithm_buffer(const double * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride, const double p_radius, const size_t p_number_clusters, const double p_threshold);
+
+/**
+ *
+ * @brief   Clustering algorithm ROCK that takes links between points from neighborhood graph
+ *          instead of calculating distances between all points.
+ * @details The graph can be reused for several amounts of clusters. Caller should destroy
+ *          returned result in 'pyclustering_package'.
+ *
+ * @param[in] p_graph: handle of the graph that is returned by 'neighborhood_graph_create', its
+ *             radius should not be less than connectivity radius.
+ * @param[in] p_radius: connectivity radius (similarity threshold).
+ * @param[in] p_number_clusters: number of clusters that should be allocated.
+ * @param[in] p_threshold: value that defines degree of normalization that influences on choice
+ *             of clusters for merging during processing.
+ *
+ * @return  Returns result of clustering - array of allocated clusters, or null if the graph can
+ *          not be used with the parameters (for example, it is built with another metric).
+ *
+ */
+extern "C" DECLARATION pyclustering_package * rock_algorithm_graph(const void * const p_graph, const double p_radius, const size_t p_number_clusters, const double p_threshold);
+
 
 #endif
@@ -95,3 +95,8 @@ pyclustering_package * som_get_neighbors(const void * pointer) {
 
     return package;
 }
+
+
+pyclustering_package * som_get_statistics(const void * pointer) {
+    return create_statistics_package(((const som *) pointer)->get_statistics());
+}
@@ -27,6 +27,7 @@
 #include "nnet/som.hpp"
 
 #include "interface/pyclustering_package.hpp"
+#include "interface/statistics_interface.h"
 
 #include "definitions.hpp"
 
@@ -157,4 +158,16 @@ extern "C" DECLARATION pyclustering_package * som_get_awards(const void * pointe
 extern "C" DECLARATION pyclustering_package * som_get_neighbors(const void * pointer);
 
 
+/**
+ *
+ * @brief   Returns performance statistics of the last training of the self-organized map.
+ * @details Statistics is collected only if it has been enabled by 'statistics_enable()'. Caller
+ *          should destroy returned package, its layout is described by 'create_statistics_package()'.
+ *
+ * @param[in] pointer: pointer to the self-organized map.
+ *
+ */
+extern "C" DECLARATION pyclustering_package * som_get_statistics(const void * pointer);
+
+
 #endif
@@ -0,0 +1,73 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#include "interface/static_kdtree_interface.h"
+
+#include <stdexcept>
+
+#include "container/static_kdtree.hpp"
+
+
+void * static_kdtree_create(const double * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride) {
+    try {
+        const dataset_view input_data(p_data, p_size, p_dimension, p_stride);
+        return new container::static_kdtree(input_data);
+    }
+    catch (std::exception &) {
+        return nullptr;
+    }
+}
+
+
+bool static_kdtree_write(const void * p_pointer, const char * const p_path) {
+    try {
+        ((const container::static_kdtree *) p_pointer)->write(p_path);
+    }
+    catch (std::exception &) {
+        return false;
+    }
+
+    return true;
+}
+
+
+void * static_kdtree_open(const char * const p_path) {
+    try {
+        return new container::static_kdtree(container::static_kdtree::open(p_path));
+    }
+    catch (std::exception &) {
+        return nullptr;
+    }
+}
+
+
+void static_kdtree_destroy(void * p_pointer) {
+    delete (container::static_kdtree *) p_pointer;
+}
+
+
+size_t static_kdtree_size(const void * p_pointer) {
+    return ((const container::static_kdtree *) p_pointer)->size();
+}
+
+
+size_t static_kdtree_dimension(const void * p_pointer) {
+    return ((const container::static_kdtree *) p_pointer)->dimension();
+}
@@ -0,0 +1,104 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#ifndef SRC_INTERFACE_STATIC_KDTREE_INTERFACE_H_
+#define SRC_INTERFACE_STATIC_KDTREE_INTERFACE_H_
+
+
+#include <cstddef>
+
+#include "definitions.hpp"
+
+
+/**
+ *
+ * @brief   Builds static KD-tree of points from contiguous row-major memory block.
+ * @details Points are copied to the tree, so the memory block can be released after the call.
+ *          Returned tree can be written to file by 'static_kdtree_write' and passed to
+ *          'dbscan_algorithm_labels_kdtree'. Caller should destroy returned handle by
+ *          'static_kdtree_destroy'.
+ *
+ * @param[in] p_data: pointer to the first coordinate of the first point.
+ * @param[in] p_size: amount of points in the block.
+ * @param[in] p_dimension: amount of coordinates of each point.
+ * @param[in] p_stride: distance in elements between beginnings of neighbor points, zero means
+ *             that points are densely packed.
+ *
+ * @return  Returns handle of the tree or null if the tree can not be built.
+ *
+ */
+extern "C" DECLARATION void * static_kdtree_create(const double * const p_data, const size_t p_size, const size_t p_dimension, const size_t p_stride);
+
+/**
+ *
+ * @brief   Writes static KD-tree to binary file, so it can be opened later without rebuilding.
+ *
+ * @param[in] p_pointer: handle of the tree.
+ * @param[in] p_path: path to the file that is created or overwritten.
+ *
+ * @return  Returns 'true' if the file has been written successfully.
+ *
+ */
+extern "C" DECLARATION bool static_kdtree_write(const void * p_pointer, const char * const p_path);
+
+/**
+ *
+ * @brief   Opens static KD-tree from binary file by mapping the file to memory.
+ * @details The tree is not rebuilt and its arrays are not copied, so the same file can be cached
+ *          on disk and opened by several processes. Caller should destroy returned handle by
+ *          'static_kdtree_destroy'.
+ *
+ * @param[in] p_path: path to the file that has been written by 'static_kdtree_write'.
+ *
+ * @return  Returns handle of the tree or null if the file can not be opened or it is not a valid
+ *          tree file.
+ *
+ */
+extern "C" DECLARATION void * static_kdtree_open(const char * const p_path);
+
+/**
+ *
+ * @brief   Destroys static KD-tree, the file of the opened tree is unmapped.
+ *
+ * @param[in] p_pointer: handle of the tree.
+ *
+ */
+extern "C" DECLARATION void static_kdtree_destroy(void * p_pointer);
+
+/**
+ *
+ * @brief   Returns amount of points in static KD-tree.
+ *
+ * @param[in] p_pointer: handle of the tree.
+ *
+ */
+extern "C" DECLARATION size_t static_kdtree_size(const void * p_pointer);
+
+/**
+ *
+ * @brief   Returns amount of coordinates of each point of static KD-tree.
+ *
+ * @param[in] p_pointer: handle of the tree.
+ *
+ */
+extern "C" DECLARATION size_t static_kdtree_dimension(const void * p_pointer);
+
+
+#endif
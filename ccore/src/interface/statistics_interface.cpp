@@ -0,0 +1,59 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#include "interface/statistics_interface.h"
+
+#include <vector>
+
+
+void statistics_enable(const bool p_enable) {
+    utils::statistics::enable(p_enable);
+}
+
+
+bool statistics_is_enabled(void) {
+    return utils::statistics::is_enabled();
+}
+
+
+pyclustering_package * create_statistics_package(const utils::statistics_ptr & p_statistics) {
+    std::vector<std::size_t> counters;
+    std::vector<double> phases;
+
+    if (p_statistics) {
+        for (std::size_t index = 0; index < utils::statistics::AMOUNT_COUNTERS; index++) {
+            counters.push_back(p_statistics->get_counter((utils::statistic_counter) index));
+        }
+
+        for (std::size_t index = 0; index < utils::statistics::AMOUNT_PHASES; index++) {
+            phases.push_back(p_statistics->get_time((utils::statistic_phase) index));
+        }
+    }
+
+    pyclustering_package * package = new pyclustering_package((unsigned int) pyclustering_type_data::PYCLUSTERING_TYPE_LIST);
+    package->size = 2;
+    package->data = new pyclustering_package * [package->size];
+
+    ((pyclustering_package **) package->data)[0] = create_package(&counters);
+    ((pyclustering_package **) package->data)[1] = create_package(&phases);
+
+    return package;
+}
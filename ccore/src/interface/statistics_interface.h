@@ -0,0 +1,69 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#ifndef SRC_INTERFACE_STATISTICS_INTERFACE_H_
+#define SRC_INTERFACE_STATISTICS_INTERFACE_H_
+
+
+#include "interface/pyclustering_package.hpp"
+
+#include "utils/statistics.hpp"
+
+#include "definitions.hpp"
+
+
+/**
+ *
+ * @brief   Enables or disables collecting of performance statistics by algorithms.
+ * @details Statistics is not collected by default. When it is enabled, statistics of each call
+ *          can be obtained by '*_get_statistics' function of the corresponding algorithm.
+ *
+ * @param[in] p_enable: if 'true' then statistics is collected.
+ *
+ */
+extern "C" DECLARATION void statistics_enable(const bool p_enable);
+
+/**
+ *
+ * @brief   Returns 'true' if collecting of performance statistics is enabled.
+ *
+ */
+extern "C" DECLARATION bool statistics_is_enabled(void);
+
+
+/**
+ *
+ * @brief   Converts performance statistics to package.
+ * @details Package consists of two packages: the first contains counters (size_t) in following
+ *          order - iterations, distance evaluations, neighbor queries, kd-tree visited nodes; the
+ *          second contains wall time of phases in milliseconds (double) in following order -
+ *          total, initialization, neighbor search, assignment, update, extraction. If statistics
+ *          has not been collected then both packages are empty.
+ *
+ * @param[in] p_statistics: statistics that should be converted, it can be null.
+ *
+ * @return  Returns package with statistics, caller should destroy it.
+ *
+ */
+pyclustering_package * create_statistics_package(const utils::statistics_ptr & p_statistics);
+
+
+#endif
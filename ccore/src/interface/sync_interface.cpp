@@ -159,4 +159,8 @@ pyclustering_package * sync_dynamic_get_output(const void * pointer) {
     }
 
     return package;
-}
\ No newline at end of file
+}
+
+pyclustering_package * sync_get_statistics(const void * pointer_network) {
+    return create_statistics_package(((const sync_network *) pointer_network)->get_statistics());
+}
@@ -22,6 +22,7 @@
 
 
 #include "interface/pyclustering_package.hpp"
+#include "interface/statistics_interface.h"
 
 #include "definitions.hpp"
 #include "utils.hpp"
@@ -153,4 +154,15 @@ extern "C" DECLARATION pyclustering_package * sync_dynamic_allocate_correlation_
 
 extern "C" DECLARATION pyclustering_package * sync_dynamic_get_time(const void * pointer);
 
-extern "C" DECLARATION pyclustering_package * sync_dynamic_get_output(const void * pointer);
\ No newline at end of file
+extern "C" DECLARATION pyclustering_package * sync_dynamic_get_output(const void * pointer);
+
+/**
+ *
+ * @brief   Returns performance statistics of the last simulation of the oscillatory network.
+ * @details Statistics is collected only if it has been enabled by 'statistics_enable()'. Caller
+ *          should destroy returned package, its layout is described by 'create_statistics_package()'.
+ *
+ * @param[in] pointer_network: pointer to the oscillatory network.
+ *
+ */
+extern "C" DECLARATION pyclustering_package * sync_get_statistics(const void * pointer_network);
@@ -24,6 +24,10 @@
 #include "utils.hpp"
 
 
+/* statistics of the last call in the thread, each thread that uses the library keeps its own */
+static thread_local utils::statistics_ptr last_statistics;
+
+
 pyclustering_package * xmeans_algorithm(const data_representation * const p_sample, const data_representation * const p_centers, const std::size_t p_kmax, const double p_tolerance, const unsigned int p_criterion) {
     std::unique_ptr<dataset> data(read_sample(p_sample));
     std::unique_ptr<dataset> centers(read_sample(p_centers));
@@ -32,7 +36,12 @@ pyclustering_package * xmeans_algorithm(const data_representation * const p_samp
 
     cluster_analysis::xmeans_data output_result;
     solver.process(*data, output_result);
+    last_statistics = output_result.statistics();
 
     pyclustering_package * package = create_package(output_result.clusters().get());
     return package;
-}
\ No newline at end of file
+}
+
+pyclustering_package * xmeans_get_statistics(void) {
+    return create_statistics_package(last_statistics);
+}
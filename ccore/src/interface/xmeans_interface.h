@@ -22,6 +22,7 @@
 
 
 #include "interface/pyclustering_package.hpp"
+#include "interface/statistics_interface.h"
 
 
 /**
@@ -39,3 +40,13 @@
 *
 */
 extern "C" DECLARATION pyclustering_package * xmeans_algorithm(const data_representation * const p_sample, const data_representation * const p_centers, const std::size_t p_kmax, const double p_tolerance, const unsigned int p_criterion);
+
+
+/**
+*
+* @brief   Returns performance statistics of the last call of X-Means algorithm in the calling thread.
+* @details Statistics is collected only if it has been enabled by 'statistics_enable()'. Caller
+*          should destroy returned package, its layout is described by 'create_statistics_package()'.
+*
+*/
+extern "C" DECLARATION pyclustering_package * xmeans_get_statistics(void);
@@ -34,7 +34,7 @@ som::som(const size_t num_rows, const size_t num_cols, const som_conn_type type_
     m_conn_type(type_conn),
     m_location(m_size),
     m_awards(m_size, 0),
-    m_sqrt_distances(m_size, std::vector<double>(m_size, 0)),
+    m_sqrt_distances(m_size),
     m_capture_objects(m_size),
     m_params(parameters) 
 {
@@ -55,15 +55,9 @@ som::som(const size_t num_rows, const size_t num_cols, const som_conn_type type_
 
 	/* distances */
 	for (size_t i = 0; i < m_size; i++) {
-		std::vector<double> column_distances(m_size, 0);
-		m_sqrt_distances[i] = column_distances;
-	}
-
-	for (size_t i = 0; i < m_size; i++) {
-		for (size_t j = i; j < m_size; j++) {
+		for (size_t j = i + 1; j < m_size; j++) {
 			double distance = euclidean_distance_sqrt(&m_location[i], &m_location[j]);
-			m_sqrt_distances[i][j] = distance;
-			m_sqrt_distances[j][i] = distance;
+			m_sqrt_distances.set(i, j, distance);
 		}
 	}
 
@@ -317,7 +311,7 @@ size_t som::adaptation(const size_t index_winner, const pattern & input_pattern)
 
 	if (m_conn_type == som_conn_type::SOM_FUNC_NEIGHBOR) {
 		for (size_t neuron_index = 0; neuron_index < m_size; neuron_index++) {
-			double distance = m_sqrt_distances[index_winner][neuron_index];
+			double distance = m_sqrt_distances(index_winner, neuron_index);
 
 			if (distance < m_local_radius) {
 				double influence = std::exp( -( distance / (2.0 * m_local_radius) ) );
@@ -339,7 +333,7 @@ size_t som::adaptation(const size_t index_winner, const pattern & input_pattern)
 
 		std::vector<size_t> & winner_neighbors = m_neighbors[index_winner];
 		for (std::vector<size_t>::iterator neighbor_index = winner_neighbors.begin(); neighbor_index != winner_neighbors.end(); neighbor_index++) {
-			double distance = m_sqrt_distances[index_winner][*neighbor_index];
+			double distance = m_sqrt_distances(index_winner, *neighbor_index);
 
 			if (distance < m_local_radius) {
 				double influence = std::exp( -( distance / (2.0 * m_local_radius) ) );
@@ -359,6 +353,9 @@ size_t som::adaptation(const size_t index_winner, const pattern & input_pattern)
 
 
 size_t som::train(const dataset & input_data, const size_t num_epochs, bool autostop) {
+    m_statistics = utils::statistics::create();
+    utils::statistics_timer total_timer(m_statistics.get(), utils::statistic_phase::TOTAL);
+
     for (size_t i = 0; i < m_capture_objects.size(); i++) {
         m_capture_objects[i].clear();
         m_awards[i] = 0;
@@ -371,10 +368,16 @@ size_t som::train(const dataset & input_data, const size_t num_epochs, bool auto
 	data = &input_data;
 
 	/* create weights */
-	create_initial_weights(m_params.init_type);
+	{
+		utils::statistics_timer timer(m_statistics.get(), utils::statistic_phase::INITIALIZATION);
+		create_initial_weights(m_params.init_type);
+	}
 
 	size_t epouch = 1;
 	for ( ; epouch < (m_epouchs + 1); epouch++) {
+		utils::increase_counter(m_statistics.get(), utils::statistic_counter::ITERATIONS);
+		utils::increase_counter(m_statistics.get(), utils::statistic_counter::DISTANCE_EVALUATIONS, data->size() * m_size);
+
 		/* Depression term of coupling */
 		m_local_radius = std::pow( ( m_params.init_radius * std::exp(-( (double) epouch / (double) m_epouchs)) ), 2);
 		m_learn_rate = m_params.init_learn_rate * std::exp(-( (double) epouch / (double) m_epouchs));
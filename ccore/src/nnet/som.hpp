@@ -26,8 +26,12 @@
 
 #include <cstddef>
 
+#include "container/condensed_matrix.hpp"
+
 #include "definitions.hpp"
 
+#include "utils/statistics.hpp"
+
 
 /**
 *
@@ -123,7 +127,7 @@ private:
 
 	/* just for convenience (avoid excess calculation during learning) */
 	dataset                 m_location;
-	dataset                 m_sqrt_distances;
+	container::condensed_matrix<double> m_sqrt_distances;
     som_gain_sequence       m_capture_objects;
     som_neighbor_sequence   m_neighbors;
 
@@ -135,6 +139,9 @@ private:
 	double m_local_radius;
 	double m_learn_rate;
 
+	/* performance statistics of the last training */
+	utils::statistics_ptr m_statistics;
+
 public:
 	/**
 	 *
@@ -194,6 +201,14 @@ public:
 	 */
 	inline size_t get_size(void) const { return m_size; }
 
+	/**
+	 *
+	 * @return  Returns performance statistics of the last training, null pointer is returned if
+	 *          collecting of statistics was disabled.
+	 *
+	 */
+	inline utils::statistics_ptr get_statistics(void) const { return m_statistics; }
+
     /**
     *
     * @brief  Returns neurons weights.
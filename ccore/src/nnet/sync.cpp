@@ -175,12 +175,17 @@ double sync_network::phase_kuramoto(const double t, const double teta, const std
 void sync_network::simulate_static(const unsigned int steps, const double time,  const solve_type solver, const bool collect_dynamic, sync_dynamic & output_dynamic) {
     output_dynamic.clear();
 
+    m_statistics = utils::statistics::create();
+    utils::statistics_timer total_timer(m_statistics.get(), utils::statistic_phase::TOTAL);
+
     const double step = time / (double) steps;
     const double int_step = step / 10.0;
 
     store_dynamic(0.0, collect_dynamic, output_dynamic);	/* store initial state */
 
     for (double cur_time = step; cur_time < (time + step); cur_time += step) {
+        utils::increase_counter(m_statistics.get(), utils::statistic_counter::ITERATIONS);
+
         calculate_phases(solver, cur_time, step, int_step);
 
         store_dynamic(cur_time, collect_dynamic, output_dynamic);	/* store initial state */
@@ -191,26 +196,41 @@ void sync_network::simulate_static(const unsigned int steps, const double time,
 void sync_network::simulate_dynamic(const double order, const double step, const solve_type solver, const bool collect_dynamic, sync_dynamic & output_dynamic) {
 	output_dynamic.clear();
 
+	m_statistics = utils::statistics::create();
+	utils::statistics_timer total_timer(m_statistics.get(), utils::statistic_phase::TOTAL);
+
 	double previous_order = 0.0;
 	double current_order = sync_local_order();
 
 	double integration_step = step / 10;
 
+	/* nested simulation (for example, hierarchical clustering) shares budget of the outer processing */
+	utils::execution_monitor local_monitor(m_control);
+	utils::execution_monitor & monitor = (m_monitor != nullptr) ? *m_monitor : local_monitor;
+
 	store_dynamic(0, collect_dynamic, output_dynamic);     /* store initial state */
 
-	for (double time_counter = step; current_order < order; time_counter += step) {
+	for (double time_counter = step; (current_order < order) && monitor.can_continue(); time_counter += step) {
+		utils::increase_counter(m_statistics.get(), utils::statistic_counter::ITERATIONS);
+
 		calculate_phases(solver, time_counter, step, integration_step);
 
 		store_dynamic(time_counter, collect_dynamic, output_dynamic);
 
+		utils::statistics_timer order_timer(m_statistics.get(), utils::statistic_phase::EXTRACTION);
+
 		previous_order = current_order;
 		current_order = sync_local_order();
 
+		monitor.next_iteration(current_order);
+
 		if (std::abs(current_order - previous_order) < 0.000001) {
 			// std::cout << "Warning: sync_network::simulate_dynamic - simulation is aborted due to low level of convergence rate (order = " << current_order << ")." << std::endl;
 			break;
 		}
 	}
+
+	m_status = monitor.get_status();
 }
 
 
@@ -233,6 +253,8 @@ void sync_network::store_dynamic(const double time, const bool collect_dynamic,
 
 
 void sync_network::calculate_phases(const solve_type solver, const double t, const double step, const double int_step) {
+	utils::statistics_timer timer(m_statistics.get(), utils::statistic_phase::UPDATE);
+
 	std::vector<double> next_phases(size(), 0);
 	std::vector<void *> argv(2, NULL);
 
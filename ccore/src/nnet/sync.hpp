@@ -36,6 +36,9 @@
 
 #include "nnet/network.hpp"
 
+#include "utils/execution_control.hpp"
+#include "utils/statistics.hpp"
+
 
 using namespace container;
 using namespace differential;
@@ -165,6 +168,14 @@ protected:
 
     double weight;
 
+    utils::statistics_ptr m_statistics;
+
+    utils::execution_control m_control;
+
+    utils::execution_status m_status = utils::execution_status::COMPLETED;
+
+    utils::execution_monitor * m_monitor = nullptr;     /* shared by nested simulations, used only during processing */
+
 
 private:
     sync_callback_solver m_callback_solver;
@@ -301,6 +312,39 @@ public:
      */
     inline std::shared_ptr<adjacency_collection> connections(void) const { return m_connections; }
 
+    /**
+     *
+     * @brief   Returns performance statistics of the last simulation.
+     * @details Null pointer is returned if collecting of statistics was disabled.
+     *
+     */
+    inline utils::statistics_ptr get_statistics(void) const { return m_statistics; }
+
+    /**
+     *
+     * @brief   Sets cancellation token, budgets and progress callback that are used by dynamic simulation.
+     * @details Progress callback receives amount of simulation steps and current level of local synchronization.
+     *
+     * @param[in] p_control: limits and observers of simulation.
+     *
+     */
+    inline void set_execution_control(const utils::execution_control & p_control) { m_control = p_control; }
+
+    /**
+     *
+     * @brief   Returns cancellation token, budgets and progress callback that are used by dynamic simulation.
+     *
+     */
+    inline const utils::execution_control & get_execution_control(void) const { return m_control; }
+
+    /**
+     *
+     * @brief   Returns status of the last dynamic simulation, if it has been stopped by cancellation or
+     *          budget then output dynamic contains states that have been simulated before the stop.
+     *
+     */
+    inline utils::execution_status get_status(void) const { return m_status; }
+
 protected:
 
     /**
@@ -0,0 +1,117 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#include "parallel/parallel.hpp"
+
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+
+namespace parallel {
+
+
+/* state of the global pool, the pool is shared by all callers to avoid oversubscription */
+static std::mutex global_pool_lock;
+static std::shared_ptr<thread_pool> global_pool;
+static std::size_t global_thread_amount = 0;
+static bool global_thread_pinning = false;
+
+
+static std::size_t get_hardware_thread_amount(void) {
+    return std::max(std::thread::hardware_concurrency(), 1U);
+}
+
+
+/* worker can release the last reference to its own pool and the pool would join the worker itself */
+static void check_configuring_thread(void) {
+    if (thread_pool::is_worker_thread()) {
+        throw std::logic_error("CCORE [parallel]: thread pool can not be reconfigured from its worker thread.");
+    }
+}
+
+
+std::shared_ptr<thread_pool> get_thread_pool(void) {
+    std::lock_guard<std::mutex> guard(global_pool_lock);
+
+    if (!global_pool) {
+        if (global_thread_amount == 0) {
+            global_thread_amount = get_hardware_thread_amount();
+        }
+
+        global_pool = std::make_shared<thread_pool>(global_thread_amount - 1, global_thread_pinning);
+    }
+
+    return global_pool;
+}
+
+
+void set_thread_amount(const std::size_t p_amount) {
+    check_configuring_thread();
+
+    std::shared_ptr<thread_pool> previous_pool;
+
+    {
+        std::lock_guard<std::mutex> guard(global_pool_lock);
+
+        const std::size_t amount = (p_amount == 0) ? get_hardware_thread_amount() : p_amount;
+        if (global_pool && (global_thread_amount == amount)) {
+            return;
+        }
+
+        global_thread_amount = amount;
+
+        /* previous pool is destroyed outside of the lock when it is not used anymore */
+        std::swap(previous_pool, global_pool);
+    }
+}
+
+
+std::size_t get_thread_amount(void) {
+    std::lock_guard<std::mutex> guard(global_pool_lock);
+    return (global_thread_amount == 0) ? get_hardware_thread_amount() : global_thread_amount;
+}
+
+
+void set_thread_pinning(const bool p_pinning) {
+    check_configuring_thread();
+
+    std::shared_ptr<thread_pool> previous_pool;
+
+    {
+        std::lock_guard<std::mutex> guard(global_pool_lock);
+        if (global_thread_pinning == p_pinning) {
+            return;
+        }
+
+        global_thread_pinning = p_pinning;
+        std::swap(previous_pool, global_pool);
+    }
+}
+
+
+bool get_thread_pinning(void) {
+    std::lock_guard<std::mutex> guard(global_pool_lock);
+    return global_thread_pinning;
+}
+
+
+}
@@ -0,0 +1,219 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#ifndef SRC_PARALLEL_PARALLEL_HPP_
+#define SRC_PARALLEL_PARALLEL_HPP_
+
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "parallel/task_group.hpp"
+#include "parallel/thread_pool.hpp"
+
+
+namespace parallel {
+
+
+/**
+*
+* @brief    Returns global thread pool that is shared by all algorithms of the library.
+* @details  The pool is created by the first call. Callers keep returned pointer while they use
+*           the pool, so it remains valid even if the pool is replaced by another thread.
+*
+*/
+std::shared_ptr<thread_pool> get_thread_pool(void);
+
+/**
+*
+* @brief    Sets amount of threads that are used by parallel algorithms of the library.
+* @details  The amount includes thread that calls the algorithm, so global pool consists of
+*           'p_amount - 1' workers and value 1 means sequential processing. Value 0 means amount
+*           of hardware threads. Algorithms that are running keep using the previous pool.
+*           Worker threads can not call it, in this case 'std::logic_error' is thrown.
+*
+* @param[in] p_amount: amount of threads.
+*
+*/
+void set_thread_amount(const std::size_t p_amount);
+
+/**
+*
+* @brief    Returns amount of threads that are used by parallel algorithms of the library.
+*
+*/
+std::size_t get_thread_amount(void);
+
+/**
+*
+* @brief    Enables or disables binding of worker threads of the global pool to processor cores.
+* @details  Worker 'i' is bound to core 'i' (modulo amount of cores), global pool is recreated
+*           if the option is changed. Worker threads can not call it, in this case
+*           'std::logic_error' is thrown.
+*
+* @param[in] p_pinning: if 'true' then worker threads are bound to cores.
+*
+*/
+void set_thread_pinning(const bool p_pinning);
+
+/**
+*
+* @brief    Returns 'true' if worker threads of the global pool are bound to processor cores.
+*
+*/
+bool get_thread_pinning(void);
+
+
+/**
+*
+* @brief    Returns amount of blocks that range of the specified length is divided into.
+* @details  There are several blocks per thread to balance load when iterations take different
+*           time, blocks that are not processed by owner are stolen by idle workers.
+*
+* @param[in] p_pool: pool that processes blocks.
+* @param[in] p_length: length of the range.
+*
+*/
+inline std::size_t get_amount_blocks(const thread_pool & p_pool, const std::size_t p_length) {
+    const std::size_t blocks_per_thread = 4;
+    return std::min(p_length, (p_pool.size() + 1) * blocks_per_thread);
+}
+
+
+/**
+*
+* @brief    Calls action for each index of range [p_start, p_end) using global thread pool.
+* @details  The range is divided into contiguous blocks, one of them is processed by the calling
+*           thread. Iterations should not depend on each other. If action throws exception then
+*           it is rethrown after all blocks are done.
+*
+* @param[in] p_start: the first index of the range.
+* @param[in] p_end: index after the last index of the range.
+* @param[in] p_action: callable object that takes index.
+*
+*/
+template <typename TypeIndex, typename TypeAction>
+void parallel_for(const TypeIndex p_start, const TypeIndex p_end, const TypeAction & p_action) {
+    if (p_start >= p_end) {
+        return;
+    }
+
+    const std::shared_ptr<thread_pool> pool = get_thread_pool();
+
+    const std::size_t length = static_cast<std::size_t>(p_end - p_start);
+    const std::size_t amount_blocks = get_amount_blocks(*pool, length);
+
+    if (amount_blocks < 2) {
+        for (TypeIndex index = p_start; index < p_end; index++) {
+            p_action(index);
+        }
+
+        return;
+    }
+
+    const std::size_t block_length = length / amount_blocks;
+    const std::size_t remainder = length % amount_blocks;
+
+    task_group group(pool);
+
+    TypeIndex block_start = p_start;
+    for (std::size_t index_block = 0; index_block < amount_blocks - 1; index_block++) {
+        const TypeIndex block_end = block_start + static_cast<TypeIndex>(block_length + ((index_block < remainder) ? 1 : 0));
+
+        group.run([&p_action, block_start, block_end]() {
+            for (TypeIndex index = block_start; index < block_end; index++) {
+                p_action(index);
+            }
+        });
+
+        block_start = block_end;
+    }
+
+    for (TypeIndex index = block_start; index < p_end; index++) {
+        p_action(index);
+    }
+
+    group.wait();
+}
+
+
+/**
+*
+* @brief    Calculates reduction of values that are produced for each index of range [p_start, p_end)
+*           using global thread pool.
+* @details  Each block of the range is reduced separately starting from identity value, then
+*           results of blocks are reduced in order of blocks. Reduce operation should be associative,
+*           floating-point result may slightly depend on amount of threads.
+*
+* @param[in] p_start: the first index of the range.
+* @param[in] p_end: index after the last index of the range.
+* @param[in] p_identity: identity value of reduce operation.
+* @param[in] p_map: callable object that takes index and returns value.
+* @param[in] p_reduce: callable object that takes two values and returns their reduction.
+*
+* @return   Returns reduction of all values of the range.
+*
+*/
+template <typename TypeValue, typename TypeIndex, typename TypeMap, typename TypeReduce>
+TypeValue parallel_reduce(const TypeIndex p_start, const TypeIndex p_end, const TypeValue & p_identity, const TypeMap & p_map, const TypeReduce & p_reduce) {
+    if (p_start >= p_end) {
+        return p_identity;
+    }
+
+    const std::shared_ptr<thread_pool> pool = get_thread_pool();
+
+    const std::size_t length = static_cast<std::size_t>(p_end - p_start);
+    const std::size_t amount_blocks = get_amount_blocks(*pool, length);
+
+    /* array instead of vector - vector of bool packs values of different blocks into shared words */
+    std::unique_ptr<TypeValue []> partial_results(new TypeValue[amount_blocks]);
+
+    const std::size_t block_length = length / amount_blocks;
+    const std::size_t remainder = length % amount_blocks;
+
+    parallel_for(std::size_t(0), amount_blocks, [&](const std::size_t p_index_block) {
+        const std::size_t offset = p_index_block * block_length + std::min(p_index_block, remainder);
+        const TypeIndex block_start = p_start + static_cast<TypeIndex>(offset);
+        const TypeIndex block_end = block_start + static_cast<TypeIndex>(block_length + ((p_index_block < remainder) ? 1 : 0));
+
+        TypeValue result = p_identity;
+        for (TypeIndex index = block_start; index < block_end; index++) {
+            result = p_reduce(result, p_map(index));
+        }
+
+        partial_results[p_index_block] = result;
+    });
+
+    TypeValue result = p_identity;
+    for (std::size_t index_block = 0; index_block < amount_blocks; index_block++) {
+        result = p_reduce(result, partial_results[index_block]);
+    }
+
+    return result;
+}
+
+
+}
+
+
+#endif
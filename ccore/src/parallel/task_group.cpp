@@ -0,0 +1,93 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#include "parallel/task_group.hpp"
+
+#include "parallel/parallel.hpp"
+
+
+namespace parallel {
+
+
+task_group::task_group(void) :
+    task_group(get_thread_pool())
+{ }
+
+
+task_group::task_group(const std::shared_ptr<thread_pool> & p_pool) :
+    m_pool(p_pool),
+    m_pending(0)
+{ }
+
+
+task_group::~task_group(void) {
+    wait_tasks();
+}
+
+
+void task_group::wait(void) {
+    wait_tasks();
+
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> guard(m_error_lock);
+        std::swap(error, m_error);
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+
+void task_group::wait_tasks(void) {
+    while(m_pending > 0) {
+        if (m_pool->execute_pending_task()) {
+            continue;
+        }
+
+        /* all remaining tasks of the group are executed by other threads */
+        std::unique_lock<std::mutex> guard(m_finish_lock);
+        const std::size_t pending = m_pending;
+        m_finished.wait(guard, [this, pending]() { return m_pending < pending || m_pending == 0; });
+    }
+
+    /* thread that has finished the last task can still hold the lock */
+    std::lock_guard<std::mutex> guard(m_finish_lock);
+}
+
+
+void task_group::finish_task(void) {
+    std::lock_guard<std::mutex> guard(m_finish_lock);
+    m_pending--;
+    m_finished.notify_all();
+}
+
+
+void task_group::store_exception(const std::exception_ptr & p_error) {
+    std::lock_guard<std::mutex> guard(m_error_lock);
+    if (!m_error) {
+        m_error = p_error;
+    }
+}
+
+
+}
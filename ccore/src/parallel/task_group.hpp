@@ -0,0 +1,136 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#ifndef SRC_PARALLEL_TASK_GROUP_HPP_
+#define SRC_PARALLEL_TASK_GROUP_HPP_
+
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "parallel/thread_pool.hpp"
+
+
+namespace parallel {
+
+
+/**
+*
+* @brief    Group of tasks that are executed by thread pool and that can be waited together.
+* @details  Thread that waits for the group executes queued tasks itself, therefore groups can be
+*           created inside tasks of other groups. When there is nothing to execute, the waiting
+*           thread sleeps until one of tasks of the group is done. The first exception that is
+*           thrown by a task is rethrown by 'wait()'.
+*
+*/
+class task_group {
+private:
+    std::shared_ptr<thread_pool>    m_pool;
+    std::atomic<std::size_t>        m_pending;
+
+    std::mutex                      m_finish_lock;
+    std::condition_variable         m_finished;
+
+    std::mutex                      m_error_lock;
+    std::exception_ptr              m_error;
+
+public:
+    /**
+    *
+    * @brief    Creates group that uses global thread pool.
+    *
+    */
+    task_group(void);
+
+    /**
+    *
+    * @brief    Creates group that uses the specified thread pool.
+    *
+    * @param[in] p_pool: thread pool that executes tasks of the group.
+    *
+    */
+    explicit task_group(const std::shared_ptr<thread_pool> & p_pool);
+
+    task_group(const task_group & p_other) = delete;
+
+    task_group(task_group && p_other) = delete;
+
+    /**
+    *
+    * @brief    Waits for all tasks of the group, exceptions of tasks are ignored.
+    *
+    */
+    ~task_group(void);
+
+public:
+    /**
+    *
+    * @brief    Places task to the thread pool as a part of the group.
+    *
+    * @param[in] p_task: callable object without arguments, it is copied to the pool.
+    *
+    */
+    template <typename TypeTask>
+    void run(TypeTask && p_task) {
+        m_pending++;
+
+        m_pool->submit([this, task = std::forward<TypeTask>(p_task)]() mutable {
+            try {
+                task();
+            }
+            catch(...) {
+                store_exception(std::current_exception());
+            }
+
+            finish_task();
+        });
+    }
+
+    /**
+    *
+    * @brief    Waits until all tasks of the group are done.
+    * @details  If any task has thrown exception then the first of them is rethrown.
+    *
+    */
+    void wait(void);
+
+public:
+    task_group & operator=(const task_group & p_other) = delete;
+
+    task_group & operator=(task_group && p_other) = delete;
+
+private:
+    void wait_tasks(void);
+
+    void finish_task(void);
+
+    void store_exception(const std::exception_ptr & p_error);
+};
+
+
+}
+
+
+#endif
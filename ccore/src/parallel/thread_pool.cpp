@@ -0,0 +1,205 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#include "parallel/thread_pool.hpp"
+
+#include <algorithm>
+
+#if defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+#elif defined(_WIN32)
+    #include <windows.h>
+#endif
+
+
+namespace parallel {
+
+
+/* pool and queue that belong to the current thread if it is a worker */
+static thread_local const thread_pool * current_pool = nullptr;
+static thread_local std::size_t current_queue = 0;
+
+
+thread_pool::thread_pool(const std::size_t p_amount_threads, const bool p_pinning) :
+    m_queued_tasks(0)
+{
+    /* the last queue is shared and it is used by threads outside of the pool */
+    for (std::size_t index = 0; index < p_amount_threads + 1; index++) {
+        m_queues.emplace_back(new task_queue());
+    }
+
+    m_workers.reserve(p_amount_threads);
+    for (std::size_t index = 0; index < p_amount_threads; index++) {
+        m_workers.emplace_back(&thread_pool::run_worker, this, index);
+
+        if (p_pinning) {
+            bind_to_core(m_workers.back(), index);
+        }
+    }
+}
+
+
+thread_pool::~thread_pool(void) {
+    {
+        std::lock_guard<std::mutex> guard(m_sleep_lock);
+        m_stop = true;
+    }
+
+    m_wakeup.notify_all();
+
+    for (auto & worker : m_workers) {
+        worker.join();
+    }
+
+    /* tasks can remain only if there are no workers */
+    task remaining_task;
+    while(pop_task(get_current_queue_index(), remaining_task)) {
+        remaining_task();
+    }
+}
+
+
+std::size_t thread_pool::size(void) const {
+    return m_workers.size();
+}
+
+
+void thread_pool::submit(task && p_task) {
+    task_queue & queue = *m_queues[get_current_queue_index()];
+
+    /* counter is increased first to keep it not less than real amount of tasks in queues */
+    m_queued_tasks++;
+
+    {
+        std::lock_guard<std::mutex> guard(queue.m_lock);
+        queue.m_tasks.push_back(std::move(p_task));
+    }
+
+    {
+        /* lock is required to avoid lost wake-up of worker that is going to sleep */
+        std::lock_guard<std::mutex> guard(m_sleep_lock);
+    }
+
+    m_wakeup.notify_one();
+}
+
+
+bool thread_pool::execute_pending_task(void) {
+    task pending_task;
+    if (pop_task(get_current_queue_index(), pending_task)) {
+        pending_task();
+        return true;
+    }
+
+    return false;
+}
+
+
+bool thread_pool::is_worker_thread(void) {
+    return current_pool != nullptr;
+}
+
+
+void thread_pool::run_worker(const std::size_t p_index) {
+    current_pool = this;
+    current_queue = p_index;
+
+    task current_task;
+    while(true) {
+        if (pop_task(p_index, current_task)) {
+            current_task();
+            current_task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> guard(m_sleep_lock);
+        m_wakeup.wait(guard, [this]() { return m_stop || (m_queued_tasks > 0); });
+
+        if (m_stop && (m_queued_tasks == 0)) {
+            return;
+        }
+    }
+}
+
+
+bool thread_pool::pop_task(const std::size_t p_index, task & p_task) {
+    if (m_queued_tasks == 0) {
+        return false;
+    }
+
+    /* own tasks are taken from the back - they are the most recent and their data is still in cache */
+    {
+        task_queue & queue = *m_queues[p_index];
+        std::lock_guard<std::mutex> guard(queue.m_lock);
+        if (!queue.m_tasks.empty()) {
+            p_task = std::move(queue.m_tasks.back());
+            queue.m_tasks.pop_back();
+            m_queued_tasks--;
+            return true;
+        }
+    }
+
+    /* other queues are visited starting from the neighbor to spread thieves over victims */
+    for (std::size_t offset = 1; offset < m_queues.size(); offset++) {
+        task_queue & queue = *m_queues[(p_index + offset) % m_queues.size()];
+        std::lock_guard<std::mutex> guard(queue.m_lock);
+        if (!queue.m_tasks.empty()) {
+            p_task = std::move(queue.m_tasks.front());
+            queue.m_tasks.pop_front();
+            m_queued_tasks--;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+std::size_t thread_pool::get_current_queue_index(void) const {
+    if (current_pool == this) {
+        return current_queue;
+    }
+
+    return m_workers.size();
+}
+
+
+void thread_pool::bind_to_core(std::thread & p_thread, const std::size_t p_core) {
+    const std::size_t amount_cores = std::max(std::thread::hardware_concurrency(), 1U);
+
+#if defined(__linux__)
+    cpu_set_t core_set;
+    CPU_ZERO(&core_set);
+    CPU_SET(p_core % amount_cores, &core_set);
+
+    pthread_setaffinity_np(p_thread.native_handle(), sizeof(cpu_set_t), &core_set);
+#elif defined(_WIN32)
+    const std::size_t core = p_core % std::min(amount_cores, sizeof(DWORD_PTR) * 8);
+    SetThreadAffinityMask(p_thread.native_handle(), ((DWORD_PTR) 1) << core);
+#else
+    (void) p_thread;
+    (void) amount_cores;
+#endif
+}
+
+
+}
@@ -0,0 +1,146 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#ifndef SRC_PARALLEL_THREAD_POOL_HPP_
+#define SRC_PARALLEL_THREAD_POOL_HPP_
+
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace parallel {
+
+
+/**
+*
+* @brief    Pool of worker threads that execute tasks using work-stealing strategy.
+* @details  Each worker has its own queue of tasks: tasks that are submitted by worker are placed
+*           to its queue and taken back in LIFO order, idle workers steal tasks from the opposite
+*           end of queues of other workers. Tasks that are submitted by threads outside of the pool
+*           (for example, by several Python threads at once) are placed to the shared queue.
+*
+*/
+class thread_pool {
+public:
+    using task = std::function<void(void)>;
+
+private:
+    struct task_queue {
+        std::mutex          m_lock;
+        std::deque<task>    m_tasks;
+    };
+
+private:
+    std::vector<std::unique_ptr<task_queue>>    m_queues;
+    std::vector<std::thread>                    m_workers;
+
+    std::atomic<std::size_t>    m_queued_tasks;
+
+    std::mutex                  m_sleep_lock;
+    std::condition_variable     m_wakeup;
+    bool                        m_stop          = false;
+
+public:
+    /**
+    *
+    * @brief    Creates pool and starts worker threads.
+    *
+    * @param[in] p_amount_threads: amount of worker threads, if it is 0 then tasks are executed
+    *             only by threads that wait for them.
+    * @param[in] p_pinning: if 'true' then each worker thread is bound to its own processor core.
+    *
+    */
+    explicit thread_pool(const std::size_t p_amount_threads, const bool p_pinning = false);
+
+    thread_pool(const thread_pool & p_other) = delete;
+
+    thread_pool(thread_pool && p_other) = delete;
+
+    /**
+    *
+    * @brief    Executes all remaining tasks and stops worker threads.
+    *
+    */
+    ~thread_pool(void);
+
+public:
+    /**
+    *
+    * @brief    Returns amount of worker threads in the pool.
+    *
+    */
+    std::size_t size(void) const;
+
+    /**
+    *
+    * @brief    Places task to the pool for execution.
+    *
+    * @param[in] p_task: task that should be executed.
+    *
+    */
+    void submit(task && p_task);
+
+    /**
+    *
+    * @brief    Executes one of the queued tasks by the calling thread if there is any.
+    * @details  It is used by threads that wait for results of tasks to help workers instead of
+    *           blocking, that also makes nested parallel regions free of deadlocks.
+    *
+    * @return   Returns 'true' if task has been executed.
+    *
+    */
+    bool execute_pending_task(void);
+
+    /**
+    *
+    * @brief    Returns 'true' if the calling thread is a worker of any thread pool.
+    *
+    */
+    static bool is_worker_thread(void);
+
+public:
+    thread_pool & operator=(const thread_pool & p_other) = delete;
+
+    thread_pool & operator=(thread_pool && p_other) = delete;
+
+private:
+    void run_worker(const std::size_t p_index);
+
+    bool pop_task(const std::size_t p_index, task & p_task);
+
+    std::size_t get_current_queue_index(void) const;
+
+    static void bind_to_core(std::thread & p_thread, const std::size_t p_core);
+};
+
+
+}
+
+
+#endif
@@ -20,6 +20,10 @@
 
 #include "tsp/distance_matrix.hpp"
 
+#include <algorithm>
+
+#include "utils/pairwise_distance.hpp"
+
 
 namespace city_distance
 {
@@ -56,13 +60,34 @@ distance_matrix::distance_matrix(const std::vector<object_coordinate>& cities)
         m_matrix[i].resize(cities.size());
     }
 
-    // initialize distance matrix
-    for (std::size_t city_from = 0; city_from < cities.size(); ++city_from)
+    const bool same_dimension = std::all_of(cities.begin(), cities.end(), [&cities](const object_coordinate & city)
+        { return city.get_dimention() == cities.front().get_dimention(); });
+
+    if (!same_dimension)
     {
-        for (std::size_t city_to = 0; city_to < cities.size(); ++city_to)
+        // cities with different dimensions are not comparable, distance between them is -1
+        for (std::size_t city_from = 0; city_from < cities.size(); ++city_from)
         {
-            m_matrix[city_from][city_to] = cities[city_from].get_distance(cities[city_to]);
+            for (std::size_t city_to = 0; city_to < cities.size(); ++city_to)
+            {
+                m_matrix[city_from][city_to] = cities[city_from].get_distance(cities[city_to]);
+            }
         }
+
+        return;
+    }
+
+    // initialize distance matrix using blocked pairwise engine
+    dataset_matrix locations(cities.size(), cities.empty() ? 0 : cities.front().get_dimention());
+    for (std::size_t city = 0; city < cities.size(); ++city)
+    {
+        std::copy(cities[city].get_location().begin(), cities[city].get_location().end(), locations[city]);
+    }
+
+    const dataset_matrix distances = utils::distance_matrix(locations.view(), utils::metric::euclidean());
+    for (std::size_t city_from = 0; city_from < cities.size(); ++city_from)
+    {
+        std::copy(distances[city_from], distances[city_from] + cities.size(), m_matrix[city_from].begin());
     }
 }
 
@@ -71,6 +71,8 @@ public:
 
     double get_distance (const object_coordinate & to_city) const;
 
+    const std::vector<double> & get_location() const { return location_point; }
+
 #ifdef __CPP_14_ENABLED__
     decltype(auto) get_dimention() const { return location_point.size(); }
 #else
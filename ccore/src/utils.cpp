@@ -20,6 +20,14 @@
 
 #include "utils.hpp"
 
+#include <functional>
+
+#include "container/static_kdtree.hpp"
+
+#include "parallel/parallel.hpp"
+
+#include "utils/pairwise_distance.hpp"
+
 std::vector<std::vector<double> > * read_sample(const char * const path_file) {
 	std::string filename(path_file);
 
@@ -51,21 +59,27 @@ std::vector<std::vector<double> > * read_sample(const char * const path_file) {
 
 
 std::vector<std::vector<double> > * read_sample(const data_representation * const sample) {
-	std::vector<double> point(sample->dimension, 0);
-	std::vector<std::vector<double> > * dataset = new std::vector<std::vector<double> >(sample->size, point);
+	std::vector<std::vector<double> > * dataset = new std::vector<std::vector<double> >(sample->size);
 
 	for (unsigned int index = 0; index < sample->size; index++) {
-		for (unsigned int dimension = 0; dimension < sample->dimension; dimension++) {
-			point[dimension] = sample->objects[index][dimension];
-		}
-
-		(*dataset)[index] = point;
+		(*dataset)[index].assign(sample->objects[index], sample->objects[index] + sample->dimension);
 	}
 
 	return dataset;
 }
 
 
+dataset_matrix read_sample_matrix(const data_representation * const sample) {
+	dataset_matrix data(sample->size, sample->dimension);
+
+	for (unsigned int index = 0; index < sample->size; index++) {
+		std::copy(sample->objects[index], sample->objects[index] + sample->dimension, data[index]);
+	}
+
+	return data;
+}
+
+
 
 
 //template <typename T>
@@ -179,23 +193,123 @@ clustering_result * create_clustering_result(const std::vector<std::vector<unsig
 //}
 
 
-double average_neighbor_distance(const std::vector<std::vector<double> > * points, const unsigned int num_neigh) {
-	std::vector<std::vector<double> > dist_matrix( points->size(), std::vector<double>(points->size(), 0.0) );
-	for (unsigned int i = 0; i < points->size(); i++) {
-		for (unsigned int j = i + 1; j < points->size(); j++) {
-			double distance = euclidean_distance( &(*points)[i], &(*points)[j] );
-			dist_matrix[i][j] = distance;
-			dist_matrix[j][i] = distance;
-		}
-		std::sort(dist_matrix[i].begin(), dist_matrix[i].end());
+/***********************************************************************************************
+ *
+ * @brief   Calls action for each point with square Euclidean distances to its nearest points
+ *          sorted in ascending order, the first one is the point itself (or its duplicate).
+ * @details Static KD-tree is used for large data of small dimension, otherwise distances are
+ *          calculated block by block. Action is called in parallel for different points.
+ *
+ ***********************************************************************************************/
+template <typename TypeAction>
+static void for_each_nearest_distances(const dataset_view & data, const std::size_t amount_nearest, const TypeAction & action) {
+	const utils::metric::euclidean metric;
+
+	if ( (data.size() >= container::static_kdtree::MINIMUM_SIZE) && container::static_kdtree::is_suitable(data.dimension(), metric) ) {
+		const container::static_kdtree tree(data);
+
+		parallel::parallel_for(std::size_t(0), data.size(), [&](const std::size_t index) {
+			std::vector<std::size_t> indexes;
+			std::vector<double> distances;
+
+			tree.find_nearest(data[index], amount_nearest, metric, indexes, distances);
+			action(index, (const double *) distances.data());
+		});
 	}
+	else {
+		std::vector<double> row(data.size());
 
-	double total_distance = 0.0;
-	for (unsigned int i = 0; i < points->size(); i++) {
-		for (unsigned int j = 0; j < num_neigh; j++) {
-			total_distance += dist_matrix[i][j + 1];
+		utils::for_each_distance_block(data, metric, [&](const std::size_t p_begin, const std::size_t p_amount, const double * const p_distances) {
+			for (std::size_t i = 0; i < p_amount; i++) {
+				std::copy(p_distances + i * data.size(), p_distances + (i + 1) * data.size(), row.begin());
+				std::partial_sort(row.begin(), row.begin() + amount_nearest, row.end());
+
+				action(p_begin + i, (const double *) row.data());
+			}
+		});
+	}
+}
+
+
+/***********************************************************************************************
+ *
+ * @brief   Calls action for each point of HNSW graph with approximate square Euclidean distances
+ *          to its nearest points sorted in ascending order. If the graph has found less points
+ *          then distance to the farthest found one is repeated.
+ *
+ ***********************************************************************************************/
+template <typename TypeAction>
+static void for_each_nearest_distances(const container::hnsw & index, const std::size_t amount_nearest, const TypeAction & action) {
+	const container::neighbor_lists nearest = index.find_nearest(index.points(), amount_nearest);
+
+	std::vector<double> row(amount_nearest);
+	for (std::size_t i = 0; i < nearest.size(); i++) {
+		const std::size_t amount_found = std::min(nearest.amount(i), amount_nearest);
+		const double farthest = (amount_found > 0) ? nearest.begin_distances(i)[amount_found - 1] : 0.0;
+
+		std::copy(nearest.begin_distances(i), nearest.begin_distances(i) + amount_found, row.begin());
+		std::fill(row.begin() + amount_found, row.end(), farthest);
+
+		action(i, (const double *) row.data());
+	}
+}
+
+
+template <typename TypePoints>
+static double calculate_average_neighbor_distance(const TypePoints & points, const std::size_t size, const std::size_t num_neigh) {
+	const std::size_t amount_nearest = std::min(num_neigh + 1, size);   /* the nearest one is the point itself */
+
+	std::vector<double> point_distances(size, 0.0);
+
+	for_each_nearest_distances(points, amount_nearest, [&](const std::size_t index, const double * const distances) {
+		for (std::size_t j = 1; j < amount_nearest; j++) {
+			point_distances[index] += std::sqrt(distances[j]);
 		}
+	});
+
+	double total_distance = 0.0;
+	for (const double distance : point_distances) {
+		total_distance += distance;
+	}
+
+	return total_distance / ( (double) num_neigh * (double) size );
+}
+
+
+template <typename TypePoints>
+static std::vector<double> calculate_k_distance_graph(const TypePoints & points, const std::size_t size, const std::size_t num_neigh) {
+	std::vector<double> result(size, 0.0);
+	if (size == 0) {
+		return result;
 	}
 
-	return total_distance / ( (double) num_neigh * (double) points->size() );
+	const std::size_t amount_nearest = std::min(num_neigh + 1, size);   /* the nearest one is the point itself */
+
+	for_each_nearest_distances(points, amount_nearest, [&](const std::size_t index, const double * const distances) {
+		result[index] = std::sqrt(distances[amount_nearest - 1]);
+	});
+
+	std::sort(result.begin(), result.end(), std::greater<double>());
+	return result;
+}
+
+
+double average_neighbor_distance(const std::vector<std::vector<double> > * points, const unsigned int num_neigh) {
+	const dataset_matrix data(*points);
+	return calculate_average_neighbor_distance(data.view(), data.size(), num_neigh);
+}
+
+
+double average_neighbor_distance(const container::hnsw & index, const std::size_t num_neigh) {
+	return calculate_average_neighbor_distance(index, index.size(), num_neigh);
+}
+
+
+std::vector<double> k_distance_graph(const dataset_view & points, const std::size_t num_neigh) {
+	return calculate_k_distance_graph(points, points.size(), num_neigh);
+}
+
+
+std::vector<double> k_distance_graph(const container::hnsw & index, const std::size_t num_neigh) {
+	return calculate_k_distance_graph(index, index.size(), num_neigh);
 }
@@ -35,6 +35,10 @@
 #include "ccore.h"
 #include "nnet/network.hpp"
 
+#include "container/hnsw.hpp"
+
+#include "utils/distance_kernel.hpp"
+
 
 typedef struct differential_result {
 	double time;
@@ -62,14 +66,8 @@ inline double heaviside(const double value) {
  *
  */
 inline double euclidean_distance_sqrt(const std::vector<double> * const point1, const std::vector<double> * const point2) {
-	double distance = 0.0;
 	/* assert(point1->size() != point1->size()); */
-	for (unsigned int dimension = 0; dimension < point1->size(); dimension++) {
-		double difference = (point1->data()[dimension] - point2->data()[dimension]);
-		distance += difference * difference;
-	}
-
-	return distance;
+	return utils::euclidean_distance_square(point1->data(), point2->data(), point1->size());
 }
 
 /**
@@ -97,14 +95,7 @@ inline double euclidean_distance_sqrt(const std::vector<double> & point1, const
  *
  */
 inline double euclidean_distance(const std::vector<double> * const point1, const std::vector<double> * const point2) {
-	double distance = 0.0;
-
-	for (unsigned int dimension = 0; dimension < point1->size(); dimension++) {
-		double difference = (point1->data()[dimension] - point2->data()[dimension]);
-		distance += difference * difference;
-	}
-
-	return std::sqrt(distance);
+	return std::sqrt(utils::euclidean_distance_square(point1->data(), point2->data(), point1->size()));
 }
 
 /**
@@ -121,6 +112,36 @@ inline double euclidean_distance(const std::vector<double> & point1, const std::
     return euclidean_distance(&point1, &point2);
 }
 
+/**
+ *
+ * @brief   Calculates square of Euclidean distance between points that are stored in contiguous memory.
+ *
+ * @param[in] point1: pointer to the first coordinate of point #1.
+ * @param[in] point2: pointer to the first coordinate of point #2.
+ * @param[in] dimension: amount of coordinates of each point.
+ *
+ * @return  Returns square of Euclidean distance between points.
+ *
+ */
+inline double euclidean_distance_sqrt(const double * const point1, const double * const point2, const std::size_t dimension) {
+    return utils::euclidean_distance_square(point1, point2, dimension);
+}
+
+/**
+ *
+ * @brief   Calculates Euclidean distance between points that are stored in contiguous memory.
+ *
+ * @param[in] point1: pointer to the first coordinate of point #1.
+ * @param[in] point2: pointer to the first coordinate of point #2.
+ * @param[in] dimension: amount of coordinates of each point.
+ *
+ * @return  Returns Euclidean distance between points.
+ *
+ */
+inline double euclidean_distance(const double * const point1, const double * const point2, const std::size_t dimension) {
+    return std::sqrt(euclidean_distance_sqrt(point1, point2, dimension));
+}
+
 /***********************************************************************************************
  *
  * @brief   Reads sample (input data) from the specified file.
@@ -143,6 +164,19 @@ std::vector<std::vector<double> > * read_sample(const char * const path_file);
  ***********************************************************************************************/
 std::vector<std::vector<double> > * read_sample(const data_representation * const sample);
 
+/***********************************************************************************************
+ *
+ * @brief   Converts representation of data from CCORE standard to contiguous block of points.
+ * @details It is used by algorithms that process the data through view, in this case points are
+ *          copied only once without intermediate nested vectors.
+ *
+ * @param   (in) sample     - input data (sample) for converting.
+ *
+ * @return  Returns contiguous block with points of the input data.
+ *
+ ***********************************************************************************************/
+dataset_matrix read_sample_matrix(const data_representation * const sample);
+
 /***********************************************************************************************
  *
  * @brief   Converts representation of cluster to standard type of CCORE interface.
@@ -192,4 +226,45 @@ clustering_result * create_clustering_result(const std::vector<std::vector<unsig
  ***********************************************************************************************/
 double average_neighbor_distance(const std::vector<std::vector<double> > * points, const unsigned int num_neigh);
 
+/***********************************************************************************************
+ *
+ * @brief   Returns approximate average distance for establish links between specified number of
+ *          neighbors, neighbors are searched by HNSW graph instead of comparison of all points.
+ *
+ * @param   (in) index          - HNSW graph of input data.
+ * @param   (in) num_neigh      - number of neighbors.
+ *
+ * @return  Returns average distance for establish links between 'num_neigh' in points of graph.
+ *
+ ***********************************************************************************************/
+double average_neighbor_distance(const container::hnsw & index, const std::size_t num_neigh);
+
+/***********************************************************************************************
+ *
+ * @brief   Returns k-distance graph - Euclidean distance from each point to its k-th nearest
+ *          neighbor sorted in descending order, the knee of the graph is a proper connectivity
+ *          radius for density based algorithms (DBSCAN, OPTICS).
+ *
+ * @param   (in) points         - input data.
+ * @param   (in) num_neigh      - number of neighbor (k), if some point has less neighbors then
+ *                                distance to the farthest one is used.
+ *
+ * @return  Returns k-distance of each point in descending order.
+ *
+ ***********************************************************************************************/
+std::vector<double> k_distance_graph(const dataset_view & points, const std::size_t num_neigh);
+
+/***********************************************************************************************
+ *
+ * @brief   Returns approximate k-distance graph of points of HNSW graph, neighbors are searched by
+ *          HNSW graph instead of comparison of all points.
+ *
+ * @param   (in) index          - HNSW graph of input data.
+ * @param   (in) num_neigh      - number of neighbor (k).
+ *
+ * @return  Returns k-distance of each point in descending order.
+ *
+ ***********************************************************************************************/
+std::vector<double> k_distance_graph(const container::hnsw & index, const std::size_t num_neigh);
+
 #endif
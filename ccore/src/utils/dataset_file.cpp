@@ -0,0 +1,168 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#include "utils/dataset_file.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+
+namespace utils {
+
+
+static const char DATASET_FILE_MAGIC[8] = { 'P', 'Y', 'C', 'L', 'D', 'S', 'E', 'T' };
+
+
+const std::size_t dataset_file::ALIGNMENT = 64;
+
+const std::uint32_t dataset_file::VERSION = 1;
+
+
+dataset_file::dataset_file(const std::string & p_path) :
+    m_file(p_path)
+{
+    if (m_file.length() < sizeof(dataset_file_header)) {
+        throw std::runtime_error("CCORE [dataset_file]: file '" + p_path + "' is too short to be dataset file.");
+    }
+
+    dataset_file_header header;
+    std::memcpy(&header, m_file.data(), sizeof(dataset_file_header));
+
+    if (std::memcmp(header.magic, DATASET_FILE_MAGIC, sizeof(DATASET_FILE_MAGIC)) != 0) {
+        throw std::runtime_error("CCORE [dataset_file]: file '" + p_path + "' is not dataset file.");
+    }
+
+    if (header.version != VERSION) {
+        throw std::runtime_error("CCORE [dataset_file]: version of file '" + p_path + "' is not supported.");
+    }
+
+    std::size_t value_size = 0;
+    switch(static_cast<dataset_file_type>(header.type)) {
+    case dataset_file_type::FLOAT64:
+        value_size = sizeof(double);
+        break;
+    case dataset_file_type::FLOAT32:
+        value_size = sizeof(float);
+        break;
+    default:
+        throw std::runtime_error("CCORE [dataset_file]: type of coordinates of file '" + p_path + "' is not supported.");
+    }
+
+    const bool consistent = (header.stride >= header.dimension) && ((header.size == 0) || (header.stride > 0))
+        && (header.offset >= sizeof(dataset_file_header)) && (header.offset % ALIGNMENT == 0);
+
+    if (!consistent) {
+        throw std::runtime_error("CCORE [dataset_file]: header of file '" + p_path + "' is corrupted.");
+    }
+
+    /* all rows except the last one occupy 'stride' elements, the last one is not padded */
+    bool complete = (header.offset <= m_file.length());
+    if (header.size > 0) {
+        complete = m_file.contains(header.offset, header.size - 1, header.stride, value_size)
+            && m_file.contains(header.offset + (header.size - 1) * header.stride * value_size, 1, header.dimension, value_size);
+    }
+
+    if (!complete) {
+        throw std::runtime_error("CCORE [dataset_file]: file '" + p_path + "' is truncated.");
+    }
+
+    const char * data = m_file.data() + header.offset;
+
+    m_type = static_cast<dataset_file_type>(header.type);
+    if (m_type == dataset_file_type::FLOAT32) {
+        m_view_f32 = dataset_view_f32(reinterpret_cast<const float *>(data), (std::size_t) header.size, (std::size_t) header.dimension, (std::size_t) header.stride);
+    }
+    else {
+        m_view = dataset_view(reinterpret_cast<const double *>(data), (std::size_t) header.size, (std::size_t) header.dimension, (std::size_t) header.stride);
+    }
+}
+
+
+const dataset_view & dataset_file::view(void) const {
+    if (m_type != dataset_file_type::FLOAT64) {
+        throw std::logic_error("CCORE [dataset_file]: coordinates are not stored in double precision.");
+    }
+
+    return m_view;
+}
+
+
+const dataset_view_f32 & dataset_file::view_f32(void) const {
+    if (m_type != dataset_file_type::FLOAT32) {
+        throw std::logic_error("CCORE [dataset_file]: coordinates are not stored in single precision.");
+    }
+
+    return m_view_f32;
+}
+
+
+void dataset_file::write(const std::string & p_path, const dataset_view & p_data, const std::size_t p_stride) {
+    write_data(p_path, p_data, p_stride, dataset_file_type::FLOAT64);
+}
+
+
+void dataset_file::write(const std::string & p_path, const dataset_view_f32 & p_data, const std::size_t p_stride) {
+    write_data(p_path, p_data, p_stride, dataset_file_type::FLOAT32);
+}
+
+
+template <typename TypeValue>
+void dataset_file::write_data(const std::string & p_path, const container::dense_matrix_view<TypeValue> & p_data, const std::size_t p_stride, const dataset_file_type p_type) {
+    const std::size_t stride = (p_stride == 0) ? p_data.dimension() : p_stride;
+    if (stride < p_data.dimension()) {
+        throw std::invalid_argument("CCORE [dataset_file]: stride can not be less than dimension.");
+    }
+
+    dataset_file_header header;
+    std::memcpy(header.magic, DATASET_FILE_MAGIC, sizeof(DATASET_FILE_MAGIC));
+    header.version = VERSION;
+    header.type = static_cast<std::uint32_t>(p_type);
+    header.size = p_data.size();
+    header.dimension = p_data.dimension();
+    header.stride = stride;
+    header.offset = ((sizeof(dataset_file_header) + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT;
+
+    std::ofstream stream(p_path, std::ios::binary | std::ios::trunc);
+    if (!stream.is_open()) {
+        throw std::runtime_error("CCORE [dataset_file]: file '" + p_path + "' can not be created.");
+    }
+
+    const std::vector<char> header_padding(header.offset - sizeof(dataset_file_header), 0);
+
+    stream.write(reinterpret_cast<const char *>(&header), sizeof(dataset_file_header));
+    stream.write(header_padding.data(), header_padding.size());
+
+    /* rows are written one by one to drop stride of the source and to add stride of the file */
+    std::vector<TypeValue> row(stride, TypeValue());
+    for (std::size_t index = 0; index < p_data.size(); index++) {
+        std::copy(p_data[index], p_data[index] + p_data.dimension(), row.begin());
+        stream.write(reinterpret_cast<const char *>(row.data()), row.size() * sizeof(TypeValue));
+    }
+
+    if (!stream.good()) {
+        throw std::runtime_error("CCORE [dataset_file]: file '" + p_path + "' can not be written.");
+    }
+}
+
+
+}
@@ -0,0 +1,187 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#ifndef SRC_UTILS_DATASET_FILE_HPP_
+#define SRC_UTILS_DATASET_FILE_HPP_
+
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "definitions.hpp"
+
+#include "utils/mapped_file.hpp"
+
+
+namespace utils {
+
+
+/**
+*
+* @brief    Types of coordinates that can be stored in binary dataset file.
+*
+*/
+enum class dataset_file_type : std::uint32_t {
+    FLOAT64 = 0,
+    FLOAT32 = 1
+};
+
+
+/**
+*
+* @brief    Header of binary dataset file.
+* @details  File consists of the header, padding up to 'offset' bytes and rows of coordinates. Each
+*           row contains 'dimension' coordinates followed by padding up to 'stride' elements. All
+*           values are stored in native (little-endian) byte order. Offset of rows is aligned to
+*           'dataset_file::ALIGNMENT' bytes, so mapped data can be used by vectorized kernels
+*           in the same way as 'dense_matrix'.
+*
+*/
+struct dataset_file_header {
+    char            magic[8];       /* 'PYCLDSET' */
+    std::uint32_t   version;
+    std::uint32_t   type;           /* value of 'dataset_file_type' */
+    std::uint64_t   size;           /* amount of rows */
+    std::uint64_t   dimension;      /* amount of coordinates in each row */
+    std::uint64_t   stride;         /* distance in elements between beginnings of neighbor rows */
+    std::uint64_t   offset;         /* position of the first row in bytes from the beginning of the file */
+};
+
+
+/**
+*
+* @brief    Writer and memory-mapped reader of binary dataset file.
+* @details  Reader maps the file to memory, so points are not parsed and not copied: algorithms
+*           receive view to the mapped memory. Mapping is valid while the object is alive.
+*
+*/
+class dataset_file {
+public:
+    static const std::size_t ALIGNMENT;
+
+    static const std::uint32_t VERSION;
+
+private:
+    mapped_file     m_file;
+    dataset_file_type   m_type  = dataset_file_type::FLOAT64;
+    dataset_view    m_view;
+    dataset_view_f32    m_view_f32;
+
+public:
+    /**
+    *
+    * @brief    Maps binary dataset file to memory.
+    * @details  Exception 'std::runtime_error' is thrown if the file can not be opened or it is not a
+    *           valid dataset file.
+    *
+    * @param[in] p_path: path to the binary dataset file.
+    *
+    */
+    explicit dataset_file(const std::string & p_path);
+
+    dataset_file(const dataset_file & p_other) = delete;
+
+public:
+    /**
+    *
+    * @brief    Returns type of coordinates that are stored in the file.
+    *
+    */
+    inline dataset_file_type type(void) const { return m_type; }
+
+    /**
+    *
+    * @brief    Returns view to the points that are stored in the file in double precision.
+    * @details  Exception 'std::logic_error' is thrown if coordinates are stored in single precision.
+    *
+    */
+    const dataset_view & view(void) const;
+
+    /**
+    *
+    * @brief    Returns view to the points that are stored in the file in single precision.
+    * @details  Exception 'std::logic_error' is thrown if coordinates are stored in double precision.
+    *
+    */
+    const dataset_view_f32 & view_f32(void) const;
+
+    /**
+    *
+    * @brief    Returns amount of points that are stored in the file.
+    *
+    */
+    inline std::size_t size(void) const { return (m_type == dataset_file_type::FLOAT32) ? m_view_f32.size() : m_view.size(); }
+
+    /**
+    *
+    * @brief    Returns amount of coordinates of each point.
+    *
+    */
+    inline std::size_t dimension(void) const { return (m_type == dataset_file_type::FLOAT32) ? m_view_f32.dimension() : m_view.dimension(); }
+
+    /**
+    *
+    * @brief    Returns distance in elements between beginnings of neighbor points.
+    *
+    */
+    inline std::size_t stride(void) const { return (m_type == dataset_file_type::FLOAT32) ? m_view_f32.stride() : m_view.stride(); }
+
+public:
+    /**
+    *
+    * @brief    Writes points to binary dataset file.
+    * @details  Exception 'std::runtime_error' is thrown if the file can not be written.
+    *
+    * @param[in] p_path: path to the file that is created or overwritten.
+    * @param[in] p_data: points that should be written.
+    * @param[in] p_stride: distance in elements between beginnings of neighbor rows in the file,
+    *             zero means that rows are densely packed.
+    *
+    */
+    static void write(const std::string & p_path, const dataset_view & p_data, const std::size_t p_stride = 0);
+
+    /**
+    *
+    * @brief    Writes points with single precision coordinates to binary dataset file.
+    * @details  Exception 'std::runtime_error' is thrown if the file can not be written.
+    *
+    * @param[in] p_path: path to the file that is created or overwritten.
+    * @param[in] p_data: points that should be written.
+    * @param[in] p_stride: distance in elements between beginnings of neighbor rows in the file,
+    *             zero means that rows are densely packed.
+    *
+    */
+    static void write(const std::string & p_path, const dataset_view_f32 & p_data, const std::size_t p_stride = 0);
+
+public:
+    dataset_file & operator=(const dataset_file & p_other) = delete;
+
+private:
+    template <typename TypeValue>
+    static void write_data(const std::string & p_path, const container::dense_matrix_view<TypeValue> & p_data, const std::size_t p_stride, const dataset_file_type p_type);
+};
+
+
+}
+
+
+#endif
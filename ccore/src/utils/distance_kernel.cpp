@@ -0,0 +1,497 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#include "utils/distance_kernel.hpp"
+
+#include <atomic>
+#include <stdexcept>
+
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define DISTANCE_KERNEL_X86
+    #define DISTANCE_KERNEL_TARGET(TARGET) __attribute__((target(TARGET)))
+    #include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #define DISTANCE_KERNEL_X86
+    #define DISTANCE_KERNEL_TARGET(TARGET)
+    #include <intrin.h>
+    #include <immintrin.h>
+#endif
+
+
+namespace utils {
+
+
+namespace {
+
+
+using distance_function = double (*)(const double * const, const double * const, const std::size_t);
+
+using distance_block_function = void (*)(const double * const, const double * const, const std::size_t, const std::size_t, const std::size_t, double * const);
+
+using distance_f32_function = float (*)(const float * const, const float * const, const std::size_t);
+
+using distance_block_f32_function = void (*)(const float * const, const float * const, const std::size_t, const std::size_t, const std::size_t, float * const);
+
+
+/**
+*
+* @brief    Set of kernels that are implemented using the same instruction set.
+*
+*/
+struct distance_kernel {
+    simd_instruction_set        instruction_set;
+    distance_function           distance;
+    distance_block_function     distance_block;
+    distance_f32_function       distance_f32;
+    distance_block_f32_function distance_block_f32;
+};
+
+
+double distance_scalar(const double * const p_point1, const double * const p_point2, const std::size_t p_dimension) {
+    double distance[4] = { 0.0, 0.0, 0.0, 0.0 };
+
+    std::size_t index = 0;
+    for (; index + 4 <= p_dimension; index += 4) {
+        for (std::size_t lane = 0; lane < 4; lane++) {
+            const double difference = p_point1[index + lane] - p_point2[index + lane];
+            distance[lane] += difference * difference;
+        }
+    }
+
+    for (; index < p_dimension; index++) {
+        const double difference = p_point1[index] - p_point2[index];
+        distance[0] += difference * difference;
+    }
+
+    return (distance[0] + distance[1]) + (distance[2] + distance[3]);
+}
+
+
+void distance_block_scalar(const double * const p_point, const double * const p_block, const std::size_t p_size, const std::size_t p_dimension, const std::size_t p_stride, double * const p_result) {
+    for (std::size_t index = 0; index < p_size; index++) {
+        p_result[index] = distance_scalar(p_point, p_block + index * p_stride, p_dimension);
+    }
+}
+
+
+float distance_f32_scalar(const float * const p_point1, const float * const p_point2, const std::size_t p_dimension) {
+    float distance[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+    std::size_t index = 0;
+    for (; index + 4 <= p_dimension; index += 4) {
+        for (std::size_t lane = 0; lane < 4; lane++) {
+            const float difference = p_point1[index + lane] - p_point2[index + lane];
+            distance[lane] += difference * difference;
+        }
+    }
+
+    for (; index < p_dimension; index++) {
+        const float difference = p_point1[index] - p_point2[index];
+        distance[0] += difference * difference;
+    }
+
+    return (distance[0] + distance[1]) + (distance[2] + distance[3]);
+}
+
+
+void distance_block_f32_scalar(const float * const p_point, const float * const p_block, const std::size_t p_size, const std::size_t p_dimension, const std::size_t p_stride, float * const p_result) {
+    for (std::size_t index = 0; index < p_size; index++) {
+        p_result[index] = distance_f32_scalar(p_point, p_block + index * p_stride, p_dimension);
+    }
+}
+
+
+#if defined(DISTANCE_KERNEL_X86)
+
+DISTANCE_KERNEL_TARGET("sse2")
+double distance_sse2(const double * const p_point1, const double * const p_point2, const std::size_t p_dimension) {
+    __m128d accumulator1 = _mm_setzero_pd();
+    __m128d accumulator2 = _mm_setzero_pd();
+
+    std::size_t index = 0;
+    for (; index + 4 <= p_dimension; index += 4) {
+        const __m128d difference1 = _mm_sub_pd(_mm_loadu_pd(p_point1 + index), _mm_loadu_pd(p_point2 + index));
+        const __m128d difference2 = _mm_sub_pd(_mm_loadu_pd(p_point1 + index + 2), _mm_loadu_pd(p_point2 + index + 2));
+
+        accumulator1 = _mm_add_pd(accumulator1, _mm_mul_pd(difference1, difference1));
+        accumulator2 = _mm_add_pd(accumulator2, _mm_mul_pd(difference2, difference2));
+    }
+
+    for (; index + 2 <= p_dimension; index += 2) {
+        const __m128d difference = _mm_sub_pd(_mm_loadu_pd(p_point1 + index), _mm_loadu_pd(p_point2 + index));
+        accumulator1 = _mm_add_pd(accumulator1, _mm_mul_pd(difference, difference));
+    }
+
+    accumulator1 = _mm_add_pd(accumulator1, accumulator2);
+
+    double lanes[2];
+    _mm_storeu_pd(lanes, accumulator1);
+
+    double distance = lanes[0] + lanes[1];
+    for (; index < p_dimension; index++) {
+        const double difference = p_point1[index] - p_point2[index];
+        distance += difference * difference;
+    }
+
+    return distance;
+}
+
+
+DISTANCE_KERNEL_TARGET("sse2")
+void distance_block_sse2(const double * const p_point, const double * const p_block, const std::size_t p_size, const std::size_t p_dimension, const std::size_t p_stride, double * const p_result) {
+    for (std::size_t index = 0; index < p_size; index++) {
+        p_result[index] = distance_sse2(p_point, p_block + index * p_stride, p_dimension);
+    }
+}
+
+
+DISTANCE_KERNEL_TARGET("sse2")
+float distance_f32_sse2(const float * const p_point1, const float * const p_point2, const std::size_t p_dimension) {
+    __m128 accumulator1 = _mm_setzero_ps();
+    __m128 accumulator2 = _mm_setzero_ps();
+
+    std::size_t index = 0;
+    for (; index + 8 <= p_dimension; index += 8) {
+        const __m128 difference1 = _mm_sub_ps(_mm_loadu_ps(p_point1 + index), _mm_loadu_ps(p_point2 + index));
+        const __m128 difference2 = _mm_sub_ps(_mm_loadu_ps(p_point1 + index + 4), _mm_loadu_ps(p_point2 + index + 4));
+
+        accumulator1 = _mm_add_ps(accumulator1, _mm_mul_ps(difference1, difference1));
+        accumulator2 = _mm_add_ps(accumulator2, _mm_mul_ps(difference2, difference2));
+    }
+
+    for (; index + 4 <= p_dimension; index += 4) {
+        const __m128 difference = _mm_sub_ps(_mm_loadu_ps(p_point1 + index), _mm_loadu_ps(p_point2 + index));
+        accumulator1 = _mm_add_ps(accumulator1, _mm_mul_ps(difference, difference));
+    }
+
+    accumulator1 = _mm_add_ps(accumulator1, accumulator2);
+
+    float lanes[4];
+    _mm_storeu_ps(lanes, accumulator1);
+
+    float distance = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for (; index < p_dimension; index++) {
+        const float difference = p_point1[index] - p_point2[index];
+        distance += difference * difference;
+    }
+
+    return distance;
+}
+
+
+DISTANCE_KERNEL_TARGET("sse2")
+void distance_block_f32_sse2(const float * const p_point, const float * const p_block, const std::size_t p_size, const std::size_t p_dimension, const std::size_t p_stride, float * const p_result) {
+    for (std::size_t index = 0; index < p_size; index++) {
+        p_result[index] = distance_f32_sse2(p_point, p_block + index * p_stride, p_dimension);
+    }
+}
+
+
+DISTANCE_KERNEL_TARGET("avx2,fma")
+double distance_avx2(const double * const p_point1, const double * const p_point2, const std::size_t p_dimension) {
+    __m256d accumulator1 = _mm256_setzero_pd();
+    __m256d accumulator2 = _mm256_setzero_pd();
+
+    std::size_t index = 0;
+    for (; index + 8 <= p_dimension; index += 8) {
+        const __m256d difference1 = _mm256_sub_pd(_mm256_loadu_pd(p_point1 + index), _mm256_loadu_pd(p_point2 + index));
+        const __m256d difference2 = _mm256_sub_pd(_mm256_loadu_pd(p_point1 + index + 4), _mm256_loadu_pd(p_point2 + index + 4));
+
+        accumulator1 = _mm256_fmadd_pd(difference1, difference1, accumulator1);
+        accumulator2 = _mm256_fmadd_pd(difference2, difference2, accumulator2);
+    }
+
+    for (; index + 4 <= p_dimension; index += 4) {
+        const __m256d difference = _mm256_sub_pd(_mm256_loadu_pd(p_point1 + index), _mm256_loadu_pd(p_point2 + index));
+        accumulator1 = _mm256_fmadd_pd(difference, difference, accumulator1);
+    }
+
+    accumulator1 = _mm256_add_pd(accumulator1, accumulator2);
+
+    __m128d half = _mm_add_pd(_mm256_castpd256_pd128(accumulator1), _mm256_extractf128_pd(accumulator1, 1));
+    half = _mm_add_sd(half, _mm_unpackhi_pd(half, half));
+
+    double distance = _mm_cvtsd_f64(half);
+    for (; index < p_dimension; index++) {
+        const double difference = p_point1[index] - p_point2[index];
+        distance += difference * difference;
+    }
+
+    return distance;
+}
+
+
+DISTANCE_KERNEL_TARGET("avx2,fma")
+void distance_block_avx2(const double * const p_point, const double * const p_block, const std::size_t p_size, const std::size_t p_dimension, const std::size_t p_stride, double * const p_result) {
+    for (std::size_t index = 0; index < p_size; index++) {
+        p_result[index] = distance_avx2(p_point, p_block + index * p_stride, p_dimension);
+    }
+}
+
+
+DISTANCE_KERNEL_TARGET("avx2,fma")
+float distance_f32_avx2(const float * const p_point1, const float * const p_point2, const std::size_t p_dimension) {
+    __m256 accumulator1 = _mm256_setzero_ps();
+    __m256 accumulator2 = _mm256_setzero_ps();
+
+    std::size_t index = 0;
+    for (; index + 16 <= p_dimension; index += 16) {
+        const __m256 difference1 = _mm256_sub_ps(_mm256_loadu_ps(p_point1 + index), _mm256_loadu_ps(p_point2 + index));
+        const __m256 difference2 = _mm256_sub_ps(_mm256_loadu_ps(p_point1 + index + 8), _mm256_loadu_ps(p_point2 + index + 8));
+
+        accumulator1 = _mm256_fmadd_ps(difference1, difference1, accumulator1);
+        accumulator2 = _mm256_fmadd_ps(difference2, difference2, accumulator2);
+    }
+
+    for (; index + 8 <= p_dimension; index += 8) {
+        const __m256 difference = _mm256_sub_ps(_mm256_loadu_ps(p_point1 + index), _mm256_loadu_ps(p_point2 + index));
+        accumulator1 = _mm256_fmadd_ps(difference, difference, accumulator1);
+    }
+
+    accumulator1 = _mm256_add_ps(accumulator1, accumulator2);
+
+    __m128 half = _mm_add_ps(_mm256_castps256_ps128(accumulator1), _mm256_extractf128_ps(accumulator1, 1));
+    half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+    half = _mm_add_ss(half, _mm_shuffle_ps(half, half, 0x55));
+
+    float distance = _mm_cvtss_f32(half);
+    for (; index < p_dimension; index++) {
+        const float difference = p_point1[index] - p_point2[index];
+        distance += difference * difference;
+    }
+
+    return distance;
+}
+
+
+DISTANCE_KERNEL_TARGET("avx2,fma")
+void distance_block_f32_avx2(const float * const p_point, const float * const p_block, const std::size_t p_size, const std::size_t p_dimension, const std::size_t p_stride, float * const p_result) {
+    for (std::size_t index = 0; index < p_size; index++) {
+        p_result[index] = distance_f32_avx2(p_point, p_block + index * p_stride, p_dimension);
+    }
+}
+
+
+DISTANCE_KERNEL_TARGET("avx512f")
+double distance_avx512(const double * const p_point1, const double * const p_point2, const std::size_t p_dimension) {
+    __m512d accumulator = _mm512_setzero_pd();
+
+    std::size_t index = 0;
+    for (; index + 8 <= p_dimension; index += 8) {
+        const __m512d difference = _mm512_sub_pd(_mm512_loadu_pd(p_point1 + index), _mm512_loadu_pd(p_point2 + index));
+        accumulator = _mm512_fmadd_pd(difference, difference, accumulator);
+    }
+
+    if (index < p_dimension) {
+        const __mmask8 mask = (__mmask8) ((1u << (p_dimension - index)) - 1u);
+        const __m512d difference = _mm512_sub_pd(_mm512_maskz_loadu_pd(mask, p_point1 + index), _mm512_maskz_loadu_pd(mask, p_point2 + index));
+        accumulator = _mm512_fmadd_pd(difference, difference, accumulator);
+    }
+
+    return _mm512_reduce_add_pd(accumulator);
+}
+
+
+DISTANCE_KERNEL_TARGET("avx512f")
+void distance_block_avx512(const double * const p_point, const double * const p_block, const std::size_t p_size, const std::size_t p_dimension, const std::size_t p_stride, double * const p_result) {
+    for (std::size_t index = 0; index < p_size; index++) {
+        p_result[index] = distance_avx512(p_point, p_block + index * p_stride, p_dimension);
+    }
+}
+
+
+DISTANCE_KERNEL_TARGET("avx512f")
+float distance_f32_avx512(const float * const p_point1, const float * const p_point2, const std::size_t p_dimension) {
+    __m512 accumulator = _mm512_setzero_ps();
+
+    std::size_t index = 0;
+    for (; index + 16 <= p_dimension; index += 16) {
+        const __m512 difference = _mm512_sub_ps(_mm512_loadu_ps(p_point1 + index), _mm512_loadu_ps(p_point2 + index));
+        accumulator = _mm512_fmadd_ps(difference, difference, accumulator);
+    }
+
+    if (index < p_dimension) {
+        const __mmask16 mask = (__mmask16) ((1u << (p_dimension - index)) - 1u);
+        const __m512 difference = _mm512_sub_ps(_mm512_maskz_loadu_ps(mask, p_point1 + index), _mm512_maskz_loadu_ps(mask, p_point2 + index));
+        accumulator = _mm512_fmadd_ps(difference, difference, accumulator);
+    }
+
+    return _mm512_reduce_add_ps(accumulator);
+}
+
+
+DISTANCE_KERNEL_TARGET("avx512f")
+void distance_block_f32_avx512(const float * const p_point, const float * const p_block, const std::size_t p_size, const std::size_t p_dimension, const std::size_t p_stride, float * const p_result) {
+    for (std::size_t index = 0; index < p_size; index++) {
+        p_result[index] = distance_f32_avx512(p_point, p_block + index * p_stride, p_dimension);
+    }
+}
+
+#endif
+
+
+const distance_kernel KERNEL_SCALAR = { simd_instruction_set::SCALAR, distance_scalar, distance_block_scalar, distance_f32_scalar, distance_block_f32_scalar };
+
+#if defined(DISTANCE_KERNEL_X86)
+const distance_kernel KERNEL_SSE2 = { simd_instruction_set::SSE2, distance_sse2, distance_block_sse2, distance_f32_sse2, distance_block_f32_sse2 };
+const distance_kernel KERNEL_AVX2 = { simd_instruction_set::AVX2, distance_avx2, distance_block_avx2, distance_f32_avx2, distance_block_f32_avx2 };
+const distance_kernel KERNEL_AVX512 = { simd_instruction_set::AVX512, distance_avx512, distance_block_avx512, distance_f32_avx512, distance_block_f32_avx512 };
+#endif
+
+
+simd_instruction_set detect_simd_instruction_set(void) {
+#if defined(DISTANCE_KERNEL_X86) && defined(__GNUC__)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f")) {
+        return simd_instruction_set::AVX512;
+    }
+    else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return simd_instruction_set::AVX2;
+    }
+    else if (__builtin_cpu_supports("sse2")) {
+        return simd_instruction_set::SSE2;
+    }
+#elif defined(DISTANCE_KERNEL_X86)
+    int registers[4] = { 0, 0, 0, 0 };
+    __cpuid(registers, 0);
+    const int maximum_leaf = registers[0];
+
+    __cpuid(registers, 1);
+    const bool sse2 = (registers[3] & (1 << 26)) != 0;
+    const bool fma = (registers[2] & (1 << 12)) != 0;
+    const bool osxsave = (registers[2] & (1 << 27)) != 0;
+
+    bool avx2 = false, avx512 = false;
+    if (osxsave && (maximum_leaf >= 7)) {
+        const unsigned long long xcr0 = _xgetbv(0);
+
+        __cpuidex(registers, 7, 0);
+        avx2 = ((xcr0 & 0x06) == 0x06) && ((registers[1] & (1 << 5)) != 0) && fma;
+        avx512 = ((xcr0 & 0xE6) == 0xE6) && ((registers[1] & (1 << 16)) != 0);
+    }
+
+    if (avx512) {
+        return simd_instruction_set::AVX512;
+    }
+    else if (avx2) {
+        return simd_instruction_set::AVX2;
+    }
+    else if (sse2) {
+        return simd_instruction_set::SSE2;
+    }
+#endif
+
+    return simd_instruction_set::SCALAR;
+}
+
+
+const distance_kernel * get_kernel(const simd_instruction_set p_set) {
+    switch(p_set) {
+#if defined(DISTANCE_KERNEL_X86)
+    case simd_instruction_set::AVX512:
+        return &KERNEL_AVX512;
+    case simd_instruction_set::AVX2:
+        return &KERNEL_AVX2;
+    case simd_instruction_set::SSE2:
+        return &KERNEL_SSE2;
+#endif
+    default:
+        return &KERNEL_SCALAR;
+    }
+}
+
+
+std::atomic<const distance_kernel *> & current_kernel(void) {
+    static std::atomic<const distance_kernel *> kernel(get_kernel(get_supported_simd_instruction_set()));
+    return kernel;
+}
+
+
+}
+
+
+simd_instruction_set get_supported_simd_instruction_set(void) {
+    static const simd_instruction_set supported_set = detect_simd_instruction_set();
+    return supported_set;
+}
+
+
+simd_instruction_set get_simd_instruction_set(void) {
+    return current_kernel().load(std::memory_order_relaxed)->instruction_set;
+}
+
+
+void set_simd_instruction_set(const simd_instruction_set p_set) {
+    if (p_set > get_supported_simd_instruction_set()) {
+        throw std::invalid_argument("CCORE [distance_kernel]: instruction set is not supported by the processor.");
+    }
+
+    current_kernel().store(get_kernel(p_set), std::memory_order_relaxed);
+}
+
+
+double euclidean_distance_square_simd(const double * const p_point1, const double * const p_point2, const std::size_t p_dimension) {
+    return current_kernel().load(std::memory_order_relaxed)->distance(p_point1, p_point2, p_dimension);
+}
+
+
+void euclidean_distance_square(const double * const p_point, const dataset_view & p_block, double * const p_result) {
+    const distance_kernel * kernel = current_kernel().load(std::memory_order_relaxed);
+    kernel->distance_block(p_point, p_block.data(), p_block.size(), p_block.dimension(), p_block.stride(), p_result);
+}
+
+
+void euclidean_distance_square(const dataset_view & p_block1, const dataset_view & p_block2, double * const p_result) {
+    if (p_block1.dimension() != p_block2.dimension()) {
+        throw std::invalid_argument("CCORE [distance_kernel]: blocks should have the same dimension.");
+    }
+
+    const distance_kernel * kernel = current_kernel().load(std::memory_order_relaxed);
+    for (std::size_t index = 0; index < p_block1.size(); index++) {
+        kernel->distance_block(p_block1[index], p_block2.data(), p_block2.size(), p_block2.dimension(), p_block2.stride(), p_result + index * p_block2.size());
+    }
+}
+
+
+float euclidean_distance_square_simd(const float * const p_point1, const float * const p_point2, const std::size_t p_dimension) {
+    return current_kernel().load(std::memory_order_relaxed)->distance_f32(p_point1, p_point2, p_dimension);
+}
+
+
+void euclidean_distance_square(const float * const p_point, const dataset_view_f32 & p_block, float * const p_result) {
+    const distance_kernel * kernel = current_kernel().load(std::memory_order_relaxed);
+    kernel->distance_block_f32(p_point, p_block.data(), p_block.size(), p_block.dimension(), p_block.stride(), p_result);
+}
+
+
+void euclidean_distance_square(const dataset_view_f32 & p_block1, const dataset_view_f32 & p_block2, float * const p_result) {
+    if (p_block1.dimension() != p_block2.dimension()) {
+        throw std::invalid_argument("CCORE [distance_kernel]: blocks should have the same dimension.");
+    }
+
+    const distance_kernel * kernel = current_kernel().load(std::memory_order_relaxed);
+    for (std::size_t index = 0; index < p_block1.size(); index++) {
+        kernel->distance_block_f32(p_block1[index], p_block2.data(), p_block2.size(), p_block2.dimension(), p_block2.stride(), p_result + index * p_block2.size());
+    }
+}
+
+}
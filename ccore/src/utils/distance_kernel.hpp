@@ -0,0 +1,214 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#ifndef SRC_UTILS_DISTANCE_KERNEL_HPP_
+#define SRC_UTILS_DISTANCE_KERNEL_HPP_
+
+
+#include <cstddef>
+
+#include "definitions.hpp"
+
+
+namespace utils {
+
+
+/**
+*
+* @brief    Instruction sets that are used by distance kernels.
+*
+*/
+enum class simd_instruction_set {
+    SCALAR = 0,
+    SSE2,
+    AVX2,
+    AVX512
+};
+
+
+/**
+*
+* @brief    Returns the most advanced instruction set that is supported by the processor and can be
+*           used by distance kernels.
+*
+*/
+simd_instruction_set get_supported_simd_instruction_set(void);
+
+/**
+*
+* @brief    Returns instruction set that is currently used by distance kernels.
+* @details  By default it is chosen once when the library is loaded using CPU feature detection.
+*
+*/
+simd_instruction_set get_simd_instruction_set(void);
+
+/**
+*
+* @brief    Forces distance kernels to use the specified instruction set.
+* @details  It is mainly intended for testing and benchmarking, the instruction set should be
+*           supported by the processor otherwise exception 'std::invalid_argument' is thrown.
+*
+* @param[in] p_set: instruction set that should be used.
+*
+*/
+void set_simd_instruction_set(const simd_instruction_set p_set);
+
+
+/**
+*
+* @brief    Calculates square of Euclidean distance between two points using vector instructions.
+*
+* @param[in] p_point1: pointer to the first coordinate of point #1.
+* @param[in] p_point2: pointer to the first coordinate of point #2.
+* @param[in] p_dimension: amount of coordinates of each point.
+*
+* @return   Returns square of Euclidean distance between points.
+*
+*/
+double euclidean_distance_square_simd(const double * const p_point1, const double * const p_point2, const std::size_t p_dimension);
+
+/**
+*
+* @brief    Calculates square of Euclidean distance between two points.
+* @details  Points with small amount of coordinates are processed inline by scalar code because
+*           vector registers can not be filled by them, other points are passed to the kernel
+*           that has been chosen for the processor.
+*
+* @param[in] p_point1: pointer to the first coordinate of point #1.
+* @param[in] p_point2: pointer to the first coordinate of point #2.
+* @param[in] p_dimension: amount of coordinates of each point.
+*
+* @return   Returns square of Euclidean distance between points.
+*
+*/
+inline double euclidean_distance_square(const double * const p_point1, const double * const p_point2, const std::size_t p_dimension) {
+    if (p_dimension < 4) {
+        double distance = 0.0;
+        for (std::size_t index = 0; index < p_dimension; index++) {
+            const double difference = p_point1[index] - p_point2[index];
+            distance += difference * difference;
+        }
+
+        return distance;
+    }
+
+    return euclidean_distance_square_simd(p_point1, p_point2, p_dimension);
+}
+
+/**
+*
+* @brief    Calculates square of Euclidean distance between the point and each point of the block
+*           (one-to-many form).
+*
+* @param[in]  p_point: pointer to the first coordinate of the point, it should have the same
+*              dimension as points of the block.
+* @param[in]  p_block: points that are compared with the point.
+* @param[out] p_result: array with size that is not less than amount of points in the block,
+*              where the i-th distance corresponds to the i-th point of the block.
+*
+*/
+void euclidean_distance_square(const double * const p_point, const dataset_view & p_block, double * const p_result);
+
+/**
+*
+* @brief    Calculates square of Euclidean distance between each point of the first block and each
+*           point of the second block (many-to-many form).
+*
+* @param[in]  p_block1: the first block of points.
+* @param[in]  p_block2: the second block of points, it should have the same dimension as the first.
+* @param[out] p_result: row-major array with size that is not less than 'p_block1.size()' *
+*              'p_block2.size()', where element [i * p_block2.size() + j] is distance between
+*              the i-th point of the first block and the j-th point of the second block.
+*
+*/
+void euclidean_distance_square(const dataset_view & p_block1, const dataset_view & p_block2, double * const p_result);
+
+
+/**
+*
+* @brief    Calculates square of Euclidean distance between two single precision points using vector
+*           instructions.
+* @details  Accumulation is performed in single precision, in comparison with double precision
+*           twice more coordinates are processed by one instruction.
+*
+* @param[in] p_point1: pointer to the first coordinate of point #1.
+* @param[in] p_point2: pointer to the first coordinate of point #2.
+* @param[in] p_dimension: amount of coordinates of each point.
+*
+* @return   Returns square of Euclidean distance between points.
+*
+*/
+float euclidean_distance_square_simd(const float * const p_point1, const float * const p_point2, const std::size_t p_dimension);
+
+/**
+*
+* @brief    Calculates square of Euclidean distance between two single precision points.
+*
+* @param[in] p_point1: pointer to the first coordinate of point #1.
+* @param[in] p_point2: pointer to the first coordinate of point #2.
+* @param[in] p_dimension: amount of coordinates of each point.
+*
+* @return   Returns square of Euclidean distance between points.
+*
+*/
+inline float euclidean_distance_square(const float * const p_point1, const float * const p_point2, const std::size_t p_dimension) {
+    if (p_dimension < 8) {
+        float distance = 0.0f;
+        for (std::size_t index = 0; index < p_dimension; index++) {
+            const float difference = p_point1[index] - p_point2[index];
+            distance += difference * difference;
+        }
+
+        return distance;
+    }
+
+    return euclidean_distance_square_simd(p_point1, p_point2, p_dimension);
+}
+
+/**
+*
+* @brief    Calculates square of Euclidean distance between the single precision point and each
+*           point of the block (one-to-many form).
+*
+* @param[in]  p_point: pointer to the first coordinate of the point.
+* @param[in]  p_block: points that are compared with the point.
+* @param[out] p_result: array with size that is not less than amount of points in the block.
+*
+*/
+void euclidean_distance_square(const float * const p_point, const dataset_view_f32 & p_block, float * const p_result);
+
+/**
+*
+* @brief    Calculates square of Euclidean distance between each point of the first single precision
+*           block and each point of the second block (many-to-many form).
+*
+* @param[in]  p_block1: the first block of points.
+* @param[in]  p_block2: the second block of points, it should have the same dimension as the first.
+* @param[out] p_result: row-major array with size that is not less than 'p_block1.size()' *
+*              'p_block2.size()'.
+*
+*/
+void euclidean_distance_square(const dataset_view_f32 & p_block1, const dataset_view_f32 & p_block2, float * const p_result);
+
+
+}
+
+
+#endif
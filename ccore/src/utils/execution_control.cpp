@@ -0,0 +1,130 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#include "utils/execution_control.hpp"
+
+
+namespace utils {
+
+
+cancellation_token::cancellation_token(void) :
+    m_cancelled(std::make_shared<std::atomic<bool>>(false))
+{ }
+
+
+void cancellation_token::cancel(void) {
+    m_cancelled->store(true);
+}
+
+
+void cancellation_token::reset(void) {
+    m_cancelled->store(false);
+}
+
+
+bool cancellation_token::is_cancelled(void) const {
+    return m_cancelled->load(std::memory_order_relaxed);
+}
+
+
+
+void execution_control::set_cancellation_token(const cancellation_token & p_token) {
+    m_token = p_token;
+}
+
+
+void execution_control::set_iteration_budget(const std::size_t p_iterations) {
+    m_iteration_budget = p_iterations;
+}
+
+
+void execution_control::set_time_budget(const double p_milliseconds) {
+    m_time_budget = p_milliseconds;
+}
+
+
+void execution_control::set_progress_callback(const progress_callback & p_callback) {
+    m_progress = p_callback;
+}
+
+
+const cancellation_token & execution_control::get_cancellation_token(void) const {
+    return m_token;
+}
+
+
+std::size_t execution_control::get_iteration_budget(void) const {
+    return m_iteration_budget;
+}
+
+
+double execution_control::get_time_budget(void) const {
+    return m_time_budget;
+}
+
+
+const progress_callback & execution_control::get_progress_callback(void) const {
+    return m_progress;
+}
+
+
+
+execution_monitor::execution_monitor(const execution_control & p_control) :
+    m_control(p_control)
+{
+    if (m_control.get_time_budget() > 0.0) {
+        m_start = clock::now();
+    }
+}
+
+
+bool execution_monitor::can_continue(void) {
+    if (is_stopped()) {
+        return false;
+    }
+
+    if (m_control.get_cancellation_token().is_cancelled()) {
+        m_status = execution_status::CANCELLED;
+    }
+    else if ((m_control.get_iteration_budget() > 0) && (m_iterations >= m_control.get_iteration_budget())) {
+        m_status = execution_status::ITERATION_BUDGET_EXCEEDED;
+    }
+    else if (m_control.get_time_budget() > 0.0) {
+        const double elapsed = std::chrono::duration<double, std::milli>(clock::now() - m_start).count();
+        if (elapsed >= m_control.get_time_budget()) {
+            m_status = execution_status::TIME_BUDGET_EXCEEDED;
+        }
+    }
+
+    return !is_stopped();
+}
+
+
+void execution_monitor::next_iteration(const double p_value) {
+    m_iterations++;
+
+    if (m_control.get_progress_callback()) {
+        m_control.get_progress_callback()(m_iterations, p_value);
+    }
+}
+
+
+}
@@ -0,0 +1,264 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#ifndef SRC_UTILS_EXECUTION_CONTROL_HPP_
+#define SRC_UTILS_EXECUTION_CONTROL_HPP_
+
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+
+namespace utils {
+
+
+/**
+*
+* @brief    Reasons why long-running processing has been finished.
+*
+*/
+enum class execution_status {
+    COMPLETED = 0,
+    CANCELLED,
+    TIME_BUDGET_EXCEEDED,
+    ITERATION_BUDGET_EXCEEDED
+};
+
+
+/**
+*
+* @brief    Cooperative cancellation token that can be shared between threads.
+* @details  Copies of the token refer to the same state, therefore processing that has been started
+*           with a copy of the token stops when any copy is cancelled. Algorithms check the token
+*           between iterations and return the best result that has been obtained so far.
+*
+*/
+class cancellation_token {
+private:
+    std::shared_ptr<std::atomic<bool>>  m_cancelled;
+
+public:
+    /**
+    *
+    * @brief    Creates token that is not cancelled.
+    *
+    */
+    cancellation_token(void);
+
+public:
+    /**
+    *
+    * @brief    Requests cancellation of processing that uses the token.
+    *
+    */
+    void cancel(void);
+
+    /**
+    *
+    * @brief    Returns token to non-cancelled state so that it can be used again.
+    *
+    */
+    void reset(void);
+
+    /**
+    *
+    * @brief    Returns 'true' if cancellation has been requested.
+    *
+    */
+    bool is_cancelled(void) const;
+};
+
+
+/**
+*
+* @brief    Callback that is called by algorithm after each iteration.
+* @details  The first argument is an amount of performed iterations, the second is an algorithm
+*           specific measure of convergence (for example, maximum change of cluster centers for
+*           K-Means or level of synchronization for oscillatory networks).
+*
+*/
+using progress_callback = std::function<void(const std::size_t, const double)>;
+
+
+/**
+*
+* @brief    Limits and observers of long-running processing.
+* @details  By default there are no budgets and no callback, in that case algorithms work until
+*           convergence as usual.
+*
+*/
+class execution_control {
+private:
+    cancellation_token  m_token;
+    std::size_t         m_iteration_budget  = 0;
+    double              m_time_budget       = 0.0;
+    progress_callback   m_progress;
+
+public:
+    /**
+    *
+    * @brief    Sets token that is checked between iterations.
+    *
+    * @param[in] p_token: cancellation token.
+    *
+    */
+    void set_cancellation_token(const cancellation_token & p_token);
+
+    /**
+    *
+    * @brief    Sets maximum amount of iterations, zero means that amount is not limited.
+    *
+    * @param[in] p_iterations: maximum amount of iterations.
+    *
+    */
+    void set_iteration_budget(const std::size_t p_iterations);
+
+    /**
+    *
+    * @brief    Sets maximum wall time of processing in milliseconds, zero means that time is not limited.
+    *
+    * @param[in] p_milliseconds: maximum wall time of processing.
+    *
+    */
+    void set_time_budget(const double p_milliseconds);
+
+    /**
+    *
+    * @brief    Sets callback that is called after each iteration.
+    *
+    * @param[in] p_callback: progress callback, it can be empty.
+    *
+    */
+    void set_progress_callback(const progress_callback & p_callback);
+
+    /**
+    *
+    * @brief    Returns token that is checked between iterations.
+    *
+    */
+    const cancellation_token & get_cancellation_token(void) const;
+
+    /**
+    *
+    * @brief    Returns maximum amount of iterations, zero means that amount is not limited.
+    *
+    */
+    std::size_t get_iteration_budget(void) const;
+
+    /**
+    *
+    * @brief    Returns maximum wall time of processing in milliseconds, zero means that time is not limited.
+    *
+    */
+    double get_time_budget(void) const;
+
+    /**
+    *
+    * @brief    Returns callback that is called after each iteration.
+    *
+    */
+    const progress_callback & get_progress_callback(void) const;
+};
+
+
+/**
+*
+* @brief    Tracks one call of an algorithm against its execution control.
+* @details  Monitor is created at the beginning of processing, the clock is read only if time
+*           budget is specified.
+*
+*/
+class execution_monitor {
+private:
+    using clock = std::chrono::steady_clock;
+
+private:
+    const execution_control &   m_control;
+    clock::time_point           m_start;
+    std::size_t                 m_iterations    = 0;
+    execution_status            m_status        = execution_status::COMPLETED;
+
+public:
+    /**
+    *
+    * @brief    Starts tracking of processing.
+    *
+    * @param[in] p_control: limits and observers of processing, it should live longer than monitor.
+    *
+    */
+    explicit execution_monitor(const execution_control & p_control);
+
+    execution_monitor(const execution_monitor & p_other) = delete;
+
+public:
+    /**
+    *
+    * @brief    Checks whether next iteration can be performed.
+    * @details  If processing has been cancelled or budget is exhausted then status of the
+    *           monitor is updated with the reason and processing should be stopped.
+    *
+    * @return   Returns 'true' if processing can be continued.
+    *
+    */
+    bool can_continue(void);
+
+    /**
+    *
+    * @brief    Registers finished iteration and reports progress to the callback.
+    *
+    * @param[in] p_value: algorithm specific measure of convergence that is passed to progress callback.
+    *
+    */
+    void next_iteration(const double p_value);
+
+    /**
+    *
+    * @brief    Returns 'true' if processing should be stopped due to cancellation or budget.
+    *
+    */
+    inline bool is_stopped(void) const { return m_status != execution_status::COMPLETED; }
+
+    /**
+    *
+    * @brief    Returns amount of registered iterations.
+    *
+    */
+    inline std::size_t get_iterations(void) const { return m_iterations; }
+
+    /**
+    *
+    * @brief    Returns status of processing, 'COMPLETED' if processing has not been stopped.
+    *
+    */
+    inline execution_status get_status(void) const { return m_status; }
+
+public:
+    execution_monitor & operator=(const execution_monitor & p_other) = delete;
+};
+
+
+}
+
+
+#endif
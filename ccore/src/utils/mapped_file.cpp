@@ -0,0 +1,141 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#include "utils/mapped_file.hpp"
+
+#include <stdexcept>
+
+#if defined(__unix__)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#elif defined(_WIN32)
+    #include <windows.h>
+#endif
+
+
+namespace utils {
+
+
+#if defined(__unix__)
+
+mapped_file::mapped_file(const std::string & p_path) {
+    const int descriptor = ::open(p_path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        throw std::runtime_error("CCORE [mapped_file]: file '" + p_path + "' can not be opened.");
+    }
+
+    struct stat file_status;
+    if (::fstat(descriptor, &file_status) != 0) {
+        ::close(descriptor);
+        throw std::runtime_error("CCORE [mapped_file]: size of file '" + p_path + "' can not be obtained.");
+    }
+
+    m_length = (std::size_t) file_status.st_size;
+    if (m_length > 0) {
+        m_address = ::mmap(nullptr, m_length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (m_address == MAP_FAILED) {
+            m_address = nullptr;
+            m_length = 0;
+        }
+    }
+
+    ::close(descriptor);    /* mapping keeps reference to the file */
+
+    if ((m_address == nullptr) && (file_status.st_size > 0)) {
+        throw std::runtime_error("CCORE [mapped_file]: file '" + p_path + "' can not be mapped to memory.");
+    }
+}
+
+
+void mapped_file::unmap(void) {
+    if (m_address != nullptr) {
+        ::munmap(m_address, m_length);
+    }
+
+    m_address = nullptr;
+    m_length = 0;
+}
+
+#elif defined(_WIN32)
+
+mapped_file::mapped_file(const std::string & p_path) {
+    HANDLE file = ::CreateFileA(p_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("CCORE [mapped_file]: file '" + p_path + "' can not be opened.");
+    }
+
+    LARGE_INTEGER file_size;
+    if (!::GetFileSizeEx(file, &file_size)) {
+        ::CloseHandle(file);
+        throw std::runtime_error("CCORE [mapped_file]: size of file '" + p_path + "' can not be obtained.");
+    }
+
+    m_length = (std::size_t) file_size.QuadPart;
+    if (m_length > 0) {
+        m_mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (m_mapping != nullptr) {
+            m_address = ::MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+        }
+    }
+
+    ::CloseHandle(file);    /* mapping keeps reference to the file */
+
+    if ((m_address == nullptr) && (m_length > 0)) {
+        unmap();
+        throw std::runtime_error("CCORE [mapped_file]: file '" + p_path + "' can not be mapped to memory.");
+    }
+}
+
+
+void mapped_file::unmap(void) {
+    if (m_address != nullptr) {
+        ::UnmapViewOfFile(m_address);
+    }
+
+    if (m_mapping != nullptr) {
+        ::CloseHandle(m_mapping);
+    }
+
+    m_address = nullptr;
+    m_mapping = nullptr;
+    m_length = 0;
+}
+
+#endif
+
+
+mapped_file::~mapped_file(void) {
+    unmap();
+}
+
+
+bool mapped_file::contains(const std::uint64_t p_offset, const std::uint64_t p_rows, const std::uint64_t p_columns, const std::size_t p_element_size) const {
+    if (p_offset > m_length) {
+        return false;
+    }
+
+    const std::uint64_t capacity = (m_length - p_offset) / p_element_size;
+    return (p_rows == 0) || (p_columns == 0) || ((p_columns <= capacity / p_rows) && (p_rows * p_columns <= capacity));
+}
+
+
+}
@@ -0,0 +1,109 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#ifndef SRC_UTILS_MAPPED_FILE_HPP_
+#define SRC_UTILS_MAPPED_FILE_HPP_
+
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+
+namespace utils {
+
+
+/**
+*
+* @brief    Read-only mapping of whole file to memory.
+* @details  Pages of the file are loaded by operating system on the first access and they are shared
+*           between processes that map the same file. Mapping is valid while the object is alive.
+*
+*/
+class mapped_file {
+private:
+    void            * m_address = nullptr;
+    std::size_t     m_length    = 0;
+
+#if defined(_WIN32)
+    void            * m_mapping = nullptr;
+#endif
+
+public:
+    /**
+    *
+    * @brief    Maps the file to memory.
+    * @details  Exception 'std::runtime_error' is thrown if the file can not be opened or mapped.
+    *
+    * @param[in] p_path: path to the file.
+    *
+    */
+    explicit mapped_file(const std::string & p_path);
+
+    mapped_file(const mapped_file & p_other) = delete;
+
+    /**
+    *
+    * @brief    Unmaps the file, pointers to its memory become invalid.
+    *
+    */
+    ~mapped_file(void);
+
+public:
+    /**
+    *
+    * @brief    Returns pointer to the first byte of the mapped file, it is aligned to page size.
+    *
+    */
+    inline const char * data(void) const { return static_cast<const char *>(m_address); }
+
+    /**
+    *
+    * @brief    Returns length of the mapped file in bytes.
+    *
+    */
+    inline std::size_t length(void) const { return m_length; }
+
+    /**
+    *
+    * @brief    Checks that array of 'p_rows * p_columns' elements that starts from the specified
+    *           offset is entirely inside the file.
+    * @details  Values are read from file header, so they are checked without overflow of products.
+    *
+    * @param[in] p_offset: position of the first element in bytes from the beginning of the file.
+    * @param[in] p_rows: amount of rows of the array.
+    * @param[in] p_columns: amount of elements in each row.
+    * @param[in] p_element_size: size of each element in bytes.
+    *
+    */
+    bool contains(const std::uint64_t p_offset, const std::uint64_t p_rows, const std::uint64_t p_columns, const std::size_t p_element_size) const;
+
+public:
+    mapped_file & operator=(const mapped_file & p_other) = delete;
+
+private:
+    void unmap(void);
+};
+
+
+}
+
+
+#endif
@@ -0,0 +1,371 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#ifndef SRC_UTILS_METRIC_HPP_
+#define SRC_UTILS_METRIC_HPP_
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+
+#include "definitions.hpp"
+
+#include "utils/distance_kernel.hpp"
+
+
+namespace utils {
+
+namespace metric {
+
+
+/**
+*
+* @brief    Metrics that can be chosen at runtime (for example, through C interface).
+*
+*/
+enum class type_metric {
+    EUCLIDEAN = 0,
+    EUCLIDEAN_SQUARE,
+    MANHATTAN,
+    CHEBYSHEV,
+    MINKOWSKI,
+    COSINE
+};
+
+
+/**
+*
+* @brief    Base class of metric policies that provides block form of comparable distance.
+* @details  Each metric policy provides following methods:
+*           - 'distance' - distance between two points;
+*           - 'comparable_distance' - monotonic function of the distance that is cheaper to
+*             calculate (for example, square of Euclidean distance), it should be used to compare
+*             distances between each other;
+*           - 'to_comparable' / 'from_comparable' - converts distance (for example, radius) to
+*             comparable form and back;
+*           - 'comparable_axis_bound' - lower bound of comparable distance between two points
+*             that is obtained using difference of one coordinate only (used by spatial trees to
+*             prune branches);
+*           - 'comparable_block' - comparable distance from point to each point of the block;
+*           - 'TYPE' - runtime identifier of the metric;
+*           - 'TRIANGLE_INEQUALITY' - true if distance satisfies triangle inequality, so metric trees
+*             can use it to prune branches.
+*           Methods that take points are templates on type of coordinates (double or float), distances
+*           are returned in double precision except block form that uses type of coordinates.
+*
+*/
+template <typename TypeMetric>
+class metric_base {
+public:
+    /**
+    *
+    * @brief    Calculates comparable distance from the point to each point of the block.
+    *
+    * @param[in]  p_point: pointer to the first coordinate of the point.
+    * @param[in]  p_block: points that are compared with the point.
+    * @param[out] p_result: array with size that is not less than amount of points in the block.
+    *
+    */
+    template <typename TypeValue>
+    inline void comparable_block(const TypeValue * const p_point, const container::dense_matrix_view<TypeValue> & p_block, TypeValue * const p_result) const {
+        const TypeMetric & metric = static_cast<const TypeMetric &>(*this);
+        for (std::size_t index = 0; index < p_block.size(); index++) {
+            p_result[index] = metric.comparable_distance(p_point, p_block[index], p_block.dimension());
+        }
+    }
+};
+
+
+/**
+*
+* @brief    Euclidean distance, comparable form is square of Euclidean distance that is calculated
+*           by SIMD distance kernel.
+*
+*/
+class euclidean : public metric_base<euclidean> {
+public:
+    static constexpr type_metric TYPE = type_metric::EUCLIDEAN;
+
+    static constexpr bool TRIANGLE_INEQUALITY = true;
+
+    template <typename TypeValue>
+    inline double distance(const TypeValue * const p_point1, const TypeValue * const p_point2, const std::size_t p_dimension) const {
+        return std::sqrt(comparable_distance(p_point1, p_point2, p_dimension));
+    }
+
+    template <typename TypeValue>
+    inline double comparable_distance(const TypeValue * const p_point1, const TypeValue * const p_point2, const std::size_t p_dimension) const {
+        return euclidean_distance_square(p_point1, p_point2, p_dimension);
+    }
+
+    template <typename TypeValue>
+    inline void comparable_block(const TypeValue * const p_point, const container::dense_matrix_view<TypeValue> & p_block, TypeValue * const p_result) const {
+        euclidean_distance_square(p_point, p_block, p_result);
+    }
+
+    inline double to_comparable(const double p_distance) const { return p_distance * p_distance; }
+
+    inline double from_comparable(const double p_distance) const { return std::sqrt(p_distance); }
+
+    inline double comparable_axis_bound(const double p_difference) const { return p_difference * p_difference; }
+};
+
+
+/**
+*
+* @brief    Square of Euclidean distance.
+*
+*/
+class euclidean_square : public metric_base<euclidean_square> {
+public:
+    static constexpr type_metric TYPE = type_metric::EUCLIDEAN_SQUARE;
+
+    static constexpr bool TRIANGLE_INEQUALITY = false;
+
+    template <typename TypeValue>
+    inline double distance(const TypeValue * const p_point1, const TypeValue * const p_point2, const std::size_t p_dimension) const {
+        return euclidean_distance_square(p_point1, p_point2, p_dimension);
+    }
+
+    template <typename TypeValue>
+    inline double comparable_distance(const TypeValue * const p_point1, const TypeValue * const p_point2, const std::size_t p_dimension) const {
+        return euclidean_distance_square(p_point1, p_point2, p_dimension);
+    }
+
+    template <typename TypeValue>
+    inline void comparable_block(const TypeValue * const p_point, const container::dense_matrix_view<TypeValue> & p_block, TypeValue * const p_result) const {
+        euclidean_distance_square(p_point, p_block, p_result);
+    }
+
+    inline double to_comparable(const double p_distance) const { return p_distance; }
+
+    inline double from_comparable(const double p_distance) const { return p_distance; }
+
+    inline double comparable_axis_bound(const double p_difference) const { return p_difference * p_difference; }
+};
+
+
+/**
+*
+* @brief    Manhattan distance (L1 norm).
+*
+*/
+class manhattan : public metric_base<manhattan> {
+public:
+    static constexpr type_metric TYPE = type_metric::MANHATTAN;
+
+    static constexpr bool TRIANGLE_INEQUALITY = true;
+
+    template <typename TypeValue>
+    inline double distance(const TypeValue * const p_point1, const TypeValue * const p_point2, const std::size_t p_dimension) const {
+        double distance = 0.0;
+        for (std::size_t index = 0; index < p_dimension; index++) {
+            distance += std::abs(static_cast<double>(p_point1[index]) - static_cast<double>(p_point2[index]));
+        }
+
+        return distance;
+    }
+
+    template <typename TypeValue>
+    inline double comparable_distance(const TypeValue * const p_point1, const TypeValue * const p_point2, const std::size_t p_dimension) const {
+        return distance(p_point1, p_point2, p_dimension);
+    }
+
+    inline double to_comparable(const double p_distance) const { return p_distance; }
+
+    inline double from_comparable(const double p_distance) const { return p_distance; }
+
+    inline double comparable_axis_bound(const double p_difference) const { return std::abs(p_difference); }
+};
+
+
+/**
+*
+* @brief    Chebyshev distance (maximum coordinate difference).
+*
+*/
+class chebyshev : public metric_base<chebyshev> {
+public:
+    static constexpr type_metric TYPE = type_metric::CHEBYSHEV;
+
+    static constexpr bool TRIANGLE_INEQUALITY = true;
+
+    template <typename TypeValue>
+    inline double distance(const TypeValue * const p_point1, const TypeValue * const p_point2, const std::size_t p_dimension) const {
+        double distance = 0.0;
+        for (std::size_t index = 0; index < p_dimension; index++) {
+            distance = std::max(distance, std::abs(static_cast<double>(p_point1[index]) - static_cast<double>(p_point2[index])));
+        }
+
+        return distance;
+    }
+
+    template <typename TypeValue>
+    inline double comparable_distance(const TypeValue * const p_point1, const TypeValue * const p_point2, const std::size_t p_dimension) const {
+        return distance(p_point1, p_point2, p_dimension);
+    }
+
+    inline double to_comparable(const double p_distance) const { return p_distance; }
+
+    inline double from_comparable(const double p_distance) const { return p_distance; }
+
+    inline double comparable_axis_bound(const double p_difference) const { return std::abs(p_difference); }
+};
+
+
+/**
+*
+* @brief    Minkowski distance with degree 'p', comparable form is sum of coordinate differences in
+*           power 'p' (without root).
+*
+*/
+class minkowski : public metric_base<minkowski> {
+public:
+    static constexpr type_metric TYPE = type_metric::MINKOWSKI;
+
+    static constexpr bool TRIANGLE_INEQUALITY = true;     /* degree is not less than 1 */
+
+private:
+    double m_degree = 2.0;
+
+public:
+    /**
+    *
+    * @brief    Creates Minkowski metric with specified degree.
+    *
+    * @param[in] p_degree: degree of the metric, it should be not less than 1.
+    *
+    */
+    explicit minkowski(const double p_degree = 2.0) : m_degree(p_degree) {
+        if (p_degree < 1.0) {
+            throw std::invalid_argument("CCORE [minkowski]: degree of the metric can not be less than 1.");
+        }
+    }
+
+public:
+    inline double get_degree(void) const { return m_degree; }
+
+    template <typename TypeValue>
+    inline double distance(const TypeValue * const p_point1, const TypeValue * const p_point2, const std::size_t p_dimension) const {
+        return from_comparable(comparable_distance(p_point1, p_point2, p_dimension));
+    }
+
+    template <typename TypeValue>
+    inline double comparable_distance(const TypeValue * const p_point1, const TypeValue * const p_point2, const std::size_t p_dimension) const {
+        double distance = 0.0;
+        for (std::size_t index = 0; index < p_dimension; index++) {
+            distance += std::pow(std::abs(static_cast<double>(p_point1[index]) - static_cast<double>(p_point2[index])), m_degree);
+        }
+
+        return distance;
+    }
+
+    inline double to_comparable(const double p_distance) const { return std::pow(p_distance, m_degree); }
+
+    inline double from_comparable(const double p_distance) const { return std::pow(p_distance, 1.0 / m_degree); }
+
+    inline double comparable_axis_bound(const double p_difference) const { return std::pow(std::abs(p_difference), m_degree); }
+};
+
+
+/**
+*
+* @brief    Cosine distance (1 - cosine similarity), it is equal to 1 if one of points is zero vector.
+* @details  It is not a metric in the strict sense, therefore spatial trees can not prune their
+*           branches using it (lower bound by one coordinate is always zero).
+*
+*/
+class cosine : public metric_base<cosine> {
+public:
+    static constexpr type_metric TYPE = type_metric::COSINE;
+
+    static constexpr bool TRIANGLE_INEQUALITY = false;
+
+    template <typename TypeValue>
+    inline double distance(const TypeValue * const p_point1, const TypeValue * const p_point2, const std::size_t p_dimension) const {
+        double product = 0.0, norm1 = 0.0, norm2 = 0.0;
+        for (std::size_t index = 0; index < p_dimension; index++) {
+            const double value1 = p_point1[index], value2 = p_point2[index];
+            product += value1 * value2;
+            norm1 += value1 * value1;
+            norm2 += value2 * value2;
+        }
+
+        if ((norm1 == 0.0) || (norm2 == 0.0)) {
+            return 1.0;
+        }
+
+        return 1.0 - product / std::sqrt(norm1 * norm2);
+    }
+
+    template <typename TypeValue>
+    inline double comparable_distance(const TypeValue * const p_point1, const TypeValue * const p_point2, const std::size_t p_dimension) const {
+        return distance(p_point1, p_point2, p_dimension);
+    }
+
+    inline double to_comparable(const double p_distance) const { return p_distance; }
+
+    inline double from_comparable(const double p_distance) const { return p_distance; }
+
+    inline double comparable_axis_bound(const double) const { return 0.0; }
+};
+
+
+/**
+*
+* @brief    Creates metric of specified type and passes it to the functor, in other words converts
+*           runtime choice of metric to compile-time policy.
+*
+* @param[in] p_type: type of metric.
+* @param[in] p_degree: degree that is used by Minkowski metric only.
+* @param[in] p_functor: generic callable object that is called with instance of metric policy.
+*
+* @return   Returns value that is returned by the functor.
+*
+*/
+template <typename TypeFunctor>
+auto dispatch(const type_metric p_type, const double p_degree, TypeFunctor && p_functor) -> decltype(p_functor(euclidean())) {
+    switch(p_type) {
+    case type_metric::EUCLIDEAN:
+        return p_functor(euclidean());
+    case type_metric::EUCLIDEAN_SQUARE:
+        return p_functor(euclidean_square());
+    case type_metric::MANHATTAN:
+        return p_functor(manhattan());
+    case type_metric::CHEBYSHEV:
+        return p_functor(chebyshev());
+    case type_metric::MINKOWSKI:
+        return p_functor(minkowski(p_degree));
+    case type_metric::COSINE:
+        return p_functor(cosine());
+    default:
+        throw std::invalid_argument("CCORE [metric]: unknown type of metric.");
+    }
+}
+
+
+}
+
+}
+
+
+#endif
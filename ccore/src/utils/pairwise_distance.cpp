@@ -0,0 +1,266 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#include "utils/pairwise_distance.hpp"
+
+#include <functional>
+#include <stdexcept>
+
+
+namespace utils {
+
+
+/* sizes of tiles: rows and columns of the result that are calculated by one task and amount of coordinates that are kept in cache */
+static const std::size_t TILE_ROWS = 64;
+static const std::size_t TILE_COLUMNS = 256;
+static const std::size_t TILE_DEPTH = 256;
+
+
+/**
+*
+* @brief    Copies points to the dense buffer subtracting the center from each of them and returns
+*           view to the copy.
+*
+*/
+static dataset_view center_points(const dataset_view & p_data, const std::vector<double> & p_center, std::vector<double> & p_buffer) {
+    const std::size_t dimension = p_data.dimension();
+
+    p_buffer.resize(p_data.size() * dimension);
+    parallel::parallel_for(std::size_t(0), p_data.size(), [&](const std::size_t p_index) {
+        const double * const point = p_data[p_index];
+        double * const centered = p_buffer.data() + p_index * dimension;
+
+        for (std::size_t index_dimension = 0; index_dimension < dimension; index_dimension++) {
+            centered[index_dimension] = point[index_dimension] - p_center[index_dimension];
+        }
+    });
+
+    return dataset_view(p_buffer.data(), p_data.size(), dimension);
+}
+
+
+/**
+*
+* @brief    Returns position of the first point of rows in columns if rows are consecutive points of
+*           columns, otherwise returns amount of columns.
+*
+*/
+static std::size_t find_subblock(const dataset_view & p_rows, const dataset_view & p_columns) {
+    const std::less_equal<const double *> less_equal;
+    if ((p_rows.stride() != p_columns.stride()) || !less_equal(p_columns.data(), p_rows.data()) ||
+        !less_equal(p_rows.data(), p_columns.data() + p_columns.size() * p_columns.stride()))
+    {
+        return p_columns.size();
+    }
+
+    const std::size_t offset = static_cast<std::size_t>(p_rows.data() - p_columns.data());
+    const std::size_t position = offset / p_columns.stride();
+    if ((offset % p_columns.stride() != 0) || (p_rows.size() > p_columns.size() - position)) {
+        return p_columns.size();
+    }
+
+    return position;
+}
+
+
+static void calculate_norms(const dataset_view & p_data, std::vector<double> & p_norms) {
+    p_norms.resize(p_data.size());
+    parallel::parallel_for(std::size_t(0), p_data.size(), [&p_data, &p_norms](const std::size_t p_index) {
+        const double * const point = p_data[p_index];
+
+        double norm = 0.0;
+        for (std::size_t index_dimension = 0; index_dimension < p_data.dimension(); index_dimension++) {
+            norm += point[index_dimension] * point[index_dimension];
+        }
+
+        p_norms[p_index] = norm;
+    });
+}
+
+
+/**
+*
+* @brief    Adds dot products of rows [p_row_begin, p_row_end) and columns [p_column_begin, p_column_end)
+*           over coordinates [p_depth_begin, p_depth_end) to the result, 4x4 products are kept in
+*           registers while coordinates are iterated.
+*
+*/
+static void multiply_tile(const dataset_view & p_rows, const dataset_view & p_columns,
+                          const std::size_t p_row_begin, const std::size_t p_row_end,
+                          const std::size_t p_column_begin, const std::size_t p_column_end,
+                          const std::size_t p_depth_begin, const std::size_t p_depth_end,
+                          double * const p_result)
+{
+    const std::size_t width = p_columns.size();
+
+    std::size_t i = p_row_begin;
+    for (; i + 4 <= p_row_end; i += 4) {
+        const double * const a0 = p_rows[i], * const a1 = p_rows[i + 1], * const a2 = p_rows[i + 2], * const a3 = p_rows[i + 3];
+
+        std::size_t j = p_column_begin;
+        for (; j + 4 <= p_column_end; j += 4) {
+            const double * const b0 = p_columns[j], * const b1 = p_columns[j + 1], * const b2 = p_columns[j + 2], * const b3 = p_columns[j + 3];
+
+            double c00 = 0.0, c01 = 0.0, c02 = 0.0, c03 = 0.0;
+            double c10 = 0.0, c11 = 0.0, c12 = 0.0, c13 = 0.0;
+            double c20 = 0.0, c21 = 0.0, c22 = 0.0, c23 = 0.0;
+            double c30 = 0.0, c31 = 0.0, c32 = 0.0, c33 = 0.0;
+
+            for (std::size_t k = p_depth_begin; k < p_depth_end; k++) {
+                const double x0 = a0[k], x1 = a1[k], x2 = a2[k], x3 = a3[k];
+                const double y0 = b0[k], y1 = b1[k], y2 = b2[k], y3 = b3[k];
+
+                c00 += x0 * y0; c01 += x0 * y1; c02 += x0 * y2; c03 += x0 * y3;
+                c10 += x1 * y0; c11 += x1 * y1; c12 += x1 * y2; c13 += x1 * y3;
+                c20 += x2 * y0; c21 += x2 * y1; c22 += x2 * y2; c23 += x2 * y3;
+                c30 += x3 * y0; c31 += x3 * y1; c32 += x3 * y2; c33 += x3 * y3;
+            }
+
+            double * const r0 = p_result + i * width + j;
+            double * const r1 = r0 + width;
+            double * const r2 = r1 + width;
+            double * const r3 = r2 + width;
+
+            r0[0] += c00; r0[1] += c01; r0[2] += c02; r0[3] += c03;
+            r1[0] += c10; r1[1] += c11; r1[2] += c12; r1[3] += c13;
+            r2[0] += c20; r2[1] += c21; r2[2] += c22; r2[3] += c23;
+            r3[0] += c30; r3[1] += c31; r3[2] += c32; r3[3] += c33;
+        }
+
+        for (; j < p_column_end; j++) {
+            const double * const b = p_columns[j];
+
+            double c0 = 0.0, c1 = 0.0, c2 = 0.0, c3 = 0.0;
+            for (std::size_t k = p_depth_begin; k < p_depth_end; k++) {
+                c0 += a0[k] * b[k]; c1 += a1[k] * b[k]; c2 += a2[k] * b[k]; c3 += a3[k] * b[k];
+            }
+
+            p_result[i * width + j] += c0;
+            p_result[(i + 1) * width + j] += c1;
+            p_result[(i + 2) * width + j] += c2;
+            p_result[(i + 3) * width + j] += c3;
+        }
+    }
+
+    for (; i < p_row_end; i++) {
+        const double * const a = p_rows[i];
+        for (std::size_t j = p_column_begin; j < p_column_end; j++) {
+            const double * const b = p_columns[j];
+
+            double c = 0.0;
+            for (std::size_t k = p_depth_begin; k < p_depth_end; k++) {
+                c += a[k] * b[k];
+            }
+
+            p_result[i * width + j] += c;
+        }
+    }
+}
+
+
+euclidean_square_columns::euclidean_square_columns(const dataset_view & p_columns) :
+    m_original(p_columns),
+    m_center(p_columns.dimension(), 0.0)
+{
+    if (p_columns.empty()) {
+        return;
+    }
+
+    /* points are moved to the mean of columns, otherwise norms of points that are far from the origin cancel each other out */
+    for (std::size_t index = 0; index < p_columns.size(); index++) {
+        const double * const point = p_columns[index];
+        for (std::size_t index_dimension = 0; index_dimension < p_columns.dimension(); index_dimension++) {
+            m_center[index_dimension] += point[index_dimension];
+        }
+    }
+
+    for (auto & coordinate : m_center) {
+        coordinate /= static_cast<double>(p_columns.size());
+    }
+
+    m_columns = center_points(p_columns, m_center, m_buffer);
+    calculate_norms(m_columns, m_norms);
+}
+
+
+void euclidean_square_columns::calculate(const dataset_view & p_rows, const std::size_t p_column_begin, double * const p_result) const {
+    if (p_rows.dimension() != m_original.dimension()) {
+        throw std::invalid_argument("CCORE [pairwise_distance]: blocks should have the same dimension.");
+    }
+
+    if (p_rows.empty() || (p_column_begin >= m_columns.size())) {
+        return;
+    }
+
+    std::vector<double> row_buffer, row_norms;
+    dataset_view rows;
+    const double * row_norm = nullptr;
+
+    const std::size_t position = find_subblock(p_rows, m_original);
+    if (position < m_columns.size()) {
+        rows = dataset_view(m_columns[position], p_rows.size(), m_columns.dimension());
+        row_norm = m_norms.data() + position;
+    }
+    else {
+        rows = center_points(p_rows, m_center, row_buffer);
+        calculate_norms(rows, row_norms);
+        row_norm = row_norms.data();
+    }
+
+    const dataset_view columns(m_columns[p_column_begin], m_columns.size() - p_column_begin, m_columns.dimension());
+    const double * const column_norm = m_norms.data() + p_column_begin;
+
+    const std::size_t amount_row_tiles = (rows.size() + TILE_ROWS - 1) / TILE_ROWS;
+    const std::size_t amount_column_tiles = (columns.size() + TILE_COLUMNS - 1) / TILE_COLUMNS;
+
+    parallel::parallel_for(std::size_t(0), amount_row_tiles * amount_column_tiles, [&](const std::size_t p_index_tile) {
+        const std::size_t row_begin = (p_index_tile / amount_column_tiles) * TILE_ROWS;
+        const std::size_t row_end = std::min(row_begin + TILE_ROWS, rows.size());
+
+        const std::size_t column_begin = (p_index_tile % amount_column_tiles) * TILE_COLUMNS;
+        const std::size_t column_end = std::min(column_begin + TILE_COLUMNS, columns.size());
+
+        for (std::size_t i = row_begin; i < row_end; i++) {
+            std::fill(p_result + i * columns.size() + column_begin, p_result + i * columns.size() + column_end, 0.0);
+        }
+
+        for (std::size_t depth_begin = 0; depth_begin < rows.dimension(); depth_begin += TILE_DEPTH) {
+            const std::size_t depth_end = std::min(depth_begin + TILE_DEPTH, rows.dimension());
+            multiply_tile(rows, columns, row_begin, row_end, column_begin, column_end, depth_begin, depth_end, p_result);
+        }
+
+        /* sum of norms is calculated first to keep result symmetric for the same blocks */
+        for (std::size_t i = row_begin; i < row_end; i++) {
+            double * const row = p_result + i * columns.size();
+            for (std::size_t j = column_begin; j < column_end; j++) {
+                const double distance = (row_norm[i] + column_norm[j]) - 2.0 * row[j];
+                row[j] = (distance > 0.0) ? distance : 0.0;
+            }
+        }
+    });
+}
+
+
+void euclidean_distance_square_matrix(const dataset_view & p_rows, const dataset_view & p_columns, double * const p_result) {
+    euclidean_square_columns(p_columns).calculate(p_rows, 0, p_result);
+}
+
+
+}
@@ -0,0 +1,369 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#ifndef SRC_UTILS_PAIRWISE_DISTANCE_HPP_
+#define SRC_UTILS_PAIRWISE_DISTANCE_HPP_
+
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "container/condensed_matrix.hpp"
+
+#include "definitions.hpp"
+
+#include "parallel/parallel.hpp"
+
+#include "utils/metric.hpp"
+
+
+namespace utils {
+
+
+/**
+*
+* @brief    Amount of distances that are calculated at once by 'for_each_distance_block', it limits
+*           memory that is used for distances between all points of large data.
+*
+*/
+const std::size_t PAIRWISE_BLOCK_ELEMENTS = std::size_t(1) << 22;
+
+
+/**
+*
+* @brief    Columns of square Euclidean distance matrix that are prepared once for several blocks of
+*           rows.
+* @details  Distances are obtained as ||x||^2 - 2 * x.y + ||y||^2, where dot products are calculated
+*           by cache-blocked matrix multiplication that is distributed between threads of the global
+*           pool. Columns are moved to their mean and their norms are calculated by constructor, so
+*           precision does not depend on distance from the data to the origin. Rows that are
+*           consecutive points of columns reuse moved columns, other rows are moved to the same mean
+*           by each call. Result is symmetric if rows and columns are the same, rounding errors that
+*           make distance negative are clamped to zero.
+*
+*/
+class euclidean_square_columns {
+private:
+    dataset_view            m_original;
+    std::vector<double>     m_center;
+    std::vector<double>     m_buffer;
+    dataset_view            m_columns;
+    std::vector<double>     m_norms;
+
+public:
+    /**
+    *
+    * @brief    Moves columns to their mean and calculates their norms.
+    *
+    * @param[in] p_columns: points that correspond to columns, they should be alive while the object
+    *             is used.
+    *
+    */
+    explicit euclidean_square_columns(const dataset_view & p_columns);
+
+    euclidean_square_columns(const euclidean_square_columns & p_other) = delete;
+
+public:
+    /**
+    *
+    * @brief    Calculates square of Euclidean distance between each point of rows and each column
+    *           starting from the specified one.
+    *
+    * @param[in]  p_rows: points that correspond to rows of the result, they should have the same
+    *              dimension as columns.
+    * @param[in]  p_column_begin: index of the first column that is calculated.
+    * @param[out] p_result: row-major matrix with size 'p_rows.size() * (amount of columns - p_column_begin)'.
+    *
+    */
+    void calculate(const dataset_view & p_rows, const std::size_t p_column_begin, double * const p_result) const;
+
+public:
+    euclidean_square_columns & operator=(const euclidean_square_columns & p_other) = delete;
+};
+
+
+/**
+*
+* @brief    Columns of comparable distance matrix for specified metric that are used for several
+*           blocks of rows.
+* @details  Rows of the result are distributed between threads of the global pool, each row is
+*           calculated by block form of the metric. Euclidean metrics are specialized to use matrix
+*           multiplication.
+*
+*/
+template <typename TypeMetric>
+class comparable_distance_columns {
+private:
+    dataset_view        m_columns;
+    TypeMetric          m_metric;
+
+public:
+    /**
+    *
+    * @brief    Creates columns of distance matrix.
+    *
+    * @param[in] p_columns: points that correspond to columns, they should be alive while the object
+    *             is used.
+    * @param[in] p_metric: metric that is used to calculate distance.
+    *
+    */
+    comparable_distance_columns(const dataset_view & p_columns, const TypeMetric & p_metric) :
+        m_columns(p_columns),
+        m_metric(p_metric)
+    { }
+
+public:
+    /**
+    *
+    * @brief    Calculates comparable distance between each point of rows and each column starting
+    *           from the specified one.
+    *
+    * @param[in]  p_rows: points that correspond to rows of the result, they should have the same
+    *              dimension as columns.
+    * @param[in]  p_column_begin: index of the first column that is calculated.
+    * @param[out] p_result: row-major matrix with size 'p_rows.size() * (amount of columns - p_column_begin)'.
+    *
+    */
+    void calculate(const dataset_view & p_rows, const std::size_t p_column_begin, double * const p_result) const {
+        if (p_rows.dimension() != m_columns.dimension()) {
+            throw std::invalid_argument("CCORE [pairwise_distance]: blocks should have the same dimension.");
+        }
+
+        if (p_column_begin >= m_columns.size()) {
+            return;
+        }
+
+        const dataset_view columns(m_columns[p_column_begin], m_columns.size() - p_column_begin, m_columns.dimension(), m_columns.stride());
+        parallel::parallel_for(std::size_t(0), p_rows.size(), [&](const std::size_t p_index) {
+            m_metric.comparable_block(p_rows[p_index], columns, p_result + p_index * columns.size());
+        });
+    }
+};
+
+
+/**
+*
+* @brief    Columns of comparable distance matrix for Euclidean metric that use matrix multiplication.
+*
+*/
+template <>
+class comparable_distance_columns<metric::euclidean> : public euclidean_square_columns {
+public:
+    comparable_distance_columns(const dataset_view & p_columns, const metric::euclidean &) :
+        euclidean_square_columns(p_columns)
+    { }
+};
+
+
+/**
+*
+* @brief    Columns of comparable distance matrix for square Euclidean metric that use matrix
+*           multiplication.
+*
+*/
+template <>
+class comparable_distance_columns<metric::euclidean_square> : public euclidean_square_columns {
+public:
+    comparable_distance_columns(const dataset_view & p_columns, const metric::euclidean_square &) :
+        euclidean_square_columns(p_columns)
+    { }
+};
+
+
+/**
+*
+* @brief    Calculates square of Euclidean distance between each point of the first block and each
+*           point of the second block.
+* @details  Calculation is described by 'euclidean_square_columns'.
+*
+* @param[in]  p_rows: points that correspond to rows of the result.
+* @param[in]  p_columns: points that correspond to columns of the result, they should have the same
+*              dimension as points of rows.
+* @param[out] p_result: row-major matrix with size 'p_rows.size() * p_columns.size()'.
+*
+*/
+void euclidean_distance_square_matrix(const dataset_view & p_rows, const dataset_view & p_columns, double * const p_result);
+
+
+/**
+*
+* @brief    Calculates comparable distance between each point of the first block and each point of
+*           the second block using specified metric.
+*
+* @param[in]  p_rows: points that correspond to rows of the result.
+* @param[in]  p_columns: points that correspond to columns of the result.
+* @param[in]  p_metric: metric that is used to calculate distance.
+* @param[out] p_result: row-major matrix with size 'p_rows.size() * p_columns.size()'.
+*
+*/
+template <typename TypeMetric>
+void comparable_distance_matrix(const dataset_view & p_rows, const dataset_view & p_columns, const TypeMetric & p_metric, double * const p_result) {
+    comparable_distance_columns<TypeMetric>(p_columns, p_metric).calculate(p_rows, 0, p_result);
+}
+
+
+/**
+*
+* @brief    Calculates distance between each point of the first block and each point of the second
+*           block using specified metric.
+*
+* @param[in]  p_rows: points that correspond to rows of the result.
+* @param[in]  p_columns: points that correspond to columns of the result.
+* @param[in]  p_metric: metric that is used to calculate distance.
+* @param[out] p_result: row-major matrix with size 'p_rows.size() * p_columns.size()'.
+*
+*/
+template <typename TypeMetric>
+void distance_matrix(const dataset_view & p_rows, const dataset_view & p_columns, const TypeMetric & p_metric, double * const p_result) {
+    comparable_distance_matrix(p_rows, p_columns, p_metric, p_result);
+
+    const std::size_t length = p_rows.size() * p_columns.size();
+    for (std::size_t index = 0; index < length; index++) {
+        p_result[index] = p_metric.from_comparable(p_result[index]);
+    }
+}
+
+
+/**
+*
+* @brief    Calculates distances between all points and returns them as square matrix.
+*
+* @param[in] p_data: points for that distances are calculated.
+* @param[in] p_metric: metric that is used to calculate distance.
+*
+* @return   Returns square matrix where element (i, j) is distance between points 'i' and 'j'.
+*
+*/
+template <typename TypeMetric>
+container::dense_matrix<double> distance_matrix(const dataset_view & p_data, const TypeMetric & p_metric) {
+    container::dense_matrix<double> result(p_data.size(), p_data.size());
+    distance_matrix(p_data, p_data, p_metric, result.data());
+
+    for (std::size_t index = 0; index < p_data.size(); index++) {
+        result[index][index] = 0.0;
+    }
+
+    return result;
+}
+
+
+/**
+*
+* @brief    Calculates comparable distances between points block by block, only distances from
+*           points of the block to points starting from the first point of the block are calculated
+*           if it is required.
+* @details  Columns are prepared once for all blocks. If 'p_upper' is 'true' then distances that
+*           are below the diagonal block are not calculated and row width of the block is equal to
+*           amount of points starting from the first point of the block.
+*
+* @param[in] p_data: points for that distances are calculated.
+* @param[in] p_metric: metric that is used to calculate distance.
+* @param[in] p_upper: if 'true' then only upper part of the distance matrix is calculated.
+* @param[in] p_handler: callable object that takes index of the first point of the block, amount
+*             of points in the block and pointer to row-major distances from them.
+*
+*/
+template <typename TypeMetric, typename TypeHandler>
+void for_each_distance_block(const dataset_view & p_data, const TypeMetric & p_metric, const bool p_upper, const TypeHandler & p_handler) {
+    if (p_data.empty()) {
+        return;
+    }
+
+    const comparable_distance_columns<TypeMetric> columns(p_data, p_metric);
+
+    const std::size_t block_size = std::max(std::size_t(1), std::min(p_data.size(), PAIRWISE_BLOCK_ELEMENTS / p_data.size()));
+    std::vector<double> distances(block_size * p_data.size());
+
+    for (std::size_t index_begin = 0; index_begin < p_data.size(); index_begin += block_size) {
+        const std::size_t amount = std::min(block_size, p_data.size() - index_begin);
+        const dataset_view rows(p_data[index_begin], amount, p_data.dimension(), p_data.stride());
+
+        const std::size_t column_begin = p_upper ? index_begin : 0;
+        const std::size_t width = p_data.size() - column_begin;
+
+        columns.calculate(rows, column_begin, distances.data());
+        for (std::size_t index = 0; index < amount; index++) {
+            distances[index * width + index_begin - column_begin + index] = 0.0;
+        }
+
+        p_handler(index_begin, amount, (const double *) distances.data());
+    }
+}
+
+
+/**
+*
+* @brief    Calculates comparable distances between all points block by block and passes each block
+*           of rows to the handler, so the whole matrix is not stored in memory.
+* @details  Each block consists of distances from several consecutive points to all points of the
+*           data, distance from the point to itself is always zero. Blocks are calculated in parallel
+*           and passed to the handler sequentially in order of points.
+*
+* @param[in] p_data: points for that distances are calculated.
+* @param[in] p_metric: metric that is used to calculate distance.
+* @param[in] p_handler: callable object that takes index of the first point of the block, amount
+*             of points in the block and pointer to row-major distances from them to all points.
+*
+*/
+template <typename TypeMetric, typename TypeHandler>
+void for_each_distance_block(const dataset_view & p_data, const TypeMetric & p_metric, const TypeHandler & p_handler) {
+    for_each_distance_block(p_data, p_metric, false, p_handler);
+}
+
+
+/**
+*
+* @brief    Calculates distances between all points and returns them in condensed form, so only
+*           distances between different pairs of points are stored.
+*
+* @param[in] p_data: points for that distances are calculated.
+* @param[in] p_metric: metric that is used to calculate distance.
+*
+* @return   Returns condensed matrix where element (i, j) is distance between points 'i' and 'j',
+*           type of elements 'TypeValue' defines precision of stored distances.
+*
+*/
+template <typename TypeValue = double, typename TypeMetric>
+container::condensed_matrix<TypeValue> condensed_distance_matrix(const dataset_view & p_data, const TypeMetric & p_metric) {
+    container::condensed_matrix<TypeValue> result(p_data.size());
+
+    for_each_distance_block(p_data, p_metric, true, [&](const std::size_t p_begin, const std::size_t p_amount, const double * const p_distances) {
+        const std::size_t width = p_data.size() - p_begin;
+
+        for (std::size_t index = 0; index < p_amount; index++) {
+            const std::size_t index_row = p_begin + index;
+            const double * const distances = p_distances + index * width;
+
+            TypeValue * const row = result.upper_row(index_row);
+            for (std::size_t index_column = index_row + 1; index_column < p_data.size(); index_column++) {
+                row[index_column - index_row - 1] = static_cast<TypeValue>(p_metric.from_comparable(distances[index_column - p_begin]));
+            }
+        }
+    });
+
+    return result;
+}
+
+
+}
+
+
+#endif
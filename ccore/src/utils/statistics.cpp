@@ -0,0 +1,67 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#include "utils/statistics.hpp"
+
+#include <atomic>
+
+
+namespace utils {
+
+
+static std::atomic<bool> statistics_enabled(false);
+
+
+constexpr std::size_t statistics::AMOUNT_COUNTERS;
+
+constexpr std::size_t statistics::AMOUNT_PHASES;
+
+
+void statistics::enable(const bool p_enable) {
+    statistics_enabled = p_enable;
+}
+
+
+bool statistics::is_enabled(void) {
+    return statistics_enabled;
+}
+
+
+statistics_ptr statistics::create(void) {
+    if (statistics_enabled) {
+        return std::make_shared<statistics>();
+    }
+
+    return nullptr;
+}
+
+
+std::size_t statistics::get_counter(const statistic_counter p_counter) const {
+    return m_counters[static_cast<std::size_t>(p_counter)];
+}
+
+
+double statistics::get_time(const statistic_phase p_phase) const {
+    return m_phases[static_cast<std::size_t>(p_phase)];
+}
+
+
+}
@@ -0,0 +1,224 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#ifndef SRC_UTILS_STATISTICS_HPP_
+#define SRC_UTILS_STATISTICS_HPP_
+
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+
+
+namespace utils {
+
+
+/**
+*
+* @brief    Counters that are collected by algorithms during processing.
+*
+*/
+enum class statistic_counter {
+    ITERATIONS = 0,
+    DISTANCE_EVALUATIONS,
+    NEIGHBOR_QUERIES,
+    KDTREE_VISITED_NODES,
+    AMOUNT_COUNTERS
+};
+
+
+/**
+*
+* @brief    Phases of processing whose wall time is measured by algorithms.
+* @details  Phase 'TOTAL' covers the whole call, other phases are filled only by algorithms that
+*           have them.
+*
+*/
+enum class statistic_phase {
+    TOTAL = 0,
+    INITIALIZATION,
+    NEIGHBOR_SEARCH,
+    ASSIGNMENT,
+    UPDATE,
+    EXTRACTION,
+    AMOUNT_PHASES
+};
+
+
+/**
+*
+* @brief    Performance counters and wall time of phases of one call of an algorithm.
+* @details  Statistics is collected only if it is enabled globally by 'statistics::enable()', in
+*           that case algorithm creates statistics object for the call. Otherwise algorithms work
+*           with null pointer to statistics and all functions that update it do nothing, that
+*           does not require even reading of the clock.
+*
+*/
+class statistics {
+public:
+    static constexpr std::size_t AMOUNT_COUNTERS    = static_cast<std::size_t>(statistic_counter::AMOUNT_COUNTERS);
+    static constexpr std::size_t AMOUNT_PHASES      = static_cast<std::size_t>(statistic_phase::AMOUNT_PHASES);
+
+private:
+    std::array<std::size_t, AMOUNT_COUNTERS>    m_counters  = { };
+    std::array<double, AMOUNT_PHASES>           m_phases    = { };
+
+public:
+    /**
+    *
+    * @brief    Enables or disables collecting of statistics by algorithms.
+    * @details  The option is global and it is read by each algorithm once at the beginning of processing.
+    *
+    * @param[in] p_enable: if 'true' then statistics is collected.
+    *
+    */
+    static void enable(const bool p_enable);
+
+    /**
+    *
+    * @brief    Returns 'true' if collecting of statistics is enabled.
+    *
+    */
+    static bool is_enabled(void);
+
+    /**
+    *
+    * @brief    Returns new statistics object if collecting is enabled, otherwise null pointer.
+    *
+    */
+    static std::shared_ptr<statistics> create(void);
+
+public:
+    /**
+    *
+    * @brief    Returns value of the specified counter.
+    *
+    */
+    std::size_t get_counter(const statistic_counter p_counter) const;
+
+    /**
+    *
+    * @brief    Returns wall time of the specified phase in milliseconds.
+    *
+    */
+    double get_time(const statistic_phase p_phase) const;
+
+    /**
+    *
+    * @brief    Increases the specified counter.
+    *
+    * @param[in] p_counter: counter that should be increased.
+    * @param[in] p_value: value that is added to the counter.
+    *
+    */
+    inline void increase(const statistic_counter p_counter, const std::size_t p_value = 1) {
+        m_counters[static_cast<std::size_t>(p_counter)] += p_value;
+    }
+
+    /**
+    *
+    * @brief    Adds time to the specified phase.
+    *
+    * @param[in] p_phase: phase whose time is increased.
+    * @param[in] p_milliseconds: time that is added in milliseconds.
+    *
+    */
+    inline void add_time(const statistic_phase p_phase, const double p_milliseconds) {
+        m_phases[static_cast<std::size_t>(p_phase)] += p_milliseconds;
+    }
+};
+
+
+using statistics_ptr = std::shared_ptr<statistics>;
+
+
+/**
+*
+* @brief    Increases the counter if statistics is collected.
+*
+* @param[in] p_statistics: statistics of the call, it can be null.
+* @param[in] p_counter: counter that should be increased.
+* @param[in] p_value: value that is added to the counter.
+*
+*/
+inline void increase_counter(statistics * const p_statistics, const statistic_counter p_counter, const std::size_t p_value = 1) {
+    if (p_statistics) {
+        p_statistics->increase(p_counter, p_value);
+    }
+}
+
+
+/**
+*
+* @brief    Measures wall time of a scope and adds it to the specified phase of statistics.
+* @details  If statistics is not collected then the clock is not read.
+*
+*/
+class statistics_timer {
+private:
+    using clock = std::chrono::steady_clock;
+
+private:
+    statistics *        m_statistics;
+    statistic_phase     m_phase;
+    clock::time_point   m_start;
+
+public:
+    /**
+    *
+    * @brief    Starts measurement of the phase.
+    *
+    * @param[in] p_statistics: statistics of the call, it can be null.
+    * @param[in] p_phase: phase whose time is measured.
+    *
+    */
+    statistics_timer(statistics * const p_statistics, const statistic_phase p_phase) :
+        m_statistics(p_statistics),
+        m_phase(p_phase)
+    {
+        if (m_statistics) {
+            m_start = clock::now();
+        }
+    }
+
+    statistics_timer(const statistics_timer & p_other) = delete;
+
+    /**
+    *
+    * @brief    Finishes measurement of the phase.
+    *
+    */
+    ~statistics_timer(void) {
+        if (m_statistics) {
+            m_statistics->add_time(m_phase, std::chrono::duration<double, std::milli>(clock::now() - m_start).count());
+        }
+    }
+
+public:
+    statistics_timer & operator=(const statistics_timer & p_other) = delete;
+};
+
+
+}
+
+
+#endif
@@ -22,6 +22,7 @@
 
 #include <fstream>
 #include <sstream>
+#include <algorithm>
 #include <iostream>
 
 
@@ -96,3 +97,19 @@ std::shared_ptr<dataset> simple_sample_factory::create_sample(const SAMPLE_SIMPL
 
     return sample_data;
 }
+
+
+const double padded_sample::PADDING_VALUE = 1000.0;
+
+
+padded_sample::padded_sample(const dataset & p_data, const std::size_t p_padding) {
+    const std::size_t dimension = p_data.empty() ? 0 : p_data[0].size();
+    const std::size_t stride = dimension + p_padding;
+
+    m_storage.assign(p_data.size() * stride, PADDING_VALUE);
+    for (std::size_t index = 0; index < p_data.size(); index++) {
+        std::copy(p_data[index].begin(), p_data[index].end(), m_storage.begin() + index * stride);
+    }
+
+    m_view = dataset_view(m_storage.data(), p_data.size(), dimension, stride);
+}
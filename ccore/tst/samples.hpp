@@ -88,4 +88,41 @@ public:
 };
 
 
+/***********************************************************************************************
+*
+* @brief   Copy of a sample where each point is followed by foreign coordinates that are far from
+*          the sample, it is used to check that algorithms follow stride of the view.
+*
+***********************************************************************************************/
+class padded_sample {
+public:
+    const static double PADDING_VALUE;
+
+private:
+    std::vector<double> m_storage;
+    dataset_view        m_view;
+
+public:
+    /***********************************************************************************************
+    *
+    * @brief   Copies sample to the memory block with padding after each point.
+    *
+    * @param[in] p_data: sample that should be copied.
+    * @param[in] p_padding: amount of foreign coordinates after each point.
+    *
+    ***********************************************************************************************/
+    padded_sample(const dataset & p_data, const std::size_t p_padding);
+
+    padded_sample(const padded_sample & p_other) = delete;
+
+public:
+    /***********************************************************************************************
+    *
+    * @brief   Returns view to the sample, stride of the view is greater than dimension.
+    *
+    ***********************************************************************************************/
+    const dataset_view & view(void) const { return m_view; }
+};
+
+
 #endif
@@ -23,6 +23,7 @@
 
 #include "cluster/agglomerative.hpp"
 #include "samples.hpp"
+#include "utest-cluster.hpp"
 
 #include <algorithm>
 
@@ -179,3 +180,14 @@ TEST(utest_agglomerative, clustering_sampl_simple_03_one_cluster_link_single) {
     std::vector<size_t> expected_clusters_length_2 = {60};
     template_length_process_data(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03), 1, cluster_analysis::type_link::SINGLE_LINK, expected_clusters_length_2);
 }
+
+
+TEST(utest_agglomerative, padded_data_sampl_simple_03_link_average) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+    const padded_sample padded_data(*data, 3);
+
+    cluster_analysis::agglomerative_data result;
+    cluster_analysis::agglomerative(4, cluster_analysis::type_link::AVERAGE_LINK).process(padded_data.view(), result);
+
+    ASSERT_CLUSTER_SIZES(*data, *result.clusters(), { 10, 10, 10, 30 });
+}
@@ -0,0 +1,227 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#include "gtest/gtest.h"
+
+#include "container/ball_tree.hpp"
+
+#include "utest-index.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+using namespace container;
+
+
+static dataset_matrix create_blobs_matrix(const std::size_t p_amount_blobs, const std::size_t p_blob_size, const std::size_t p_dimension) {
+    dataset_matrix matrix(p_amount_blobs * p_blob_size, p_dimension);
+    for (std::size_t i = 0; i < matrix.size(); i++) {
+        const std::size_t index_blob = i % p_amount_blobs;
+        for (std::size_t j = 0; j < p_dimension; j++) {
+            const double center = (j % p_amount_blobs == index_blob) ? 50.0 : 0.0;
+            matrix[i][j] = center + std::sin(double(i * 7 + j * 13)) * 0.5;
+        }
+    }
+
+    return matrix;
+}
+
+
+template <typename TypeMetric>
+static void template_find_radius(const dataset_view & p_data, const double p_radius, const std::size_t p_bucket_size, const TypeMetric & p_metric = TypeMetric()) {
+    const basic_ball_tree<TypeMetric> tree(p_data, p_metric, p_bucket_size);
+    ASSERT_EQ(p_data.size(), tree.size());
+
+    ASSERT_RADIUS_SEARCH(tree, p_data, p_radius, p_metric);
+}
+
+
+template <typename TypeMetric>
+static void template_find_nearest(const dataset_view & p_data, const std::size_t p_amount, const std::size_t p_bucket_size, const TypeMetric & p_metric = TypeMetric()) {
+    const basic_ball_tree<TypeMetric> tree(p_data, p_metric, p_bucket_size);
+    ASSERT_NEAREST_SEARCH(tree, p_data, p_amount, p_metric);
+}
+
+
+TEST(utest_ball_tree, empty) {
+    ball_tree default_tree;
+    ASSERT_EQ(0U, default_tree.size());
+    ASSERT_EQ(0U, default_tree.amount_nodes());
+
+    const dataset_matrix matrix(0, 2);
+    const ball_tree tree(matrix.view());
+    ASSERT_EQ(0U, tree.size());
+
+    const double point[2] = { 0.0, 0.0 };
+    std::vector<std::size_t> indexes = { 1 };
+    std::vector<double> distances = { 1.0 };
+
+    ASSERT_EQ(0U, tree.find_radius(point, 10.0, indexes, distances));
+    ASSERT_TRUE(indexes.empty());
+    ASSERT_TRUE(distances.empty());
+
+    ASSERT_EQ(0U, tree.find_nearest(point, 3, indexes, distances));
+    ASSERT_TRUE(indexes.empty());
+}
+
+
+TEST(utest_ball_tree, unsuitable_metric) {
+    const dataset_matrix matrix = create_random_matrix(10, 3);
+
+    ASSERT_FALSE(basic_ball_tree<utils::metric::euclidean_square>::is_suitable(utils::metric::euclidean_square()));
+    ASSERT_FALSE(basic_ball_tree<utils::metric::cosine>::is_suitable(utils::metric::cosine()));
+    ASSERT_TRUE(basic_ball_tree<utils::metric::chebyshev>::is_suitable(utils::metric::chebyshev()));
+
+    ASSERT_THROW(basic_ball_tree<utils::metric::euclidean_square> tree(matrix.view()), std::invalid_argument);
+    ASSERT_THROW(basic_ball_tree<utils::metric::cosine> tree(matrix.view()), std::invalid_argument);
+}
+
+
+TEST(utest_ball_tree, leaf_buckets) {
+    const dataset_matrix matrix = create_random_matrix(1000, 8);
+
+    const ball_tree tree(matrix.view(), utils::metric::euclidean(), 16);
+    ASSERT_EQ(8U, tree.dimension());
+    ASSERT_GE(tree.amount_nodes(), 2 * (1000 / 16) - 1);
+
+    const ball_tree single_leaf(matrix.view(), utils::metric::euclidean(), 1000);
+    ASSERT_EQ(1U, single_leaf.amount_nodes());
+}
+
+
+TEST(utest_ball_tree, find_radius_euclidean) {
+    const dataset_matrix matrix = create_random_matrix(500, 2);
+
+    template_find_radius<utils::metric::euclidean>(matrix.view(), 0.5, 16);
+    template_find_radius<utils::metric::euclidean>(matrix.view(), 1.5, 32);
+    template_find_radius<utils::metric::euclidean>(matrix.view(), 0.0, 64);
+}
+
+
+TEST(utest_ball_tree, find_radius_high_dimension) {
+    const dataset_matrix matrix = create_random_matrix(400, 64);
+
+    template_find_radius<utils::metric::euclidean>(matrix.view(), 16.0, 16);
+    template_find_radius<utils::metric::manhattan>(matrix.view(), 100.0, 32);
+    template_find_radius<utils::metric::chebyshev>(matrix.view(), 5.0, 1);
+    template_find_radius(matrix.view(), 9.0, 32, utils::metric::minkowski(3.0));
+}
+
+
+TEST(utest_ball_tree, find_nearest_euclidean) {
+    const dataset_matrix matrix = create_random_matrix(500, 2);
+
+    template_find_nearest<utils::metric::euclidean>(matrix.view(), 1, 16);
+    template_find_nearest<utils::metric::euclidean>(matrix.view(), 5, 32);
+    template_find_nearest<utils::metric::euclidean>(matrix.view(), 600, 32);
+}
+
+
+TEST(utest_ball_tree, find_nearest_high_dimension) {
+    const dataset_matrix matrix = create_random_matrix(300, 64);
+
+    template_find_nearest<utils::metric::euclidean>(matrix.view(), 4, 16);
+    template_find_nearest<utils::metric::manhattan>(matrix.view(), 3, 16);
+    template_find_nearest<utils::metric::chebyshev>(matrix.view(), 7, 64);
+    template_find_nearest(matrix.view(), 5, 8, utils::metric::minkowski(3.0));
+}
+
+
+TEST(utest_ball_tree, duplicated_points) {
+    dataset_matrix matrix(300, 20);
+    for (std::size_t i = 0; i < matrix.size(); i++) {
+        for (std::size_t j = 0; j < matrix.dimension(); j++) {
+            matrix[i][j] = double((i + j) % 3);
+        }
+    }
+
+    template_find_radius<utils::metric::euclidean>(matrix.view(), 0.0, 16);
+    template_find_radius<utils::metric::euclidean>(matrix.view(), 1.0, 16);
+    template_find_nearest<utils::metric::euclidean>(matrix.view(), 4, 16);
+}
+
+
+TEST(utest_ball_tree, pruning_high_dimension) {
+    const dataset_matrix matrix = create_blobs_matrix(8, 128, 64);
+    const ball_tree tree(matrix.view());
+
+    std::vector<std::size_t> indexes;
+    std::vector<double> distances;
+
+    const std::size_t calculated_distances = tree.find_radius(matrix[0], utils::metric::euclidean().to_comparable(10.0), indexes, distances);
+    ASSERT_EQ(128U, indexes.size());
+    ASSERT_LT(calculated_distances, matrix.size());
+
+    const std::size_t calculated_nearest = tree.find_nearest(matrix[1], 5, indexes, distances);
+    ASSERT_EQ(5U, indexes.size());
+    ASSERT_LT(calculated_nearest, matrix.size());
+}
+
+
+TEST(utest_ball_tree, batch_find_radius) {
+    const dataset_matrix matrix = create_random_matrix(1000, 32);
+    const dataset_matrix queries = create_random_matrix(300, 32);
+
+    const basic_ball_tree<utils::metric::manhattan> tree(matrix.view());
+    const double radius = 60.0;
+
+    const neighbor_lists result = tree.find_radius(queries.view(), radius);
+    ASSERT_EQ(queries.size(), result.size());
+    ASSERT_EQ(queries.size() + 1, result.offsets().size());
+
+    std::size_t total = 0;
+    std::vector<std::size_t> indexes;
+    std::vector<double> distances;
+
+    for (std::size_t i = 0; i < queries.size(); i++) {
+        tree.find_radius(queries[i], radius, indexes, distances);
+
+        ASSERT_EQ(indexes, std::vector<std::size_t>(result.begin_neighbors(i), result.end_neighbors(i)));
+        ASSERT_EQ(distances, std::vector<double>(result.begin_distances(i), result.begin_distances(i) + result.amount(i)));
+
+        total += indexes.size();
+    }
+
+    ASSERT_EQ(total, result.total());
+}
+
+
+TEST(utest_ball_tree, batch_find_nearest) {
+    const dataset_matrix matrix = create_random_matrix(1000, 32);
+    const ball_tree tree(matrix.view(), utils::metric::euclidean(), 16);
+
+    const neighbor_lists result = tree.find_nearest(matrix.view(), 6);
+    ASSERT_EQ(matrix.size(), result.size());
+    ASSERT_EQ(matrix.size() * 6, result.total());
+
+    std::vector<std::size_t> indexes;
+    std::vector<double> distances;
+
+    for (std::size_t i = 0; i < matrix.size(); i++) {
+        tree.find_nearest(matrix[i], 6, indexes, distances);
+
+        ASSERT_EQ(indexes, std::vector<std::size_t>(result.begin_neighbors(i), result.end_neighbors(i)));
+        ASSERT_EQ(0.0, result.begin_distances(i)[0]);
+    }
+}
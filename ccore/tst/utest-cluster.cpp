@@ -20,6 +20,7 @@
 
 #include "utest-cluster.hpp"
 
+#include <cmath>
 #include <numeric>
 
 
@@ -64,3 +65,30 @@ void ASSERT_CLUSTER_SIZES(const dataset & p_data, const cluster_sequence & p_act
         ASSERT_EQ(p_data.size(), total_size);
     }
 }
+
+
+dataset_matrix_f32 create_matrix_f32(const dataset & p_data) {
+    dataset_matrix_f32 matrix(p_data.size(), p_data.empty() ? 0 : p_data[0].size());
+    for (size_t index = 0; index < p_data.size(); index++) {
+        std::copy(p_data[index].begin(), p_data[index].end(), matrix[index]);
+    }
+
+    return matrix;
+}
+
+
+dataset create_separated_blobs(const size_t p_amount_blobs, const size_t p_blob_size, const size_t p_dimension) {
+    dataset data;
+    data.reserve(p_amount_blobs * p_blob_size);
+
+    for (size_t index = 0; index < p_amount_blobs * p_blob_size; index++) {
+        const double center = double(index % p_amount_blobs) * 100.0;
+        data.push_back({ center + std::sin(double(index)) * 2.0, std::cos(double(index) * 1.3) * 2.0 });
+
+        for (size_t index_dimension = 2; index_dimension < p_dimension; index_dimension++) {
+            data.back().push_back(std::sin(double(index * index_dimension)) * 0.01);
+        }
+    }
+
+    return data;
+}
@@ -51,4 +51,27 @@ void ASSERT_CLUSTER_SIZES(const dataset & p_data,
         const std::vector<size_t> & p_expected_cluster_length);
 
 
+/***********************************************************************************************
+*
+* @brief    Converts input data to contiguous block with single precision coordinates.
+*
+* @param[in] p_data: data that should be converted.
+*
+***********************************************************************************************/
+dataset_matrix_f32 create_matrix_f32(const dataset & p_data);
+
+
+/***********************************************************************************************
+*
+* @brief    Creates data with well separated blobs of points, point with index 'i' belongs to blob
+*           'i % p_amount_blobs', blobs are separated by the first two coordinates.
+*
+* @param[in] p_amount_blobs: amount of blobs.
+* @param[in] p_blob_size: amount of points in each blob.
+* @param[in] p_dimension: amount of coordinates, others than the first two are small noise.
+*
+***********************************************************************************************/
+dataset create_separated_blobs(const size_t p_amount_blobs, const size_t p_blob_size, const size_t p_dimension = 2);
+
+
 #endif
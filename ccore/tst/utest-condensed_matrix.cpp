@@ -0,0 +1,157 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#include "gtest/gtest.h"
+
+#include "container/condensed_matrix.hpp"
+
+#include "utils/pairwise_distance.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+
+using namespace container;
+
+
+TEST(utest_condensed_matrix, create_empty) {
+    condensed_matrix<double> matrix;
+    ASSERT_EQ(0U, matrix.size());
+    ASSERT_EQ(0U, matrix.elements());
+    ASSERT_TRUE(matrix.empty());
+
+    condensed_matrix<double> zero_matrix(0);
+    ASSERT_EQ(0U, zero_matrix.elements());
+}
+
+
+TEST(utest_condensed_matrix, create_one_element) {
+    condensed_matrix<double> matrix(1, 3.0, 7.0);
+    ASSERT_EQ(1U, matrix.size());
+    ASSERT_EQ(0U, matrix.elements());
+    ASSERT_EQ(7.0, matrix(0, 0));
+}
+
+
+TEST(utest_condensed_matrix, create_with_value) {
+    condensed_matrix<float> matrix(6, 2.5f);
+    ASSERT_EQ(15U, matrix.elements());
+
+    for (std::size_t i = 0; i < matrix.size(); i++) {
+        for (std::size_t j = 0; j < matrix.size(); j++) {
+            ASSERT_EQ((i == j) ? 0.0f : 2.5f, matrix(i, j));
+        }
+    }
+}
+
+
+TEST(utest_condensed_matrix, set_get_symmetric) {
+    const std::size_t size = 9;
+    condensed_matrix<double> matrix(size);
+
+    for (std::size_t i = 0; i < size; i++) {
+        for (std::size_t j = i + 1; j < size; j++) {
+            matrix.set(j, i, (double) (i * size + j));
+        }
+    }
+
+    for (std::size_t i = 0; i < size; i++) {
+        for (std::size_t j = i + 1; j < size; j++) {
+            ASSERT_EQ((double) (i * size + j), matrix.get(i, j));
+            ASSERT_EQ((double) (i * size + j), matrix.get(j, i));
+        }
+    }
+
+    ASSERT_THROW(matrix.set(3, 3, 1.0), std::invalid_argument);
+}
+
+
+TEST(utest_condensed_matrix, upper_row_is_contiguous) {
+    const std::size_t size = 7;
+    condensed_matrix<double> matrix(size);
+
+    for (std::size_t i = 0; i < size; i++) {
+        for (std::size_t j = i + 1; j < size; j++) {
+            matrix.set(i, j, (double) (10 * i + j));
+        }
+    }
+
+    for (std::size_t i = 0; i < size; i++) {
+        const double * row = matrix.upper_row(i);
+        for (std::size_t j = i + 1; j < size; j++) {
+            ASSERT_EQ((double) (10 * i + j), row[j - i - 1]);
+        }
+    }
+}
+
+
+TEST(utest_condensed_matrix, row_iteration) {
+    const std::size_t size = 8;
+    condensed_matrix<double> matrix(size, 0.0, -1.0);
+
+    for (std::size_t i = 0; i < size; i++) {
+        for (std::size_t j = i + 1; j < size; j++) {
+            matrix.set(i, j, (double) (i + j * j));
+        }
+    }
+
+    for (std::size_t i = 0; i < size; i++) {
+        std::vector<std::size_t> columns;
+        matrix.for_each_in_row(i, [&](const std::size_t p_column, const double p_value) {
+            columns.push_back(p_column);
+            ASSERT_EQ(matrix.get(i, p_column), p_value);
+        });
+
+        ASSERT_EQ(size - 1, columns.size());
+        for (std::size_t k = 0; k < columns.size(); k++) {
+            ASSERT_EQ((k < i) ? k : k + 1, columns[k]);
+        }
+
+        std::vector<double> row(size, 100.0);
+        matrix.get_row(i, row.data());
+        for (std::size_t j = 0; j < size; j++) {
+            ASSERT_EQ(matrix.get(i, j), row[j]);
+        }
+    }
+}
+
+
+TEST(utest_condensed_matrix, distance_matrix) {
+    dataset_matrix points(23, 3);
+    for (std::size_t i = 0; i < points.size(); i++) {
+        for (std::size_t j = 0; j < points.dimension(); j++) {
+            points[i][j] = std::sin(1.3 * i + 0.7 * j);
+        }
+    }
+
+    const condensed_matrix<double> distances = utils::condensed_distance_matrix(points.view(), utils::metric::euclidean());
+    const condensed_matrix<float> distances_f32 = utils::condensed_distance_matrix<float>(points.view(), utils::metric::manhattan());
+
+    for (std::size_t i = 0; i < points.size(); i++) {
+        for (std::size_t j = 0; j < points.size(); j++) {
+            const double expected = utils::metric::euclidean().distance(points[i], points[j], points.dimension());
+            ASSERT_NEAR(expected, distances(i, j), 1e-9);
+
+            const double expected_manhattan = utils::metric::manhattan().distance(points[i], points[j], points.dimension());
+            ASSERT_NEAR(expected_manhattan, distances_f32(i, j), 1e-5);
+        }
+    }
+}
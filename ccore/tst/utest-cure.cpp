@@ -117,3 +117,34 @@ TEST(utest_cure, allocation_sample_simple_08) {
     const std::vector<size_t> expected_clusters_length = { 15, 30, 20, 80 };
     template_length_process_data(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_08), 4, 5, 0.5, expected_clusters_length);
 }
+
+
+TEST(utest_cure, padded_data_sample_simple_03) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+    const padded_sample padded_data(*data, 3);
+
+    cure_data result;
+    cure(4, 5, 0.5).process(padded_data.view(), result);
+
+    ASSERT_CLUSTER_SIZES(*data, *result.clusters(), { 10, 10, 10, 30 });
+}
+
+
+TEST(utest_cure, static_kdtree_separated_blobs) {
+    const dataset data = create_separated_blobs(3, 100);
+    const dataset_matrix matrix_data(data);
+
+    cure_data result;
+    cure(3, 5, 0.5).process(matrix_data.view(), result);
+    ASSERT_CLUSTER_SIZES(data, *result.clusters(), { 100, 100, 100 });
+}
+
+
+TEST(utest_cure, ball_tree_separated_blobs) {
+    const dataset data = create_separated_blobs(3, 100, 24);
+    const dataset_matrix matrix_data(data);
+
+    cure_data result;
+    cure(3, 5, 0.5).process(matrix_data.view(), result);
+    ASSERT_CLUSTER_SIZES(data, *result.clusters(), { 100, 100, 100 });
+}
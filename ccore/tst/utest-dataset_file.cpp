@@ -0,0 +1,264 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+
+#include "gtest/gtest.h"
+
+#include "cluster/dbscan.hpp"
+
+#include "interface/dataset_file_interface.h"
+#include "interface/dbscan_interface.h"
+
+#include "utils/dataset_file.hpp"
+
+#include "samples.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+
+using namespace utils;
+
+
+static const char * const UTEST_DATASET_FILE = "utest-dataset_file.bin";
+
+
+static void template_write_read(const dataset & p_data, const std::size_t p_stride) {
+    const dataset_matrix matrix(p_data);
+    dataset_file::write(UTEST_DATASET_FILE, matrix.view(), p_stride);
+
+    {
+        dataset_file file(UTEST_DATASET_FILE);
+
+        ASSERT_EQ(p_data.size(), file.size());
+        ASSERT_EQ(matrix.dimension(), file.dimension());
+        ASSERT_EQ((p_stride == 0) ? matrix.dimension() : p_stride, file.view().stride());
+        ASSERT_EQ(0U, reinterpret_cast<std::uintptr_t>(file.view().data()) % sizeof(double));
+
+        for (std::size_t index = 0; index < p_data.size(); index++) {
+            point actual_point;
+            file.view().get_point(index, actual_point);
+
+            ASSERT_EQ(p_data[index], actual_point);
+        }
+    }
+
+    std::remove(UTEST_DATASET_FILE);
+}
+
+
+TEST(utest_dataset_file, write_read_dense) {
+    template_write_read(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03), 0);
+}
+
+
+TEST(utest_dataset_file, write_read_stride) {
+    template_write_read(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03), 8);
+}
+
+
+TEST(utest_dataset_file, write_read_one_dimension) {
+    template_write_read({ { 1.0 }, { -2.5 }, { 3.75 } }, 0);
+}
+
+
+TEST(utest_dataset_file, write_read_empty) {
+    template_write_read({ }, 0);
+}
+
+
+TEST(utest_dataset_file, open_missing_file) {
+    ASSERT_THROW(dataset_file("utest-dataset_file-missing.bin"), std::runtime_error);
+    ASSERT_EQ(nullptr, dataset_file_open("utest-dataset_file-missing.bin"));
+}
+
+
+TEST(utest_dataset_file, open_text_file) {
+    {
+        std::ofstream stream(UTEST_DATASET_FILE);
+        stream << "1.0 2.0\n3.0 4.0\n5.0 6.0\n7.0 8.0\n9.0 10.0\n11.0 12.0\n13.0 14.0\n";
+    }
+
+    ASSERT_THROW(dataset_file file(UTEST_DATASET_FILE), std::runtime_error);
+    std::remove(UTEST_DATASET_FILE);
+}
+
+
+TEST(utest_dataset_file, open_truncated_file) {
+    const dataset_matrix matrix(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01));
+    dataset_file::write(UTEST_DATASET_FILE, matrix.view());
+
+    std::vector<char> content;
+    {
+        std::ifstream stream(UTEST_DATASET_FILE, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+
+    {
+        std::ofstream stream(UTEST_DATASET_FILE, std::ios::binary | std::ios::trunc);
+        stream.write(content.data(), content.size() - sizeof(double));
+    }
+
+    ASSERT_THROW(dataset_file file(UTEST_DATASET_FILE), std::runtime_error);
+    std::remove(UTEST_DATASET_FILE);
+}
+
+
+TEST(utest_dataset_file, open_corrupted_header) {
+    const dataset_matrix matrix(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01));
+    dataset_file::write(UTEST_DATASET_FILE, matrix.view());
+
+    dataset_file_header valid_header;
+    {
+        std::ifstream stream(UTEST_DATASET_FILE, std::ios::binary);
+        stream.read(reinterpret_cast<char *>(&valid_header), sizeof(dataset_file_header));
+    }
+
+    const auto write_header = [](const dataset_file_header & p_header) {
+        std::ofstream stream(UTEST_DATASET_FILE, std::ios::binary | std::ios::trunc);
+        stream.write(reinterpret_cast<const char *>(&p_header), sizeof(dataset_file_header));
+
+        const std::vector<char> content(128 - sizeof(dataset_file_header), 0);
+        stream.write(content.data(), content.size());
+    };
+
+    /* size of the file is overflowed by the amount of rows */
+    dataset_file_header header = valid_header;
+    header.size = (std::uint64_t(1) << 61) + 1;
+    header.dimension = 1;
+    header.stride = 1;
+    header.offset = 64;
+    write_header(header);
+    ASSERT_THROW(dataset_file file(UTEST_DATASET_FILE), std::runtime_error);
+
+    header = valid_header;
+    header.size = 1;
+    header.offset = 8;
+    write_header(header);
+    ASSERT_THROW(dataset_file file(UTEST_DATASET_FILE), std::runtime_error);
+
+    header.offset = 72;
+    write_header(header);
+    ASSERT_THROW(dataset_file file(UTEST_DATASET_FILE), std::runtime_error);
+
+    header = valid_header;
+    header.size = std::numeric_limits<std::uint64_t>::max();
+    header.stride = std::numeric_limits<std::uint64_t>::max();
+    write_header(header);
+    ASSERT_THROW(dataset_file file(UTEST_DATASET_FILE), std::runtime_error);
+
+    std::remove(UTEST_DATASET_FILE);
+}
+
+
+TEST(utest_dataset_file, interface_dbscan_on_file) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+
+    cluster_analysis::dbscan_data expected_result;
+    cluster_analysis::dbscan(0.7, 3).process(*data, expected_result);
+
+    const dataset_matrix matrix(*data);
+    ASSERT_TRUE(dataset_file_write(UTEST_DATASET_FILE, matrix.data(), matrix.size(), matrix.dimension(), 0));
+
+    void * file = dataset_file_open(UTEST_DATASET_FILE);
+    ASSERT_NE(nullptr, file);
+
+    std::vector<int32_t> labels(dataset_file_size(file));
+    const std::size_t amount_clusters = dbscan_algorithm_labels(dataset_file_data(file), dataset_file_size(file),
+        dataset_file_dimension(file), dataset_file_stride(file), 0.7, 3, labels.data());
+
+    dataset_file_close(file);
+    std::remove(UTEST_DATASET_FILE);
+
+    ASSERT_EQ(expected_result.size(), amount_clusters);
+    for (std::size_t index_cluster = 0; index_cluster < expected_result.size(); index_cluster++) {
+        for (const auto index_object : expected_result[index_cluster]) {
+            ASSERT_EQ((int32_t) index_cluster, labels[index_object]);
+        }
+    }
+}
+
+
+TEST(utest_dataset_file, write_read_single_precision) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_04);
+
+    dataset_matrix_f32 matrix(data->size(), data->at(0).size());
+    for (std::size_t index = 0; index < data->size(); index++) {
+        std::copy(data->at(index).begin(), data->at(index).end(), matrix[index]);
+    }
+
+    dataset_file::write(UTEST_DATASET_FILE, matrix.view(), 4);
+
+    {
+        dataset_file file(UTEST_DATASET_FILE);
+
+        ASSERT_EQ(dataset_file_type::FLOAT32, file.type());
+        ASSERT_EQ(matrix.size(), file.size());
+        ASSERT_EQ(matrix.dimension(), file.dimension());
+        ASSERT_EQ(4U, file.stride());
+        ASSERT_THROW(file.view(), std::logic_error);
+
+        for (std::size_t index = 0; index < matrix.size(); index++) {
+            for (std::size_t index_dimension = 0; index_dimension < matrix.dimension(); index_dimension++) {
+                ASSERT_EQ(matrix[index][index_dimension], file.view_f32()[index][index_dimension]);
+            }
+        }
+    }
+
+    std::remove(UTEST_DATASET_FILE);
+}
+
+
+TEST(utest_dataset_file, interface_dbscan_on_single_precision_file) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+
+    cluster_analysis::dbscan_data expected_result;
+    cluster_analysis::dbscan(0.7, 3).process(*data, expected_result);
+
+    std::vector<float> points;
+    for (const auto & point : *data) {
+        points.insert(points.end(), point.begin(), point.end());
+    }
+
+    ASSERT_TRUE(dataset_file_write_f32(UTEST_DATASET_FILE, points.data(), data->size(), data->at(0).size(), 0));
+
+    void * file = dataset_file_open(UTEST_DATASET_FILE);
+    ASSERT_NE(nullptr, file);
+    ASSERT_EQ(1U, dataset_file_value_type(file));
+    ASSERT_EQ(nullptr, dataset_file_data(file));
+
+    std::vector<int32_t> labels(dataset_file_size(file));
+    const std::size_t amount_clusters = dbscan_algorithm_labels_f32(dataset_file_data_f32(file), dataset_file_size(file),
+        dataset_file_dimension(file), dataset_file_stride(file), 0.7, 3, labels.data());
+
+    dataset_file_close(file);
+    std::remove(UTEST_DATASET_FILE);
+
+    ASSERT_EQ(expected_result.size(), amount_clusters);
+    for (std::size_t index_cluster = 0; index_cluster < expected_result.size(); index_cluster++) {
+        for (const auto index_object : expected_result[index_cluster]) {
+            ASSERT_EQ((int32_t) index_cluster, labels[index_object]);
+        }
+    }
+}
@@ -23,13 +23,43 @@
 
 #include "cluster/dbscan.hpp"
 
+#include "utils.hpp"
+
 #include "samples.hpp"
 #include "utest-cluster.hpp"
 
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
 
 using namespace cluster_analysis;
 
 
+static void template_k_distance_graph(const dataset & p_data, const std::size_t p_neighbors) {
+    const dataset_matrix matrix_data(p_data);
+    const std::vector<double> graph = k_distance_graph(matrix_data.view(), p_neighbors);
+
+    std::vector<double> expected;
+    for (const auto & point : p_data) {
+        std::vector<double> distances;
+        for (const auto & other : p_data) {
+            distances.push_back(euclidean_distance(point, other));
+        }
+
+        std::sort(distances.begin(), distances.end());
+        expected.push_back(distances[std::min(p_neighbors, distances.size() - 1)]);
+    }
+
+    std::sort(expected.begin(), expected.end(), std::greater<double>());
+
+    ASSERT_EQ(expected.size(), graph.size());
+    for (std::size_t index = 0; index < expected.size(); index++) {
+        ASSERT_NEAR(expected[index], graph[index], 1e-10);
+    }
+}
+
+
 static std::shared_ptr<dbscan_data>
 template_length_process_data(const std::shared_ptr<dataset> & p_data,
         const double p_radius,
@@ -133,3 +163,291 @@ TEST(utest_dbscan, noise_cluster_allocation_sample_simple_02) {
     const std::vector<size_t> expected_clusters_length = { 10 };
     template_noise_allocation(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_02), 2.0, 9, expected_clusters_length, 13);
 }
+
+
+TEST(utest_dbscan, padded_data_sample_simple_04) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_04);
+    const padded_sample padded_data(*data, 3);
+
+    dbscan_data result;
+    dbscan(0.7, 3).process(padded_data.view(), result);
+
+    ASSERT_CLUSTER_SIZES(*data, *result.clusters(), { 15, 15, 15, 15, 15 });
+    ASSERT_TRUE(result.noise()->empty());
+}
+
+TEST(utest_dbscan, metric_euclidean_square_sample_simple_03) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+
+    dbscan_data expected_result;
+    dbscan(0.7, 3).process(*data, expected_result);
+
+    dbscan_data actual_result;
+    basic_dbscan<utils::metric::euclidean_square>(0.7 * 0.7, 3).process(*data, actual_result);
+
+    ASSERT_EQ(*expected_result.clusters(), *actual_result.clusters());
+    ASSERT_EQ(*expected_result.noise(), *actual_result.noise());
+}
+
+
+TEST(utest_dbscan, metric_chebyshev_sample_simple_01) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+
+    dbscan_data result;
+    basic_dbscan<utils::metric::chebyshev>(0.5, 2).process(*data, result);
+
+    ASSERT_CLUSTER_SIZES(*data, *result.clusters(), { 5, 5 });
+}
+
+
+TEST(utest_dbscan, metric_manhattan_sample_simple_01) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+
+    dbscan_data result;
+    basic_dbscan<utils::metric::manhattan>(10.0, 2).process(*data, result);
+
+    ASSERT_CLUSTER_SIZES(*data, *result.clusters(), { 10 });
+}
+
+
+TEST(utest_dbscan, single_precision_sample_simple_02) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_02);
+
+    dbscan_data expected_result;
+    dbscan(2.0, 9).process(*data, expected_result);
+
+    const dataset_matrix_f32 matrix_data = create_matrix_f32(*data);
+    dbscan_data actual_result;
+    dbscan(2.0, 9).process(matrix_data.view(), actual_result);
+
+    ASSERT_EQ(*expected_result.clusters(), *actual_result.clusters());
+    ASSERT_EQ(*expected_result.noise(), *actual_result.noise());
+}
+
+
+TEST(utest_dbscan, single_precision_metric_manhattan_sample_simple_01) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+
+    const dataset_matrix_f32 matrix_data = create_matrix_f32(*data);
+    dbscan_data result;
+    basic_dbscan<utils::metric::manhattan>(10.0, 2).process(matrix_data.view(), result);
+
+    ASSERT_CLUSTER_SIZES(*data, *result.clusters(), { 10 });
+}
+
+
+TEST(utest_dbscan, neighborhood_graph_sample_simple_03) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+    const dataset_matrix matrix_data(*data);
+
+    const container::neighborhood_graph graph = container::neighborhood_graph::create(matrix_data.view(), 1.0, utils::metric::euclidean());
+
+    for (const size_t neighbors : { 1, 3, 5, 10 }) {
+        dbscan_data expected_result;
+        dbscan(0.7, neighbors).process(matrix_data.view(), expected_result);
+
+        dbscan_data actual_result;
+        dbscan(0.7, neighbors).process(graph, actual_result);
+
+        ASSERT_EQ(*expected_result.clusters(), *actual_result.clusters());
+        ASSERT_EQ(*expected_result.noise(), *actual_result.noise());
+    }
+}
+
+
+TEST(utest_dbscan, neighborhood_graph_small_radius) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+    const dataset_matrix matrix_data(*data);
+
+    const container::neighborhood_graph graph = container::neighborhood_graph::create(matrix_data.view(), 0.5, utils::metric::euclidean());
+
+    dbscan_data result;
+    ASSERT_THROW(dbscan(1.0, 2).process(graph, result), std::invalid_argument);
+}
+
+
+TEST(utest_dbscan, neighborhood_graph_another_metric) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+    const dataset_matrix matrix_data(*data);
+
+    const container::neighborhood_graph graph = container::neighborhood_graph::create(matrix_data.view(), 2.0, utils::metric::manhattan());
+
+    dbscan_data result;
+    ASSERT_THROW(basic_dbscan<utils::metric::euclidean_square>(1.0, 2).process(graph, result), std::invalid_argument);
+    ASSERT_NO_THROW(basic_dbscan<utils::metric::manhattan>(1.0, 2).process(graph, result));
+}
+
+
+TEST(utest_dbscan, static_kdtree_separated_blobs) {
+    const dataset data = create_separated_blobs(3, 300);
+    const dataset_matrix matrix_data(data);
+
+    dbscan_data tree_result;
+    dbscan(1.0, 3).process(matrix_data.view(), tree_result);
+    ASSERT_CLUSTER_SIZES(data, *tree_result.clusters(), { 300, 300, 300 });
+
+    const container::neighborhood_graph graph = container::neighborhood_graph::create(matrix_data.view(), 1.0, utils::metric::euclidean());
+    dbscan_data graph_result;
+    dbscan(1.0, 3).process(graph, graph_result);
+
+    ASSERT_EQ(*graph_result.clusters(), *tree_result.clusters());
+    ASSERT_EQ(*graph_result.noise(), *tree_result.noise());
+}
+
+
+TEST(utest_dbscan, static_kdtree_single_precision) {
+    const dataset data = create_separated_blobs(3, 300);
+
+    dbscan_data expected_result;
+    dbscan(1.0, 3).process(data, expected_result);
+
+    const dataset_matrix_f32 matrix_data = create_matrix_f32(data);
+    dbscan_data actual_result;
+    dbscan(1.0, 3).process(matrix_data.view(), actual_result);
+
+    ASSERT_EQ(*expected_result.clusters(), *actual_result.clusters());
+    ASSERT_EQ(*expected_result.noise(), *actual_result.noise());
+
+    const container::static_kdtree_f32 tree(matrix_data.view());
+    dbscan_data tree_result;
+    dbscan(1.0, 3).process(tree, matrix_data.view(), tree_result);
+
+    ASSERT_EQ(*expected_result.clusters(), *tree_result.clusters());
+}
+
+
+TEST(utest_dbscan, static_kdtree_core_points_with_noise) {
+    /* border points and noise are classified by count-only queries */
+    dataset data = create_separated_blobs(3, 200);
+    for (size_t index = 0; index < 60; index++) {
+        data.push_back({ 50.0 + double(index) * 3.7, 30.0 + std::sin(double(index)) * 10.0 });
+    }
+
+    const dataset_matrix matrix_data(data);
+
+    for (const size_t neighbors : { 2, 8, 40 }) {
+        dbscan_data tree_result;
+        dbscan(0.8, neighbors).process(matrix_data.view(), tree_result);
+
+        const container::neighborhood_graph graph = container::neighborhood_graph::create(matrix_data.view(), 0.8, utils::metric::euclidean());
+        dbscan_data graph_result;
+        dbscan(0.8, neighbors).process(graph, graph_result);
+
+        ASSERT_EQ(*graph_result.clusters(), *tree_result.clusters());
+        ASSERT_EQ(*graph_result.noise(), *tree_result.noise());
+        ASSERT_FALSE(tree_result.noise()->empty());
+    }
+}
+
+
+TEST(utest_dbscan, static_kdtree_from_file) {
+    const dataset data = create_separated_blobs(3, 200);
+    const dataset_matrix matrix_data(data);
+
+    dbscan_data expected_result;
+    dbscan(1.0, 3).process(matrix_data.view(), expected_result);
+
+    container::static_kdtree(matrix_data.view()).write("utest-dbscan-kdtree.bin");
+    const container::static_kdtree tree = container::static_kdtree::open("utest-dbscan-kdtree.bin");
+
+    dbscan_data result;
+    dbscan(1.0, 3).process(tree, matrix_data.view(), result);
+
+    ASSERT_EQ(*expected_result.clusters(), *result.clusters());
+    ASSERT_EQ(*expected_result.noise(), *result.noise());
+
+    const dataset_matrix other_data(create_separated_blobs(3, 100));
+    ASSERT_THROW(dbscan(1.0, 3).process(tree, other_data.view(), result), std::invalid_argument);
+
+    /* data of the same shape, but with other coordinates */
+    dataset_matrix shifted_data(data);
+    for (std::size_t index = 0; index < shifted_data.size(); index++) {
+        shifted_data[index][0] += 0.5;
+    }
+
+    ASSERT_THROW(dbscan(1.0, 3).process(tree, shifted_data.view(), result), std::invalid_argument);
+
+    std::remove("utest-dbscan-kdtree.bin");
+}
+
+
+TEST(utest_dbscan, k_distance_graph_sample_simple_01) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+
+    template_k_distance_graph(*data, 1);
+    template_k_distance_graph(*data, 3);
+    template_k_distance_graph(*data, 20);
+}
+
+
+TEST(utest_dbscan, ball_tree_separated_blobs) {
+    const dataset data = create_separated_blobs(3, 300, 24);
+    const dataset_matrix matrix_data(data);
+
+    dbscan_data tree_result;
+    dbscan(1.0, 3).process(matrix_data.view(), tree_result);
+    ASSERT_CLUSTER_SIZES(data, *tree_result.clusters(), { 300, 300, 300 });
+
+    const container::neighborhood_graph graph = container::neighborhood_graph::create(matrix_data.view(), 1.0, utils::metric::euclidean());
+    dbscan_data graph_result;
+    dbscan(1.0, 3).process(graph, graph_result);
+
+    ASSERT_EQ(*graph_result.clusters(), *tree_result.clusters());
+    ASSERT_EQ(*graph_result.noise(), *tree_result.noise());
+
+    dbscan_data manhattan_result;
+    basic_dbscan<utils::metric::manhattan>(1.5, 3).process(matrix_data.view(), manhattan_result);
+    ASSERT_CLUSTER_SIZES(data, *manhattan_result.clusters(), { 300, 300, 300 });
+}
+
+
+TEST(utest_dbscan, k_distance_graph_separated_blobs) {
+    template_k_distance_graph(create_separated_blobs(3, 300), 4);
+}
+
+
+TEST(utest_dbscan, hnsw_separated_blobs) {
+    const dataset data = create_separated_blobs(3, 300, 24);
+    const dataset_matrix matrix_data(data);
+    const container::hnsw index(matrix_data.view());
+
+    dbscan_data result;
+    dbscan(1.0, 3).process(index, result);
+    ASSERT_CLUSTER_SIZES(data, *result.clusters(), { 300, 300, 300 });
+    ASSERT_TRUE(result.noise()->empty());
+}
+
+
+TEST(utest_dbscan, hnsw_another_metric_degree) {
+    const dataset_matrix matrix_data(create_separated_blobs(3, 100));
+    const container::basic_hnsw<utils::metric::minkowski> index(matrix_data.view(), container::hnsw_parameters(), utils::metric::minkowski(3.0));
+
+    dbscan_data result;
+    ASSERT_THROW(basic_dbscan<utils::metric::minkowski>(1.0, 3, utils::metric::minkowski(4.0)).process(index, result), std::invalid_argument);
+
+    basic_dbscan<utils::metric::minkowski>(1.0, 3, utils::metric::minkowski(3.0)).process(index, result);
+    ASSERT_EQ(3U, result.clusters()->size());
+}
+
+
+TEST(utest_dbscan, k_distance_graph_hnsw) {
+    const dataset data = create_separated_blobs(3, 300, 8);
+    const dataset_matrix matrix_data(data);
+    const container::hnsw index(matrix_data.view());
+
+    const std::vector<double> expected = k_distance_graph(matrix_data.view(), 4);
+    const std::vector<double> graph = k_distance_graph(index, 4);
+    ASSERT_EQ(expected.size(), graph.size());
+
+    /* approximate neighbors are not closer than exact ones */
+    std::size_t amount_equal = 0;
+    for (std::size_t index_point = 0; index_point < expected.size(); index_point++) {
+        ASSERT_GE(graph[index_point] + 1e-10, expected[index_point]);
+        if (std::abs(graph[index_point] - expected[index_point]) < 1e-10) {
+            amount_equal++;
+        }
+    }
+
+    ASSERT_GE(amount_equal, expected.size() * 95 / 100);
+    ASSERT_NEAR(average_neighbor_distance(index, 4), average_neighbor_distance(&data, 4), 1e-2);
+}
@@ -0,0 +1,134 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#include "gtest/gtest.h"
+
+#include "container/dense_matrix.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+using namespace container;
+
+
+TEST(utest_dense_matrix, create_empty) {
+    dense_matrix<double> matrix;
+    ASSERT_EQ(0, matrix.size());
+    ASSERT_EQ(0, matrix.dimension());
+    ASSERT_TRUE(matrix.empty());
+    ASSERT_TRUE(matrix.view().empty());
+}
+
+
+TEST(utest_dense_matrix, create_with_value) {
+    dense_matrix<double> matrix(5, 3, 1.5);
+    ASSERT_EQ(5, matrix.size());
+    ASSERT_EQ(3, matrix.dimension());
+
+    for (std::size_t i = 0; i < matrix.size(); i++) {
+        for (std::size_t j = 0; j < matrix.dimension(); j++) {
+            ASSERT_EQ(1.5, matrix[i][j]);
+        }
+    }
+}
+
+
+TEST(utest_dense_matrix, create_from_vectors) {
+    std::vector< std::vector<double> > points = { { 1.0, 2.0 }, { 3.0, 4.0 }, { 5.0, 6.0 } };
+    dense_matrix<double> matrix(points);
+
+    ASSERT_EQ(3, matrix.size());
+    ASSERT_EQ(2, matrix.dimension());
+
+    for (std::size_t i = 0; i < points.size(); i++) {
+        ASSERT_EQ(matrix.data() + i * 2, matrix[i]);
+        for (std::size_t j = 0; j < points[i].size(); j++) {
+            ASSERT_EQ(points[i][j], matrix[i][j]);
+        }
+    }
+
+    std::vector< std::vector<double> > actual_points;
+    matrix.get_points(actual_points);
+    ASSERT_EQ(points, actual_points);
+}
+
+
+TEST(utest_dense_matrix, create_from_different_dimensions) {
+    std::vector< std::vector<double> > points = { { 1.0, 2.0 }, { 3.0 } };
+    ASSERT_THROW(dense_matrix<double> matrix(points), std::invalid_argument);
+}
+
+
+TEST(utest_dense_matrix, alignment) {
+    for (std::size_t size = 1; size < 10; size++) {
+        dense_matrix<double> matrix(size, 3);
+        ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(matrix.data()) % dense_matrix<double>::ALIGNMENT);
+    }
+}
+
+
+TEST(utest_dense_matrix, copy_and_move) {
+    std::vector< std::vector<double> > points = { { 1.0, 2.0 }, { 3.0, 4.0 } };
+    dense_matrix<double> matrix(points);
+
+    dense_matrix<double> copy_matrix(matrix);
+    ASSERT_NE(matrix.data(), copy_matrix.data());
+    ASSERT_EQ(4.0, copy_matrix[1][1]);
+
+    const double * memory = copy_matrix.data();
+    dense_matrix<double> move_matrix(std::move(copy_matrix));
+    ASSERT_EQ(memory, move_matrix.data());
+    ASSERT_TRUE(copy_matrix.empty());
+
+    dense_matrix<double> assigned_matrix;
+    assigned_matrix = matrix;
+    ASSERT_EQ(2, assigned_matrix.size());
+    ASSERT_EQ(3.0, assigned_matrix[1][0]);
+}
+
+
+TEST(utest_dense_matrix, view_with_stride) {
+    const double buffer[] = { 1.0, 2.0, -1.0, 3.0, 4.0, -1.0, 5.0, 6.0, -1.0 };
+    dense_matrix_view<double> view(buffer, 3, 2, 3);
+
+    ASSERT_EQ(3, view.size());
+    ASSERT_EQ(2, view.dimension());
+    ASSERT_EQ(3, view.stride());
+    ASSERT_EQ(5.0, view[2][0]);
+    ASSERT_EQ(6.0, view[2][1]);
+
+    std::vector<double> point;
+    view.get_point(1, point);
+    ASSERT_EQ(std::vector<double>({ 3.0, 4.0 }), point);
+
+    dense_matrix<double> matrix(view);
+    ASSERT_EQ(2, matrix.view().stride());
+    ASSERT_EQ(4.0, matrix[1][1]);
+    ASSERT_EQ(5.0, matrix[2][0]);
+}
+
+
+TEST(utest_dense_matrix, view_invalid_stride) {
+    const double buffer[] = { 1.0, 2.0, 3.0, 4.0 };
+    ASSERT_THROW(dense_matrix_view<double> view(buffer, 2, 2, 1), std::invalid_argument);
+}
@@ -0,0 +1,177 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#include "gtest/gtest.h"
+
+#include "utils/distance_kernel.hpp"
+
+#include <cmath>
+
+
+using namespace utils;
+
+
+static dataset create_points(const std::size_t p_size, const std::size_t p_dimension) {
+    dataset points(p_size, point(p_dimension, 0.0));
+    for (std::size_t index_point = 0; index_point < p_size; index_point++) {
+        for (std::size_t index_dimension = 0; index_dimension < p_dimension; index_dimension++) {
+            points[index_point][index_dimension] = std::sin(0.37 * index_point + 1.13 * index_dimension) * (1.0 + index_dimension);
+        }
+    }
+
+    return points;
+}
+
+
+static double calculate_distance(const point & p_point1, const point & p_point2) {
+    double distance = 0.0;
+    for (std::size_t index = 0; index < p_point1.size(); index++) {
+        distance += (p_point1[index] - p_point2[index]) * (p_point1[index] - p_point2[index]);
+    }
+
+    return distance;
+}
+
+
+static void template_distance_kernel(const simd_instruction_set p_set) {
+    if (p_set > get_supported_simd_instruction_set()) {
+        ASSERT_THROW(set_simd_instruction_set(p_set), std::invalid_argument);
+        return;
+    }
+
+    const simd_instruction_set default_set = get_simd_instruction_set();
+    set_simd_instruction_set(p_set);
+    ASSERT_EQ(p_set, get_simd_instruction_set());
+
+    for (std::size_t dimension = 1; dimension < 35; dimension++) {
+        dataset points = create_points(7, dimension);
+
+        for (std::size_t i = 0; i < points.size(); i++) {
+            for (std::size_t j = 0; j < points.size(); j++) {
+                const double expected = calculate_distance(points[i], points[j]);
+                ASSERT_NEAR(expected, euclidean_distance_square(points[i].data(), points[j].data(), dimension), 1e-9 * (1.0 + expected));
+                ASSERT_NEAR(expected, euclidean_distance_square_simd(points[i].data(), points[j].data(), dimension), 1e-9 * (1.0 + expected));
+
+                const std::vector<float> point1(points[i].begin(), points[i].end());
+                const std::vector<float> point2(points[j].begin(), points[j].end());
+                ASSERT_NEAR(expected, euclidean_distance_square(point1.data(), point2.data(), dimension), 1e-4 * (1.0 + expected));
+                ASSERT_NEAR(expected, euclidean_distance_square_simd(point1.data(), point2.data(), dimension), 1e-4 * (1.0 + expected));
+            }
+        }
+    }
+
+    set_simd_instruction_set(default_set);
+}
+
+
+TEST(utest_distance_kernel, scalar) {
+    template_distance_kernel(simd_instruction_set::SCALAR);
+}
+
+
+TEST(utest_distance_kernel, sse2) {
+    template_distance_kernel(simd_instruction_set::SSE2);
+}
+
+
+TEST(utest_distance_kernel, avx2) {
+    template_distance_kernel(simd_instruction_set::AVX2);
+}
+
+
+TEST(utest_distance_kernel, avx512) {
+    template_distance_kernel(simd_instruction_set::AVX512);
+}
+
+
+TEST(utest_distance_kernel, one_to_many_with_stride) {
+    const std::size_t dimension = 11;
+    const std::size_t stride = 16;
+
+    dataset points = create_points(20, dimension);
+
+    std::vector<double> block(points.size() * stride, 1000.0);
+    for (std::size_t index = 0; index < points.size(); index++) {
+        std::copy(points[index].begin(), points[index].end(), block.begin() + index * stride);
+    }
+
+    std::vector<double> result(points.size(), -1.0);
+    euclidean_distance_square(points[3].data(), dataset_view(block.data(), points.size(), dimension, stride), result.data());
+
+    for (std::size_t index = 0; index < points.size(); index++) {
+        const double expected = calculate_distance(points[3], points[index]);
+        ASSERT_NEAR(expected, result[index], 1e-9 * (1.0 + expected));
+    }
+}
+
+
+TEST(utest_distance_kernel, many_to_many) {
+    const dataset_matrix block1(create_points(9, 6));
+    const dataset_matrix block2(create_points(5, 6));
+
+    std::vector<double> result(block1.size() * block2.size(), -1.0);
+    euclidean_distance_square(block1.view(), block2.view(), result.data());
+
+    dataset points1, points2;
+    block1.get_points(points1);
+    block2.get_points(points2);
+
+    for (std::size_t i = 0; i < points1.size(); i++) {
+        for (std::size_t j = 0; j < points2.size(); j++) {
+            const double expected = calculate_distance(points1[i], points2[j]);
+            ASSERT_NEAR(expected, result[i * points2.size() + j], 1e-9 * (1.0 + expected));
+        }
+    }
+}
+
+
+TEST(utest_distance_kernel, many_to_many_different_dimensions) {
+    const dataset_matrix block1(create_points(2, 3));
+    const dataset_matrix block2(create_points(2, 4));
+
+    std::vector<double> result(4);
+    ASSERT_THROW(euclidean_distance_square(block1.view(), block2.view(), result.data()), std::invalid_argument);
+}
+
+
+TEST(utest_distance_kernel, many_to_many_single_precision) {
+    const dataset points1 = create_points(9, 13);
+    const dataset points2 = create_points(5, 13);
+
+    dataset_matrix_f32 block1(points1.size(), 13), block2(points2.size(), 13);
+    for (std::size_t index = 0; index < points1.size(); index++) {
+        std::copy(points1[index].begin(), points1[index].end(), block1[index]);
+    }
+
+    for (std::size_t index = 0; index < points2.size(); index++) {
+        std::copy(points2[index].begin(), points2[index].end(), block2[index]);
+    }
+
+    std::vector<float> result(points1.size() * points2.size(), -1.0f);
+    euclidean_distance_square(block1.view(), block2.view(), result.data());
+
+    for (std::size_t i = 0; i < points1.size(); i++) {
+        for (std::size_t j = 0; j < points2.size(); j++) {
+            const double expected = calculate_distance(points1[i], points2[j]);
+            ASSERT_NEAR(expected, result[i * points2.size() + j], 1e-4 * (1.0 + expected));
+        }
+    }
+}
@@ -0,0 +1,249 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+
+#include "gtest/gtest.h"
+
+#include "cluster/hsyncnet.hpp"
+#include "cluster/kmeans.hpp"
+#include "cluster/kmedians.hpp"
+#include "cluster/xmeans.hpp"
+
+#include "nnet/sync.hpp"
+
+#include "utils/execution_control.hpp"
+
+#include "samples.hpp"
+
+#include <thread>
+
+
+using namespace cluster_analysis;
+using namespace utils;
+
+
+static std::size_t total_size(const cluster_data & p_result) {
+    std::size_t total = 0;
+    for (std::size_t index = 0; index < p_result.size(); index++) {
+        total += p_result[index].size();
+    }
+
+    return total;
+}
+
+
+TEST(utest_execution_control, cancellation_token_shared_state) {
+    cancellation_token token;
+    cancellation_token copy = token;
+
+    ASSERT_FALSE(token.is_cancelled());
+
+    copy.cancel();
+    ASSERT_TRUE(token.is_cancelled());
+
+    token.reset();
+    ASSERT_FALSE(copy.is_cancelled());
+}
+
+
+TEST(utest_execution_control, monitor_without_limits) {
+    execution_control control;
+    execution_monitor monitor(control);
+
+    for (std::size_t iteration = 0; iteration < 100; iteration++) {
+        ASSERT_TRUE(monitor.can_continue());
+        monitor.next_iteration(0.0);
+    }
+
+    ASSERT_EQ(100U, monitor.get_iterations());
+    ASSERT_EQ(execution_status::COMPLETED, monitor.get_status());
+}
+
+
+TEST(utest_execution_control, monitor_cancellation_from_another_thread) {
+    execution_control control;
+    cancellation_token token = control.get_cancellation_token();
+
+    execution_monitor monitor(control);
+    std::thread canceller([&token]() { token.cancel(); });
+    canceller.join();
+
+    ASSERT_FALSE(monitor.can_continue());
+    ASSERT_TRUE(monitor.is_stopped());
+    ASSERT_EQ(execution_status::CANCELLED, monitor.get_status());
+}
+
+
+TEST(utest_execution_control, kmeans_without_control) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+
+    kmeans_data output_result;
+    kmeans({ { 0.2, 0.1 }, { 4.0, 1.0 }, { 2.0, 2.0 }, { 2.3, 3.9 } }, 0.0001).process(*data, output_result);
+
+    ASSERT_EQ(execution_status::COMPLETED, output_result.status());
+}
+
+
+TEST(utest_execution_control, kmeans_iteration_budget) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+
+    std::vector<double> changes;
+
+    execution_control control;
+    control.set_iteration_budget(1);
+    control.set_progress_callback([&changes](const std::size_t p_iteration, const double p_change) {
+        ASSERT_EQ(changes.size() + 1, p_iteration);
+        changes.push_back(p_change);
+    });
+
+    kmeans solver({ { 0.2, 0.1 }, { 4.0, 1.0 }, { 2.0, 2.0 }, { 2.3, 3.9 } }, 0.0001);
+    solver.set_execution_control(control);
+
+    kmeans_data output_result;
+    solver.process(*data, output_result);
+
+    ASSERT_EQ(execution_status::ITERATION_BUDGET_EXCEEDED, output_result.status());
+    ASSERT_EQ(1U, changes.size());
+    ASSERT_EQ(data->size(), total_size(output_result));
+    ASSERT_EQ(output_result.size(), output_result.centers()->size());
+}
+
+
+TEST(utest_execution_control, kmeans_time_budget) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+
+    execution_control control;
+    control.set_time_budget(0.000001);
+
+    kmeans solver({ { 0.2, 0.1 }, { 4.0, 1.0 }, { 2.0, 2.0 }, { 2.3, 3.9 } }, 0.0001);
+    solver.set_execution_control(control);
+
+    kmeans_data output_result;
+    solver.process(*data, output_result);
+
+    ASSERT_EQ(execution_status::TIME_BUDGET_EXCEEDED, output_result.status());
+    ASSERT_EQ(data->size(), total_size(output_result));
+}
+
+
+TEST(utest_execution_control, kmeans_cancellation_by_callback) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+
+    execution_control control;
+    cancellation_token token = control.get_cancellation_token();
+    control.set_progress_callback([&token](const std::size_t, const double) { token.cancel(); });
+
+    kmeans solver({ { 0.2, 0.1 }, { 4.0, 1.0 }, { 2.0, 2.0 }, { 2.3, 3.9 } }, 0.0001);
+    solver.set_execution_control(control);
+
+    kmeans_data output_result;
+    solver.process(*data, output_result);
+
+    ASSERT_EQ(execution_status::CANCELLED, output_result.status());
+    ASSERT_EQ(data->size(), total_size(output_result));
+}
+
+
+TEST(utest_execution_control, kmedians_iteration_budget) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+
+    std::size_t amount_iterations = 0;
+
+    execution_control control;
+    control.set_iteration_budget(1);
+    control.set_progress_callback([&amount_iterations](const std::size_t p_iteration, const double) {
+        amount_iterations = p_iteration;
+    });
+
+    kmedians solver({ { 0.2, 0.1 }, { 4.0, 1.0 }, { 2.0, 2.0 }, { 2.3, 3.9 } }, 0.0001);
+    solver.set_execution_control(control);
+
+    kmedians_data output_result;
+    solver.process(*data, output_result);
+
+    ASSERT_EQ(execution_status::ITERATION_BUDGET_EXCEEDED, output_result.status());
+    ASSERT_EQ(1U, amount_iterations);
+    ASSERT_EQ(data->size(), total_size(output_result));
+}
+
+
+TEST(utest_execution_control, xmeans_iteration_budget) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+
+    execution_control control;
+    control.set_iteration_budget(1);
+
+    xmeans solver({ { 0.2, 0.1 }, { 4.0, 1.0 } }, 20, 0.0001, splitting_type::BAYESIAN_INFORMATION_CRITERION);
+    solver.set_execution_control(control);
+
+    xmeans_data output_result;
+    solver.process(*data, output_result);
+
+    ASSERT_EQ(execution_status::ITERATION_BUDGET_EXCEEDED, output_result.status());
+    ASSERT_EQ(2U, output_result.size());
+    ASSERT_EQ(data->size(), total_size(output_result));
+}
+
+
+TEST(utest_execution_control, sync_iteration_budget) {
+    sync_network network(10, 1, 0, connection_t::CONNECTION_ALL_TO_ALL, initial_type::RANDOM_GAUSSIAN);
+
+    std::size_t amount_steps = 0;
+
+    execution_control control;
+    control.set_iteration_budget(3);
+    control.set_progress_callback([&amount_steps](const std::size_t p_iteration, const double p_order) {
+        ASSERT_GE(p_order, 0.0);
+        amount_steps = p_iteration;
+    });
+
+    network.set_execution_control(control);
+
+    sync_dynamic output_dynamic;
+    network.simulate_dynamic(0.999999, 0.1, solve_type::FAST, true, output_dynamic);
+
+    ASSERT_EQ(execution_status::ITERATION_BUDGET_EXCEEDED, network.get_status());
+    ASSERT_EQ(3U, amount_steps);
+    ASSERT_EQ(4U, output_dynamic.size());
+
+    network.set_execution_control(execution_control());
+    network.simulate_dynamic(0.998, 0.1, solve_type::FAST, false, output_dynamic);
+
+    ASSERT_EQ(execution_status::COMPLETED, network.get_status());
+}
+
+
+TEST(utest_execution_control, hsyncnet_cancellation) {
+    std::vector<std::vector<double> > sample = { { 0.1, 0.1 }, { 1.2, 1.1 }, { 5.0, 5.0 }, { 10.2, 10.1 }, { 11.3, 11.0 }, { 15.1, 15.4 } };
+
+    hsyncnet network(&sample, 1, initial_type::EQUIPARTITION);
+
+    execution_control control;
+    cancellation_token token = control.get_cancellation_token();
+    token.cancel();
+    network.set_execution_control(control);
+
+    hsyncnet_analyser analyser;
+    network.process(0.998, solve_type::FAST, false, analyser);
+
+    ASSERT_EQ(execution_status::CANCELLED, network.get_status());
+    ASSERT_EQ(1U, analyser.size());
+}
@@ -0,0 +1,301 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#include "gtest/gtest.h"
+
+#include "container/hnsw.hpp"
+
+#include "utest-index.hpp"
+
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+using namespace container;
+
+
+template <typename TypeMetric>
+static double template_nearest_recall(const dataset_view & p_data, const std::size_t p_amount, const hnsw_parameters & p_parameters, const TypeMetric & p_metric = TypeMetric()) {
+    const basic_hnsw<TypeMetric> index(p_data, p_parameters, p_metric);
+    EXPECT_EQ(p_data.size(), index.size());
+
+    std::vector<std::size_t> indexes;
+    std::vector<double> distances;
+
+    std::size_t found = 0;
+    std::size_t total = 0;
+
+    for (std::size_t i = 0; i < p_data.size(); i++) {
+        index.find_nearest(p_data[i], p_amount, indexes, distances);
+
+        std::vector<std::pair<double, std::size_t>> expected;
+        for (std::size_t j = 0; j < p_data.size(); j++) {
+            expected.emplace_back(p_metric.comparable_distance(p_data[i], p_data[j], p_data.dimension()), j);
+        }
+        std::sort(expected.begin(), expected.end());
+        expected.resize(std::min(p_amount, expected.size()));
+
+        EXPECT_EQ(expected.size(), indexes.size());
+        EXPECT_EQ(indexes.size(), distances.size());
+
+        for (std::size_t position = 1; position < distances.size(); position++) {
+            EXPECT_LE(distances[position - 1], distances[position]);
+        }
+
+        const std::set<std::size_t> actual(indexes.begin(), indexes.end());
+        for (const auto & neighbor : expected) {
+            found += actual.count(neighbor.second);
+        }
+
+        total += expected.size();
+    }
+
+    return double(found) / double(total);
+}
+
+
+template <typename TypeMetric>
+static double template_radius_recall(const dataset_view & p_data, const double p_radius, const hnsw_parameters & p_parameters, const TypeMetric & p_metric = TypeMetric()) {
+    const basic_hnsw<TypeMetric> index(p_data, p_parameters, p_metric);
+    const double comparable_radius = p_metric.to_comparable(p_radius);
+
+    std::vector<std::size_t> indexes;
+    std::vector<double> distances;
+
+    std::size_t found = 0;
+    std::size_t total = 0;
+
+    for (std::size_t i = 0; i < p_data.size(); i++) {
+        index.find_radius(p_data[i], comparable_radius, indexes, distances);
+        EXPECT_EQ(indexes.size(), distances.size());
+
+        /* approximate search never returns points out of radius */
+        for (std::size_t position = 0; position < indexes.size(); position++) {
+            const double distance = p_metric.comparable_distance(p_data[i], p_data[indexes[position]], p_data.dimension());
+            EXPECT_NEAR(distance, distances[position], 1e-10);
+            EXPECT_LE(distances[position], comparable_radius);
+        }
+
+        const std::set<std::size_t> actual(indexes.begin(), indexes.end());
+        EXPECT_EQ(actual.size(), indexes.size());
+
+        for (std::size_t j = 0; j < p_data.size(); j++) {
+            if (p_metric.comparable_distance(p_data[i], p_data[j], p_data.dimension()) <= comparable_radius) {
+                found += actual.count(j);
+                total++;
+            }
+        }
+    }
+
+    return double(found) / double(total);
+}
+
+
+TEST(utest_hnsw, empty) {
+    hnsw default_index;
+    ASSERT_EQ(0U, default_index.size());
+
+    const dataset_matrix matrix(0, 2);
+    const hnsw index(matrix.view());
+    ASSERT_EQ(0U, index.size());
+
+    const double point[2] = { 0.0, 0.0 };
+    std::vector<std::size_t> indexes = { 1 };
+    std::vector<double> distances = { 1.0 };
+
+    ASSERT_EQ(0U, index.find_radius(point, 10.0, indexes, distances));
+    ASSERT_TRUE(indexes.empty());
+    ASSERT_TRUE(distances.empty());
+
+    ASSERT_EQ(0U, index.find_nearest(point, 3, indexes, distances));
+    ASSERT_TRUE(indexes.empty());
+}
+
+
+TEST(utest_hnsw, invalid_parameters) {
+    const dataset_matrix matrix = create_random_matrix(10, 2);
+
+    hnsw_parameters parameters;
+    parameters.m_connections = 1;
+
+    ASSERT_THROW(hnsw index(matrix.view(), parameters), std::invalid_argument);
+}
+
+
+TEST(utest_hnsw, built_with_metric) {
+    const dataset_matrix matrix = create_random_matrix(20, 2);
+
+    const basic_hnsw<utils::metric::minkowski> index(matrix.view(), hnsw_parameters(), utils::metric::minkowski(3.0));
+    ASSERT_TRUE(index.is_built_with(utils::metric::minkowski(3.0)));
+    ASSERT_FALSE(index.is_built_with(utils::metric::minkowski(2.0)));
+
+    const hnsw euclidean_index(matrix.view());
+    ASSERT_TRUE(euclidean_index.is_built_with(utils::metric::euclidean()));
+}
+
+
+TEST(utest_hnsw, small_data_is_exact) {
+    const dataset_matrix matrix = create_random_matrix(40, 3);
+
+    ASSERT_EQ(1.0, template_nearest_recall<utils::metric::euclidean>(matrix.view(), 5, hnsw_parameters()));
+    ASSERT_EQ(1.0, template_radius_recall<utils::metric::euclidean>(matrix.view(), 2.0, hnsw_parameters()));
+}
+
+
+TEST(utest_hnsw, nearest_recall_euclidean) {
+    const dataset_matrix matrix = create_random_matrix(2000, 16);
+
+    ASSERT_GE(template_nearest_recall<utils::metric::euclidean>(matrix.view(), 10, hnsw_parameters()), 0.95);
+}
+
+
+TEST(utest_hnsw, nearest_recall_metrics) {
+    const dataset_matrix matrix = create_random_matrix(1000, 24);
+
+    ASSERT_GE(template_nearest_recall<utils::metric::manhattan>(matrix.view(), 5, hnsw_parameters()), 0.95);
+    ASSERT_GE(template_nearest_recall<utils::metric::chebyshev>(matrix.view(), 5, hnsw_parameters()), 0.90);
+    ASSERT_GE(template_nearest_recall<utils::metric::cosine>(matrix.view(), 5, hnsw_parameters()), 0.95);
+    ASSERT_GE(template_nearest_recall(matrix.view(), 5, hnsw_parameters(), utils::metric::minkowski(3.0)), 0.95);
+}
+
+
+TEST(utest_hnsw, radius_recall) {
+    const dataset_matrix matrix = create_random_matrix(1500, 16);
+
+    ASSERT_GE(template_radius_recall<utils::metric::euclidean>(matrix.view(), 4.0, hnsw_parameters()), 0.95);
+    ASSERT_GE(template_radius_recall<utils::metric::manhattan>(matrix.view(), 12.0, hnsw_parameters()), 0.95);
+}
+
+
+TEST(utest_hnsw, search_candidates) {
+    const dataset_matrix matrix = create_random_matrix(2000, 16);
+
+    hnsw_parameters parameters;
+    parameters.m_search_candidates = 1;
+
+    hnsw index(matrix.view(), parameters);
+
+    std::vector<std::size_t> indexes;
+    std::vector<double> distances;
+
+    const std::size_t narrow_search = index.find_nearest(matrix[7], 1, indexes, distances);
+
+    index.set_search_candidates(200);
+    ASSERT_EQ(200U, index.parameters().m_search_candidates);
+
+    const std::size_t wide_search = index.find_nearest(matrix[7], 1, indexes, distances);
+    ASSERT_LT(narrow_search, wide_search);
+    ASSERT_EQ(7U, indexes.front());
+}
+
+
+TEST(utest_hnsw, reproducible_construction) {
+    const dataset_matrix matrix = create_random_matrix(1000, 8);
+
+    const hnsw index1(matrix.view());
+    const hnsw index2(matrix.view());
+
+    const neighbor_lists result1 = index1.find_nearest(matrix.view(), 4);
+    const neighbor_lists result2 = index2.find_nearest(matrix.view(), 4);
+
+    ASSERT_EQ(result1.neighbors(), result2.neighbors());
+}
+
+
+TEST(utest_hnsw, duplicated_points) {
+    dataset_matrix matrix(300, 4);
+    for (std::size_t i = 0; i < matrix.size(); i++) {
+        for (std::size_t j = 0; j < matrix.dimension(); j++) {
+            matrix[i][j] = double((i + j) % 3);
+        }
+    }
+
+    const hnsw index(matrix.view());
+
+    std::vector<std::size_t> indexes;
+    std::vector<double> distances;
+
+    for (std::size_t i = 0; i < 3; i++) {
+        index.find_radius(matrix[i], 0.0, indexes, distances);
+        ASSERT_EQ(100U, indexes.size());
+
+        index.find_nearest(matrix[i], 3, indexes, distances);
+        ASSERT_EQ(std::vector<double>(3, 0.0), distances);
+    }
+}
+
+
+TEST(utest_hnsw, batch_queries) {
+    const dataset_matrix matrix = create_random_matrix(1000, 16);
+    const dataset_matrix queries = create_random_matrix(300, 16);
+
+    const hnsw index(matrix.view());
+    const double radius = utils::metric::euclidean().to_comparable(4.0);
+
+    const neighbor_lists radius_result = index.find_radius(queries.view(), radius);
+    const neighbor_lists nearest_result = index.find_nearest(queries.view(), 6);
+    ASSERT_EQ(queries.size(), radius_result.size());
+    ASSERT_EQ(queries.size() * 6, nearest_result.total());
+
+    std::vector<std::size_t> indexes;
+    std::vector<double> distances;
+
+    for (std::size_t i = 0; i < queries.size(); i++) {
+        index.find_radius(queries[i], radius, indexes, distances);
+        ASSERT_EQ(indexes, std::vector<std::size_t>(radius_result.begin_neighbors(i), radius_result.end_neighbors(i)));
+
+        index.find_nearest(queries[i], 6, indexes, distances);
+        ASSERT_EQ(indexes, std::vector<std::size_t>(nearest_result.begin_neighbors(i), nearest_result.end_neighbors(i)));
+    }
+}
+
+
+TEST(utest_hnsw, reused_search_buffer) {
+    const dataset_matrix matrix = create_random_matrix(1000, 16);
+    const hnsw index(matrix.view());
+    const double radius = utils::metric::euclidean().to_comparable(4.0);
+
+    hnsw::search_buffer buffer;
+    std::vector<std::size_t> indexes, buffer_indexes;
+    std::vector<double> distances, buffer_distances;
+
+    for (std::size_t i = 0; i < matrix.size(); i++) {
+        index.find_radius(matrix[i], radius, indexes, distances);
+
+        buffer_indexes.clear();
+        buffer_distances.clear();
+        index.find_radius(matrix[i], radius, buffer, buffer_indexes, buffer_distances);
+
+        ASSERT_EQ(indexes, buffer_indexes);
+        ASSERT_EQ(distances, buffer_distances);
+
+        index.find_nearest(matrix[i], 6, indexes, distances);
+
+        buffer_indexes.clear();
+        buffer_distances.clear();
+        index.find_nearest(matrix[i], 6, buffer, buffer_indexes, buffer_distances);
+
+        ASSERT_EQ(indexes, buffer_indexes);
+        ASSERT_EQ(distances, buffer_distances);
+    }
+}
@@ -23,6 +23,8 @@
 
 #include "cluster/hsyncnet.hpp"
 
+#include "container/hnsw.hpp"
+
 
 static void template_cluster_allocation(const unsigned int number_clusters) {
 	bool result_testing = false;
@@ -63,3 +65,47 @@ TEST(utest_hsyncnet, allocation_2_clusters) {
 TEST(utest_hsyncnet, allocation_1_clusters) {
 	template_cluster_allocation(1);
 }
+
+
+static void template_cluster_allocation_hnsw(const unsigned int number_clusters) {
+	bool result_testing = false;
+
+	for (unsigned int i = 0; i < 3; i++) {
+		std::vector<std::vector<double> > sample;
+
+		sample.push_back( { 0.1, 0.1 } );
+		sample.push_back( { 1.2, 1.1 } );
+		sample.push_back( { 5.0, 5.0 } );
+
+		sample.push_back( { 10.2, 10.1 } );
+		sample.push_back( { 11.3, 11.0 } );
+		sample.push_back( { 15.1, 15.4 } );
+
+		const dataset_matrix locations(sample);
+		const container::hnsw index(locations.view());
+
+		hsyncnet network(&sample, index, number_clusters, initial_type::EQUIPARTITION, 3, 0.15);
+
+		hsyncnet_analyser analyser;
+		network.process(0.998, solve_type::FAST, true, analyser);
+
+		hsyncnet_cluster_data ensembles;
+		analyser.allocate_clusters(0.1, ensembles);
+
+		if (number_clusters != ensembles.size()) {
+			continue;
+		}
+
+		result_testing = true;
+	}
+
+	ASSERT_TRUE(result_testing);
+}
+
+TEST(utest_hsyncnet, allocation_2_clusters_hnsw) {
+	template_cluster_allocation_hnsw(2);
+}
+
+TEST(utest_hsyncnet, allocation_1_clusters_hnsw) {
+	template_cluster_allocation_hnsw(1);
+}
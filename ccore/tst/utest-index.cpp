@@ -0,0 +1,35 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#include "utest-index.hpp"
+
+#include <cmath>
+
+
+dataset_matrix create_random_matrix(const std::size_t p_size, const std::size_t p_dimension) {
+    dataset_matrix matrix(p_size, p_dimension);
+    for (std::size_t i = 0; i < p_size; i++) {
+        for (std::size_t j = 0; j < p_dimension; j++) {
+            matrix[i][j] = std::sin(double(i * 17 + j * 11)) * 3.0 + std::cos(double(i * j + 3)) * 0.5;
+        }
+    }
+
+    return matrix;
+}
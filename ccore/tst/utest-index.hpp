@@ -0,0 +1,161 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#ifndef TST_UTEST_INDEX_HPP_
+#define TST_UTEST_INDEX_HPP_
+
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "container/ball_tree.hpp"
+#include "container/static_kdtree.hpp"
+
+
+/***********************************************************************************************
+*
+* @brief    Creates deterministic pseudo-random data with coordinates in range [-3.5, 3.5].
+*
+* @param[in] p_size: amount of points.
+* @param[in] p_dimension: amount of coordinates of each point.
+*
+***********************************************************************************************/
+dataset_matrix create_random_matrix(const std::size_t p_size, const std::size_t p_dimension);
+
+
+/***********************************************************************************************
+*
+* @brief    Adapters of search indexes to the common form that is used by search checks.
+*
+***********************************************************************************************/
+template <typename TypeMetric>
+void index_find_radius(const container::static_kdtree & p_index, const double * p_point, const double p_radius, const TypeMetric & p_metric, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) {
+    p_index.find_radius(p_point, p_radius, p_metric, p_indexes, p_distances);
+}
+
+
+template <typename TypeMetric>
+void index_find_radius(const container::basic_ball_tree<TypeMetric> & p_index, const double * p_point, const double p_radius, const TypeMetric &, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) {
+    p_index.find_radius(p_point, p_radius, p_indexes, p_distances);
+}
+
+
+template <typename TypeMetric>
+void index_find_nearest(const container::static_kdtree & p_index, const double * p_point, const std::size_t p_amount, const TypeMetric & p_metric, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) {
+    p_index.find_nearest(p_point, p_amount, p_metric, p_indexes, p_distances);
+}
+
+
+template <typename TypeMetric>
+void index_find_nearest(const container::basic_ball_tree<TypeMetric> & p_index, const double * p_point, const std::size_t p_amount, const TypeMetric &, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) {
+    p_index.find_nearest(p_point, p_amount, p_indexes, p_distances);
+}
+
+
+/***********************************************************************************************
+*
+* @brief    Checks radius search of the index for each point of data against full search.
+* @details  Results of the index are compared without order, distances are comparable.
+*
+* @param[in] p_index: index that has been built for the data.
+* @param[in] p_data: data that is used as queries and as expected neighbors.
+* @param[in] p_radius: radius of the search (not comparable).
+* @param[in] p_metric: metric that is used for the search.
+*
+***********************************************************************************************/
+template <typename TypeIndex, typename TypeMetric>
+void ASSERT_RADIUS_SEARCH(const TypeIndex & p_index, const dataset_view & p_data, const double p_radius, const TypeMetric & p_metric) {
+    const double comparable_radius = p_metric.to_comparable(p_radius);
+
+    std::vector<std::size_t> indexes;
+    std::vector<double> distances;
+
+    for (std::size_t i = 0; i < p_data.size(); i++) {
+        index_find_radius(p_index, p_data[i], comparable_radius, p_metric, indexes, distances);
+        ASSERT_EQ(indexes.size(), distances.size());
+
+        std::vector<std::pair<std::size_t, double>> actual;
+        for (std::size_t position = 0; position < indexes.size(); position++) {
+            actual.emplace_back(indexes[position], distances[position]);
+        }
+        std::sort(actual.begin(), actual.end());
+
+        std::vector<std::size_t> expected;
+        for (std::size_t j = 0; j < p_data.size(); j++) {
+            if (p_metric.comparable_distance(p_data[i], p_data[j], p_data.dimension()) <= comparable_radius) {
+                expected.push_back(j);
+            }
+        }
+
+        ASSERT_EQ(expected.size(), actual.size());
+        for (std::size_t position = 0; position < expected.size(); position++) {
+            ASSERT_EQ(expected[position], actual[position].first);
+
+            const double expected_distance = p_metric.comparable_distance(p_data[i], p_data[expected[position]], p_data.dimension());
+            ASSERT_NEAR(expected_distance, actual[position].second, 1e-10);
+        }
+    }
+}
+
+
+/***********************************************************************************************
+*
+* @brief    Checks nearest neighbor search of the index for each point of data against full search.
+* @details  Distances should be equal to the closest ones and sorted, indexes of neighbors with
+*           equal distances are not compared.
+*
+* @param[in] p_index: index that has been built for the data.
+* @param[in] p_data: data that is used as queries and as expected neighbors.
+* @param[in] p_amount: amount of neighbors that should be found.
+* @param[in] p_metric: metric that is used for the search.
+*
+***********************************************************************************************/
+template <typename TypeIndex, typename TypeMetric>
+void ASSERT_NEAREST_SEARCH(const TypeIndex & p_index, const dataset_view & p_data, const std::size_t p_amount, const TypeMetric & p_metric) {
+    std::vector<std::size_t> indexes;
+    std::vector<double> distances;
+
+    for (std::size_t i = 0; i < p_data.size(); i++) {
+        index_find_nearest(p_index, p_data[i], p_amount, p_metric, indexes, distances);
+
+        std::vector<std::pair<double, std::size_t>> expected;
+        for (std::size_t j = 0; j < p_data.size(); j++) {
+            expected.emplace_back(p_metric.comparable_distance(p_data[i], p_data[j], p_data.dimension()), j);
+        }
+        std::sort(expected.begin(), expected.end());
+        expected.resize(std::min(p_amount, expected.size()));
+
+        ASSERT_EQ(expected.size(), indexes.size());
+        ASSERT_EQ(expected.size(), distances.size());
+
+        for (std::size_t position = 0; position < expected.size(); position++) {
+            ASSERT_NEAR(expected[position].first, distances[position], 1e-10);
+            if (position > 0) {
+                ASSERT_LE(distances[position - 1], distances[position]);
+            }
+        }
+    }
+}
+
+
+#endif
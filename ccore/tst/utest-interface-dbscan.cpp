@@ -0,0 +1,187 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#include "gtest/gtest.h"
+
+#include "interface/dbscan_interface.h"
+#include "interface/neighborhood_graph_interface.h"
+#include "interface/static_kdtree_interface.h"
+
+#include "cluster/dbscan.hpp"
+
+#include "samples.hpp"
+
+#include <cstdio>
+
+
+static std::vector<double> create_padded_buffer(const dataset & p_data, const std::size_t p_stride) {
+    std::vector<double> buffer(p_data.size() * p_stride, -1.0);
+    for (std::size_t index = 0; index < p_data.size(); index++) {
+        std::copy(p_data[index].begin(), p_data[index].end(), buffer.begin() + index * p_stride);
+    }
+
+    return buffer;
+}
+
+
+TEST(utest_interface_dbscan, dbscan_algorithm_buffer) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+
+    cluster_analysis::dbscan_data expected_result;
+    cluster_analysis::dbscan(0.7, 3).process(*data, expected_result);
+
+    const std::size_t dimension = data->front().size();
+    const std::size_t stride = dimension + 1;
+    std::vector<double> buffer = create_padded_buffer(*data, stride);
+
+    std::unique_ptr<pyclustering_package> package(dbscan_algorithm_buffer(buffer.data(), data->size(), dimension, stride, 0.7, 3));
+
+    ASSERT_EQ(expected_result.size() + 1, package->size);
+    for (std::size_t index = 0; index < expected_result.size(); index++) {
+        pyclustering_package * cluster = ((pyclustering_package **) package->data)[index];
+        std::vector<size_t> actual_cluster((size_t *) cluster->data, (size_t *) cluster->data + cluster->size);
+
+        ASSERT_EQ(expected_result[index], actual_cluster);
+    }
+
+    pyclustering_package * noise = ((pyclustering_package **) package->data)[expected_result.size()];
+    ASSERT_EQ(expected_result.noise()->size(), noise->size);
+}
+
+
+TEST(utest_interface_dbscan, dbscan_algorithm_labels) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+
+    cluster_analysis::dbscan_data expected_result;
+    cluster_analysis::dbscan(0.7, 3).process(*data, expected_result);
+
+    const dataset_matrix buffer(*data);
+    std::vector<int32_t> labels(data->size(), 100);
+
+    const std::size_t amount_clusters = dbscan_algorithm_labels(buffer.data(), buffer.size(), buffer.dimension(), 0, 0.7, 3, labels.data());
+
+    ASSERT_EQ(expected_result.size(), amount_clusters);
+    for (std::size_t index_cluster = 0; index_cluster < expected_result.size(); index_cluster++) {
+        for (const auto index_object : expected_result[index_cluster]) {
+            ASSERT_EQ((int32_t) index_cluster, labels[index_object]);
+        }
+    }
+
+    for (const auto index_object : *expected_result.noise()) {
+        ASSERT_EQ(cluster_analysis::cluster_data::NOISE_LABEL, labels[index_object]);
+    }
+}
+
+
+TEST(utest_interface_dbscan, dbscan_algorithm_labels_package) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_02);
+
+    const dataset_matrix buffer(*data);
+    std::vector<int32_t> expected_labels(data->size(), 100);
+    dbscan_algorithm_labels(buffer.data(), buffer.size(), buffer.dimension(), 0, 2.0, 9, expected_labels.data());
+
+    std::unique_ptr<pyclustering_package> package(dbscan_algorithm_labels_package(buffer.data(), buffer.size(), buffer.dimension(), 0, 2.0, 9));
+
+    ASSERT_EQ((unsigned int) PYCLUSTERING_TYPE_INT, package->type);
+    ASSERT_EQ(data->size(), package->size);
+
+    const int32_t * labels = (const int32_t *) package->data;
+    ASSERT_EQ(expected_labels, std::vector<int32_t>(labels, labels + package->size));
+}
+
+
+TEST(utest_interface_dbscan, dbscan_algorithm_labels_all_noise) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+
+    const dataset_matrix buffer(*data);
+    std::vector<int32_t> labels(data->size(), 100);
+
+    const std::size_t amount_clusters = dbscan_algorithm_labels(buffer.data(), buffer.size(), buffer.dimension(), 0, 0.001, 3, labels.data());
+
+    ASSERT_EQ(0U, amount_clusters);
+    ASSERT_EQ(std::vector<int32_t>(data->size(), -1), labels);
+}
+
+
+TEST(utest_interface_dbscan, dbscan_algorithm_labels_graph_small_radius) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+
+    const dataset_matrix buffer(*data);
+    void * graph = neighborhood_graph_create(buffer.data(), buffer.size(), buffer.dimension(), 0, 0.5);
+    ASSERT_NE(nullptr, graph);
+
+    std::vector<int32_t> labels(data->size(), 100);
+    const std::size_t amount_clusters = dbscan_algorithm_labels_graph(graph, 0.7, 3, labels.data());
+
+    neighborhood_graph_destroy(graph);
+
+    ASSERT_EQ(SIZE_MAX, amount_clusters);
+    ASSERT_EQ(std::vector<int32_t>(data->size(), 100), labels);
+}
+
+
+TEST(utest_interface_dbscan, dbscan_algorithm_labels_kdtree) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+
+    const dataset_matrix buffer(*data);
+    std::vector<int32_t> expected_labels(data->size(), 100);
+    const std::size_t expected_amount = dbscan_algorithm_labels(buffer.data(), buffer.size(), buffer.dimension(), 0, 0.7, 3, expected_labels.data());
+
+    void * built_tree = static_kdtree_create(buffer.data(), buffer.size(), buffer.dimension(), 0);
+    ASSERT_NE(nullptr, built_tree);
+    ASSERT_TRUE(static_kdtree_write(built_tree, "utest-interface-dbscan-kdtree.bin"));
+    static_kdtree_destroy(built_tree);
+
+    void * tree = static_kdtree_open("utest-interface-dbscan-kdtree.bin");
+    ASSERT_NE(nullptr, tree);
+    ASSERT_EQ(buffer.size(), static_kdtree_size(tree));
+    ASSERT_EQ(buffer.dimension(), static_kdtree_dimension(tree));
+
+    std::vector<int32_t> labels(data->size(), 100);
+    const std::size_t amount_clusters = dbscan_algorithm_labels_kdtree(tree, buffer.data(), buffer.size(), buffer.dimension(), 0, 0.7, 3, labels.data());
+
+    static_kdtree_destroy(tree);
+    std::remove("utest-interface-dbscan-kdtree.bin");
+
+    ASSERT_EQ(expected_amount, amount_clusters);
+    ASSERT_EQ(expected_labels, labels);
+
+    ASSERT_EQ(nullptr, static_kdtree_open("utest-interface-dbscan-kdtree.bin"));
+}
+
+
+TEST(utest_interface_dbscan, dbscan_algorithm_labels_kdtree_other_data) {
+    std::shared_ptr<dataset> tree_data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+
+    const dataset_matrix tree_buffer(*tree_data);
+    void * tree = static_kdtree_create(tree_buffer.data(), tree_buffer.size(), tree_buffer.dimension(), 0);
+    ASSERT_NE(nullptr, tree);
+
+    const dataset_matrix buffer(*data);
+    std::vector<int32_t> labels(data->size(), 100);
+    const std::size_t amount_clusters = dbscan_algorithm_labels_kdtree(tree, buffer.data(), buffer.size(), buffer.dimension(), 0, 0.7, 3, labels.data());
+
+    static_kdtree_destroy(tree);
+
+    ASSERT_EQ(SIZE_MAX, amount_clusters);
+    ASSERT_EQ(std::vector<int32_t>(data->size(), 100), labels);
+}
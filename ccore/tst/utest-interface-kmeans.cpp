@@ -0,0 +1,129 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#include "gtest/gtest.h"
+
+#include "interface/kmeans_interface.h"
+
+#include "cluster/kmeans.hpp"
+
+#include "samples.hpp"
+
+
+TEST(utest_interface_kmeans, kmeans_algorithm_buffer) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+    dataset start_centers = { { 0.2, 0.1 },{ 4.0, 1.0 },{ 2.0, 2.0 },{ 2.3, 3.9 } };
+
+    cluster_analysis::kmeans_data expected_result;
+    cluster_analysis::kmeans(start_centers, 0.0001).process(*data, expected_result);
+
+    const dataset_matrix data_buffer(*data);
+    const dataset_matrix centers_buffer(start_centers);
+
+    std::unique_ptr<pyclustering_package> package(kmeans_algorithm_buffer(data_buffer.data(), data_buffer.size(), data_buffer.dimension(), 0,
+        centers_buffer.data(), centers_buffer.size(), 0.0001));
+
+    ASSERT_EQ(expected_result.size(), package->size);
+    for (std::size_t index = 0; index < expected_result.size(); index++) {
+        pyclustering_package * cluster = ((pyclustering_package **) package->data)[index];
+        std::vector<size_t> actual_cluster((size_t *) cluster->data, (size_t *) cluster->data + cluster->size);
+
+        ASSERT_EQ(expected_result[index], actual_cluster);
+    }
+}
+
+
+TEST(utest_interface_kmeans, kmeans_algorithm_labels) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+    dataset start_centers = { { 0.2, 0.1 },{ 4.0, 1.0 },{ 2.0, 2.0 },{ 2.3, 3.9 } };
+
+    cluster_analysis::kmeans_data expected_result;
+    cluster_analysis::kmeans(start_centers, 0.0001).process(*data, expected_result);
+
+    const dataset_matrix data_buffer(*data);
+    const dataset_matrix centers_buffer(start_centers);
+
+    std::vector<int32_t> labels(data->size(), -1);
+    const std::size_t amount_clusters = kmeans_algorithm_labels(data_buffer.data(), data_buffer.size(), data_buffer.dimension(), 0,
+        centers_buffer.data(), centers_buffer.size(), 0.0001, labels.data());
+
+    ASSERT_EQ(expected_result.size(), amount_clusters);
+    for (std::size_t index_cluster = 0; index_cluster < expected_result.size(); index_cluster++) {
+        for (const auto index_object : expected_result[index_cluster]) {
+            ASSERT_EQ((int32_t) index_cluster, labels[index_object]);
+        }
+    }
+
+    for (const auto label : labels) {
+        ASSERT_NE(cluster_analysis::cluster_data::NOISE_LABEL, label);
+    }
+}
+
+
+TEST(utest_interface_kmeans, kmeans_algorithm_labels_package) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+    dataset start_centers = { { 0.2, 0.1 },{ 4.0, 1.0 },{ 2.0, 2.0 },{ 2.3, 3.9 } };
+
+    const dataset_matrix data_buffer(*data);
+    const dataset_matrix centers_buffer(start_centers);
+
+    std::vector<int32_t> expected_labels(data->size(), -1);
+    kmeans_algorithm_labels(data_buffer.data(), data_buffer.size(), data_buffer.dimension(), 0,
+        centers_buffer.data(), centers_buffer.size(), 0.0001, expected_labels.data());
+
+    std::unique_ptr<pyclustering_package> package(kmeans_algorithm_labels_package(data_buffer.data(), data_buffer.size(), data_buffer.dimension(), 0,
+        centers_buffer.data(), centers_buffer.size(), 0.0001));
+
+    ASSERT_EQ((unsigned int) PYCLUSTERING_TYPE_INT, package->type);
+    ASSERT_EQ(data->size(), package->size);
+
+    const int32_t * labels = (const int32_t *) package->data;
+    ASSERT_EQ(expected_labels, std::vector<int32_t>(labels, labels + package->size));
+}
+
+
+TEST(utest_interface_kmeans, kmeans_algorithm_labels_f32) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+    dataset start_centers = { { 0.2, 0.1 },{ 4.0, 1.0 },{ 2.0, 2.0 },{ 2.3, 3.9 } };
+
+    cluster_analysis::kmeans_data expected_result;
+    cluster_analysis::kmeans(start_centers, 0.0001).process(*data, expected_result);
+
+    std::vector<float> data_buffer, centers_buffer;
+    for (const auto & point : *data) {
+        data_buffer.insert(data_buffer.end(), point.begin(), point.end());
+    }
+
+    for (const auto & center : start_centers) {
+        centers_buffer.insert(centers_buffer.end(), center.begin(), center.end());
+    }
+
+    std::vector<int32_t> labels(data->size(), -1);
+    const std::size_t amount_clusters = kmeans_algorithm_labels_f32(data_buffer.data(), data->size(), 2, 0,
+        centers_buffer.data(), start_centers.size(), 0.0001, labels.data());
+
+    ASSERT_EQ(expected_result.size(), amount_clusters);
+    for (std::size_t index_cluster = 0; index_cluster < expected_result.size(); index_cluster++) {
+        for (const auto index_object : expected_result[index_cluster]) {
+            ASSERT_EQ((int32_t) index_cluster, labels[index_object]);
+        }
+    }
+}
@@ -23,7 +23,12 @@
 
 #include "container/kdtree.hpp"
 
+#include "utils.hpp"
+
 #include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
 
 
 using namespace container;
@@ -224,3 +229,489 @@ TEST_F(utest_kdtree, insert_remove_permutation_vector) {
 	DestroyPoints(test_sample_point_vector);
 	delete permutated_point_vector;
 }
+
+TEST_F(utest_kdtree, search_nearest_nodes_with_metric) {
+	double test_sample_point[9][2] = { {0, 0}, {0, 1}, {0, 2}, {1, 0}, {1, 1}, {1, 2}, {2, 0}, {2, 1}, {2, 2} };
+	std::vector< std::vector<double> * > * test_sample_point_vector = GeneratePoints((double *) &test_sample_point, 2, 9);
+
+	InitTestObject(test_sample_point_vector);
+
+	std::vector<double> search_point = { 1.0, 1.0 };
+
+	basic_kdtree_searcher<utils::metric::chebyshev> chebyshev_searcher(&search_point, tree->get_root(), 1.0);
+	std::unique_ptr< std::vector<kdnode *> > chebyshev_nodes(chebyshev_searcher.find_nearest_nodes());
+	ASSERT_EQ(9U, chebyshev_nodes->size());
+
+	basic_kdtree_searcher<utils::metric::manhattan> manhattan_searcher(&search_point, tree->get_root(), 1.0);
+	std::unique_ptr< std::vector<kdnode *> > manhattan_nodes(manhattan_searcher.find_nearest_nodes());
+	ASSERT_EQ(5U, manhattan_nodes->size());
+
+	kdtree_searcher euclidean_searcher(&search_point, tree->get_root(), 1.5);
+	std::unique_ptr< std::vector<kdnode *> > euclidean_nodes(euclidean_searcher.find_nearest_nodes());
+	ASSERT_EQ(9U, euclidean_nodes->size());
+
+	DestroyPoints(test_sample_point_vector);
+}
+
+
+static std::size_t calculate_depth(kdnode * node) {
+	if (node == nullptr) {
+		return 0;
+	}
+
+	return 1 + std::max(calculate_depth(node->get_left()), calculate_depth(node->get_right()));
+}
+
+static void check_subtree_order(kdnode * node) {
+	if (node == nullptr) {
+		return;
+	}
+
+	std::vector<kdnode *> stack;
+	if (node->get_left() != nullptr) { stack.push_back(node->get_left()); }
+	while (!stack.empty()) {
+		kdnode * current = stack.back();
+		stack.pop_back();
+
+		/* coordinates of removed nodes are not kept */
+		if (!current->is_removed()) {
+			ASSERT_LT(current->get_value(node->get_discriminator()), node->get_value());
+		}
+
+		if (current->get_left() != nullptr) { stack.push_back(current->get_left()); }
+		if (current->get_right() != nullptr) { stack.push_back(current->get_right()); }
+	}
+
+	if (node->get_right() != nullptr) { stack.push_back(node->get_right()); }
+	while (!stack.empty()) {
+		kdnode * current = stack.back();
+		stack.pop_back();
+
+		if (!current->is_removed()) {
+			ASSERT_GE(current->get_value(node->get_discriminator()), node->get_value());
+		}
+
+		if (current->get_left() != nullptr) { stack.push_back(current->get_left()); }
+		if (current->get_right() != nullptr) { stack.push_back(current->get_right()); }
+	}
+
+	check_subtree_order(node->get_left());
+	check_subtree_order(node->get_right());
+}
+
+static void template_balanced_creation(const std::vector< std::vector<double> > & points, const kdtree_split split, const std::size_t maximum_depth) {
+	std::vector< std::vector<double> * > point_pointers;
+	std::vector<void *> payloads;
+	for (std::size_t index = 0; index < points.size(); index++) {
+		point_pointers.push_back((std::vector<double> *) &points[index]);
+		payloads.push_back((void *) index);
+	}
+
+	kdtree tree(&point_pointers, &payloads, split);
+
+	ASSERT_EQ(points.size(), tree.traverse(tree.get_root()));
+	ASSERT_LE(calculate_depth(tree.get_root()), maximum_depth);
+	check_subtree_order(tree.get_root());
+
+	for (std::size_t index = 0; index < points.size(); index++) {
+		kdnode * node = tree.find_node(point_pointers[index]);
+		ASSERT_NE(nullptr, node);
+		ASSERT_EQ((void *) index, node->get_payload());
+	}
+
+	const double radius = 1.5;
+	for (std::size_t index = 0; index < points.size(); index += points.size() / 10 + 1) {
+		kdtree_searcher searcher(point_pointers[index], tree.get_root(), radius);
+		std::unique_ptr< std::vector<kdnode *> > nodes(searcher.find_nearest_nodes());
+
+		std::size_t expected_amount = 0;
+		for (const auto & point : points) {
+			if (euclidean_distance(point, points[index]) <= radius) {
+				expected_amount++;
+			}
+		}
+
+		ASSERT_EQ(expected_amount, nodes->size());
+	}
+}
+
+TEST(utest_kdtree_balanced, sorted_points_median) {
+	std::vector< std::vector<double> > points;
+	for (std::size_t index = 0; index < 10000; index++) {
+		points.push_back({ (double) index, 0.0 });
+	}
+
+	template_balanced_creation(points, kdtree_split::MEDIAN, 14);
+}
+
+TEST(utest_kdtree_balanced, sorted_points_sliding_midpoint) {
+	std::vector< std::vector<double> > points;
+	for (std::size_t index = 0; index < 10000; index++) {
+		points.push_back({ 0.0, (double) index });
+	}
+
+	template_balanced_creation(points, kdtree_split::SLIDING_MIDPOINT, 28);
+}
+
+TEST(utest_kdtree_balanced, duplicated_points) {
+	std::vector< std::vector<double> > points;
+	for (std::size_t index = 0; index < 300; index++) {
+		points.push_back({ (double) (index % 3), (double) (index % 5) });
+	}
+
+	template_balanced_creation(points, kdtree_split::MEDIAN, points.size());
+	template_balanced_creation(points, kdtree_split::SLIDING_MIDPOINT, points.size());
+}
+
+TEST(utest_kdtree_balanced, clustered_points) {
+	std::vector< std::vector<double> > points;
+	for (std::size_t index = 0; index < 2000; index++) {
+		const double center = (index % 2 == 0) ? 0.0 : 1000.0;
+		points.push_back({ center + std::sin((double) index), center + std::cos((double) index * 3.0), (double) (index % 7) });
+	}
+
+	template_balanced_creation(points, kdtree_split::MEDIAN, 20);
+	template_balanced_creation(points, kdtree_split::SLIDING_MIDPOINT, 40);
+}
+
+TEST(utest_kdtree_balanced, empty_data) {
+	std::vector< std::vector<double> * > points;
+	kdtree tree(&points, nullptr, kdtree_split::MEDIAN);
+	ASSERT_EQ(nullptr, tree.get_root());
+}
+
+TEST(utest_kdtree_balanced, insert_remove_after_creation) {
+	std::vector< std::vector<double> > points;
+	for (std::size_t index = 0; index < 100; index++) {
+		points.push_back({ (double) (index / 10), (double) (index % 10) });
+	}
+
+	std::vector< std::vector<double> * > point_pointers;
+	for (auto & point : points) {
+		point_pointers.push_back(&point);
+	}
+
+	kdtree tree(&point_pointers, nullptr, kdtree_split::MEDIAN);
+
+	std::vector<double> extra_point = { 4.5, 4.5 };
+	tree.insert(&extra_point, nullptr);
+	ASSERT_NE(nullptr, tree.find_node(&extra_point));
+
+	for (std::size_t index = 0; index < points.size(); index += 2) {
+		tree.remove(point_pointers[index]);
+	}
+
+	ASSERT_EQ(51U, tree.traverse(tree.get_root()));
+	check_subtree_order(tree.get_root());
+
+	for (std::size_t index = 1; index < points.size(); index += 2) {
+		ASSERT_NE(nullptr, tree.find_node(point_pointers[index]));
+	}
+}
+
+
+template <typename TypeMetric>
+static void template_k_nearest_nodes(const std::size_t amount, const double radius, const kdtree_split split, const TypeMetric & metric = TypeMetric()) {
+	std::vector< std::vector<double> > points;
+	for (std::size_t index = 0; index < 300; index++) {
+		points.push_back({ std::sin((double) index) * 5.0, std::cos((double) index * 0.7) * 5.0 });
+	}
+
+	std::vector< std::vector<double> * > point_pointers;
+	std::vector<void *> payloads;
+	for (std::size_t index = 0; index < points.size(); index++) {
+		point_pointers.push_back(&points[index]);
+		payloads.push_back((void *) (index + 1));	/* null payload can't be excluded from search */
+	}
+
+	kdtree tree(&point_pointers, &payloads, split);
+
+	for (std::size_t index = 0; index < points.size(); index += 7) {
+		std::vector<double> expected;
+		for (const auto & point : points) {
+			const double candidate = metric.comparable_distance(point.data(), points[index].data(), point.size());
+			if (candidate <= metric.to_comparable(radius)) {
+				expected.push_back(candidate);
+			}
+		}
+
+		std::sort(expected.begin(), expected.end());
+		expected.resize(std::min(amount, expected.size()));
+
+		basic_kdtree_searcher<TypeMetric> searcher(&points[index], tree.get_root(), radius, metric);
+
+		std::vector<double> distances;
+		std::unique_ptr< std::vector<kdnode *> > nodes(searcher.find_k_nearest_nodes(amount, &distances));
+
+		ASSERT_EQ(expected.size(), nodes->size());
+		ASSERT_EQ(expected.size(), distances.size());
+		for (std::size_t position = 0; position < expected.size(); position++) {
+			ASSERT_DOUBLE_EQ(expected[position], distances[position]);
+
+			const std::vector<double> & found_point = *((*nodes)[position]->get_data());
+			ASSERT_DOUBLE_EQ(distances[position], metric.comparable_distance(found_point.data(), points[index].data(), found_point.size()));
+		}
+
+		/* the nearest node is the point itself or its duplicate */
+		double nearest_distance = -1.0;
+		ASSERT_NE(nullptr, searcher.find_nearest_node(&nearest_distance));
+		ASSERT_EQ(0.0, nearest_distance);
+
+		if (expected.size() > 1) {
+			kdnode * nearest_other = searcher.find_nearest_node(&nearest_distance, (void *) (index + 1));
+			ASSERT_NE(nullptr, nearest_other);
+			ASSERT_NE((void *) (index + 1), nearest_other->get_payload());
+			ASSERT_DOUBLE_EQ(expected[1], nearest_distance);
+		}
+	}
+}
+
+
+TEST(utest_kdtree_searcher, k_nearest_nodes_euclidean) {
+	template_k_nearest_nodes<utils::metric::euclidean>(1, 100.0, kdtree_split::MEDIAN);
+	template_k_nearest_nodes<utils::metric::euclidean>(5, 100.0, kdtree_split::MEDIAN);
+	template_k_nearest_nodes<utils::metric::euclidean>(10, 1.0, kdtree_split::SLIDING_MIDPOINT);
+	template_k_nearest_nodes<utils::metric::euclidean>(400, 100.0, kdtree_split::MEDIAN);
+}
+
+
+TEST(utest_kdtree_searcher, k_nearest_nodes_metrics) {
+	template_k_nearest_nodes<utils::metric::manhattan>(4, 100.0, kdtree_split::MEDIAN);
+	template_k_nearest_nodes<utils::metric::chebyshev>(6, 2.0, kdtree_split::SLIDING_MIDPOINT);
+}
+
+
+TEST(utest_kdtree_searcher, nearest_node_is_root) {
+	std::vector< std::vector<double> > points = { { 1.0, 1.0 }, { 5.0, 5.0 }, { -3.0, -3.0 }, { 4.0, 0.0 } };
+
+	kdtree tree;
+	for (auto & point : points) {
+		tree.insert(&point, nullptr);
+	}
+
+	std::vector<double> search_point = { 1.1, 0.9 };
+	kdtree_searcher searcher(&search_point, tree.get_root(), 10.0);
+
+	kdnode * nearest = searcher.find_nearest_node();
+	ASSERT_NE(nullptr, nearest);
+	ASSERT_EQ(tree.get_root(), nearest);
+
+	kdtree_searcher small_searcher(&search_point, tree.get_root(), 0.01);
+	ASSERT_EQ(nullptr, small_searcher.find_nearest_node());
+
+	std::unique_ptr< std::vector<kdnode *> > nodes(small_searcher.find_k_nearest_nodes(3));
+	ASSERT_TRUE(nodes->empty());
+}
+
+
+TEST(utest_kdtree_searcher, visited_nodes_are_pruned) {
+	std::vector< std::vector<double> > points;
+	for (std::size_t index = 0; index < 1000; index++) {
+		points.push_back({ (double) (index / 40), (double) (index % 40) });
+	}
+
+	std::vector< std::vector<double> * > point_pointers;
+	for (auto & point : points) {
+		point_pointers.push_back(&point);
+	}
+
+	kdtree tree(&point_pointers, nullptr, kdtree_split::MEDIAN);
+
+	std::vector<double> search_point = { 10.2, 20.3 };
+	kdtree_searcher searcher(&search_point, tree.get_root(), std::numeric_limits<double>::max());
+
+	std::unique_ptr< std::vector<kdnode *> > nodes(searcher.find_k_nearest_nodes(4));
+	ASSERT_EQ(4U, nodes->size());
+	ASSERT_EQ(10.0, (*nodes)[0]->get_data()->at(0));
+	ASSERT_EQ(20.0, (*nodes)[0]->get_data()->at(1));
+	ASSERT_LT(searcher.get_visited_nodes(), points.size() / 4);
+}
+
+
+TEST(utest_kdtree_searcher, batch_queries) {
+	std::vector< std::vector<double> > points;
+	for (std::size_t index = 0; index < 500; index++) {
+		points.push_back({ std::sin((double) index) * 5.0, std::cos((double) index * 0.3) * 5.0 });
+	}
+
+	std::vector< std::vector<double> * > point_pointers;
+	for (auto & point : points) {
+		point_pointers.push_back(&point);
+	}
+
+	kdtree tree(&point_pointers, nullptr, kdtree_split::MEDIAN);
+
+	const dataset_matrix queries(points);
+
+	const kdtree_neighbor_lists radius_result = tree.find_nearest_nodes(queries.view(), 0.7);
+	const kdtree_neighbor_lists nearest_result = tree.find_k_nearest_nodes(queries.view(), 5, utils::metric::chebyshev());
+
+	ASSERT_EQ(points.size(), radius_result.size());
+	ASSERT_EQ(points.size(), nearest_result.size());
+	ASSERT_EQ(points.size() * 5, nearest_result.total());
+
+	for (std::size_t index = 0; index < points.size(); index++) {
+		kdtree_searcher searcher(&points[index], tree.get_root(), 0.7);
+
+		std::vector<double> distances;
+		std::unique_ptr< std::vector<kdnode *> > nodes(searcher.find_nearest_nodes(&distances));
+
+		ASSERT_EQ(*nodes, std::vector<kdnode *>(radius_result.begin_neighbors(index), radius_result.end_neighbors(index)));
+		ASSERT_EQ(distances, std::vector<double>(radius_result.begin_distances(index), radius_result.begin_distances(index) + radius_result.amount(index)));
+
+		basic_kdtree_searcher<utils::metric::chebyshev> nearest_searcher(&points[index], tree.get_root(), std::numeric_limits<double>::max());
+		std::unique_ptr< std::vector<kdnode *> > nearest_nodes(nearest_searcher.find_k_nearest_nodes(5, &distances));
+
+		ASSERT_EQ(distances, std::vector<double>(nearest_result.begin_distances(index), nearest_result.begin_distances(index) + nearest_result.amount(index)));
+	}
+
+	kdtree empty_tree;
+	ASSERT_EQ(0U, empty_tree.find_nearest_nodes(queries.view(), 1.0).total());
+}
+
+
+TEST(utest_kdtree_pool, removed_nodes_are_reused) {
+	std::vector< std::vector<double> > points;
+	for (std::size_t index = 0; index < 200; index++) {
+		points.push_back({ std::sin((double) index) * 5.0, std::cos((double) index) * 5.0 });
+	}
+
+	kdtree tree;
+	for (auto & point : points) {
+		tree.insert(&point, nullptr);
+	}
+
+	ASSERT_EQ(points.size(), tree.get_pool().size());
+	ASSERT_GE(tree.get_pool().get_capacity(), points.size());
+
+	/* memory of removed nodes is reused, removed inner nodes are kept until rebuilding */
+	for (std::size_t iteration = 0; iteration < 10; iteration++) {
+		for (std::size_t index = 0; index < points.size(); index += 3) {
+			tree.remove(&points[index]);
+		}
+
+		for (std::size_t index = 0; index < points.size(); index += 3) {
+			tree.insert(&points[index], nullptr);
+		}
+	}
+
+	ASSERT_LE(tree.get_pool().size(), 2 * points.size() + 1);
+	ASSERT_EQ(points.size(), tree.get_size());
+	ASSERT_EQ(points.size(), tree.traverse(tree.get_root()));
+	check_subtree_order(tree.get_root());
+
+	kdtree single_tree;
+	std::vector<double> point = { 100.0, 100.0 };
+	kdnode * node = single_tree.insert(&point, nullptr);
+	single_tree.remove(&point);
+	ASSERT_EQ(nullptr, single_tree.get_root());
+	ASSERT_EQ(node, single_tree.insert(&point, nullptr));
+}
+
+
+TEST(utest_kdtree_pool, sorted_insertion) {
+	/* sorted points would produce chain of nodes without rebuilding of unbalanced subtrees */
+	std::vector< std::vector<double> > points;
+	for (std::size_t index = 0; index < 5000; index++) {
+		points.push_back({ (double) index });
+	}
+
+	kdtree tree;
+	for (auto & point : points) {
+		tree.insert(&point, nullptr);
+	}
+
+	ASSERT_EQ(points.size(), tree.traverse(tree.get_root()));
+	ASSERT_GE(32U, calculate_depth(tree.get_root()));
+	check_subtree_order(tree.get_root());
+
+	std::vector<double> search_point = { 4999.0 };
+	kdtree_searcher searcher(&search_point, tree.get_root(), 2.5);
+
+	std::vector<kdnode *> nodes;
+	std::vector<double> distances;
+	searcher.find_nearest_nodes(nodes, distances);
+	ASSERT_EQ(3U, nodes.size());
+
+	std::vector<kdnode *> children;
+	tree.get_root()->get_children(children);
+	ASSERT_FALSE(children.empty());
+	for (kdnode * child : children) {
+		ASSERT_EQ(tree.get_root(), child->get_parent());
+	}
+}
+
+
+TEST(utest_kdtree_pool, insert_remove_churn) {
+	std::vector< std::vector<double> > points;
+	for (std::size_t index = 0; index < 2000; index++) {
+		points.push_back({ std::sin((double) index * 1.7) * 10.0, std::cos((double) index * 0.3) * 10.0 });
+	}
+
+	kdtree tree;
+	std::vector<bool> inserted(points.size(), false);
+
+	/* points are inserted in sorted order and removed in another order, the tree keeps its depth */
+	for (std::size_t iteration = 0; iteration < 20; iteration++) {
+		for (std::size_t index = 0; index < points.size(); index++) {
+			const std::size_t position = (index * 7 + iteration * 13) % points.size();
+			if (inserted[position] && (index % 3 == iteration % 3)) {
+				tree.remove(&points[position]);
+				inserted[position] = false;
+			}
+			else if (!inserted[position] && (index % 2 == 0)) {
+				tree.insert(&points[position], (void *) position);
+				inserted[position] = true;
+			}
+		}
+
+		const std::size_t expected_size = (std::size_t) std::count(inserted.begin(), inserted.end(), true);
+		ASSERT_EQ(expected_size, tree.get_size());
+		ASSERT_EQ(expected_size, tree.traverse(tree.get_root()));
+		ASSERT_GE(64U, calculate_depth(tree.get_root()));
+	}
+
+	check_subtree_order(tree.get_root());
+
+	for (std::size_t index = 0; index < points.size(); index++) {
+		kdnode * node = tree.find_node(&points[index]);
+		ASSERT_EQ(inserted[index], node != nullptr);
+	}
+
+	/* removed nodes are not returned by searches */
+	for (std::size_t index = 0; index < points.size(); index += 37) {
+		kdtree_searcher searcher(&points[index], tree.get_root(), 2.0);
+
+		std::vector<kdnode *> nodes;
+		std::vector<double> distances;
+		searcher.find_nearest_nodes(nodes, distances);
+
+		std::size_t expected = 0;
+		for (std::size_t position = 0; position < points.size(); position++) {
+			const double distance = utils::metric::euclidean().comparable_distance(points[index].data(), points[position].data(), 2);
+			if (inserted[position] && (distance <= 4.0)) {
+				expected++;
+			}
+		}
+
+		ASSERT_EQ(expected, nodes.size());
+		for (kdnode * node : nodes) {
+			ASSERT_TRUE(inserted[(std::size_t) node->get_payload()]);
+		}
+
+		kdnode * nearest = searcher.find_nearest_node();
+		if (expected > 0) {
+			ASSERT_NE(nullptr, nearest);
+			ASSERT_FALSE(nearest->is_removed());
+		}
+	}
+
+	for (std::size_t index = 0; index < points.size(); index++) {
+		if (inserted[index]) {
+			tree.remove(&points[index]);
+		}
+	}
+
+	ASSERT_EQ(nullptr, tree.get_root());
+	ASSERT_EQ(0U, tree.get_pool().size());
+}
@@ -107,3 +107,31 @@ TEST(utest_kmeans, one_dimension_sample_simple_08) {
     std::vector<size_t> expected_clusters_length = { 15, 30, 20, 80 };
     template_kmeans_length_process_data(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_08), start_centers, expected_clusters_length);
 }
+
+
+TEST(utest_kmeans, padded_data_sample_simple_03) {
+    dataset_ptr data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+    const padded_sample padded_data(*data, 3);
+    dataset start_centers = { { 0.2, 0.1 },{ 4.0, 1.0 },{ 2.0, 2.0 },{ 2.3, 3.9 } };
+
+    kmeans_data result;
+    kmeans(start_centers, 0.0001).process(padded_data.view(), result);
+
+    ASSERT_CLUSTER_SIZES(*data, *result.clusters(), { 10, 10, 10, 30 });
+}
+
+
+TEST(utest_kmeans, single_precision_sample_simple_03) {
+    dataset_ptr data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+    dataset start_centers = { { 0.2, 0.1 },{ 4.0, 1.0 },{ 2.0, 2.0 },{ 2.3, 3.9 } };
+
+    kmeans_data expected_result;
+    kmeans(start_centers, 0.0001).process(*data, expected_result);
+
+    const dataset_matrix_f32 matrix_data = create_matrix_f32(*data);
+    kmeans_data actual_result;
+    kmeans(start_centers, 0.0001).process(matrix_data.view(), actual_result);
+
+    ASSERT_EQ(*expected_result.clusters(), *actual_result.clusters());
+    ASSERT_EQ(expected_result.centers()->size(), actual_result.centers()->size());
+}
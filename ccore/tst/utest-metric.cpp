@@ -0,0 +1,114 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+#include "gtest/gtest.h"
+
+#include "utils/metric.hpp"
+
+#include <cmath>
+#include <vector>
+
+
+using namespace utils::metric;
+
+
+static const std::vector<double> POINT1 = { 1.0, 2.0, 3.0, 4.0, 5.0 };
+static const std::vector<double> POINT2 = { 2.0, 0.0, 3.0, 8.0, 4.0 };
+
+
+template <typename TypeMetric>
+static void template_metric_distance(const TypeMetric & p_metric, const double p_expected) {
+    const double distance = p_metric.distance(POINT1.data(), POINT2.data(), POINT1.size());
+    ASSERT_NEAR(p_expected, distance, 1e-10);
+
+    const double comparable = p_metric.comparable_distance(POINT1.data(), POINT2.data(), POINT1.size());
+    ASSERT_NEAR(p_metric.to_comparable(distance), comparable, 1e-10);
+    ASSERT_NEAR(distance, p_metric.from_comparable(comparable), 1e-10);
+
+    ASSERT_NEAR(0.0, p_metric.distance(POINT1.data(), POINT1.data(), POINT1.size()), 1e-10);
+}
+
+
+TEST(utest_metric, euclidean) {
+    template_metric_distance(euclidean(), std::sqrt(22.0));
+}
+
+
+TEST(utest_metric, euclidean_square) {
+    template_metric_distance(euclidean_square(), 22.0);
+}
+
+
+TEST(utest_metric, manhattan) {
+    template_metric_distance(manhattan(), 8.0);
+}
+
+
+TEST(utest_metric, chebyshev) {
+    template_metric_distance(chebyshev(), 4.0);
+}
+
+
+TEST(utest_metric, minkowski) {
+    template_metric_distance(minkowski(3.0), std::pow(1.0 + 8.0 + 64.0 + 1.0, 1.0 / 3.0));
+    template_metric_distance(minkowski(1.0), 8.0);
+}
+
+
+TEST(utest_metric, minkowski_invalid_degree) {
+    ASSERT_THROW(minkowski(0.5), std::invalid_argument);
+}
+
+
+TEST(utest_metric, cosine) {
+    const double product = 2.0 + 0.0 + 9.0 + 32.0 + 20.0;
+    const double norm1 = std::sqrt(1.0 + 4.0 + 9.0 + 16.0 + 25.0);
+    const double norm2 = std::sqrt(4.0 + 0.0 + 9.0 + 64.0 + 16.0);
+
+    template_metric_distance(cosine(), 1.0 - product / (norm1 * norm2));
+
+    const std::vector<double> zero(POINT1.size(), 0.0);
+    ASSERT_EQ(1.0, cosine().distance(POINT1.data(), zero.data(), POINT1.size()));
+}
+
+
+TEST(utest_metric, comparable_block) {
+    const dataset_matrix block(dataset({ POINT1, POINT2, POINT1 }));
+
+    std::vector<double> result(block.size());
+    manhattan().comparable_block(POINT2.data(), block.view(), result.data());
+
+    ASSERT_EQ(std::vector<double>({ 8.0, 0.0, 8.0 }), result);
+}
+
+
+TEST(utest_metric, dispatch) {
+    auto functor = [](const auto & p_metric) {
+        return p_metric.distance(POINT1.data(), POINT2.data(), POINT1.size());
+    };
+
+    ASSERT_NEAR(std::sqrt(22.0), dispatch(type_metric::EUCLIDEAN, 0.0, functor), 1e-10);
+    ASSERT_NEAR(22.0, dispatch(type_metric::EUCLIDEAN_SQUARE, 0.0, functor), 1e-10);
+    ASSERT_NEAR(8.0, dispatch(type_metric::MANHATTAN, 0.0, functor), 1e-10);
+    ASSERT_NEAR(4.0, dispatch(type_metric::CHEBYSHEV, 0.0, functor), 1e-10);
+    ASSERT_NEAR(8.0, dispatch(type_metric::MINKOWSKI, 1.0, functor), 1e-10);
+    ASSERT_THROW(dispatch((type_metric) 100, 0.0, functor), std::invalid_argument);
+}
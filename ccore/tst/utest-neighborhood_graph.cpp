@@ -0,0 +1,177 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#include "gtest/gtest.h"
+
+#include "container/neighborhood_graph.hpp"
+
+#include "samples.hpp"
+
+#include "utest-index.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+
+using namespace container;
+
+
+template <typename TypeMetric>
+static void template_compare_with_full_search(const dataset_view & p_data, const double p_radius, const TypeMetric & p_metric = TypeMetric()) {
+    const neighborhood_graph graph = neighborhood_graph::create(p_data, p_radius, p_metric);
+
+    ASSERT_EQ(p_data.size(), graph.size());
+    ASSERT_EQ(p_data.size() + 1, graph.offsets().size());
+    ASSERT_EQ(p_radius, graph.radius());
+    ASSERT_TRUE(TypeMetric::TYPE == graph.metric());
+    ASSERT_TRUE(graph.is_built_with(p_metric));
+
+    const double comparable_radius = p_metric.to_comparable(p_radius);
+
+    std::size_t expected_edges = 0;
+    for (std::size_t i = 0; i < p_data.size(); i++) {
+        std::vector<std::size_t> expected_neighbors;
+        for (std::size_t j = 0; j < p_data.size(); j++) {
+            if ( (i != j) && (p_metric.comparable_distance(p_data[i], p_data[j], p_data.dimension()) <= comparable_radius) ) {
+                expected_neighbors.push_back(j);
+            }
+        }
+
+        const std::vector<std::size_t> actual_neighbors(graph.begin_neighbors(i), graph.end_neighbors(i));
+        ASSERT_EQ(expected_neighbors, actual_neighbors);
+        ASSERT_EQ(expected_neighbors.size(), graph.degree(i));
+
+        const double * distances = graph.begin_distances(i);
+        for (std::size_t position = 0; position < actual_neighbors.size(); position++) {
+            const double expected_distance = p_metric.comparable_distance(p_data[i], p_data[actual_neighbors[position]], p_data.dimension());
+            ASSERT_NEAR(expected_distance, distances[position], 1e-10);
+        }
+
+        expected_edges += expected_neighbors.size();
+    }
+
+    ASSERT_EQ(expected_edges, graph.edges());
+}
+
+
+TEST(utest_neighborhood_graph, create_empty) {
+    neighborhood_graph graph;
+    ASSERT_EQ(0U, graph.size());
+    ASSERT_EQ(0U, graph.edges());
+
+    const dataset_matrix matrix(0, 2);
+    const neighborhood_graph empty_graph = neighborhood_graph::create(matrix.view(), 1.0, utils::metric::euclidean());
+    ASSERT_EQ(0U, empty_graph.size());
+    ASSERT_EQ(0U, empty_graph.edges());
+}
+
+
+TEST(utest_neighborhood_graph, negative_radius) {
+    const dataset_matrix matrix = create_random_matrix(10, 2);
+    ASSERT_THROW(neighborhood_graph::create(matrix.view(), -1.0, utils::metric::euclidean()), std::invalid_argument);
+}
+
+
+TEST(utest_neighborhood_graph, euclidean_sample_simple_01) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+    const dataset_matrix matrix(*data);
+
+    template_compare_with_full_search<utils::metric::euclidean>(matrix.view(), 0.5);
+    template_compare_with_full_search<utils::metric::euclidean>(matrix.view(), 5.0);
+}
+
+
+TEST(utest_neighborhood_graph, euclidean_sample_simple_03) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+    const dataset_matrix matrix(*data);
+
+    template_compare_with_full_search<utils::metric::euclidean>(matrix.view(), 0.7);
+}
+
+
+TEST(utest_neighborhood_graph, other_metrics) {
+    const dataset_matrix matrix = create_random_matrix(200, 3);
+
+    template_compare_with_full_search<utils::metric::euclidean_square>(matrix.view(), 1.0);
+    template_compare_with_full_search<utils::metric::manhattan>(matrix.view(), 1.5);
+    template_compare_with_full_search<utils::metric::chebyshev>(matrix.view(), 0.7);
+    template_compare_with_full_search(matrix.view(), 1.0, utils::metric::minkowski(3.0));
+    template_compare_with_full_search<utils::metric::cosine>(matrix.view(), 0.1);
+}
+
+
+TEST(utest_neighborhood_graph, built_with_metric) {
+    const dataset_matrix matrix = create_random_matrix(20, 2);
+
+    const neighborhood_graph graph = neighborhood_graph::create(matrix.view(), 1.0, utils::metric::minkowski(3.0));
+    ASSERT_TRUE(graph.is_built_with(utils::metric::minkowski(3.0)));
+    ASSERT_FALSE(graph.is_built_with(utils::metric::minkowski(2.0)));
+    ASSERT_FALSE(graph.is_built_with(utils::metric::euclidean()));
+    ASSERT_FALSE(graph.is_built_with(utils::metric::manhattan()));
+}
+
+
+TEST(utest_neighborhood_graph, high_dimension) {
+    const dataset_matrix matrix = create_random_matrix(150, static_kdtree::DIMENSION_LIMIT + 4);
+    template_compare_with_full_search<utils::metric::euclidean>(matrix.view(), 5.0);
+}
+
+
+TEST(utest_neighborhood_graph, high_dimension_ball_tree) {
+    const dataset_matrix matrix = create_random_matrix(basic_ball_tree<utils::metric::euclidean>::MINIMUM_SIZE + 44, static_kdtree::DIMENSION_LIMIT + 4);
+
+    template_compare_with_full_search<utils::metric::euclidean>(matrix.view(), 5.0);
+    template_compare_with_full_search<utils::metric::manhattan>(matrix.view(), 12.0);
+    template_compare_with_full_search(matrix.view(), 5.0, utils::metric::minkowski(3.0));
+}
+
+
+TEST(utest_neighborhood_graph, sorted_and_duplicated_points) {
+    dataset_matrix matrix(100, 1);
+    for (std::size_t i = 0; i < matrix.size(); i++) {
+        matrix[i][0] = double(i / 2);
+    }
+
+    template_compare_with_full_search<utils::metric::euclidean>(matrix.view(), 1.0);
+    template_compare_with_full_search<utils::metric::euclidean>(matrix.view(), 0.0);
+}
+
+
+TEST(utest_neighborhood_graph, point_without_itself) {
+    /* distance from NaN point to itself is not less or equal to radius, so the point is not its own neighbor */
+    dataset_matrix matrix(5, 2);
+    for (std::size_t i = 0; i < matrix.size(); i++) {
+        matrix[i][0] = double(i);
+        matrix[i][1] = 0.0;
+    }
+
+    matrix[2][1] = std::nan("");
+
+    const container::neighborhood_graph graph = container::neighborhood_graph::create(matrix.view(), 1.0, utils::metric::euclidean());
+
+    ASSERT_EQ(matrix.size() + 1, graph.offsets().size());
+    ASSERT_EQ(0U, graph.degree(2));
+    ASSERT_EQ(1U, graph.degree(0));
+    ASSERT_EQ(1U, graph.degree(1));
+    ASSERT_EQ(1U, graph.degree(3));
+    ASSERT_EQ(1U, graph.degree(4));
+    ASSERT_EQ(graph.offsets().back(), graph.edges());
+}
@@ -149,3 +149,153 @@ TEST(utest_optics, noise_cluster_allocation_sample_simple_02) {
     const std::vector<size_t> expected_clusters_length = { 10 };
     template_optics_noise_allocation(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_02), 2.0, 9, 0, expected_clusters_length, 13);
 }
+
+
+TEST(utest_optics, padded_data_sample_simple_04) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_04);
+    const padded_sample padded_data(*data, 3);
+
+    optics_data result;
+    optics(0.7, 3, 0).process(padded_data.view(), result);
+
+    ASSERT_CLUSTER_SIZES(*data, *result.clusters(), { 15, 15, 15, 15, 15 });
+    ASSERT_TRUE(result.noise()->empty());
+}
+
+
+TEST(utest_optics, single_precision_sample_simple_02) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_02);
+
+    optics_data expected_result;
+    optics(2.0, 9, 0).process(*data, expected_result);
+
+    const dataset_matrix_f32 matrix_data = create_matrix_f32(*data);
+    optics_data actual_result;
+    optics(2.0, 9, 0).process(matrix_data.view(), actual_result);
+
+    ASSERT_EQ(*expected_result.clusters(), *actual_result.clusters());
+    ASSERT_EQ(*expected_result.noise(), *actual_result.noise());
+    ASSERT_EQ(expected_result.ordering()->size(), actual_result.ordering()->size());
+    for (std::size_t index = 0; index < expected_result.ordering()->size(); index++) {
+        ASSERT_NEAR(expected_result.ordering()->at(index), actual_result.ordering()->at(index), 1e-5);
+    }
+}
+
+
+TEST(utest_optics, neighborhood_graph_sample_simple_02) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_02);
+    const dataset_matrix matrix_data(*data);
+
+    const container::neighborhood_graph graph = container::neighborhood_graph::create(matrix_data.view(), 3.0, utils::metric::euclidean());
+
+    for (const std::size_t amount_clusters : { 0, 3 }) {
+        optics_data expected_result;
+        optics(2.0, 9, amount_clusters).process(matrix_data.view(), expected_result);
+
+        optics_data actual_result;
+        optics(2.0, 9, amount_clusters).process(graph, actual_result);
+
+        ASSERT_EQ(*expected_result.clusters(), *actual_result.clusters());
+        ASSERT_EQ(*expected_result.noise(), *actual_result.noise());
+        ASSERT_EQ(expected_result.ordering()->size(), actual_result.ordering()->size());
+        for (std::size_t index = 0; index < expected_result.ordering()->size(); index++) {
+            ASSERT_NEAR(expected_result.ordering()->at(index), actual_result.ordering()->at(index), 1e-10);
+        }
+    }
+}
+
+
+TEST(utest_optics, neighborhood_graph_another_metric) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_02);
+    const dataset_matrix matrix_data(*data);
+
+    const container::neighborhood_graph graph = container::neighborhood_graph::create(matrix_data.view(), 3.0, utils::metric::chebyshev());
+
+    optics_data result;
+    ASSERT_THROW(optics(2.0, 9).process(graph, result), std::invalid_argument);
+}
+
+
+TEST(utest_optics, static_kdtree_separated_blobs) {
+    const dataset data = create_separated_blobs(3, 300);
+    const dataset_matrix matrix_data(data);
+
+    optics_data tree_result;
+    optics(1.0, 3, 0).process(matrix_data.view(), tree_result);
+    ASSERT_CLUSTER_SIZES(data, *tree_result.clusters(), { 300, 300, 300 });
+
+    const container::neighborhood_graph graph = container::neighborhood_graph::create(matrix_data.view(), 1.0, utils::metric::euclidean());
+    optics_data graph_result;
+    optics(1.0, 3, 0).process(graph, graph_result);
+
+    ASSERT_EQ(*graph_result.clusters(), *tree_result.clusters());
+    ASSERT_EQ(*graph_result.noise(), *tree_result.noise());
+    ASSERT_EQ(graph_result.ordering()->size(), tree_result.ordering()->size());
+    for (std::size_t index = 0; index < graph_result.ordering()->size(); index++) {
+        ASSERT_NEAR(graph_result.ordering()->at(index), tree_result.ordering()->at(index), 1e-10);
+    }
+}
+
+
+TEST(utest_optics, static_kdtree_single_precision) {
+    const dataset data = create_separated_blobs(3, 300);
+
+    optics_data expected_result;
+    optics(1.0, 3, 0).process(data, expected_result);
+
+    const dataset_matrix_f32 matrix_data = create_matrix_f32(data);
+    optics_data actual_result;
+    optics(1.0, 3, 0).process(matrix_data.view(), actual_result);
+
+    ASSERT_EQ(*expected_result.clusters(), *actual_result.clusters());
+    ASSERT_EQ(*expected_result.noise(), *actual_result.noise());
+    ASSERT_EQ(expected_result.ordering()->size(), actual_result.ordering()->size());
+    for (std::size_t index = 0; index < expected_result.ordering()->size(); index++) {
+        ASSERT_NEAR(expected_result.ordering()->at(index), actual_result.ordering()->at(index), 1e-4);
+    }
+}
+
+
+TEST(utest_optics, ball_tree_separated_blobs) {
+    const dataset data = create_separated_blobs(3, 300, 24);
+    const dataset_matrix matrix_data(data);
+
+    optics_data tree_result;
+    optics(1.0, 3, 0).process(matrix_data.view(), tree_result);
+    ASSERT_CLUSTER_SIZES(data, *tree_result.clusters(), { 300, 300, 300 });
+
+    const container::neighborhood_graph graph = container::neighborhood_graph::create(matrix_data.view(), 1.0, utils::metric::euclidean());
+    optics_data graph_result;
+    optics(1.0, 3, 0).process(graph, graph_result);
+
+    ASSERT_EQ(*graph_result.clusters(), *tree_result.clusters());
+    ASSERT_EQ(*graph_result.noise(), *tree_result.noise());
+    ASSERT_EQ(graph_result.ordering()->size(), tree_result.ordering()->size());
+    for (std::size_t index = 0; index < graph_result.ordering()->size(); index++) {
+        ASSERT_NEAR(graph_result.ordering()->at(index), tree_result.ordering()->at(index), 1e-10);
+    }
+}
+
+
+TEST(utest_optics, hnsw_separated_blobs) {
+    const dataset data = create_separated_blobs(3, 300, 24);
+    const dataset_matrix matrix_data(data);
+    const container::hnsw index(matrix_data.view());
+
+    optics_data result;
+    optics(1.0, 3, 0).process(index, result);
+    ASSERT_CLUSTER_SIZES(data, *result.clusters(), { 300, 300, 300 });
+    ASSERT_TRUE(result.noise()->empty());
+}
+
+
+TEST(utest_optics, hnsw_another_metric_degree) {
+    const dataset_matrix matrix_data(create_separated_blobs(3, 100));
+    const container::basic_hnsw<utils::metric::minkowski> index(matrix_data.view(), container::hnsw_parameters(), utils::metric::minkowski(3.0));
+
+    optics_data result;
+    ASSERT_THROW(basic_optics<utils::metric::minkowski>(1.0, 3, 0, utils::metric::minkowski(4.0)).process(index, result), std::invalid_argument);
+
+    basic_optics<utils::metric::minkowski>(1.0, 3, 0, utils::metric::minkowski(3.0)).process(index, result);
+    ASSERT_EQ(3U, result.clusters()->size());
+}
@@ -0,0 +1,188 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#include "gtest/gtest.h"
+
+#include "utils/pairwise_distance.hpp"
+
+#include <cmath>
+
+
+using namespace utils;
+
+
+static dataset_matrix create_points(const std::size_t p_size, const std::size_t p_dimension, const double p_shift) {
+    dataset_matrix points(p_size, p_dimension);
+    for (std::size_t index_point = 0; index_point < p_size; index_point++) {
+        for (std::size_t index_dimension = 0; index_dimension < p_dimension; index_dimension++) {
+            points[index_point][index_dimension] = std::cos(0.71 * index_point + 0.53 * index_dimension + p_shift) * (1.0 + 0.1 * index_dimension);
+        }
+    }
+
+    return points;
+}
+
+
+template <typename TypeMetric>
+static void template_distance_matrix(const std::size_t p_rows, const std::size_t p_columns, const std::size_t p_dimension, const TypeMetric & p_metric) {
+    const dataset_matrix rows = create_points(p_rows, p_dimension, 0.0);
+    const dataset_matrix columns = create_points(p_columns, p_dimension, 0.3);
+
+    std::vector<double> result(p_rows * p_columns, -1.0);
+    distance_matrix(rows.view(), columns.view(), p_metric, result.data());
+
+    for (std::size_t i = 0; i < p_rows; i++) {
+        for (std::size_t j = 0; j < p_columns; j++) {
+            const double expected = p_metric.distance(rows[i], columns[j], p_dimension);
+            ASSERT_NEAR(expected, result[i * p_columns + j], 1e-9 * (1.0 + expected));
+        }
+    }
+}
+
+
+TEST(utest_pairwise_distance, euclidean_square_small) {
+    template_distance_matrix(3, 5, 2, metric::euclidean_square());
+}
+
+
+TEST(utest_pairwise_distance, euclidean_square_tile_edges) {
+    template_distance_matrix(70, 261, 3, metric::euclidean_square());
+}
+
+
+TEST(utest_pairwise_distance, euclidean_square_deep) {
+    template_distance_matrix(9, 13, 300, metric::euclidean_square());
+}
+
+
+TEST(utest_pairwise_distance, euclidean) {
+    template_distance_matrix(17, 31, 5, metric::euclidean());
+}
+
+
+TEST(utest_pairwise_distance, manhattan) {
+    template_distance_matrix(17, 31, 5, metric::manhattan());
+}
+
+
+TEST(utest_pairwise_distance, minkowski) {
+    template_distance_matrix(17, 31, 5, metric::minkowski(3.0));
+}
+
+
+TEST(utest_pairwise_distance, square_matrix_symmetric) {
+    const dataset_matrix points = create_points(67, 4, 0.0);
+    const dataset_matrix distances = distance_matrix(points.view(), metric::euclidean());
+
+    for (std::size_t i = 0; i < points.size(); i++) {
+        ASSERT_EQ(0.0, distances[i][i]);
+        for (std::size_t j = 0; j < points.size(); j++) {
+            ASSERT_EQ(distances[i][j], distances[j][i]);
+        }
+    }
+}
+
+
+TEST(utest_pairwise_distance, for_each_distance_block) {
+    const dataset_matrix points = create_points(40, 3, 0.0);
+
+    std::size_t next_row = 0;
+    for_each_distance_block(points.view(), metric::euclidean_square(), [&](const std::size_t p_begin, const std::size_t p_amount, const double * const p_distances) {
+        ASSERT_EQ(next_row, p_begin);
+
+        for (std::size_t i = 0; i < p_amount; i++) {
+            for (std::size_t j = 0; j < points.size(); j++) {
+                const double expected = (p_begin + i == j) ? 0.0 : metric::euclidean_square().distance(points[p_begin + i], points[j], 3);
+                ASSERT_NEAR(expected, p_distances[i * points.size() + j], 1e-9 * (1.0 + expected));
+            }
+        }
+
+        next_row += p_amount;
+    });
+
+    ASSERT_EQ(points.size(), next_row);
+}
+
+
+template <typename TypeMetric>
+static void template_upper_distance_block(const std::size_t p_size, const TypeMetric & p_metric) {
+    const dataset_matrix points = create_points(p_size, 3, 0.0);
+
+    std::size_t next_row = 0, amount_blocks = 0;
+    for_each_distance_block(points.view(), p_metric, true, [&](const std::size_t p_begin, const std::size_t p_amount, const double * const p_distances) {
+        ASSERT_EQ(next_row, p_begin);
+
+        const std::size_t width = points.size() - p_begin;
+        for (std::size_t i = 0; i < p_amount; i++) {
+            for (std::size_t j = p_begin; j < points.size(); j++) {
+                const double expected = (p_begin + i == j) ? 0.0 : p_metric.distance(points[p_begin + i], points[j], 3);
+                ASSERT_NEAR(expected, p_metric.from_comparable(p_distances[i * width + j - p_begin]), 1e-9 * (1.0 + expected));
+            }
+        }
+
+        next_row += p_amount;
+        amount_blocks++;
+    });
+
+    ASSERT_EQ(points.size(), next_row);
+    ASSERT_LT(1U, amount_blocks);
+}
+
+
+TEST(utest_pairwise_distance, upper_distance_block_euclidean) {
+    template_upper_distance_block(2100, metric::euclidean());
+}
+
+
+TEST(utest_pairwise_distance, upper_distance_block_manhattan) {
+    template_upper_distance_block(2100, metric::manhattan());
+}
+
+
+TEST(utest_pairwise_distance, euclidean_square_large_offset) {
+    dataset_matrix points = create_points(50, 3, 0.0);
+    for (std::size_t index_point = 0; index_point < points.size(); index_point++) {
+        for (std::size_t index_dimension = 0; index_dimension < points.dimension(); index_dimension++) {
+            points[index_point][index_dimension] += 1e6;
+        }
+    }
+
+    const dataset_view rows(points[10], 20, points.dimension());
+
+    std::vector<double> result(rows.size() * points.size());
+    euclidean_distance_square_matrix(rows, points.view(), result.data());
+
+    for (std::size_t i = 0; i < rows.size(); i++) {
+        for (std::size_t j = 0; j < points.size(); j++) {
+            const double expected = metric::euclidean_square().distance(rows[i], points[j], points.dimension());
+            ASSERT_NEAR(expected, result[i * points.size() + j], 1e-8);
+        }
+    }
+}
+
+
+TEST(utest_pairwise_distance, different_dimensions) {
+    const dataset_matrix rows = create_points(2, 3, 0.0);
+    const dataset_matrix columns = create_points(2, 4, 0.0);
+
+    std::vector<double> result(4);
+    ASSERT_THROW(euclidean_distance_square_matrix(rows.view(), columns.view(), result.data()), std::invalid_argument);
+    ASSERT_THROW(comparable_distance_matrix(rows.view(), columns.view(), metric::manhattan(), result.data()), std::invalid_argument);
+}
@@ -0,0 +1,290 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+
+#include "gtest/gtest.h"
+
+#include "parallel/parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+using namespace parallel;
+
+
+static void template_parallel_for(const std::size_t p_length) {
+    std::vector<std::size_t> values(p_length, 0);
+    parallel_for(std::size_t(0), p_length, [&values](const std::size_t p_index) {
+        values[p_index] += p_index + 1;
+    });
+
+    for (std::size_t index = 0; index < p_length; index++) {
+        ASSERT_EQ(index + 1, values[index]);
+    }
+}
+
+
+TEST(utest_parallel, parallel_for_empty) {
+    template_parallel_for(0);
+}
+
+
+TEST(utest_parallel, parallel_for_single) {
+    template_parallel_for(1);
+}
+
+
+TEST(utest_parallel, parallel_for_large) {
+    template_parallel_for(100003);
+}
+
+
+TEST(utest_parallel, parallel_for_signed_range) {
+    std::atomic<long> sum(0);
+    parallel_for(-50L, 51L, [&sum](const long p_index) { sum += p_index; });
+    ASSERT_EQ(0L, sum.load());
+}
+
+
+TEST(utest_parallel, parallel_for_sequential) {
+    const std::size_t amount = get_thread_amount();
+    set_thread_amount(1);
+    ASSERT_EQ(1U, get_thread_amount());
+    ASSERT_EQ(0U, get_thread_pool()->size());
+
+    template_parallel_for(1000);
+
+    set_thread_amount(amount);
+}
+
+
+TEST(utest_parallel, parallel_for_nested) {
+    const std::size_t size = 64;
+    std::vector<std::size_t> values(size * size, 0);
+
+    parallel_for(std::size_t(0), size, [&values, size](const std::size_t p_row) {
+        parallel_for(std::size_t(0), size, [&values, size, p_row](const std::size_t p_column) {
+            values[p_row * size + p_column] = p_row + p_column;
+        });
+    });
+
+    for (std::size_t row = 0; row < size; row++) {
+        for (std::size_t column = 0; column < size; column++) {
+            ASSERT_EQ(row + column, values[row * size + column]);
+        }
+    }
+}
+
+
+TEST(utest_parallel, parallel_for_exception) {
+    ASSERT_THROW(parallel_for(0, 1000, [](const int p_index) {
+        if (p_index == 777) {
+            throw std::runtime_error("failure");
+        }
+    }), std::runtime_error);
+}
+
+
+TEST(utest_parallel, parallel_reduce_sum) {
+    const std::size_t length = 100000;
+    const std::size_t sum = parallel_reduce(std::size_t(0), length, std::size_t(0),
+        [](const std::size_t p_index) { return p_index; },
+        [](const std::size_t p_value1, const std::size_t p_value2) { return p_value1 + p_value2; });
+
+    ASSERT_EQ(length * (length - 1) / 2, sum);
+}
+
+
+TEST(utest_parallel, parallel_reduce_maximum) {
+    std::vector<int> values(5000);
+    std::iota(values.begin(), values.end(), -2500);
+    values[1234] = 100000;
+
+    const int maximum = parallel_reduce(std::size_t(0), values.size(), std::numeric_limits<int>::min(),
+        [&values](const std::size_t p_index) { return values[p_index]; },
+        [](const int p_value1, const int p_value2) { return std::max(p_value1, p_value2); });
+
+    ASSERT_EQ(100000, maximum);
+}
+
+
+TEST(utest_parallel, parallel_reduce_boolean) {
+    const std::size_t length = 10000;
+    for (std::size_t repeat = 0; repeat < 20; repeat++) {
+        const bool all = parallel_reduce(std::size_t(0), length, true,
+            [length](const std::size_t p_index) { return p_index < length; },
+            [](const bool p_value1, const bool p_value2) { return p_value1 && p_value2; });
+
+        const bool any = parallel_reduce(std::size_t(0), length, false,
+            [length](const std::size_t p_index) { return p_index == length - 1; },
+            [](const bool p_value1, const bool p_value2) { return p_value1 || p_value2; });
+
+        ASSERT_TRUE(all);
+        ASSERT_TRUE(any);
+    }
+}
+
+
+TEST(utest_parallel, parallel_reduce_empty) {
+    const double result = parallel_reduce(0, 0, 1.5,
+        [](const int) { return 0.0; },
+        [](const double p_value1, const double p_value2) { return p_value1 + p_value2; });
+
+    ASSERT_EQ(1.5, result);
+}
+
+
+TEST(utest_parallel, task_group_run_wait) {
+    std::atomic<std::size_t> counter(0);
+
+    task_group group;
+    for (std::size_t index = 0; index < 100; index++) {
+        group.run([&counter]() { counter++; });
+    }
+
+    group.wait();
+    ASSERT_EQ(100U, counter.load());
+}
+
+
+TEST(utest_parallel, task_group_wait_running_tasks) {
+    const std::shared_ptr<thread_pool> pool = std::make_shared<thread_pool>(2);
+    std::atomic<std::size_t> counter(0);
+
+    task_group group(pool);
+    for (std::size_t index = 0; index < 2; index++) {
+        group.run([&counter]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            counter++;
+        });
+    }
+
+    /* tasks are likely taken by workers, so the waiting thread has nothing to execute */
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    group.wait();
+    ASSERT_EQ(2U, counter.load());
+}
+
+
+TEST(utest_parallel, task_group_exception) {
+    task_group group;
+    group.run([]() { throw std::invalid_argument("failure"); });
+    group.run([]() { });
+
+    ASSERT_THROW(group.wait(), std::invalid_argument);
+    ASSERT_NO_THROW(group.wait());
+}
+
+
+TEST(utest_parallel, thread_pool_without_workers) {
+    std::shared_ptr<thread_pool> pool = std::make_shared<thread_pool>(0);
+    std::atomic<std::size_t> counter(0);
+
+    task_group group(pool);
+    for (std::size_t index = 0; index < 10; index++) {
+        group.run([&counter]() { counter++; });
+    }
+
+    group.wait();
+    ASSERT_EQ(10U, counter.load());
+}
+
+
+TEST(utest_parallel, concurrent_callers) {
+    std::vector<std::thread> callers;
+    std::vector<std::size_t> results(8, 0);
+
+    for (std::size_t index_caller = 0; index_caller < results.size(); index_caller++) {
+        callers.emplace_back([&results, index_caller]() {
+            results[index_caller] = parallel_reduce(std::size_t(0), std::size_t(10000), std::size_t(0),
+                [](const std::size_t p_index) { return p_index; },
+                [](const std::size_t p_value1, const std::size_t p_value2) { return p_value1 + p_value2; });
+        });
+    }
+
+    for (auto & caller : callers) {
+        caller.join();
+    }
+
+    for (const auto result : results) {
+        ASSERT_EQ(10000U * 9999U / 2, result);
+    }
+}
+
+
+TEST(utest_parallel, change_configuration_from_worker) {
+    thread_pool pool(1);
+
+    std::promise<std::size_t> rejected;
+    std::future<std::size_t> result = rejected.get_future();
+
+    pool.submit([&rejected]() {
+        std::size_t amount_errors = 0;
+        try {
+            set_thread_amount(get_thread_amount() + 1);
+        }
+        catch(std::logic_error &) {
+            amount_errors++;
+        }
+
+        try {
+            set_thread_pinning(!get_thread_pinning());
+        }
+        catch(std::logic_error &) {
+            amount_errors++;
+        }
+
+        rejected.set_value(amount_errors);
+    });
+
+    ASSERT_EQ(2U, result.get());
+    ASSERT_FALSE(thread_pool::is_worker_thread());
+}
+
+
+TEST(utest_parallel, change_configuration) {
+    const std::size_t amount = get_thread_amount();
+
+    set_thread_amount(3);
+    ASSERT_EQ(3U, get_thread_amount());
+    ASSERT_EQ(2U, get_thread_pool()->size());
+
+    set_thread_pinning(true);
+    ASSERT_TRUE(get_thread_pinning());
+    template_parallel_for(10000);
+
+    set_thread_pinning(false);
+    ASSERT_FALSE(get_thread_pinning());
+
+    set_thread_amount(0);
+    ASSERT_EQ((std::size_t) std::max(std::thread::hardware_concurrency(), 1U), get_thread_amount());
+
+    set_thread_amount(amount);
+}
@@ -110,3 +110,76 @@ TEST(utest_rock, allocation_sample_simple_08) {
     const std::vector<size_t> expected_clusters_length = { 15, 30, 20, 80 };
     template_length_process_data(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_08), 1.0, 4, 0.5, expected_clusters_length);
 }
+
+
+TEST(utest_rock, padded_data_sample_simple_04) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_04);
+    const padded_sample padded_data(*data, 3);
+
+    rock_data result;
+    rock(1.0, 5, 0.5).process(padded_data.view(), result);
+
+    ASSERT_CLUSTER_SIZES(*data, *result.clusters(), { 15, 15, 15, 15, 15 });
+}
+
+
+TEST(utest_rock, neighborhood_graph_sample_simple_02) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_02);
+    const dataset_matrix matrix_data(*data);
+
+    const container::neighborhood_graph graph = container::neighborhood_graph::create(matrix_data.view(), 1.0, utils::metric::euclidean());
+
+    for (const size_t amount_clusters : { 1, 3 }) {
+        rock_data expected_result;
+        rock(1.0, amount_clusters, 0.5).process(matrix_data.view(), expected_result);
+
+        rock_data actual_result;
+        rock(1.0, amount_clusters, 0.5).process(graph, actual_result);
+
+        ASSERT_EQ(*expected_result.clusters(), *actual_result.clusters());
+    }
+}
+
+
+TEST(utest_rock, neighborhood_graph_another_metric) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_02);
+    const dataset_matrix matrix_data(*data);
+
+    const container::neighborhood_graph graph = container::neighborhood_graph::create(matrix_data.view(), 1.0, utils::metric::manhattan());
+
+    rock_data result;
+    ASSERT_THROW(rock(1.0, 3, 0.5).process(graph, result), std::invalid_argument);
+}
+
+
+TEST(utest_rock, large_offset_exact_distance) {
+    /* neighbors are closer than radius by 0.00005 and groups are farther than radius by the same value */
+    std::vector<std::vector<double>> points;
+    double position = 0.0;
+    for (size_t index = 0; index < 12; index++) {
+        points.push_back({ 1e6 + position, 1e6 });
+        position += (index % 3 == 2) ? 1.00005 : 0.99995;
+    }
+
+    const dataset_matrix matrix_data(points);
+    const container::neighborhood_graph graph = container::neighborhood_graph::create(matrix_data.view(), 1.0, utils::metric::euclidean());
+
+    rock_data expected_result;
+    rock(1.0, 4, 0.5).process(graph, expected_result);
+
+    rock_data actual_result;
+    rock(1.0, 4, 0.5).process(matrix_data.view(), actual_result);
+
+    ASSERT_EQ(*expected_result.clusters(), *actual_result.clusters());
+    ASSERT_CLUSTER_SIZES(points, *actual_result.clusters(), { 3, 3, 3, 3 });
+}
+
+
+TEST(utest_rock, kdtree_separated_blobs) {
+    const dataset data = create_separated_blobs(3, 100);
+    const dataset_matrix matrix_data(data);
+
+    rock_data result;
+    rock(1.5, 3, 0.5).process(matrix_data.view(), result);
+    ASSERT_CLUSTER_SIZES(data, *result.clusters(), { 100, 100, 100 });
+}
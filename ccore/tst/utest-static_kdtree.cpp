@@ -0,0 +1,536 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#include "gtest/gtest.h"
+
+#include "container/static_kdtree.hpp"
+
+#include "utest-index.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+using namespace container;
+
+
+static const char * const UTEST_STATIC_KDTREE_FILE = "utest-static_kdtree.bin";
+
+
+template <typename TypeMetric>
+static void template_find_radius(const dataset_view & p_data, const double p_radius, const std::size_t p_bucket_size, const TypeMetric & p_metric = TypeMetric()) {
+    const static_kdtree tree(p_data, p_bucket_size);
+    ASSERT_EQ(p_data.size(), tree.size());
+
+    ASSERT_RADIUS_SEARCH(tree, p_data, p_radius, p_metric);
+}
+
+
+template <typename TypeMetric>
+static void template_find_nearest(const dataset_view & p_data, const std::size_t p_amount, const std::size_t p_bucket_size, const TypeMetric & p_metric = TypeMetric()) {
+    const static_kdtree tree(p_data, p_bucket_size);
+    ASSERT_NEAREST_SEARCH(tree, p_data, p_amount, p_metric);
+}
+
+
+TEST(utest_static_kdtree, empty) {
+    static_kdtree default_tree;
+    ASSERT_EQ(0U, default_tree.size());
+    ASSERT_EQ(0U, default_tree.amount_nodes());
+
+    const dataset_matrix matrix(0, 2);
+    const static_kdtree tree(matrix.view());
+    ASSERT_EQ(0U, tree.size());
+
+    const double point[2] = { 0.0, 0.0 };
+    std::vector<std::size_t> indexes = { 1 };
+    std::vector<double> distances = { 1.0 };
+
+    ASSERT_EQ(0U, tree.find_radius(point, 10.0, utils::metric::euclidean(), indexes, distances));
+    ASSERT_TRUE(indexes.empty());
+    ASSERT_TRUE(distances.empty());
+
+    ASSERT_EQ(0U, tree.find_nearest(point, 3, utils::metric::euclidean(), indexes, distances));
+    ASSERT_TRUE(indexes.empty());
+}
+
+
+TEST(utest_static_kdtree, single_precision) {
+    const dataset_matrix matrix = create_random_matrix(500, 3);
+
+    dataset_matrix_f32 matrix_f32(matrix.size(), matrix.dimension());
+    for (std::size_t i = 0; i < matrix.size(); i++) {
+        std::copy(matrix[i], matrix[i] + matrix.dimension(), matrix_f32[i]);
+    }
+
+    const static_kdtree_f32 tree(matrix_f32.view(), 8);
+    const utils::metric::euclidean_square metric;
+
+    std::vector<std::size_t> indexes;
+    std::vector<double> distances;
+
+    for (std::size_t i = 0; i < matrix_f32.size(); i++) {
+        tree.find_radius(matrix_f32[i], 1.0, metric, indexes, distances);
+        std::sort(indexes.begin(), indexes.end());
+
+        std::vector<std::size_t> expected;
+        for (std::size_t j = 0; j < matrix_f32.size(); j++) {
+            if (metric.comparable_distance(matrix_f32[i], matrix_f32[j], matrix_f32.dimension()) <= 1.0) {
+                expected.push_back(j);
+            }
+        }
+
+        ASSERT_EQ(expected, indexes);
+        ASSERT_EQ(expected.size(), tree.count_radius(matrix_f32[i], 1.0, metric));
+
+        tree.find_nearest(matrix_f32[i], 1, metric, indexes, distances);
+        ASSERT_EQ(1U, indexes.size());
+        ASSERT_EQ(0.0, distances[0]);
+    }
+
+    tree.write(UTEST_STATIC_KDTREE_FILE);
+    ASSERT_EQ(tree.amount_nodes(), static_kdtree_f32::open(UTEST_STATIC_KDTREE_FILE).amount_nodes());
+    ASSERT_THROW(static_kdtree::open(UTEST_STATIC_KDTREE_FILE), std::runtime_error);
+    std::remove(UTEST_STATIC_KDTREE_FILE);
+}
+
+
+TEST(utest_static_kdtree, leaf_buckets) {
+    const dataset_matrix matrix = create_random_matrix(1000, 2);
+
+    const static_kdtree tree(matrix.view(), 16);
+    ASSERT_EQ(2U, tree.dimension());
+    ASSERT_GE(tree.amount_nodes(), 2 * (1000 / 16) - 1);
+
+    const static_kdtree single_leaf(matrix.view(), 1000);
+    ASSERT_EQ(1U, single_leaf.amount_nodes());
+}
+
+
+TEST(utest_static_kdtree, find_radius_euclidean) {
+    const dataset_matrix matrix = create_random_matrix(500, 2);
+
+    template_find_radius<utils::metric::euclidean>(matrix.view(), 0.5, 16);
+    template_find_radius<utils::metric::euclidean>(matrix.view(), 1.5, 32);
+    template_find_radius<utils::metric::euclidean>(matrix.view(), 0.0, 64);
+}
+
+
+TEST(utest_static_kdtree, find_radius_metrics) {
+    const dataset_matrix matrix = create_random_matrix(400, 3);
+
+    template_find_radius<utils::metric::euclidean_square>(matrix.view(), 1.0, 16);
+    template_find_radius<utils::metric::manhattan>(matrix.view(), 1.5, 32);
+    template_find_radius<utils::metric::chebyshev>(matrix.view(), 0.7, 1);
+    template_find_radius(matrix.view(), 1.0, 32, utils::metric::minkowski(3.0));
+}
+
+
+TEST(utest_static_kdtree, find_nearest_euclidean) {
+    const dataset_matrix matrix = create_random_matrix(500, 2);
+
+    template_find_nearest<utils::metric::euclidean>(matrix.view(), 1, 16);
+    template_find_nearest<utils::metric::euclidean>(matrix.view(), 5, 32);
+    template_find_nearest<utils::metric::euclidean>(matrix.view(), 600, 32);
+}
+
+
+TEST(utest_static_kdtree, find_nearest_metrics) {
+    const dataset_matrix matrix = create_random_matrix(300, 4);
+
+    template_find_nearest<utils::metric::manhattan>(matrix.view(), 3, 16);
+    template_find_nearest<utils::metric::chebyshev>(matrix.view(), 7, 64);
+}
+
+
+TEST(utest_static_kdtree, duplicated_points) {
+    dataset_matrix matrix(300, 2);
+    for (std::size_t i = 0; i < matrix.size(); i++) {
+        matrix[i][0] = double(i % 3);
+        matrix[i][1] = 1.0;
+    }
+
+    template_find_radius<utils::metric::euclidean>(matrix.view(), 0.0, 16);
+    template_find_radius<utils::metric::euclidean>(matrix.view(), 1.0, 16);
+    template_find_nearest<utils::metric::euclidean>(matrix.view(), 4, 16);
+}
+
+
+TEST(utest_static_kdtree, batch_find_radius) {
+    const dataset_matrix matrix = create_random_matrix(1000, 3);
+    const dataset_matrix queries = create_random_matrix(700, 3);
+
+    const static_kdtree tree(matrix.view());
+    const double radius = utils::metric::euclidean().to_comparable(0.8);
+
+    const neighbor_lists result = tree.find_radius(queries.view(), radius, utils::metric::euclidean());
+    ASSERT_EQ(queries.size(), result.size());
+    ASSERT_EQ(queries.size() + 1, result.offsets().size());
+
+    std::size_t total = 0;
+    std::vector<std::size_t> indexes;
+    std::vector<double> distances;
+
+    for (std::size_t i = 0; i < queries.size(); i++) {
+        tree.find_radius(queries[i], radius, utils::metric::euclidean(), indexes, distances);
+
+        const std::vector<std::size_t> batch_indexes(result.begin_neighbors(i), result.end_neighbors(i));
+        const std::vector<double> batch_distances(result.begin_distances(i), result.begin_distances(i) + result.amount(i));
+
+        ASSERT_EQ(indexes, batch_indexes);
+        ASSERT_EQ(distances, batch_distances);
+
+        total += indexes.size();
+    }
+
+    ASSERT_EQ(total, result.total());
+}
+
+
+TEST(utest_static_kdtree, batch_find_nearest) {
+    const dataset_matrix matrix = create_random_matrix(1000, 2);
+    const static_kdtree tree(matrix.view(), 16);
+
+    const neighbor_lists result = tree.find_nearest(matrix.view(), 6, utils::metric::manhattan());
+    ASSERT_EQ(matrix.size(), result.size());
+    ASSERT_EQ(matrix.size() * 6, result.total());
+
+    std::vector<std::size_t> indexes;
+    std::vector<double> distances;
+
+    for (std::size_t i = 0; i < matrix.size(); i++) {
+        tree.find_nearest(matrix[i], 6, utils::metric::manhattan(), indexes, distances);
+
+        ASSERT_EQ(indexes, std::vector<std::size_t>(result.begin_neighbors(i), result.end_neighbors(i)));
+        ASSERT_EQ(0.0, result.begin_distances(i)[0]);
+    }
+}
+
+
+TEST(utest_static_kdtree, reused_search_buffer) {
+    const dataset_matrix matrix = create_random_matrix(1000, 3);
+    const static_kdtree tree(matrix.view(), 16);
+    const double radius = utils::metric::euclidean().to_comparable(0.8);
+
+    static_kdtree::search_buffer buffer;
+    std::vector<std::size_t> indexes, buffer_indexes;
+    std::vector<double> distances, buffer_distances;
+
+    for (std::size_t i = 0; i < matrix.size(); i++) {
+        tree.find_radius(matrix[i], radius, utils::metric::euclidean(), indexes, distances);
+
+        buffer_indexes.clear();
+        buffer_distances.clear();
+        tree.find_radius(matrix[i], radius, utils::metric::euclidean(), buffer, buffer_indexes, buffer_distances);
+
+        ASSERT_EQ(indexes, buffer_indexes);
+        ASSERT_EQ(distances, buffer_distances);
+        std::size_t calculated_distances = 0;
+        ASSERT_EQ(tree.count_radius(matrix[i], radius, utils::metric::euclidean()), tree.count_radius(matrix[i], radius, utils::metric::euclidean(), std::numeric_limits<std::size_t>::max(), buffer, calculated_distances));
+        ASSERT_LT(0U, calculated_distances);
+
+        /* amount of calculated distances is accumulated */
+        const std::size_t first_query_distances = calculated_distances;
+        tree.count_radius(matrix[i], radius, utils::metric::euclidean(), std::numeric_limits<std::size_t>::max(), buffer, calculated_distances);
+        ASSERT_EQ(2 * first_query_distances, calculated_distances);
+
+        tree.find_nearest(matrix[i], 5, utils::metric::euclidean(), indexes, distances);
+
+        buffer_indexes.clear();
+        buffer_distances.clear();
+        tree.find_nearest(matrix[i], 5, utils::metric::euclidean(), buffer, buffer_indexes, buffer_distances);
+
+        ASSERT_EQ(indexes, buffer_indexes);
+        ASSERT_EQ(distances, buffer_distances);
+    }
+}
+
+
+TEST(utest_static_kdtree, is_built_for) {
+    const dataset_matrix matrix = create_random_matrix(1000, 3);
+    const static_kdtree tree(matrix.view());
+
+    ASSERT_TRUE(tree.is_built_for(matrix.view()));
+    ASSERT_FALSE(tree.is_built_for(dataset_view(matrix[0], 999, 3)));
+    ASSERT_FALSE(tree.is_built_for(create_random_matrix(1000, 2).view()));
+
+    /* all points are changed, so any sampled point differs */
+    dataset_matrix shifted = matrix;
+    for (std::size_t i = 0; i < shifted.size(); i++) {
+        shifted[i][2] += 1.0;
+    }
+
+    ASSERT_FALSE(tree.is_built_for(shifted.view()));
+
+    ASSERT_TRUE(static_kdtree().is_built_for(dataset_view()));
+}
+
+
+TEST(utest_static_kdtree, batch_empty) {
+    const dataset_matrix matrix = create_random_matrix(100, 2);
+    const dataset_matrix no_queries(0, 2);
+
+    const static_kdtree tree(matrix.view());
+    const neighbor_lists result = tree.find_nearest(no_queries.view(), 3, utils::metric::euclidean());
+    ASSERT_EQ(0U, result.size());
+    ASSERT_EQ(0U, result.total());
+
+    const static_kdtree empty_tree;
+    const neighbor_lists empty_result = empty_tree.find_radius(matrix.view(), 1.0, utils::metric::euclidean());
+    ASSERT_EQ(matrix.size(), empty_result.size());
+    ASSERT_EQ(0U, empty_result.total());
+}
+
+
+template <typename TypeMetric>
+static void template_find_all_neighbors(const dataset_view & p_data, const double p_radius, const std::size_t p_bucket_size, const TypeMetric & p_metric = TypeMetric()) {
+    const static_kdtree tree(p_data, p_bucket_size);
+    const double comparable_radius = p_metric.to_comparable(p_radius);
+
+    const neighbor_lists result = tree.find_all_neighbors(comparable_radius, p_metric);
+    ASSERT_EQ(p_data.size(), result.size());
+
+    std::vector<std::size_t> expected;
+    for (std::size_t i = 0; i < p_data.size(); i++) {
+        expected.clear();
+        for (std::size_t j = 0; j < p_data.size(); j++) {
+            if (p_metric.comparable_distance(p_data[i], p_data[j], p_data.dimension()) <= comparable_radius) {
+                expected.push_back(j);
+            }
+        }
+
+        ASSERT_EQ(expected, std::vector<std::size_t>(result.begin_neighbors(i), result.end_neighbors(i)));
+        for (std::size_t position = 0; position < expected.size(); position++) {
+            const double expected_distance = p_metric.comparable_distance(p_data[i], p_data[expected[position]], p_data.dimension());
+            ASSERT_NEAR(expected_distance, result.begin_distances(i)[position], 1e-10);
+        }
+    }
+}
+
+
+TEST(utest_static_kdtree, find_all_neighbors_euclidean) {
+    const dataset_matrix matrix = create_random_matrix(1500, 2);
+    template_find_all_neighbors<utils::metric::euclidean>(matrix.view(), 0.3, 16);
+    template_find_all_neighbors<utils::metric::euclidean_square>(matrix.view(), 0.5, 8);
+}
+
+
+TEST(utest_static_kdtree, find_all_neighbors_metrics) {
+    const dataset_matrix matrix = create_random_matrix(800, 3);
+    template_find_all_neighbors<utils::metric::manhattan>(matrix.view(), 0.7, 16);
+    template_find_all_neighbors<utils::metric::chebyshev>(matrix.view(), 0.4, 32);
+    template_find_all_neighbors<utils::metric::minkowski>(matrix.view(), 0.5, 16, utils::metric::minkowski(3.0));
+}
+
+
+TEST(utest_static_kdtree, find_all_neighbors_duplicated_points) {
+    dataset_matrix matrix(300, 2);
+    for (std::size_t i = 0; i < matrix.size(); i++) {
+        matrix[i][0] = double(i % 3);
+        matrix[i][1] = 1.0;
+    }
+
+    template_find_all_neighbors<utils::metric::euclidean>(matrix.view(), 0.0, 16);
+    template_find_all_neighbors<utils::metric::euclidean>(matrix.view(), 1.0, 4);
+}
+
+
+TEST(utest_static_kdtree, find_all_neighbors_empty) {
+    const static_kdtree empty_tree;
+    const neighbor_lists empty_result = empty_tree.find_all_neighbors(1.0, utils::metric::euclidean());
+    ASSERT_EQ(0U, empty_result.size());
+    ASSERT_EQ(0U, empty_result.total());
+
+    const dataset_matrix matrix = create_random_matrix(1, 2);
+    const static_kdtree tree(matrix.view());
+    const neighbor_lists result = tree.find_all_neighbors(0.0, utils::metric::euclidean());
+    ASSERT_EQ(1U, result.size());
+    ASSERT_EQ(0U, result.begin_neighbors(0)[0]);
+}
+
+
+template <typename TypeMetric>
+static void template_count_radius(const dataset_view & p_data, const double p_radius, const std::size_t p_bucket_size, const TypeMetric & p_metric = TypeMetric()) {
+    const static_kdtree tree(p_data, p_bucket_size);
+    const double comparable_radius = p_metric.to_comparable(p_radius);
+
+    for (std::size_t i = 0; i < p_data.size(); i += 3) {
+        std::size_t expected = 0;
+        for (std::size_t j = 0; j < p_data.size(); j++) {
+            if (p_metric.comparable_distance(p_data[i], p_data[j], p_data.dimension()) <= comparable_radius) {
+                expected++;
+            }
+        }
+
+        ASSERT_EQ(expected, tree.count_radius(p_data[i], comparable_radius, p_metric));
+
+        for (const std::size_t limit : { std::size_t(1), std::size_t(5), expected, expected + 1 }) {
+            const std::size_t amount = tree.count_radius(p_data[i], comparable_radius, p_metric, limit);
+            if (expected >= limit) {
+                ASSERT_GE(amount, limit);
+            }
+            else {
+                ASSERT_EQ(expected, amount);
+            }
+        }
+    }
+}
+
+
+TEST(utest_static_kdtree, count_radius_euclidean) {
+    const dataset_matrix matrix = create_random_matrix(1500, 2);
+    template_count_radius<utils::metric::euclidean>(matrix.view(), 0.3, 16);
+    template_count_radius<utils::metric::euclidean>(matrix.view(), 2.0, 8);
+    template_count_radius<utils::metric::euclidean_square>(matrix.view(), 0.5, 16);
+}
+
+
+TEST(utest_static_kdtree, count_radius_metrics) {
+    const dataset_matrix matrix = create_random_matrix(800, 3);
+    template_count_radius<utils::metric::manhattan>(matrix.view(), 1.5, 16);
+    template_count_radius<utils::metric::chebyshev>(matrix.view(), 0.8, 32);
+    template_count_radius<utils::metric::minkowski>(matrix.view(), 1.0, 16, utils::metric::minkowski(3.0));
+}
+
+
+TEST(utest_static_kdtree, count_radius_duplicated_points) {
+    dataset_matrix matrix(300, 2);
+    for (std::size_t i = 0; i < matrix.size(); i++) {
+        matrix[i][0] = double(i % 3);
+        matrix[i][1] = 1.0;
+    }
+
+    template_count_radius<utils::metric::euclidean>(matrix.view(), 0.0, 16);
+    template_count_radius<utils::metric::euclidean>(matrix.view(), 1.0, 4);
+
+    const static_kdtree empty_tree;
+    const double point[2] = { 0.0, 1.0 };
+    ASSERT_EQ(0U, empty_tree.count_radius(point, 1.0, utils::metric::euclidean()));
+}
+
+
+static void template_write_open(const dataset_view & p_data, const double p_radius, const std::size_t p_bucket_size) {
+    const static_kdtree built_tree(p_data, p_bucket_size);
+    built_tree.write(UTEST_STATIC_KDTREE_FILE);
+
+    const static_kdtree * opened_tree = new static_kdtree(static_kdtree::open(UTEST_STATIC_KDTREE_FILE));
+    const static_kdtree tree(*opened_tree);   /* copy shares mapping of the file */
+    delete opened_tree;
+
+    std::remove(UTEST_STATIC_KDTREE_FILE);    /* mapping keeps data of the removed file */
+
+    ASSERT_EQ(built_tree.size(), tree.size());
+    ASSERT_EQ(built_tree.dimension(), tree.dimension());
+    ASSERT_EQ(built_tree.amount_nodes(), tree.amount_nodes());
+
+    const utils::metric::euclidean_square metric;
+
+    std::vector<std::size_t> expected_indexes, actual_indexes;
+    std::vector<double> expected_distances, actual_distances;
+
+    for (std::size_t i = 0; i < p_data.size(); i++) {
+        built_tree.find_radius(p_data[i], p_radius, metric, expected_indexes, expected_distances);
+        tree.find_radius(p_data[i], p_radius, metric, actual_indexes, actual_distances);
+        ASSERT_EQ(expected_indexes, actual_indexes);
+        ASSERT_EQ(expected_distances, actual_distances);
+
+        built_tree.find_nearest(p_data[i], 5, metric, expected_indexes, expected_distances);
+        tree.find_nearest(p_data[i], 5, metric, actual_indexes, actual_distances);
+        ASSERT_EQ(expected_indexes, actual_indexes);
+        ASSERT_EQ(expected_distances, actual_distances);
+
+        ASSERT_EQ(built_tree.count_radius(p_data[i], p_radius, metric), tree.count_radius(p_data[i], p_radius, metric));
+    }
+
+    const neighbor_lists expected_lists = built_tree.find_all_neighbors(p_radius, metric);
+    const neighbor_lists actual_lists = tree.find_all_neighbors(p_radius, metric);
+    ASSERT_EQ(expected_lists.offsets(), actual_lists.offsets());
+    ASSERT_EQ(expected_lists.neighbors(), actual_lists.neighbors());
+}
+
+
+TEST(utest_static_kdtree, write_open) {
+    const dataset_matrix matrix = create_random_matrix(500, 3);
+    template_write_open(matrix.view(), 1.0, 8);
+    template_write_open(matrix.view(), 0.5, static_kdtree::DEFAULT_BUCKET_SIZE);
+}
+
+
+TEST(utest_static_kdtree, write_open_small) {
+    const dataset_matrix matrix = create_random_matrix(3, 2);
+    template_write_open(matrix.view(), 2.0, 8);
+}
+
+
+TEST(utest_static_kdtree, write_open_empty) {
+    const static_kdtree empty_tree;
+    empty_tree.write(UTEST_STATIC_KDTREE_FILE);
+
+    const static_kdtree tree = static_kdtree::open(UTEST_STATIC_KDTREE_FILE);
+    std::remove(UTEST_STATIC_KDTREE_FILE);
+
+    ASSERT_EQ(0U, tree.size());
+    ASSERT_EQ(0U, tree.amount_nodes());
+    ASSERT_EQ(0U, tree.find_all_neighbors(1.0, utils::metric::euclidean()).total());
+}
+
+
+TEST(utest_static_kdtree, open_invalid_file) {
+    ASSERT_THROW(static_kdtree::open("utest-static_kdtree-missing.bin"), std::runtime_error);
+
+    {
+        std::ofstream stream(UTEST_STATIC_KDTREE_FILE, std::ios::binary | std::ios::trunc);
+        stream << "not a tree file, but long enough to contain the header of the tree file";
+    }
+    ASSERT_THROW(static_kdtree::open(UTEST_STATIC_KDTREE_FILE), std::runtime_error);
+
+    const dataset_matrix matrix = create_random_matrix(200, 2);
+    static_kdtree(matrix.view(), 8).write(UTEST_STATIC_KDTREE_FILE);
+
+    std::vector<char> content;
+    {
+        std::ifstream stream(UTEST_STATIC_KDTREE_FILE, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+
+    {
+        std::ofstream stream(UTEST_STATIC_KDTREE_FILE, std::ios::binary | std::ios::trunc);
+        stream.write(content.data(), content.size() - 1);
+    }
+    ASSERT_THROW(static_kdtree::open(UTEST_STATIC_KDTREE_FILE), std::runtime_error);
+
+    /* index of right child of the root that is placed at the first aligned offset after the header */
+    const std::size_t invalid_child = 1000000;
+    std::memcpy(content.data() + 128 + sizeof(double) + 2 * sizeof(std::size_t), &invalid_child, sizeof(std::size_t));
+    {
+        std::ofstream stream(UTEST_STATIC_KDTREE_FILE, std::ios::binary | std::ios::trunc);
+        stream.write(content.data(), content.size());
+    }
+    ASSERT_THROW(static_kdtree::open(UTEST_STATIC_KDTREE_FILE), std::runtime_error);
+
+    std::remove(UTEST_STATIC_KDTREE_FILE);
+}
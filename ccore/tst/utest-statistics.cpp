@@ -0,0 +1,197 @@
+/**
+*
+* Copyright (C) 2014-2017    Andrei Novikov (pyclustering@yandex.ru)
+*
+* GNU_PUBLIC_LICENSE
+*   pyclustering is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   pyclustering is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+
+
+
+#include "gtest/gtest.h"
+
+#include "cluster/dbscan.hpp"
+#include "cluster/kmeans.hpp"
+
+#include "interface/kmeans_interface.h"
+#include "interface/statistics_interface.h"
+
+#include "utils/statistics.hpp"
+
+#include "samples.hpp"
+#include "utest-cluster.hpp"
+
+#include <memory>
+#include <thread>
+
+
+using namespace cluster_analysis;
+using namespace utils;
+
+
+TEST(utest_statistics, disabled_by_default) {
+    ASSERT_FALSE(statistics::is_enabled());
+    ASSERT_EQ(nullptr, statistics::create());
+}
+
+
+TEST(utest_statistics, counters_and_phases) {
+    statistics::enable(true);
+
+    statistics_ptr collector = statistics::create();
+    ASSERT_NE(nullptr, collector);
+
+    increase_counter(collector.get(), statistic_counter::ITERATIONS);
+    increase_counter(collector.get(), statistic_counter::DISTANCE_EVALUATIONS, 10);
+    increase_counter(nullptr, statistic_counter::DISTANCE_EVALUATIONS, 10);
+
+    {
+        statistics_timer timer(collector.get(), statistic_phase::UPDATE);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    {
+        statistics_timer timer(nullptr, statistic_phase::UPDATE);
+    }
+
+    ASSERT_EQ(1U, collector->get_counter(statistic_counter::ITERATIONS));
+    ASSERT_EQ(10U, collector->get_counter(statistic_counter::DISTANCE_EVALUATIONS));
+    ASSERT_EQ(0U, collector->get_counter(statistic_counter::NEIGHBOR_QUERIES));
+    ASSERT_GT(collector->get_time(statistic_phase::UPDATE), 0.0);
+    ASSERT_EQ(0.0, collector->get_time(statistic_phase::TOTAL));
+
+    statistics::enable(false);
+}
+
+
+TEST(utest_statistics, kmeans_disabled) {
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+
+    kmeans_data output_result;
+    kmeans({ { 3.7, 5.5 }, { 6.7, 7.5 } }, 0.0001).process(*data, output_result);
+
+    ASSERT_EQ(nullptr, output_result.statistics());
+}
+
+
+TEST(utest_statistics, kmeans_enabled) {
+    statistics::enable(true);
+
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+
+    kmeans_data output_result;
+    kmeans({ { 3.7, 5.5 }, { 6.7, 7.5 } }, 0.0001).process(*data, output_result);
+
+    const statistics_ptr collector = output_result.statistics();
+    ASSERT_NE(nullptr, collector);
+
+    const std::size_t iterations = collector->get_counter(statistic_counter::ITERATIONS);
+    ASSERT_GT(iterations, 0U);
+    ASSERT_GE(collector->get_counter(statistic_counter::DISTANCE_EVALUATIONS), iterations * data->size() * 2);
+    ASSERT_GE(collector->get_time(statistic_phase::TOTAL), collector->get_time(statistic_phase::ASSIGNMENT));
+
+    statistics::enable(false);
+}
+
+
+TEST(utest_statistics, dbscan_enabled) {
+    statistics::enable(true);
+
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+
+    dbscan_data output_result;
+    dbscan(0.5, 2).process(*data, output_result);
+
+    const statistics_ptr collector = output_result.statistics();
+    ASSERT_NE(nullptr, collector);
+
+    ASSERT_EQ(data->size(), collector->get_counter(statistic_counter::NEIGHBOR_QUERIES));
+    ASSERT_EQ(data->size() * data->size(), collector->get_counter(statistic_counter::DISTANCE_EVALUATIONS));
+
+    statistics::enable(false);
+}
+
+
+TEST(utest_statistics, dbscan_static_kdtree) {
+    statistics::enable(true);
+
+    const dataset data = create_separated_blobs(3, 300);
+
+    dbscan_data output_result;
+    dbscan(1.0, 3).process(data, output_result);
+
+    const statistics_ptr collector = output_result.statistics();
+    ASSERT_NE(nullptr, collector);
+
+    /* the first point of each cluster is checked by count-only query before its neighbors are found */
+    ASSERT_EQ(data.size() + output_result.clusters()->size(), collector->get_counter(statistic_counter::NEIGHBOR_QUERIES));
+    ASSERT_LT(collector->get_counter(statistic_counter::DISTANCE_EVALUATIONS), data.size() * data.size() / 4);
+
+    /* each query calculates distances at least to both corners of the root box */
+    ASSERT_LE(2 * data.size(), collector->get_counter(statistic_counter::DISTANCE_EVALUATIONS));
+
+    statistics::enable(false);
+}
+
+
+TEST(utest_statistics, dbscan_static_kdtree_single_precision) {
+    statistics::enable(true);
+
+    const dataset data = create_separated_blobs(3, 300);
+    const dataset_matrix_f32 matrix_data = create_matrix_f32(data);
+
+    dbscan_data output_result;
+    dbscan(1.0, 3).process(matrix_data.view(), output_result);
+
+    const statistics_ptr collector = output_result.statistics();
+    ASSERT_NE(nullptr, collector);
+
+    ASSERT_EQ(data.size() + output_result.clusters()->size(), collector->get_counter(statistic_counter::NEIGHBOR_QUERIES));
+    ASSERT_LT(collector->get_counter(statistic_counter::DISTANCE_EVALUATIONS), data.size() * data.size() / 4);
+
+    statistics::enable(false);
+}
+
+
+TEST(utest_statistics, interface_kmeans_package) {
+    statistics_enable(true);
+
+    std::shared_ptr<dataset> data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+    const dataset_matrix data_buffer(*data);
+    const dataset_matrix centers_buffer(dataset({ { 3.7, 5.5 }, { 6.7, 7.5 } }));
+
+    delete kmeans_algorithm_buffer(data_buffer.data(), data_buffer.size(), data_buffer.dimension(), 0,
+        centers_buffer.data(), centers_buffer.size(), 0.0001);
+
+    std::unique_ptr<pyclustering_package> package(kmeans_get_statistics());
+    ASSERT_EQ(2U, package->size);
+
+    pyclustering_package * counters = ((pyclustering_package **) package->data)[0];
+    pyclustering_package * phases = ((pyclustering_package **) package->data)[1];
+
+    ASSERT_EQ(statistics::AMOUNT_COUNTERS, counters->size);
+    ASSERT_EQ(statistics::AMOUNT_PHASES, phases->size);
+    ASSERT_GT(((std::size_t *) counters->data)[0], 0U);
+
+    statistics_enable(false);
+
+    delete kmeans_algorithm_buffer(data_buffer.data(), data_buffer.size(), data_buffer.dimension(), 0,
+        centers_buffer.data(), centers_buffer.size(), 0.0001);
+
+    std::unique_ptr<pyclustering_package> empty_package(kmeans_get_statistics());
+    ASSERT_EQ(2U, empty_package->size);
+    ASSERT_EQ(0U, ((pyclustering_package **) empty_package->data)[0]->size);
+    ASSERT_EQ(0U, ((pyclustering_package **) empty_package->data)[1]->size);
+}
@@ -23,6 +23,10 @@
 
 #include "cluster/syncnet.hpp"
 
+#include "utils/metric.hpp"
+
+#include <cmath>
+
 
 static void template_create_delete(const unsigned int size) {
 	std::vector<std::vector<double> > sample;
@@ -132,3 +136,72 @@ TEST(utest_syncnet, two_clusters_rk4_solver_without_collection) {
 TEST(utest_syncnet, two_clusters_rkf45_solver_without_collection) {
 	template_two_cluster_allocation(solve_type::RKF45, false);
 }
+
+
+TEST(utest_syncnet, large_offset_exact_connections) {
+	/* distances between points differ from connectivity radius by 0.00005 */
+	std::vector<std::vector<double> > sample;
+	double position = 0.0;
+	for (std::size_t index = 0; index < 20; index++) {
+		sample.push_back( { 1e6 + position, 1e6 - position } );
+		position += (index % 2 == 0) ? 0.49995 : 0.50005;
+	}
+
+	const double radius = 0.5 * std::sqrt(2.0);
+	syncnet network(&sample, radius, false, initial_type::EQUIPARTITION);
+
+	for (std::size_t i = 0; i < sample.size(); i++) {
+		for (std::size_t j = i + 1; j < sample.size(); j++) {
+			const double distance = utils::metric::euclidean_square().distance(sample[i].data(), sample[j].data(), 2);
+			ASSERT_EQ(distance <= radius * radius, network.connections()->has_connection(i, j));
+		}
+	}
+}
+
+
+TEST(utest_syncnet, neighborhood_graph_another_metric) {
+	std::vector<std::vector<double> > sample = { { 0.1, 0.1 }, { 0.2, 0.1 }, { 2.2, 2.1 } };
+
+	const dataset_matrix matrix_data(sample);
+	const container::neighborhood_graph graph = container::neighborhood_graph::create(matrix_data.view(), 1.0, utils::metric::euclidean_square());
+
+	ASSERT_THROW(syncnet(&sample, graph, 0.5, false, initial_type::EQUIPARTITION), std::invalid_argument);
+}
+
+
+TEST(utest_syncnet, two_clusters_neighborhood_graph) {
+	std::vector<std::vector<double> > sample;
+
+	sample.push_back( { 0.1, 0.1 } );
+	sample.push_back( { 0.2, 0.1 } );
+	sample.push_back( { 0.0, 0.0 } );
+
+	sample.push_back( { 2.2, 2.1 } );
+	sample.push_back( { 2.3, 2.0 } );
+	sample.push_back( { 2.1, 2.4 } );
+
+	const dataset_matrix matrix_data(sample);
+	const container::neighborhood_graph graph = container::neighborhood_graph::create(matrix_data.view(), 1.0, utils::metric::euclidean());
+
+	bool result_testing = false;
+
+	for (unsigned int attempt = 0; attempt < 3; attempt++) {
+		syncnet network(&sample, graph, 0.5, false, initial_type::EQUIPARTITION);
+
+		syncnet_analyser analyser;
+		network.process(0.995, solve_type::FAST, true, analyser);
+
+		ensemble_data<syncnet_cluster> ensembles;
+		analyser.allocate_clusters(0.1, ensembles);
+
+		if (2 != ensembles.size()) {
+			continue;
+		}
+
+		result_testing = true;
+	}
+
+	ASSERT_TRUE(result_testing);
+
+	ASSERT_THROW(syncnet(&sample, graph, 2.0, false, initial_type::EQUIPARTITION), std::invalid_argument);
+}
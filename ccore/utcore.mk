@@ -27,7 +27,7 @@ TOOLS_DIRECTORY = tools
 
 
 # Project sources
-SOURCES_MODULES = . cluster container differential interface nnet tsp
+SOURCES_MODULES = . cluster container differential interface nnet parallel tsp utils
 UTEST_MODULES = .
 TOOLS_MODULES = gtest
 